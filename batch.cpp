@@ -0,0 +1,658 @@
+/*batch.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Batch maze generation
+ * 
+ * Generates and solves many independent mazes in parallel on a pool of worker threads,
+ * streaming the results into one .csv or .mzb shard file per worker
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "batch.h"
+#include "boundedQueue.h"
+#include "maze.h"
+#include "mazeGenerators.h"
+#include "mazeReader.h"
+#include "mazeSolver.h"
+#include "mazeWriter.h"
+#include "rng.h"
+#include "scratchArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * appendShardRecord()
+ * 
+ * Adds one solved maze to a shard file, after the ones before it
+ * 
+ * @param[in,out]   shardBuffer     Buffer in front of the shard file
+ * @param[in]       solvedMaze      Maze to write
+ * @param[in]       outputFormat    Format of the shard file, see mazeWriter.h
+ * @param[in]       isFirstRecord   true if no maze was written to the shard yet
+ * --------------------------------------------------------------------------------------
+*/
+void appendShardRecord(MazeOutputBuffer& shardBuffer, const Maze& solvedMaze, int outputFormat, bool isFirstRecord)
+{
+    if(outputFormat == MAZE_FORMAT_BINARY)
+    {
+        // Binary records are back to back, each one says how long it is
+        writeMazeDataBinary(shardBuffer, solvedMaze, false, 0);
+    }
+    else
+    {
+        // Mazes in a shard are separated by newlines
+        if(!isFirstRecord)
+        {
+            shardBuffer.append('\n');
+        }
+        writeMazeDataCSV(shardBuffer, solvedMaze);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * runBatchWorker()
+ * 
+ * Body of one worker thread in runBatch(), runs every numWorkers-th job starting at its 
+ * own worker index
+ * 
+ * @param[in]       numRows         Number of rows in each maze
+ * @param[in]       numCols         Number of columns in each maze
+ * @param[in]       numMazes        Total number of maze jobs in the batch
+ * @param[in]       worker          Index of this worker, its first job
+ * @param[in]       numWorkers      Number of workers in the batch
+ * @param[in]       generatorType   Generator to fill out each maze with, see mazeGenerators.h
+ * @param[in]       aldousBroderFraction    Fraction of the cells the hybrid generator adds 
+ *                                          before switching to Wilson's Algorithm
+ * @param[in]       solverType      Solver engine to solve each maze with, see MazeSolver
+ * @param[in]       seed            Seed of the batch, each job draws from the stream of 
+ *                                  its maze index, see makeStreamEngine()
+ * @param[in]       shardFileName   Name of the shard file this worker writes to
+ * @param[in]       outputFormat    Format of the shard file, see mazeWriter.h
+ * @param[out]      numWritten      Number of mazes this worker wrote
+ * --------------------------------------------------------------------------------------
+*/
+void runBatchWorker(int numRows, int numCols, std::uint64_t numMazes, int worker, int numWorkers, \
+                    int generatorType, double aldousBroderFraction, int solverType, std::uint64_t seed, const std::string& shardFileName, int outputFormat, std::uint64_t& numWritten)
+{
+    std::ios_base::openmode shardMode = std::ofstream::out | std::ofstream::trunc;
+    if(outputFormat == MAZE_FORMAT_BINARY)
+    {
+        shardMode |= std::ofstream::binary;
+    }
+
+    std::ofstream shardFile(shardFileName, shardMode);
+    if(!shardFile)
+    {
+        std::cerr << "ERROR: runBatch() could not open the shard file " << shardFileName << std::endl;
+        return;
+    }
+
+    Maze workerMaze(numRows, numCols);
+    MazeSolver workerSolver(numRows, numCols);
+    MazeOutputBuffer shardBuffer(shardFile);
+
+    // Sized for one maze up front, so no job allocates generator scratch
+    ScratchArena workerScratch(mazeGeneratorScratchBytes(generatorType, numRows, numCols));
+
+    for(std::uint64_t job = worker; job < numMazes; job += numWorkers)
+    {
+        workerMaze.reset();
+        workerScratch.reset();
+        DefaultRng rng = makeStreamEngine(seed, job);
+
+        runMazeGenerator(workerMaze, generatorType, rng, 1, aldousBroderFraction, &workerScratch);
+        solveMaze(workerMaze, solverType, workerSolver);
+
+        appendShardRecord(shardBuffer, workerMaze, outputFormat, numWritten == 0);
+        numWritten++;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * runBatch()
+ * 
+ * Generates numMazes independent mazes with the given generator (Wilson's Algorithm by 
+ * default) and solves each of them with the given solver engine, spread across numThreads 
+ * worker threads
+ *     Worker w runs jobs w, w + numThreads, w + 2 * numThreads and so on, the mazes being 
+ *     the same size so the split stays even without a shared job counter
+ *     Each maze draws from the counter-based stream of its own maze index, see 
+ *     makeStreamEngine(), so maze i is the same whatever the number of threads, and no 
+ *     engine is shared between threads
+ *     Each worker owns one Maze, one MazeSolver, one MazeOutputBuffer and one ScratchArena 
+ *     for the generator which it reuses for every job it takes
+ *     Each worker streams its mazes to its own shard file "<outputPrefix>_<worker>.csv" 
+ *     (or .mzb), one maze after another in the same format as mazeData.csv, separated by 
+ *     newlines, or as back to back binary records, so taking one record of each shard in 
+ *     turn gives the mazes back in maze index order
+ * 
+ * @param[in] numRows       Number of rows in each maze
+ * @param[in] numCols       Number of columns in each maze
+ * @param[in] numMazes      Number of mazes to generate and solve
+ * @param[in] numThreads    Number of worker threads, at least 1
+ * @param[in] generatorType Generator to fill out each maze with, see mazeGenerators.h, 
+ *                          every maze is generated on its worker's thread alone
+ * @param[in] aldousBroderFraction Fraction of the cells the hybrid generator adds before 
+ *                          switching to Wilson's Algorithm, see runWilson()
+ * @param[in] solverType    Solver engine to solve each maze with, see MazeSolver
+ * @param[in] seed          Seed for the random number engine streams
+ * @param[in] outputPrefix  Prefix of the shard files to write
+ * @param[in] outputFormat  Format of the shard files, MAZE_FORMAT_CSV or MAZE_FORMAT_BINARY
+ * @return the number of mazes written
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t runBatch(int numRows, int numCols, std::uint64_t numMazes, int numThreads, int generatorType, double aldousBroderFraction, int solverType, std::uint64_t seed, const std::string& outputPrefix, int outputFormat)
+{
+    if(numThreads < 1)
+    {
+        numThreads = 1;
+    }
+
+    // One output counter per worker
+    std::vector<std::uint64_t> workerNumWritten(numThreads, 0);
+
+    std::vector<std::thread> workers;
+    for(int worker = 0; worker < numThreads; worker++)
+    {
+        workers.emplace_back(runBatchWorker, numRows, numCols, numMazes, worker, numThreads, generatorType, aldousBroderFraction, solverType, seed, \
+                             outputPrefix + "_" + std::to_string(worker) + mazeFormatExtension(outputFormat), outputFormat, \
+                             std::ref(workerNumWritten[worker]));
+    }
+
+    std::uint64_t totalWritten = 0;
+    for(int worker = 0; worker < numThreads; worker++)
+    {
+        workers[worker].join();
+        totalWritten += workerNumWritten[worker];
+    }
+
+    return totalWritten;
+}
+
+/**--------------------------------------------------------------------------------------
+ * runLoadedBatchWorker()
+ * 
+ * Body of one worker thread in runLoadedBatch(), loads and solves every numWorkers-th 
+ * file starting at its own worker index
+ * 
+ * @param[in]       fileNames       Maze files of the batch
+ * @param[in]       worker          Index of this worker, its first file
+ * @param[in]       numWorkers      Number of workers in the batch
+ * @param[in]       imageRows       Rows of cells of png images, 0 to find them, see MazeReader
+ * @param[in]       imageCols       Columns of cells of png images, 0 to find them
+ * @param[in]       solverType      Solver engine to solve each maze with, see MazeSolver
+ * @param[in]       shardFileName   Name of the shard file this worker writes to
+ * @param[in]       outputFormat    Format of the shard file, see mazeWriter.h
+ * @param[out]      numWritten      Number of mazes this worker wrote
+ * @param[out]      numFailed       Number of files this worker could not load, and mazes 
+ *                                  it could not solve
+ * --------------------------------------------------------------------------------------
+*/
+void runLoadedBatchWorker(const std::vector<std::string>& fileNames, int worker, int numWorkers, int imageRows, int imageCols, int solverType, \
+                          const std::string& shardFileName, int outputFormat, std::uint64_t& numWritten, std::uint64_t& numFailed)
+{
+    std::ios_base::openmode shardMode = std::ofstream::out | std::ofstream::trunc;
+    if(outputFormat == MAZE_FORMAT_BINARY)
+    {
+        shardMode |= std::ofstream::binary;
+    }
+
+    std::ofstream shardFile(shardFileName, shardMode);
+    if(!shardFile)
+    {
+        std::cerr << "ERROR: runLoadedBatch() could not open the shard file " << shardFileName << std::endl;
+        numFailed += (fileNames.size() - worker + numWorkers - 1) / numWorkers;
+        return;
+    }
+
+    MazeReader workerReader;
+    std::unique_ptr<Maze> workerMaze;
+    MazeSolver workerSolver;
+    MazeOutputBuffer shardBuffer(shardFile);
+
+    for(std::size_t file = worker; file < fileNames.size(); file += numWorkers)
+    {
+        workerReader.open(fileNames[file], imageRows, imageCols);
+        while(workerReader.nextMaze())
+        {
+            // Mazes of the same size one after another reuse the same Maze
+            if(!workerMaze || workerMaze->getROWCELLS() != workerReader.getNumRows() || workerMaze->getCOLCELLS() != workerReader.getNumCols())
+            {
+                workerMaze.reset();
+                workerMaze = std::make_unique<Maze>(workerReader.getNumRows(), workerReader.getNumCols());
+            }
+            if(!workerReader.readMaze(*workerMaze))
+            {
+                break;
+            }
+
+            if(!solveMaze(*workerMaze, solverType, workerSolver))
+            {
+                std::cerr << "ERROR: Solver did not find a path from the maze entrance to the maze exit of a maze in " << fileNames[file] << std::endl;
+                numFailed++;
+                continue;
+            }
+
+            appendShardRecord(shardBuffer, *workerMaze, outputFormat, numWritten == 0);
+            numWritten++;
+        }
+        numFailed += workerReader.hasFailed();
+    }
+    workerReader.close();
+}
+
+/**--------------------------------------------------------------------------------------
+ * runLoadedBatch()
+ * 
+ * Loads every maze of a list of maze files and solves it with the given solver engine, 
+ * spread across numThreads worker threads, see MazeReader
+ *     Worker w loads files w, w + numThreads, w + 2 * numThreads and so on, and every 
+ *     maze in them, so a file of many mazes (like a batch shard) stays on one worker
+ *     Each worker owns one MazeReader, one MazeSolver and one MazeOutputBuffer, and one 
+ *     Maze it only allocates again when the size of the mazes changes
+ *     Each worker streams its solved mazes to its own shard file, like runBatch()
+ * 
+ * @param[in]   fileNames       Maze files to load, see listMazeFiles()
+ * @param[in]   numThreads      Number of worker threads, at least 1
+ * @param[in]   imageRows       Rows of cells of png images, 0 to find them, see MazeReader
+ * @param[in]   imageCols       Columns of cells of png images, 0 to find them
+ * @param[in]   solverType      Solver engine to solve each maze with, see MazeSolver
+ * @param[in]   outputPrefix    Prefix of the shard files to write
+ * @param[in]   outputFormat    Format of the shard files, MAZE_FORMAT_CSV or MAZE_FORMAT_BINARY
+ * @param[out]  numFailed       Number of files that could not be loaded, and of mazes that 
+ *                              could not be solved
+ * @return the number of mazes written
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t runLoadedBatch(const std::vector<std::string>& fileNames, int numThreads, int imageRows, int imageCols, int solverType, const std::string& outputPrefix, int outputFormat, std::uint64_t& numFailed)
+{
+    if(numThreads < 1)
+    {
+        numThreads = 1;
+    }
+
+    // One pair of counters per worker
+    std::vector<std::uint64_t> workerNumWritten(numThreads, 0);
+    std::vector<std::uint64_t> workerNumFailed(numThreads, 0);
+
+    std::vector<std::thread> workers;
+    for(int worker = 0; worker < numThreads; worker++)
+    {
+        workers.emplace_back(runLoadedBatchWorker, std::cref(fileNames), worker, numThreads, imageRows, imageCols, solverType, \
+                             outputPrefix + "_" + std::to_string(worker) + mazeFormatExtension(outputFormat), outputFormat, \
+                             std::ref(workerNumWritten[worker]), std::ref(workerNumFailed[worker]));
+    }
+
+    std::uint64_t totalWritten = 0;
+    numFailed = 0;
+    for(int worker = 0; worker < numThreads; worker++)
+    {
+        workers[worker].join();
+        totalWritten += workerNumWritten[worker];
+        numFailed += workerNumFailed[worker];
+    }
+
+    return totalWritten;
+}
+
+/**--------------------------------------------------------------------------------------
+ * splitPipelineThreads()
+ * 
+ * Splits the threads of runPipelinedBatch() between its generator and solver stages
+ *     Generating takes most of the work for every generator but the linear time ones, so 
+ *     the generators get about two thirds of the threads, and each stage at least one, 
+ *     so fewer than 2 threads still run as 2
+ * 
+ * @param[in]   numThreads      Number of generator and solver threads
+ * @param[out]  numGenerators   Number of generator threads
+ * @param[out]  numSolvers      Number of solver threads
+ * --------------------------------------------------------------------------------------
+*/
+void splitPipelineThreads(int numThreads, int& numGenerators, int& numSolvers)
+{
+    numGenerators = std::max(1, std::min(numThreads - 1, (2 * numThreads + 1) / 3));
+    numSolvers = std::max(1, numThreads - numGenerators);
+}
+
+// Slot index a stage passes on to tell the next stage that no more mazes are coming
+const std::uint32_t NO_PIPELINE_SLOT = std::numeric_limits<std::uint32_t>::max();
+
+// Maze slots in flight per CPU stage thread, enough that no stage waits on another for long
+const int PIPELINE_SLOTS_PER_THREAD = 2;
+
+/**
+ * One maze in flight through the pipeline of runPipelinedBatch()
+ *     jobIndex: maze index of the job the slot holds, which the writer orders records by
+ *     maze: maze being generated and solved, reset for every job
+ *     record: the maze formatted for the output file by its solver, kept in memory until 
+ *     the writer takes it
+*/
+struct PipelineSlot
+{
+    std::uint64_t jobIndex;
+    Maze maze;
+    MazeOutputBuffer record;
+
+    PipelineSlot(int numRows, int numCols) : jobIndex(0), maze(numRows, numCols)
+    {
+    }
+};
+
+/**--------------------------------------------------------------------------------------
+ * backOff()
+ * 
+ * Waits a little before trying an empty or full queue again, longer the more tries have 
+ * failed: spinning at first, then yielding, then sleeping so an idle stage leaves its 
+ * core to the busy ones
+ * 
+ * @param[in,out] numAttempts Number of failed tries so far, incremented
+ * --------------------------------------------------------------------------------------
+*/
+void backOff(int& numAttempts)
+{
+    numAttempts++;
+    if(numAttempts > 128)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    else if(numAttempts > 64)
+    {
+        std::this_thread::yield();
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * popPipelineSlot() / pushPipelineSlot()
+ * 
+ * Takes a slot index from a queue or adds one to it, backing off until it succeeds
+ * --------------------------------------------------------------------------------------
+*/
+std::uint32_t popPipelineSlot(BoundedQueue<std::uint32_t>& queue)
+{
+    std::uint32_t slotIndex = NO_PIPELINE_SLOT;
+    int numAttempts = 0;
+    while(!queue.tryPop(slotIndex))
+    {
+        backOff(numAttempts);
+    }
+    return slotIndex;
+}
+
+void pushPipelineSlot(BoundedQueue<std::uint32_t>& queue, std::uint32_t slotIndex)
+{
+    int numAttempts = 0;
+    while(!queue.tryPush(slotIndex))
+    {
+        backOff(numAttempts);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * runPipelineGenerator()
+ * 
+ * Body of one generator thread in runPipelinedBatch(), takes jobs until none are left
+ *     A generator waits for a free slot before it takes a job, so generators never get more 
+ *     than the slots ahead of the writer, and the jobs in flight are always the ones right 
+ *     after the last one written
+ *     The last generator to finish tells every solver that no more mazes are coming
+ * 
+ * @param[in]       numMazes        Total number of maze jobs in the batch
+ * @param[in,out]   nextJob         Index of the next job to take, shared by every generator
+ * @param[in]       generatorType   Generator to fill out each maze with, see mazeGenerators.h
+ * @param[in]       aldousBroderFraction    Fraction of the cells the hybrid generator adds 
+ *                                          before switching to Wilson's Algorithm
+ * @param[in]       seed            Seed of the batch, each job draws from the stream of 
+ *                                  its maze index, see makeStreamEngine()
+ * @param[in,out]   slots           Maze slots of the pipeline
+ * @param[in,out]   freeSlots       Queue of slots the writer is done with
+ * @param[in,out]   solveSlots      Queue of slots waiting to be solved
+ * @param[in,out]   numGeneratorsLeft   Number of generators still running
+ * @param[in]       numSolvers      Number of solver threads to tell when generating is done
+ * --------------------------------------------------------------------------------------
+*/
+void runPipelineGenerator(std::uint64_t numMazes, std::atomic<std::uint64_t>& nextJob, int generatorType, double aldousBroderFraction, std::uint64_t seed, \
+                          std::vector<std::unique_ptr<PipelineSlot>>& slots, BoundedQueue<std::uint32_t>& freeSlots, BoundedQueue<std::uint32_t>& solveSlots, \
+                          std::atomic<int>& numGeneratorsLeft, int numSolvers)
+{
+    ScratchArena generatorScratch(mazeGeneratorScratchBytes(generatorType, slots[0]->maze.getROWCELLS(), slots[0]->maze.getCOLCELLS()));
+
+    while(true)
+    {
+        std::uint32_t slotIndex = popPipelineSlot(freeSlots);
+        const std::uint64_t job = nextJob.fetch_add(1, std::memory_order_relaxed);
+        if(job >= numMazes)
+        {
+            pushPipelineSlot(freeSlots, slotIndex);
+            break;
+        }
+
+        PipelineSlot& slot = *slots[slotIndex];
+        slot.jobIndex = job;
+        slot.maze.reset();
+        generatorScratch.reset();
+
+        DefaultRng rng = makeStreamEngine(seed, job);
+        runMazeGenerator(slot.maze, generatorType, rng, 1, aldousBroderFraction, &generatorScratch);
+        pushPipelineSlot(solveSlots, slotIndex);
+    }
+
+    if(numGeneratorsLeft.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        for(int solver = 0; solver < numSolvers; solver++)
+        {
+            pushPipelineSlot(solveSlots, NO_PIPELINE_SLOT);
+        }
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * runPipelineSolver()
+ * 
+ * Body of one solver thread in runPipelinedBatch(), solves mazes and formats them into 
+ * their slot's record until the generators are done
+ *     The last solver to finish tells the writer that no more mazes are coming
+ * 
+ * @param[in]       solverType      Solver engine to solve each maze with, see MazeSolver
+ * @param[in]       outputFormat    Format of the records, see mazeWriter.h
+ * @param[in,out]   slots           Maze slots of the pipeline
+ * @param[in,out]   solveSlots      Queue of slots waiting to be solved
+ * @param[in,out]   writeSlots      Queue of slots waiting to be written
+ * @param[in,out]   numSolversLeft  Number of solvers still running
+ * --------------------------------------------------------------------------------------
+*/
+void runPipelineSolver(int solverType, int outputFormat, std::vector<std::unique_ptr<PipelineSlot>>& slots, BoundedQueue<std::uint32_t>& solveSlots, \
+                       BoundedQueue<std::uint32_t>& writeSlots, std::atomic<int>& numSolversLeft)
+{
+    MazeSolver solver(slots[0]->maze.getROWCELLS(), slots[0]->maze.getCOLCELLS());
+
+    std::uint32_t slotIndex = popPipelineSlot(solveSlots);
+    while(slotIndex != NO_PIPELINE_SLOT)
+    {
+        PipelineSlot& slot = *slots[slotIndex];
+        solveMaze(slot.maze, solverType, solver);
+
+        slot.record.clear();
+        if(outputFormat == MAZE_FORMAT_BINARY)
+        {
+            writeMazeDataBinary(slot.record, slot.maze, false, 0);
+        }
+        else
+        {
+            writeMazeDataCSV(slot.record, slot.maze);
+        }
+
+        pushPipelineSlot(writeSlots, slotIndex);
+        slotIndex = popPipelineSlot(solveSlots);
+    }
+
+    if(numSolversLeft.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        pushPipelineSlot(writeSlots, NO_PIPELINE_SLOT);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * runPipelinedBatch()
+ * 
+ * Generates and solves numMazes independent mazes like runBatch(), but as a pipeline of 
+ * three stages so writing to disk overlaps with generating and solving
+ *     Generator threads fill out mazes, solver threads solve them and format them into 
+ *     memory, and the calling thread is the only one writing to disk
+ *     The stages hand each other slot indices through lock-free BoundedQueues. There are 
+ *     only PIPELINE_SLOTS_PER_THREAD slots per generator and solver, each owning one Maze 
+ *     and one formatted record, and a slot only goes back to the generators once the 
+ *     writer is done with it. A stage that runs ahead waits for the one behind it, so 
+ *     memory stays bounded and the batch runs at the speed of its slowest stage
+ *     Each maze draws from the counter-based stream of its maze index, like the workers of 
+ *     runBatch()
+ *     Every maze is written to one file "<outputPrefix>.csv" (or .mzb) in maze index order, 
+ *     separated like the shard files of runBatch(), so the file is the same whatever the 
+ *     number of threads. The writer holds a record that finishes early until the ones 
+ *     before it are written; the jobs in flight always fit in the slots, so it never holds 
+ *     more than the slots and never waits on a record that needs a slot it holds
+ * 
+ * @param[in] numRows       Number of rows in each maze
+ * @param[in] numCols       Number of columns in each maze
+ * @param[in] numMazes      Number of mazes to generate and solve
+ * @param[in] numThreads    Number of generator and solver threads, at least 1 of each, the 
+ *                          writer runs on the calling thread
+ * @param[in] generatorType Generator to fill out each maze with, see mazeGenerators.h
+ * @param[in] aldousBroderFraction Fraction of the cells the hybrid generator adds before 
+ *                          switching to Wilson's Algorithm, see runWilson()
+ * @param[in] solverType    Solver engine to solve each maze with, see MazeSolver
+ * @param[in] seed          Seed for the random number engine streams
+ * @param[in] outputPrefix  Prefix of the file to write
+ * @param[in] outputFormat  Format of the file, MAZE_FORMAT_CSV or MAZE_FORMAT_BINARY
+ * @return the number of mazes written
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t runPipelinedBatch(int numRows, int numCols, std::uint64_t numMazes, int numThreads, int generatorType, double aldousBroderFraction, int solverType, std::uint64_t seed, const std::string& outputPrefix, int outputFormat)
+{
+    int numGenerators = 0;
+    int numSolvers = 0;
+    splitPipelineThreads(numThreads, numGenerators, numSolvers);
+
+    const std::string outputFileName = outputPrefix + mazeFormatExtension(outputFormat);
+    std::ios_base::openmode outputMode = std::ofstream::out | std::ofstream::trunc;
+    if(outputFormat == MAZE_FORMAT_BINARY)
+    {
+        outputMode |= std::ofstream::binary;
+    }
+
+    std::ofstream outputFile(outputFileName, outputMode);
+    if(!outputFile)
+    {
+        std::cerr << "ERROR: runPipelinedBatch() could not open the output file " << outputFileName << std::endl;
+        return 0;
+    }
+
+    // Every slot starts out free, and the queues hold every slot plus the end markers so a push never has to wait
+    const std::uint32_t numSlots = static_cast<std::uint32_t>(PIPELINE_SLOTS_PER_THREAD * (numGenerators + numSolvers));
+    std::vector<std::unique_ptr<PipelineSlot>> slots;
+    BoundedQueue<std::uint32_t> freeSlots(numSlots);
+    BoundedQueue<std::uint32_t> solveSlots(numSlots + static_cast<std::uint32_t>(numSolvers));
+    BoundedQueue<std::uint32_t> writeSlots(numSlots + 1);
+    for(std::uint32_t slotIndex = 0; slotIndex < numSlots; slotIndex++)
+    {
+        slots.push_back(std::unique_ptr<PipelineSlot>(new PipelineSlot(numRows, numCols)));
+        freeSlots.tryPush(slotIndex);
+    }
+
+    std::atomic<std::uint64_t> nextJob(0);
+    std::atomic<int> numGeneratorsLeft(numGenerators);
+    std::atomic<int> numSolversLeft(numSolvers);
+    std::vector<std::thread> stageThreads;
+    for(int generator = 0; generator < numGenerators; generator++)
+    {
+        stageThreads.emplace_back(runPipelineGenerator, numMazes, std::ref(nextJob), generatorType, aldousBroderFraction, seed, \
+                                  std::ref(slots), std::ref(freeSlots), std::ref(solveSlots), std::ref(numGeneratorsLeft), numSolvers);
+    }
+    for(int solver = 0; solver < numSolvers; solver++)
+    {
+        stageThreads.emplace_back(runPipelineSolver, solverType, outputFormat, std::ref(slots), std::ref(solveSlots), std::ref(writeSlots), std::ref(numSolversLeft));
+    }
+
+    // Writer stage, keeps taking records until the solvers are done, even after a failed write so no stage is left waiting
+    // Jobs in flight are always within numSlots of the next one to write, so early records are held by job index modulo numSlots
+    std::vector<std::uint32_t> heldSlots(numSlots, NO_PIPELINE_SLOT);
+    std::uint64_t nextToWrite = 0;
+    std::uint64_t numWritten = 0;
+    std::uint32_t slotIndex = popPipelineSlot(writeSlots);
+    while(slotIndex != NO_PIPELINE_SLOT)
+    {
+        heldSlots[slots[slotIndex]->jobIndex % numSlots] = slotIndex;
+
+        while(heldSlots[nextToWrite % numSlots] != NO_PIPELINE_SLOT)
+        {
+            const std::uint32_t nextSlotIndex = heldSlots[nextToWrite % numSlots];
+            heldSlots[nextToWrite % numSlots] = NO_PIPELINE_SLOT;
+
+            const MazeOutputBuffer& record = slots[nextSlotIndex]->record;
+            if(outputFile)
+            {
+                // Csv mazes are separated by newlines, binary records are back to back
+                if(outputFormat != MAZE_FORMAT_BINARY && numWritten > 0)
+                {
+                    outputFile.put('\n');
+                }
+                outputFile.write(record.getData(), static_cast<std::streamsize>(record.getSize()));
+                if(outputFile)
+                {
+                    numWritten++;
+                }
+            }
+
+            pushPipelineSlot(freeSlots, nextSlotIndex);
+            nextToWrite++;
+        }
+
+        slotIndex = popPipelineSlot(writeSlots);
+    }
+
+    for(std::thread& stageThread : stageThreads)
+    {
+        stageThread.join();
+    }
+
+    outputFile.flush();
+    if(!outputFile)
+    {
+        std::cerr << "ERROR: runPipelinedBatch() could not write the output file " << outputFileName << std::endl;
+        return 0;
+    }
+
+    return numWritten;
+}
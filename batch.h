@@ -0,0 +1,151 @@
+/*batch.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Batch maze generation
+ * 
+ * Generates and solves many independent mazes in parallel on a pool of worker threads,
+ * streaming the results into one .csv or .mzb shard file per worker
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * runBatch()
+ * 
+ * Generates numMazes independent mazes with the given generator (Wilson's Algorithm by 
+ * default) and solves each of them with the given solver engine, spread across numThreads 
+ * worker threads
+ *     Worker w runs jobs w, w + numThreads, w + 2 * numThreads and so on, the mazes being 
+ *     the same size so the split stays even without a shared job counter
+ *     Each maze draws from the counter-based stream of its own maze index, see 
+ *     makeStreamEngine(), so maze i is the same whatever the number of threads, and no 
+ *     engine is shared between threads
+ *     Each worker owns one Maze, one MazeSolver, one MazeOutputBuffer and one ScratchArena 
+ *     for the generator which it reuses for every job it takes
+ *     Each worker streams its mazes to its own shard file "<outputPrefix>_<worker>.csv" 
+ *     (or .mzb), one maze after another in the same format as mazeData.csv, separated by 
+ *     newlines, or as back to back binary records, so taking one record of each shard in 
+ *     turn gives the mazes back in maze index order
+ * 
+ * @param[in] numRows       Number of rows in each maze
+ * @param[in] numCols       Number of columns in each maze
+ * @param[in] numMazes      Number of mazes to generate and solve
+ * @param[in] numThreads    Number of worker threads, at least 1
+ * @param[in] generatorType Generator to fill out each maze with, see mazeGenerators.h, 
+ *                          every maze is generated on its worker's thread alone
+ * @param[in] aldousBroderFraction Fraction of the cells the hybrid generator adds before 
+ *                          switching to Wilson's Algorithm, see runWilson()
+ * @param[in] solverType    Solver engine to solve each maze with, see MazeSolver
+ * @param[in] seed          Seed for the random number engine streams
+ * @param[in] outputPrefix  Prefix of the shard files to write
+ * @param[in] outputFormat  Format of the shard files, MAZE_FORMAT_CSV or MAZE_FORMAT_BINARY
+ * @return the number of mazes written
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t runBatch(int numRows, int numCols, std::uint64_t numMazes, int numThreads, int generatorType, double aldousBroderFraction, int solverType, std::uint64_t seed, const std::string& outputPrefix, int outputFormat);
+
+/**--------------------------------------------------------------------------------------
+ * runLoadedBatch()
+ * 
+ * Loads every maze of a list of maze files and solves it with the given solver engine, 
+ * spread across numThreads worker threads, see MazeReader
+ *     Worker w loads files w, w + numThreads, w + 2 * numThreads and so on, and every 
+ *     maze in them, so a file of many mazes (like a batch shard) stays on one worker
+ *     Each worker owns one MazeReader, one MazeSolver and one MazeOutputBuffer, and one 
+ *     Maze it only allocates again when the size of the mazes changes
+ *     Each worker streams its solved mazes to its own shard file, like runBatch()
+ * 
+ * @param[in]   fileNames       Maze files to load, see listMazeFiles()
+ * @param[in]   numThreads      Number of worker threads, at least 1
+ * @param[in]   imageRows       Rows of cells of png images, 0 to find them, see MazeReader
+ * @param[in]   imageCols       Columns of cells of png images, 0 to find them
+ * @param[in]   solverType      Solver engine to solve each maze with, see MazeSolver
+ * @param[in]   outputPrefix    Prefix of the shard files to write
+ * @param[in]   outputFormat    Format of the shard files, MAZE_FORMAT_CSV or MAZE_FORMAT_BINARY
+ * @param[out]  numFailed       Number of files that could not be loaded, and of mazes that 
+ *                              could not be solved
+ * @return the number of mazes written
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t runLoadedBatch(const std::vector<std::string>& fileNames, int numThreads, int imageRows, int imageCols, int solverType, const std::string& outputPrefix, int outputFormat, std::uint64_t& numFailed);
+
+/**--------------------------------------------------------------------------------------
+ * splitPipelineThreads()
+ * 
+ * Splits the threads of runPipelinedBatch() between its generator and solver stages
+ *     Generating takes most of the work for every generator but the linear time ones, so 
+ *     the generators get about two thirds of the threads, and each stage at least one, 
+ *     so fewer than 2 threads still run as 2
+ * 
+ * @param[in]   numThreads      Number of generator and solver threads
+ * @param[out]  numGenerators   Number of generator threads
+ * @param[out]  numSolvers      Number of solver threads
+ * --------------------------------------------------------------------------------------
+*/
+void splitPipelineThreads(int numThreads, int& numGenerators, int& numSolvers);
+
+/**--------------------------------------------------------------------------------------
+ * runPipelinedBatch()
+ * 
+ * Generates and solves numMazes independent mazes like runBatch(), but as a pipeline of 
+ * three stages so writing to disk overlaps with generating and solving
+ *     Generator threads fill out mazes, solver threads solve them and format them into 
+ *     memory, and the calling thread is the only one writing to disk
+ *     The stages hand each other slot indices through lock-free BoundedQueues. There are 
+ *     only PIPELINE_SLOTS_PER_THREAD slots per generator and solver, each owning one Maze 
+ *     and one formatted record, and a slot only goes back to the generators once the 
+ *     writer is done with it. A stage that runs ahead waits for the one behind it, so 
+ *     memory stays bounded and the batch runs at the speed of its slowest stage
+ *     Each maze draws from the counter-based stream of its maze index, like the workers of 
+ *     runBatch()
+ *     Every maze is written to one file "<outputPrefix>.csv" (or .mzb) in maze index order, 
+ *     separated like the shard files of runBatch(), so the file is the same whatever the 
+ *     number of threads. The writer holds a record that finishes early until the ones 
+ *     before it are written; the jobs in flight always fit in the slots, so it never holds 
+ *     more than the slots and never waits on a record that needs a slot it holds
+ * 
+ * @param[in] numRows       Number of rows in each maze
+ * @param[in] numCols       Number of columns in each maze
+ * @param[in] numMazes      Number of mazes to generate and solve
+ * @param[in] numThreads    Number of generator and solver threads, at least 1 of each, the 
+ *                          writer runs on the calling thread
+ * @param[in] generatorType Generator to fill out each maze with, see mazeGenerators.h
+ * @param[in] aldousBroderFraction Fraction of the cells the hybrid generator adds before 
+ *                          switching to Wilson's Algorithm, see runWilson()
+ * @param[in] solverType    Solver engine to solve each maze with, see MazeSolver
+ * @param[in] seed          Seed for the random number engine streams
+ * @param[in] outputPrefix  Prefix of the file to write
+ * @param[in] outputFormat  Format of the file, MAZE_FORMAT_CSV or MAZE_FORMAT_BINARY
+ * @return the number of mazes written
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t runPipelinedBatch(int numRows, int numCols, std::uint64_t numMazes, int numThreads, int generatorType, double aldousBroderFraction, int solverType, std::uint64_t seed, const std::string& outputPrefix, int outputFormat);
@@ -0,0 +1,515 @@
+/*mazeBenchmark.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Stage benchmark
+ * 
+ * Sweeps maze sizes, generators, solvers and thread counts, timing generation, solving, path 
+ * index queries and output as separate stages, and writes wall time, cells per second, walk steps, peak memory 
+ * and allocations for each stage as JSON, to compare across releases
+ * 
+ * Build from the maze folder, leaving out main.cpp:
+ *     g++ -O2 -pthread benchmark/mazeBenchmark.cpp cell.cpp eller.cpp gridGraph.cpp mappedFile.cpp maze.cpp mazeBinary.cpp mazeGenerators.cpp mazePath.cpp mazePathIndex.cpp mazeSolver.cpp mazeWriter.cpp parallelWilson.cpp scratchArena.cpp tremaux.cpp wall.cpp wilson.cpp -I. -o mazeBenchmark
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eller.h"
+#include "maze.h"
+#include "mazeGenerators.h"
+#include "mazePathIndex.h"
+#include "mazeSolver.h"
+#include "mazeWriter.h"
+#include "rng.h"
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+// Number of random cell pairs the index-queries stage finds the path length between
+const int NUM_INDEX_QUERIES = 1000000;
+
+/**
+ * Allocation counters, updated by the replacement operator new below
+ *     Every allocation in the program goes through them, so a stage's allocations are the 
+ *     difference between the counters before and after it
+*/
+static std::atomic<std::uint64_t> g_numAllocations(0);
+static std::atomic<std::uint64_t> g_numAllocatedBytes(0);
+
+void* operator new(std::size_t numBytes)
+{
+    g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+    g_numAllocatedBytes.fetch_add(numBytes, std::memory_order_relaxed);
+    void* memory = std::malloc(numBytes > 0 ? numBytes : 1);
+    if(memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t numBytes)
+{
+    return operator new(numBytes);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+/**--------------------------------------------------------------------------------------
+ * CountingBuffer class
+ * 
+ * Stream buffer that throws away everything written to it, only counting the bytes, so 
+ * output stages are timed without the disk
+ * --------------------------------------------------------------------------------------
+*/
+class CountingBuffer : public std::streambuf
+{
+public:
+    std::uint64_t numBytes = 0;
+
+protected:
+    int_type overflow(int_type character) override
+    {
+        numBytes++;
+        return traits_type::not_eof(character);
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override
+    {
+        numBytes += static_cast<std::uint64_t>(count);
+        return count;
+    }
+};
+
+/**--------------------------------------------------------------------------------------
+ * resetPeakRss() / readPeakRss()
+ * 
+ * Resets and reads the peak resident set size of the process
+ *     On Linux the peak is reset through /proc/self/clear_refs, so each stage reports its 
+ *     own peak. Elsewhere, or on kernels without it, the peak is that of the whole process
+ *     so far
+ * --------------------------------------------------------------------------------------
+*/
+void resetPeakRss()
+{
+#ifdef __linux__
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+#endif
+}
+
+std::uint64_t readPeakRss()
+{
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while(std::getline(status, line))
+    {
+        if(line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+        }
+    }
+
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+    }
+#endif
+    return 0;
+}
+
+/**--------------------------------------------------------------------------------------
+ * StageResult struct
+ * 
+ * Measurements of one stage of one benchmark run, one JSON object each
+ * --------------------------------------------------------------------------------------
+*/
+struct StageResult
+{
+    std::string generator;
+    std::string stage;
+    int numRows = 0;
+    int numCols = 0;
+    int numThreads = 1;
+    int run = 0;
+    double seconds = 0.0;
+    std::uint64_t walkSteps = 0;
+    std::uint64_t outputBytes = 0;
+    std::uint64_t peakRssBytes = 0;
+    std::uint64_t numAllocations = 0;
+    std::uint64_t allocatedBytes = 0;
+};
+
+/**--------------------------------------------------------------------------------------
+ * measureStage()
+ * 
+ * Runs one stage, measuring its wall time, peak memory and allocations
+ * 
+ * @param[in,out]   result  Result with the stage's names and sizes filled in, updated with 
+ *                          its measurements
+ * @param[in]       stage   Stage to run, returning its walk steps or other generator work (0 if none)
+ * --------------------------------------------------------------------------------------
+*/
+template <typename Stage>
+void measureStage(StageResult& result, Stage stage)
+{
+    resetPeakRss();
+    std::uint64_t allocationsBefore = g_numAllocations.load();
+    std::uint64_t bytesBefore = g_numAllocatedBytes.load();
+
+    auto startTime = std::chrono::steady_clock::now();
+    result.walkSteps = stage();
+    auto endTime = std::chrono::steady_clock::now();
+
+    result.seconds = std::chrono::duration<double>(endTime - startTime).count();
+    result.peakRssBytes = readPeakRss();
+    result.numAllocations = g_numAllocations.load() - allocationsBefore;
+    result.allocatedBytes = g_numAllocatedBytes.load() - bytesBefore;
+}
+
+/**--------------------------------------------------------------------------------------
+ * parseList()
+ * 
+ * Splits a comma-separated command line value
+ * 
+ * @param[in] text Text of the value, like "64,128,256"
+ * @return the items, in order
+ * --------------------------------------------------------------------------------------
+*/
+std::vector<std::string> parseList(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::stringstream textStream(text);
+    std::string item;
+    while(std::getline(textStream, item, ','))
+    {
+        if(!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**--------------------------------------------------------------------------------------
+ * writeJson()
+ * 
+ * Writes every result as a JSON document, one object per stage of each run
+ * 
+ * @param[in,out]   outfile Stream to write to
+ * @param[in]       results Results of the sweep
+ * @param[in]       seed    Seed of the first run
+ * @param[in]       numRuns Number of runs of each configuration
+ * --------------------------------------------------------------------------------------
+*/
+void writeJson(std::ostream& outfile, const std::vector<StageResult>& results, std::uint64_t seed, int numRuns)
+{
+    outfile << "{\n    \"benchmark\": \"mazeBenchmark\",\n    \"seed\": " << seed << ",\n    \"runs\": " << numRuns \
+            << ",\n    \"hardwareThreads\": " << std::thread::hardware_concurrency() << ",\n    \"results\": [";
+
+    char number[64];
+    for(std::size_t i = 0; i < results.size(); i++)
+    {
+        const StageResult& result = results[i];
+        double numCells = static_cast<double>(result.numRows) * result.numCols;
+        std::snprintf(number, sizeof(number), "%.9f", result.seconds);
+
+        outfile << (i > 0 ? "," : "") << "\n        {\"generator\": \"" << result.generator << "\", \"stage\": \"" << result.stage \
+                << "\", \"rows\": " << result.numRows << ", \"cols\": " << result.numCols << ", \"threads\": " << result.numThreads \
+                << ", \"run\": " << result.run << ", \"seconds\": " << number;
+        std::snprintf(number, sizeof(number), "%.1f", result.seconds > 0.0 ? numCells / result.seconds : 0.0);
+        outfile << ", \"cellsPerSecond\": " << number << ", \"walkSteps\": " << result.walkSteps << ", \"outputBytes\": " << result.outputBytes \
+                << ", \"peakRssBytes\": " << result.peakRssBytes << ", \"allocations\": " << result.numAllocations \
+                << ", \"allocatedBytes\": " << result.allocatedBytes << "}";
+    }
+    outfile << "\n    ]\n}" << std::endl;
+}
+
+int main(int argc, const char** argv)
+{
+    std::vector<std::string> sizeNames = parseList("64,128,256,512,1024,2048,4096,8192");
+    std::vector<std::string> generatorNames = parseList("wilson,parallel,eller,sidewinder,kruskal,backtracker,hybrid,eller-stream");
+    std::vector<std::string> solverNames = parseList("tremaux,bfs,bidirectional,deadend,bitboard");
+    std::vector<std::string> threadNames = parseList("1," + std::to_string(std::max(1u, std::thread::hardware_concurrency())));
+    int numRuns = 1;
+    std::uint64_t seed = 1;
+    std::string outputFileName;
+
+    for(int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if(i + 1 >= argc)
+        {
+            std::cerr << "ERROR: Missing value for " << arg << std::endl;
+            return -1;
+        }
+
+        std::string value = argv[++i];
+        if(arg == "--sizes")
+        {
+            sizeNames = parseList(value);
+        }
+        else if(arg == "--generators")
+        {
+            generatorNames = parseList(value);
+        }
+        else if(arg == "--solvers")
+        {
+            solverNames = parseList(value);
+        }
+        else if(arg == "--threads")
+        {
+            threadNames = parseList(value);
+        }
+        else if(arg == "--runs")
+        {
+            numRuns = atoi(value.c_str());
+        }
+        else if(arg == "--seed")
+        {
+            seed = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if(arg == "--output")
+        {
+            outputFileName = value;
+        }
+        else
+        {
+            std::cerr << "Usage: mazeBenchmark [--sizes <n,...>] [--generators <wilson|parallel|eller|sidewinder|kruskal|backtracker|hybrid|eller-stream,...>] [--solvers <tremaux|bfs|bidirectional|deadend|bitboard,...>] " \
+                      << "[--threads <n,...>] [--runs <runs>] [--seed <seed>] [--output <file.json>]" << std::endl;
+            return -1;
+        }
+    }
+
+    std::vector<int> sizes;
+    for(const std::string& sizeName : sizeNames)
+    {
+        sizes.push_back(atoi(sizeName.c_str()));
+    }
+    std::vector<int> threadCounts;
+    for(const std::string& threadName : threadNames)
+    {
+        threadCounts.push_back(atoi(threadName.c_str()));
+    }
+    std::sort(threadCounts.begin(), threadCounts.end());
+    threadCounts.erase(std::unique(threadCounts.begin(), threadCounts.end()), threadCounts.end());
+    std::vector<int> solverTypes;
+    for(const std::string& solverName : solverNames)
+    {
+        solverTypes.push_back(MazeSolver::solverTypeFromName(solverName));
+    }
+
+    if(numRuns < 1 || std::count_if(sizes.begin(), sizes.end(), [](int size) { return size < 2; }) > 0 || \
+       std::count_if(threadCounts.begin(), threadCounts.end(), [](int threads) { return threads < 1; }) > 0 || \
+       std::count(solverTypes.begin(), solverTypes.end(), MazeSolver::INVALID_SOLVER) > 0)
+    {
+        std::cerr << "ERROR: Sizes must be at least 2, thread counts and runs at least 1, and solvers one of tremaux, bfs, bidirectional, deadend or bitboard" << std::endl;
+        return -1;
+    }
+    for(const std::string& generatorName : generatorNames)
+    {
+        if(generatorName != "eller-stream" && mazeGeneratorFromName(generatorName) == MAZE_GENERATOR_INVALID)
+        {
+            std::cerr << "ERROR: Generators must be one of wilson, parallel, eller, sidewinder, kruskal, backtracker, hybrid or eller-stream: " << generatorName << std::endl;
+            return -1;
+        }
+    }
+
+    std::vector<StageResult> results;
+    auto report = [&](const StageResult& result)
+    {
+        std::cerr << result.generator << " " << result.numRows << "x" << result.numCols << " threads " << result.numThreads << " run " << result.run \
+                  << ": " << result.stage << " " << result.seconds * 1000.0 << " ms" << std::endl;
+        results.push_back(result);
+    };
+
+    for(int size : sizes)
+    {
+        for(const std::string& generatorName : generatorNames)
+        {
+            // Only the parallel generator uses more than one thread
+            for(int numThreads : threadCounts)
+            {
+                if(generatorName != "parallel" && numThreads != threadCounts.front())
+                {
+                    continue;
+                }
+
+                for(int run = 0; run < numRuns; run++)
+                {
+                    StageResult result;
+                    result.generator = generatorName;
+                    result.numRows = size;
+                    result.numCols = size;
+                    result.numThreads = (generatorName == "parallel") ? numThreads : 1;
+                    result.run = run;
+                    DefaultRng rng(seed + static_cast<std::uint64_t>(run));
+
+                    // Streaming Eller's Algorithm writes its maze out as it goes, so generating is also writing
+                    if(generatorName == "eller-stream")
+                    {
+                        CountingBuffer countingBuffer;
+                        std::ostream countingStream(&countingBuffer);
+                        result.stage = "generate";
+                        measureStage(result, [&]()
+                        {
+                            MazeOutputBuffer outputBuffer(countingStream);
+                            runStreamingEller(size, size, rng, outputBuffer, true, seed);
+                            return std::uint64_t(0);
+                        });
+                        result.outputBytes = countingBuffer.numBytes;
+                        report(result);
+                        continue;
+                    }
+
+                    std::optional<Maze> maze;
+                    result.stage = "generate";
+                    measureStage(result, [&]()
+                    {
+                        maze.emplace(size, size);
+                        return runMazeGenerator(*maze, mazeGeneratorFromName(generatorName), rng, numThreads);
+                    });
+                    report(result);
+                    result.walkSteps = 0;
+
+                    for(std::size_t solver = 0; solver < solverTypes.size(); solver++)
+                    {
+                        maze->clearPath();
+                        result.stage = "solve-" + solverNames[solver];
+                        measureStage(result, [&]()
+                        {
+                            MazeSolver benchSolver(size, size);
+                            solveMaze(*maze, solverTypes[solver], benchSolver);
+                            return std::uint64_t(0);
+                        });
+                        report(result);
+                    }
+
+                    // Every generator makes a perfect maze, so every maze can be indexed
+                    MazePathIndex pathIndex;
+                    result.stage = "index-build";
+                    measureStage(result, [&]()
+                    {
+                        pathIndex.build(*maze);
+                        return std::uint64_t(0);
+                    });
+                    report(result);
+
+                    result.stage = "index-queries";
+                    measureStage(result, [&]()
+                    {
+                        const std::uint64_t numCells = maze->getNumCells();
+                        std::uint64_t totalLength = 0;
+                        for(int query = 0; query < NUM_INDEX_QUERIES; query++)
+                        {
+                            std::size_t fromIndex = static_cast<std::size_t>(rng() % numCells);
+                            std::size_t toIndex = static_cast<std::size_t>(rng() % numCells);
+                            totalLength += pathIndex.pathLength(fromIndex, toIndex);
+                        }
+                        return totalLength;
+                    });
+                    report(result);
+                    result.walkSteps = 0;
+
+                    for(int format : {MAZE_FORMAT_CSV, MAZE_FORMAT_BINARY})
+                    {
+                        CountingBuffer countingBuffer;
+                        std::ostream countingStream(&countingBuffer);
+                        result.stage = (format == MAZE_FORMAT_CSV) ? "write-csv" : "write-binary";
+                        measureStage(result, [&]()
+                        {
+                            if(format == MAZE_FORMAT_CSV)
+                            {
+                                writeMazeDataCSV(countingStream, *maze);
+                            }
+                            else
+                            {
+                                writeMazeDataBinary(countingStream, *maze, true, seed);
+                            }
+                            return std::uint64_t(0);
+                        });
+                        result.outputBytes = countingBuffer.numBytes;
+                        report(result);
+                        result.outputBytes = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    if(outputFileName.empty())
+    {
+        writeJson(std::cout, results, seed, numRuns);
+    }
+    else
+    {
+        std::ofstream outputFile(outputFileName, std::ofstream::out | std::ofstream::trunc);
+        writeJson(outputFile, results, seed, numRuns);
+        if(!outputFile)
+        {
+            std::cerr << "ERROR: Could not write " << outputFileName << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*staticMazeBenchmark.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Static maze benchmark
+ * 
+ * Generates and solves millions of small fixed-size mazes, as StaticMazes and as
+ * Mazes, and reports how many of each it managed per second
+ * 
+ * Build from the maze folder, leaving out main.cpp:
+ *     g++ -O2 benchmark/staticMazeBenchmark.cpp cell.cpp gridGraph.cpp maze.cpp mazePath.cpp scratchArena.cpp tremaux.cpp wall.cpp wilson.cpp -I. -o staticMazeBenchmark
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdlib.h>
+
+#include "maze.h"
+#include "rng.h"
+#include "staticMaze.h"
+#include "tremaux.h"
+#include "wilson.h"
+
+/**--------------------------------------------------------------------------------------
+ * timeStaticMazes()
+ * 
+ * Generates and solves numMazes StaticMazes of one size, one after another on the stack
+ * 
+ * @param[in]       numMazes    Number of mazes to generate and solve
+ * @param[in,out]   rng         Random number engine driving the generator
+ * @return the number of seconds taken
+ * --------------------------------------------------------------------------------------
+*/
+template <int NUM_ROWS, int NUM_COLS>
+double timeStaticMazes(int numMazes, DefaultRng& rng)
+{
+    std::uint64_t numPathCells = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for(int i = 0; i < numMazes; i++)
+    {
+        StaticMaze<NUM_ROWS, NUM_COLS> benchMaze;
+        runWilson(benchMaze, rng);
+        runTremaux(benchMaze);
+        numPathCells += benchMaze.isCellOnPath(benchMaze.getExitIndex());
+    }
+    auto endTime = std::chrono::steady_clock::now();
+
+    if(numPathCells != static_cast<std::uint64_t>(numMazes))
+    {
+        std::cerr << "ERROR: " << numMazes - numPathCells << " static mazes were not solved" << std::endl;
+    }
+    return std::chrono::duration<double>(endTime - startTime).count();
+}
+
+/**--------------------------------------------------------------------------------------
+ * timeMazes()
+ * 
+ * Generates and solves numMazes Mazes of the same size as timeStaticMazes(), reusing one 
+ * Maze, one scratch arena and one TremauxContext the way a batch worker does
+ * 
+ * @param[in]       numRows     Number of rows in each maze
+ * @param[in]       numCols     Number of columns in each maze
+ * @param[in]       numMazes    Number of mazes to generate and solve
+ * @param[in,out]   rng         Random number engine driving the generator
+ * @return the number of seconds taken
+ * --------------------------------------------------------------------------------------
+*/
+double timeMazes(int numRows, int numCols, int numMazes, DefaultRng& rng)
+{
+    Maze benchMaze(numRows, numCols);
+    ScratchArena scratch(wilsonScratchBytes(numRows, numCols));
+    TremauxContext context(numRows, numCols);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for(int i = 0; i < numMazes; i++)
+    {
+        benchMaze.reset();
+        scratch.reset();
+        runWilson(benchMaze, rng, 0.0, &scratch);
+        runTremaux(benchMaze, context);
+    }
+    auto endTime = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(endTime - startTime).count();
+}
+
+/**--------------------------------------------------------------------------------------
+ * reportSize()
+ * 
+ * Times both kinds of maze at one size and prints how many mazes per second each managed
+ * --------------------------------------------------------------------------------------
+*/
+template <int NUM_ROWS, int NUM_COLS>
+void reportSize(int numMazes, DefaultRng& rng)
+{
+    double staticSeconds = timeStaticMazes<NUM_ROWS, NUM_COLS>(numMazes, rng);
+    double mazeSeconds = timeMazes(NUM_ROWS, NUM_COLS, numMazes, rng);
+
+    std::cout << NUM_ROWS << "x" << NUM_COLS << ", mazes: " << numMazes << "\n" \
+              << "    StaticMaze mazes per second: " << numMazes / staticSeconds << "\n" \
+              << "    Maze mazes per second:       " << numMazes / mazeSeconds << std::endl;
+}
+
+int main(int argc, const char** argv)
+{
+    if(argc > 2)
+    {
+        std::cerr << "Usage: staticMazeBenchmark [number of mazes per size]" << std::endl;
+        return -1;
+    }
+
+    int numMazes = (argc == 2) ? atoi(argv[1]) : 100000;
+    if(numMazes < 1)
+    {
+        std::cerr << "ERROR: Number of mazes must be at least 1" << std::endl;
+        return -1;
+    }
+
+    DefaultRng rng(makeRandomSeed());
+    reportSize<16, 16>(numMazes, rng);
+    reportSize<32, 32>(numMazes, rng);
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*walkBenchmark.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Random walk benchmark
+ * 
+ * Times Wilson's Algorithm on NxN mazes and reports how many random walk steps it takes 
+ * per second
+ * 
+ * Build from the maze folder, leaving out main.cpp:
+ *     g++ -O2 benchmark/walkBenchmark.cpp cell.cpp gridGraph.cpp maze.cpp scratchArena.cpp wall.cpp wilson.cpp -I. -o walkBenchmark
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdlib.h>
+
+#include "maze.h"
+#include "rng.h"
+#include "wilson.h"
+
+int main(int argc, const char** argv)
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: walkBenchmark <side length> [number of runs]" << std::endl;
+        return -1;
+    }
+
+    int sideLength = atoi(argv[1]);
+    int numRuns = (argc == 3) ? atoi(argv[2]) : 5;
+    if(sideLength < 1 || numRuns < 1)
+    {
+        std::cerr << "ERROR: Side length and number of runs must both be at least 1" << std::endl;
+        return -1;
+    }
+
+    std::uint64_t totalSteps = 0;
+    double totalSeconds = 0.0;
+    DefaultRng rng(makeRandomSeed());
+
+    for(int run = 0; run < numRuns; run++)
+    {
+        Maze benchMaze(sideLength, sideLength);
+
+        auto startTime = std::chrono::steady_clock::now();
+        std::uint64_t numSteps = runWilson(benchMaze, rng);
+        auto endTime = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        totalSteps += numSteps;
+        totalSeconds += seconds;
+
+        std::cout << "Run " << run + 1 << ": " << numSteps << " walk steps in " << seconds * 1000.0 << " ms" << std::endl;
+    }
+
+    std::cout << "Side length: " << sideLength << ", runs: " << numRuns << "\n" \
+              << "    Average time: " << totalSeconds / numRuns * 1000.0 << " ms\n" \
+              << "    Walk steps per second: " << totalSteps / totalSeconds << std::endl;
+
+    return 0;
+}
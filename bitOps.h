@@ -0,0 +1,83 @@
+/*bitOps.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Bit operations
+ * 
+ * Word-level bit counting used to scan the wall and path bitplanes, with a portable fallback
+ * for compilers without the GCC builtins
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**--------------------------------------------------------------------------------------
+ * countTrailingZeros()
+ * 
+ * Returns the index of the lowest set bit of a word
+ * 
+ * @param[in] word Word with at least one bit set
+ * @return the number of zero bits below the lowest set bit
+ * --------------------------------------------------------------------------------------
+*/
+inline int countTrailingZeros(std::uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while(!((word >> bit) & 1))
+    {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**--------------------------------------------------------------------------------------
+ * countSetBits()
+ * 
+ * Returns the number of set bits in a word
+ * 
+ * @param[in] word Word to count
+ * @return the number of set bits, 0 to 64
+ * --------------------------------------------------------------------------------------
+*/
+inline int countSetBits(std::uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int numBits = 0;
+    for(; word != 0; word &= word - 1)
+    {
+        numBits++;
+    }
+    return numBits;
+#endif
+}
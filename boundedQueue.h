@@ -0,0 +1,191 @@
+/*boundedQueue.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Bounded Queue
+ * 
+ * Fixed size lock-free queue connecting the stages of the batch pipeline
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**--------------------------------------------------------------------------------------
+ * BoundedQueue class
+ * 
+ * Fixed size lock-free queue that any number of threads can push to and pop from at once
+ *     A ring of slots, each with a sequence number telling whether it is free for the 
+ *     next push or full for the next pop. Pushes and pops claim a slot by advancing their 
+ *     position with a compare-and-swap, so no thread ever waits on a lock
+ *     Never allocates after it is constructed: a push to a full queue, or a pop from an 
+ *     empty one, fails and the caller backs off, which is how a slow consumer holds back 
+ *     its producers
+ *     Capacity is rounded up to a power of two
+ * --------------------------------------------------------------------------------------
+*/
+template <typename T>
+class BoundedQueue
+{
+public:
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates an empty queue
+     * 
+     * @param[in] minCapacity Least number of values the queue must hold at once
+     * --------------------------------------------------------------------------------------
+    */
+    explicit BoundedQueue(std::size_t minCapacity)
+        : m_capacity(roundUpToPowerOfTwo(minCapacity)),
+          m_slots(new Slot[m_capacity]),
+          m_pushPosition(0),
+          m_popPosition(0)
+    {
+        for(std::size_t i = 0; i < m_capacity; i++)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**--------------------------------------------------------------------------------------
+     * tryPush()
+     * 
+     * Adds a value to the back of the queue, if there is room
+     * 
+     * @param[in] value Value to add
+     * @return false if the queue is full
+     * --------------------------------------------------------------------------------------
+    */
+    bool tryPush(const T& value)
+    {
+        std::size_t position = m_pushPosition.load(std::memory_order_relaxed);
+        while(true)
+        {
+            Slot& slot = m_slots[position & (m_capacity - 1)];
+            std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(slot.sequence.load(std::memory_order_acquire) - position);
+
+            // The slot is free for this position, a lap behind it is still full
+            if(lag == 0)
+            {
+                if(m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(lag < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * tryPop()
+     * 
+     * Takes the value at the front of the queue, if there is one
+     * 
+     * @param[out] value Value taken
+     * @return false if the queue is empty
+     * --------------------------------------------------------------------------------------
+    */
+    bool tryPop(T& value)
+    {
+        std::size_t position = m_popPosition.load(std::memory_order_relaxed);
+        while(true)
+        {
+            Slot& slot = m_slots[position & (m_capacity - 1)];
+            std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(slot.sequence.load(std::memory_order_acquire) - (position + 1));
+
+            // The slot is full for this position, otherwise no push has reached it yet
+            if(lag == 0)
+            {
+                if(m_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    value = slot.value;
+                    slot.sequence.store(position + m_capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(lag < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_popPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getCapacity()
+     * 
+     * Returns the most values the queue holds at once
+     * --------------------------------------------------------------------------------------
+    */
+    std::size_t getCapacity() const
+    {
+        return m_capacity;
+    }
+
+private:
+    // Size of a cache line, so the push and pop positions never share one
+    static const std::size_t CACHE_LINE_BYTES = 64;
+
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t powerOfTwo = 2;
+        while(powerOfTwo < value)
+        {
+            powerOfTwo <<= 1;
+        }
+        return powerOfTwo;
+    }
+
+    const std::size_t m_capacity;
+    std::unique_ptr<Slot[]> m_slots;
+    alignas(CACHE_LINE_BYTES) std::atomic<std::size_t> m_pushPosition;
+    alignas(CACHE_LINE_BYTES) std::atomic<std::size_t> m_popPosition;
+};
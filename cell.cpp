@@ -9,6 +9,8 @@
  * Defines a cell in a maze, with four different sides (North, South, East, West)
  * 
  * Is either on the path from the maze entrance to the maze exit, or isn't
+ * 
+ * A Cell is a lightweight view over the packed state of one cell stored by a Maze
  */
 
 /**
@@ -40,30 +42,18 @@
 /**--------------------------------------------------------------------------------------
  * Constructor
  * 
- * Creates a regular cell with no exits in any cardinal direction
+ * Creates a view of a cell whose packed state is stored elsewhere
  * 
- * @param[in] r Row index of cell
- * @param[in] c Column index of cell
+ * @param[in] state Reference to the packed exits and path byte of the cell, only read
+ * @param[in] marks Reference to the packed Tremaux marks byte of the cell
+ * @param[in] r     Row index of cell
+ * @param[in] c     Column index of cell
  * --------------------------------------------------------------------------------------
 */
-Cell::Cell(int r, int c)
-  : m_rowLoc(r), m_colLoc(c)
+Cell::Cell(const std::uint8_t& state, std::uint8_t& marks, int r, int c)
+  : m_state(&state), m_marks(&marks), m_rowLoc(r), m_colLoc(c)
 {}
 
-/**--------------------------------------------------------------------------------------
- * updateMyExit()
- * 
- * Given a direction, creates an exit in said direction
- * 
- * @param[in] dir Cardinal direction in which to create an exit
- * --------------------------------------------------------------------------------------
-*/
-void Cell::updateMyExit(int dir)
-{
-  m_exits[dir] = VALID_EXIT_NO_MARKS;
-  m_numExits++;
-}
-
 /**--------------------------------------------------------------------------------------
  * markCellExit()
  * 
@@ -77,9 +67,12 @@ void Cell::updateMyExit(int dir)
 */
 void Cell::markCellExit(int dir)
 {
-  if(m_exits[dir] > INVALID_EXIT) // Exit exists
+  if(hasExit(dir)) // Exit exists
   {
-    m_exits[dir]++;
+    if(getMarks(dir) < MAX_MARKS)
+    {
+      *m_marks += static_cast<std::uint8_t>(1 << (2 * dir));
+    }
   }
   else
   {
@@ -118,7 +111,7 @@ bool Cell::isItThisCell(int otherRow, int otherCol) const
 */
 bool Cell::isCellEntranceAndJunction() const
 {
-  return m_numExits >= VALID_EXIT_TWO_MARKS;
+  return getNumExits() >= VALID_EXIT_TWO_MARKS;
 }
 
 /**--------------------------------------------------------------------------------------
@@ -131,7 +124,7 @@ bool Cell::isCellEntranceAndJunction() const
 */
 bool Cell::isCellJunction() const
 {
-  return m_numExits > VALID_EXIT_TWO_MARKS;
+  return getNumExits() > VALID_EXIT_TWO_MARKS;
 }
 
 /**--------------------------------------------------------------------------------------
@@ -144,7 +137,7 @@ bool Cell::isCellJunction() const
 */
 bool Cell::isCellDeadEnd() const
 {
-  return m_numExits < VALID_EXIT_TWO_MARKS;
+  return getNumExits() < VALID_EXIT_TWO_MARKS;
 }
 
 /**--------------------------------------------------------------------------------------
@@ -158,15 +151,8 @@ bool Cell::isCellDeadEnd() const
 */
 bool Cell::isOnlyThisDirMarked(int dir) const
 {
-  for(int i = 0; i < NUM_CARDINAL_DIRECTIONS; i++) // Checking all 4 cardinal directions
-  {
-    if(m_exits[i] > VALID_EXIT_NO_MARKS && i != dir)
-    {
-      return false;
-    }
-  }
-
-  return true;
+  // Clearing the marks of the given direction, checking all 3 other cardinal directions at once
+  return (*m_marks & ~(3 << (2 * dir))) == 0;
 }
 
 /**--------------------------------------------------------------------------------------
@@ -186,7 +172,7 @@ bool Cell::isThisDirMarkedTwice(int dir) const
    *     Therefore the conditional checks for if the marks on the current exit is 
    *     greater than or equal to 1 
   */
-  return m_exits[dir] > VALID_EXIT_ONE_MARK; 
+  return getMarks(dir) > VALID_EXIT_ONE_MARK; 
 }
 
 /**--------------------------------------------------------------------------------------
@@ -207,35 +193,38 @@ bool Cell::isCellJunctionAllDirFilled() const
 
   for(int i = 0; i < NUM_CARDINAL_DIRECTIONS; i++)
   {
-    if(m_exits[i] > VALID_EXIT_ONE_MARK)
+    if(getMarks(i) > VALID_EXIT_ONE_MARK)
     {
       numTwoMarks++;
     }
   }
 
-  return numTwoMarks == m_numExits - 1;
+  return numTwoMarks == getNumExits() - 1;
 }
 
 /**--------------------------------------------------------------------------------------
  * getDirFewestMarks()
  * 
  * From all valid exits to the current cell, finds the exit with the least amount of marks
- *     Returns the direction with the fewest marks (0, 1, or 2), 
+ *     Returns the direction with the fewest marks (0 or 1), 
  *     excluding -1 (exit in that direction does not exist)
+ *     An exit marked twice was walked both ways already, so a cell whose exits are all 
+ *     marked twice, or that has no exits, has nowhere left to go
  * 
- * @return an int representing the cardinal direction of the exit with the least marks
+ * @return an int representing the cardinal direction of the exit with the least marks, 
+ * or -1 if every exit is marked twice or the cell has no exits
  * --------------------------------------------------------------------------------------
 */
 int Cell::getDirFewestMarks() const
 {
-  int numMarks = 100; // High number of marks impossible to reach
-  int dir = 0; // North by default
+  int numMarks = VALID_EXIT_TWO_MARKS; // Exits marked twice are never taken again
+  int dir = INVALID_EXIT;
 
   for(int i = 0; i < NUM_CARDINAL_DIRECTIONS; i++)
   {
-    if(m_exits[i] > INVALID_EXIT && m_exits[i] < numMarks)
+    if(hasExit(i) && getMarks(i) < numMarks)
     {
-      numMarks = m_exits[i];
+      numMarks = getMarks(i);
       dir = i;
     }
   }
@@ -264,7 +253,7 @@ int Cell::findDirOnlyOtherExit(int dir) const
 
   for(int i = 0; i < NUM_CARDINAL_DIRECTIONS; i++)
   {
-    if(m_exits[i] > INVALID_EXIT && i != dir)
+    if(hasExit(i) && i != dir)
     {
       otherDir = i;
       numOtherExits++;
@@ -287,8 +276,11 @@ int Cell::findDirOnlyOtherExit(int dir) const
 */
 std::string Cell::getStringMarks() const
 {
-  return "Marks... North: " + std::to_string(m_exits[0]) + ", South: " \
-                            + std::to_string(m_exits[1]) + ", East: " \
-                            + std::to_string(m_exits[2]) + ", West: " \
-                            + std::to_string(m_exits[3]);
+  // A value of -1 in a direction means an exit in that direction does not exist
+  auto exitMarks = [this](int dir) { return hasExit(dir) ? getMarks(dir) : INVALID_EXIT; };
+
+  return "Marks... North: " + std::to_string(exitMarks(0)) + ", South: " \
+                            + std::to_string(exitMarks(1)) + ", East: " \
+                            + std::to_string(exitMarks(2)) + ", West: " \
+                            + std::to_string(exitMarks(3));
 }
\ No newline at end of file
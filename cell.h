@@ -9,6 +9,8 @@
  * Defines a cell in a maze, with four different sides (North, South, East, West)
  * 
  * Is either on the path from the maze entrance to the maze exit, or isn't
+ * 
+ * A Cell is a lightweight view over the packed state of one cell stored by a Maze
  */
 
 /**
@@ -35,7 +37,7 @@
 
 #pragma once
 
-#include <array>
+#include <cstdint>
 #include <string>
 #include <assert.h>
 
@@ -47,37 +49,29 @@
  *     A regular cell
  *     An entrance or exit cell to the maze
  *     A path cell (on the path from the maze entrance to the maze exit)
+ * 
+ * The cell's state is not owned by the Cell object, it refers to two bytes kept elsewhere:
+ *     State byte: kept by the Maze and only read through the Cell, bits 0-3 are the exits 
+ *     (North, South, East, West), bit 4 is the path label
+ *     Marks byte: kept by whoever is solving the maze (see TremauxContext), 2 bits per 
+ *     cardinal direction holding the number of Tremaux marks on that exit
+ * Cells are cheap to copy, copying a Cell creates another view of the same maze cell
  * --------------------------------------------------------------------------------------
 */
 class Cell
 {
 public:
-    /**--------------------------------------------------------------------------------------
-     * Default Constructor
-     * --------------------------------------------------------------------------------------
-    */
-    Cell(){};
-
     /**--------------------------------------------------------------------------------------
      * Constructor
      * 
-     * Creates a regular cell with no exits in any cardinal direction
+     * Creates a view of a cell whose packed state is stored elsewhere
      * 
-     * @param[in] r Row index of cell
-     * @param[in] c Column index of cell
+    XX
+     * @param[in] r     Row index of cell
+     * @param[in] c     Column index of cell
      * --------------------------------------------------------------------------------------
     */
-    Cell(int r, int c);
-
-    /**--------------------------------------------------------------------------------------
-     * updateMyExit()
-     * 
-     * Given a direction, creates an exit in said direction
-     * 
-     * @param[in] dir Cardinal direction in which to create an exit
-     * --------------------------------------------------------------------------------------
-    */
-    void updateMyExit(int dir);
+    Cell(const std::uint8_t& state, std::uint8_t& marks, int r, int c);
 
     /**--------------------------------------------------------------------------------------
      * markCellExit()
@@ -180,10 +174,13 @@ public:
      * getDirFewestMarks()
      * 
      * From all valid exits to the current cell, finds the exit with the least amount of marks
-     *     Returns the direction with the fewest marks (0, 1, or 2), 
+     *     Returns the direction with the fewest marks (0 or 1), 
      *     excluding -1 (exit in that direction does not exist)
+     *     An exit marked twice was walked both ways already, so a cell whose exits are all 
+     *     marked twice, or that has no exits, has nowhere left to go
      * 
-     * @return an int representing the cardinal direction of the exit with the least marks
+     * @return an int representing the cardinal direction of the exit with the least marks, 
+     * or -1 if every exit is marked twice or the cell has no exits
      * --------------------------------------------------------------------------------------
     */
     int getDirFewestMarks() const;
@@ -204,18 +201,6 @@ public:
     */
     int findDirOnlyOtherExit(int dir) const;
 
-    /**--------------------------------------------------------------------------------------
-     * labelAsPath()
-     * 
-     * Labels the current cell as part of the path from the maze entrance to the maze exit
-     *     Changes to value of the boolean "amIOnPath" to true
-     * --------------------------------------------------------------------------------------
-    */
-    void labelCellAsPath()
-    {
-        m_amIOnPath = true;
-    }
-
     /**--------------------------------------------------------------------------------------
      * isCellOnPath()
      * 
@@ -227,7 +212,7 @@ public:
     */
     bool isCellOnPath() const
     {
-        return m_amIOnPath;
+        return (*m_state & PATH_BIT) != 0;
     }
 
     /**--------------------------------------------------------------------------------------
@@ -238,25 +223,51 @@ public:
     */
     std::string getStringMarks() const;
 
+    /**
+     * Layout of the packed state byte
+     *     Bits 0-3: set if an exit exists in direction 0: North, 1: South, 2: East, 3: West
+     *     Bit 4: set if the cell is on the path from the maze entrance to the maze exit
+    */
+    static const std::uint8_t EXITS_MASK = 0x0F;
+    static const std::uint8_t PATH_BIT = 0x10;
+
 private:
-    int m_rowLoc;
-    int m_colLoc;
     static const int NUM_CARDINAL_DIRECTIONS = 4;
     static const int INVALID_EXIT = -1;
     static const int VALID_EXIT_NO_MARKS = 0;
     static const int VALID_EXIT_ONE_MARK = 1;
     static const int VALID_EXIT_TWO_MARKS = 2;
+    static const int MAX_MARKS = 3;
 
-    // If true, this cell is part of the path traversed from the entrance to the exit, false otherwise
-    bool m_amIOnPath = false;
+    // Returns true if an exit exists in the given direction
+    bool hasExit(int dir) const
+    {
+        return (*m_state >> dir) & 1;
+    }
+
+    // Returns the number of marks on the exit in the given direction (0 to 3)
+    int getMarks(int dir) const
+    {
+        return (*m_marks >> (2 * dir)) & 3;
+    }
+
+    // Returns the number of exits the cell has
+    int getNumExits() const
+    {
+        return hasExit(0) + hasExit(1) + hasExit(2) + hasExit(3);
+    }
 
     /**
-     * Array Indices 0: North, 1: South, 2: East, 3: West
-     *     A value of -1 in a direction means an exit in that directions does not exist
-     *     A value of 0 in a direction means that exit exists and has not been marked before
-     *     A value of 1 in a direction means that exit has been marked once
-     *     A value of 2 in a direction means that exit has been marked twice
+     * Packed cell state owned by the Maze
+     *     m_state: exits and path label, see EXITS_MASK and PATH_BIT, owned by the Maze
+     *     m_marks: Tremaux marks, 2 bits per direction, owned by the solver
+     *         A value of 0 in a direction means that exit has not been marked before
+     *         A value of 1 in a direction means that exit has been marked once
+     *         A value of 2 in a direction means that exit has been marked twice
     */
-    std::array<int, NUM_CARDINAL_DIRECTIONS> m_exits{ INVALID_EXIT, INVALID_EXIT, INVALID_EXIT, INVALID_EXIT };
-    int m_numExits = 0;
+    const std::uint8_t* m_state;
+    std::uint8_t* m_marks;
+
+    int m_rowLoc;
+    int m_colLoc;
 };
\ No newline at end of file
@@ -0,0 +1,346 @@
+/*eller.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Out-of-core maze generation
+ * 
+ * Generates mazes row by row with Eller's Algorithm, streaming them straight into the binary
+ * format so mazes far larger than memory can be made
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "eller.h"
+#include "bitOps.h"
+#include "mazeBinary.h"
+#include "metrics.h"
+#include "wilson.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Marks a cell of the next row that no set has opened down into yet
+const std::uint32_t FRESH_SET_LABEL = 0xFFFFFFFFu;
+
+/**--------------------------------------------------------------------------------------
+ * EllerRowState struct
+ * 
+ * Everything runStreamingEller() keeps about the row being generated, one entry per column
+ *     labels: set of each cell, sets are labeled 0 to numCols - 1
+ *     parents: union-find forest over the set labels, sets joined in this row point to 
+ *     the set they were joined to
+ *     remainingCells, hasOpenedDown: per set, cells of the set not yet given a chance to 
+ *     open down, and whether any has
+ *     nextLabels: per set, its label in the next row, plus a scratch entry for cells not 
+ *     opened into
+ *     southWords, eastWords: the row's open walls, in the layout of mazeBinary.h
+ * --------------------------------------------------------------------------------------
+*/
+struct EllerRowState
+{
+    std::vector<std::uint32_t> labels;
+    std::vector<std::uint32_t> parents;
+    std::vector<std::uint32_t> remainingCells;
+    std::vector<std::uint8_t> hasOpenedDown;
+    std::vector<std::uint32_t> nextLabels;
+    std::vector<std::uint64_t> southWords;
+    std::vector<std::uint64_t> eastWords;
+
+    explicit EllerRowState(int numCols)
+        : labels(numCols), parents(numCols), remainingCells(numCols, 0), hasOpenedDown(numCols, 0), nextLabels(static_cast<std::size_t>(numCols) + 1, FRESH_SET_LABEL),
+          southWords((static_cast<std::size_t>(numCols) + 63) / 64, 0), eastWords((static_cast<std::size_t>(numCols) + 63) / 64, 0)
+    {
+        // Every cell of the first row starts in a set of its own
+        std::iota(labels.begin(), labels.end(), 0u);
+        std::iota(parents.begin(), parents.end(), 0u);
+    }
+
+    // Root of the set with the given label, halving the path to it on the way
+    std::uint32_t findSet(std::uint32_t label)
+    {
+        while(parents[label] != label)
+        {
+            parents[label] = parents[parents[label]];
+            label = parents[label];
+        }
+        return label;
+    }
+};
+
+/**--------------------------------------------------------------------------------------
+ * EllerCoinFlips struct
+ * 
+ * Coin flips for Eller's Algorithm, taken one bit at a time from 32-bit draws
+ *     Flips are used without branching on them, since they can never be predicted
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+struct EllerCoinFlips
+{
+    RngEngine& rng;
+    std::uint32_t randomBits = 0;
+    int numRandomBits = 0;
+
+    explicit EllerCoinFlips(RngEngine& engine) : rng(engine)
+    {
+    }
+
+    std::uint32_t flip()
+    {
+        if(numRandomBits == 0)
+        {
+            randomBits = randomBits32(rng);
+            numRandomBits = 32;
+        }
+        std::uint32_t isHeads = randomBits & 1;
+        randomBits >>= 1;
+        numRandomBits--;
+        return isHeads;
+    }
+};
+
+/**--------------------------------------------------------------------------------------
+ * generateEllerRow()
+ * 
+ * Generates the open walls of one row with Eller's Algorithm, and labels the sets of the 
+ * next row
+ *     Neighbors in different sets are joined at random, then every set opens at least one 
+ *     wall down into the next row. The last row joins every neighbor still in a different 
+ *     set, and opens nothing down
+ * 
+ * @param[in,out]   state       Row state, holding the sets of the row on entry and the sets 
+ *                              of the next row on return, with the row's walls in southWords 
+ *                              and eastWords
+ * @param[in]       isLastRow   Whether this is the last row of the maze
+ * @param[in,out]   coinFlips   Coin flips driving the generation
+ * @return the number of walls opened in the row
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t generateEllerRow(EllerRowState& state, bool isLastRow, EllerCoinFlips<RngEngine>& coinFlips)
+{
+    const int numCols = static_cast<int>(state.labels.size());
+    std::uint64_t numOpened = 0;
+    std::fill(state.southWords.begin(), state.southWords.end(), 0);
+    std::fill(state.eastWords.begin(), state.eastWords.end(), 0);
+
+    // Joining neighbors in different sets, at random except in the last row
+    for(int col = 0; col + 1 < numCols; col++)
+    {
+        std::uint32_t westSet = state.findSet(state.labels[col]);
+        std::uint32_t eastSet = state.findSet(state.labels[col + 1]);
+        std::uint32_t isJoined = static_cast<std::uint32_t>(westSet != eastSet) & (static_cast<std::uint32_t>(isLastRow) | coinFlips.flip());
+        state.parents[eastSet] = isJoined ? westSet : eastSet;
+        state.eastWords[col >> 6] |= static_cast<std::uint64_t>(isJoined) << (col & 63);
+        numOpened += isJoined;
+    }
+
+    if(isLastRow)
+    {
+        return numOpened;
+    }
+
+    // Counting the cells of each set, so its last cell can open down if none has yet
+    for(int col = 0; col < numCols; col++)
+    {
+        std::uint32_t set = state.findSet(state.labels[col]);
+        state.labels[col] = set;
+        state.remainingCells[set]++;
+        state.hasOpenedDown[set] = 0;
+    }
+
+    for(int col = 0; col < numCols; col++)
+    {
+        std::uint32_t set = state.labels[col];
+        state.remainingCells[set]--;
+        std::uint32_t isLastChance = static_cast<std::uint32_t>(state.remainingCells[set] == 0) & static_cast<std::uint32_t>(state.hasOpenedDown[set] == 0);
+        std::uint32_t isOpenedDown = coinFlips.flip() | isLastChance;
+        state.hasOpenedDown[set] |= static_cast<std::uint8_t>(isOpenedDown);
+        state.southWords[col >> 6] |= static_cast<std::uint64_t>(isOpenedDown) << (col & 63);
+        numOpened += isOpenedDown;
+    }
+
+    // Labeling the next row, cells opened into keep their set and the rest start new ones
+    //     A cell not opened into gets a label of its own, a cell opened into gets its 
+    //     set's label, made up the first time the set is seen
+    std::uint32_t numSets = 0;
+    for(int col = 0; col < numCols; col++)
+    {
+        std::uint32_t isOpenedInto = (state.southWords[col >> 6] >> (col & 63)) & 1;
+        std::uint32_t& setLabel = state.nextLabels[isOpenedInto ? state.labels[col] : numCols];
+        std::uint32_t isNewLabel = static_cast<std::uint32_t>(setLabel == FRESH_SET_LABEL) | (isOpenedInto ^ 1);
+        setLabel = isNewLabel ? numSets : setLabel;
+        state.labels[col] = setLabel;
+        numSets += isNewLabel;
+    }
+
+    std::fill(state.nextLabels.begin(), state.nextLabels.end(), FRESH_SET_LABEL);
+    std::iota(state.parents.begin(), state.parents.end(), 0u);
+    return numOpened;
+}
+
+/**--------------------------------------------------------------------------------------
+ * ellerRowStateBytes()
+ * 
+ * Returns the memory runStreamingEller() needs besides its output buffer
+ * 
+ * @param[in] numCols Number of columns in the maze
+ * @return the number of bytes of row state, which does not depend on the number of rows
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t ellerRowStateBytes(int numCols)
+{
+    std::size_t wordsPerRow = (static_cast<std::size_t>(numCols) + 63) / 64;
+    return static_cast<std::size_t>(numCols) * (4 * sizeof(std::uint32_t) + sizeof(std::uint8_t)) + 2 * wordsPerRow * sizeof(std::uint64_t);
+}
+
+/**--------------------------------------------------------------------------------------
+ * runStreamingEller()
+ * 
+ * Generates a maze row by row with Eller's Algorithm, streaming it straight out in the 
+ * binary format (see mazeBinary.h) without ever holding more than one row
+ *     Each cell of the current row carries the label of the set of cells it is connected 
+ *     to above it. Neighbors in different sets are joined at random, then every set opens 
+ *     at least one wall down into the next row, so no set is ever cut off
+ *     The last row joins every neighbor still in a different set, so the maze is perfect
+ *     Memory is ellerRowStateBytes() plus the output buffer, whatever the number of rows
+ *     Eller's mazes are not unbiased like Wilson's, their passages favor running along 
+ *     the rows
+ *     The maze is not solved, so the record has no path section
+ * 
+ * @param[in]       numRows     Number of rows in the maze
+ * @param[in]       numCols     Number of columns in the maze
+ * @param[in,out]   rng         Random number engine driving the generation, the same engine 
+ *                              state always produces the same maze
+ * @param[in,out]   outfile     Buffer in front of the binary file to write to
+ * @param[in]       hasSeed     Whether seed is stored in the header
+ * @param[in]       seed        Seed the maze was generated from
+ * @return the number of walls opened
+ * 
+ * Instantiated in eller.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runStreamingEller(int numRows, int numCols, RngEngine& rng, MazeOutputBuffer& outfile, bool hasSeed, std::uint64_t seed)
+{
+    METRIC_TIMER(METRIC_ELLER_TIMER)
+    // The header comes first, so the entrance and exit are placed before any row exists
+    MazeBinaryHeader header;
+    int entranceRow = Maze::INVALID_ROW_COL;
+    int entranceCol = Maze::INVALID_ROW_COL;
+    int exitRow = Maze::INVALID_ROW_COL;
+    int exitCol = Maze::INVALID_ROW_COL;
+    chooseEntranceAndExit(numRows, numCols, rng, entranceRow, entranceCol, exitRow, exitCol);
+
+    header.numRows = static_cast<std::uint64_t>(numRows);
+    header.numCols = static_cast<std::uint64_t>(numCols);
+    header.entranceRow = entranceRow;
+    header.entranceCol = entranceCol;
+    header.exitRow = exitRow;
+    header.exitCol = exitCol;
+    header.seed = hasSeed ? seed : 0;
+    header.flags = hasSeed ? MAZE_BINARY_HAS_SEED : 0;
+    makeMazeBinaryHeader(header);
+
+    encodeMazeBinaryHeader(header, reinterpret_cast<std::uint8_t*>(outfile.reserve(MAZE_BINARY_HEADER_BYTES)));
+    outfile.commit(MAZE_BINARY_HEADER_BYTES);
+
+    EllerRowState state(numCols);
+    EllerCoinFlips<RngEngine> coinFlips(rng);
+    std::uint64_t numOpened = 0;
+
+    for(int row = 0; row < numRows; row++)
+    {
+        numOpened += generateEllerRow(state, row == numRows - 1, coinFlips);
+
+        // Row is done, south then east words like writeMazeDataBinary()
+        char* rowBytes = outfile.reserve(16 * state.southWords.size());
+        rowBytes = storeRowWords(rowBytes, state.southWords.data(), state.southWords.size());
+        storeRowWords(rowBytes, state.eastWords.data(), state.eastWords.size());
+        outfile.commit(16 * state.southWords.size());
+    }
+
+    return numOpened;
+}
+
+/**--------------------------------------------------------------------------------------
+ * runEller()
+ * 
+ * Given an empty (blank) maze, fills it out row by row with Eller's Algorithm, see 
+ * runStreamingEller()
+ *     Takes linear time and only one row of extra memory, but the maze is biased towards 
+ *     passages running along the rows
+ *     The entrance and exit are placed first like in runStreamingEller(), so the same 
+ *     engine state gives the same maze as the one streamed out
+ * 
+ * @param[in,out]   blankMaze   Maze object with every wall closed, is filled out
+ * @param[in,out]   rng         Random number engine driving the generation
+ * @return the number of walls opened
+ * 
+ * Instantiated in eller.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runEller(Maze& blankMaze, RngEngine& rng)
+{
+    METRIC_TIMER(METRIC_ELLER_TIMER)
+    createEntranceAndExit(blankMaze, rng);
+
+    const int numRows = blankMaze.getROWCELLS();
+    EllerRowState state(blankMaze.getCOLCELLS());
+    EllerCoinFlips<RngEngine> coinFlips(rng);
+    std::uint64_t numOpened = 0;
+
+    for(int row = 0; row < numRows; row++)
+    {
+        numOpened += generateEllerRow(state, row == numRows - 1, coinFlips);
+
+        // Opening the passages of the row, one set bit at a time
+        for(std::size_t word = 0; word < state.southWords.size(); word++)
+        {
+            int firstCol = static_cast<int>(word * 64);
+            for(std::uint64_t bits = state.southWords[word]; bits != 0; bits &= bits - 1)
+            {
+                blankMaze.openPassage(row, firstCol + countTrailingZeros(bits), Maze::SOUTH_DIRECTION);
+            }
+            for(std::uint64_t bits = state.eastWords[word]; bits != 0; bits &= bits - 1)
+            {
+                blankMaze.openPassage(row, firstCol + countTrailingZeros(bits), Maze::EAST_DIRECTION);
+            }
+        }
+    }
+
+    return numOpened;
+}
+
+// Explicit instantiations for the engines in rng.h
+template std::uint64_t runStreamingEller<SplitMix64>(int numRows, int numCols, SplitMix64& rng, MazeOutputBuffer& outfile, bool hasSeed, std::uint64_t seed);
+template std::uint64_t runStreamingEller<Xoshiro256StarStar>(int numRows, int numCols, Xoshiro256StarStar& rng, MazeOutputBuffer& outfile, bool hasSeed, std::uint64_t seed);
+template std::uint64_t runStreamingEller<Pcg32>(int numRows, int numCols, Pcg32& rng, MazeOutputBuffer& outfile, bool hasSeed, std::uint64_t seed);
+
+template std::uint64_t runEller<SplitMix64>(Maze& blankMaze, SplitMix64& rng);
+template std::uint64_t runEller<Xoshiro256StarStar>(Maze& blankMaze, Xoshiro256StarStar& rng);
+template std::uint64_t runEller<Pcg32>(Maze& blankMaze, Pcg32& rng);
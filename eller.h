@@ -0,0 +1,102 @@
+/*eller.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Out-of-core maze generation
+ * 
+ * Generates mazes row by row with Eller's Algorithm, streaming them straight into the binary
+ * format so mazes far larger than memory can be made
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "maze.h"
+#include "mazeWriter.h"
+#include "rng.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**--------------------------------------------------------------------------------------
+ * ellerRowStateBytes()
+ * 
+ * Returns the memory runStreamingEller() needs besides its output buffer
+ * 
+ * @param[in] numCols Number of columns in the maze
+ * @return the number of bytes of row state, which does not depend on the number of rows
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t ellerRowStateBytes(int numCols);
+
+/**--------------------------------------------------------------------------------------
+ * runStreamingEller()
+ * 
+ * Generates a maze row by row with Eller's Algorithm, streaming it straight out in the 
+ * binary format (see mazeBinary.h) without ever holding more than one row
+ *     Each cell of the current row carries the label of the set of cells it is connected 
+ *     to above it. Neighbors in different sets are joined at random, then every set opens 
+ *     at least one wall down into the next row, so no set is ever cut off
+ *     The last row joins every neighbor still in a different set, so the maze is perfect
+ *     Memory is ellerRowStateBytes() plus the output buffer, whatever the number of rows
+ *     Eller's mazes are not unbiased like Wilson's, their passages favor running along 
+ *     the rows
+ *     The maze is not solved, so the record has no path section
+ * 
+ * @param[in]       numRows     Number of rows in the maze
+ * @param[in]       numCols     Number of columns in the maze
+ * @param[in,out]   rng         Random number engine driving the generation, the same engine 
+ *                              state always produces the same maze
+ * @param[in,out]   outfile     Buffer in front of the binary file to write to
+ * @param[in]       hasSeed     Whether seed is stored in the header
+ * @param[in]       seed        Seed the maze was generated from
+ * @return the number of walls opened
+ * 
+ * Instantiated in eller.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runStreamingEller(int numRows, int numCols, RngEngine& rng, MazeOutputBuffer& outfile, bool hasSeed, std::uint64_t seed);
+
+/**--------------------------------------------------------------------------------------
+ * runEller()
+ * 
+ * Given an empty (blank) maze, fills it out row by row with Eller's Algorithm, see 
+ * runStreamingEller()
+ *     Takes linear time and only one row of extra memory, but the maze is biased towards 
+ *     passages running along the rows
+ *     The entrance and exit are placed first like in runStreamingEller(), so the same 
+ *     engine state gives the same maze as the one streamed out
+ * 
+ * @param[in,out]   blankMaze   Maze object with every wall closed, is filled out
+ * @param[in,out]   rng         Random number engine driving the generation
+ * @return the number of walls opened
+ * 
+ * Instantiated in eller.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runEller(Maze& blankMaze, RngEngine& rng);
@@ -0,0 +1,583 @@
+/*gridGraph.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Grid graph
+ * 
+ * Builds the compressed sparse row adjacency and the cell outlines of square,
+ * hexagonal, triangular and polar grids
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "gridGraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+/**
+ * Most cells build() makes, so that every side and neighbor entry can be indexed with 32 bits
+*/
+const std::uint64_t MAX_GRID_GRAPH_CELLS = std::uint64_t(1) << 28;
+
+/**
+ * Most rings build() makes for POLAR_TOPOLOGY, well past the ones that fit in MAX_GRID_GRAPH_CELLS
+*/
+const int MAX_POLAR_RINGS = 16384;
+
+/**
+ * Cells of the center of a polar maze with no rings around it are drawn as a polygon with this many sides
+*/
+const int POLAR_CENTER_SIDES = 24;
+
+const double GRID_GRAPH_PI = 3.14159265358979323846;
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates a graph with no cells, see build()
+ * --------------------------------------------------------------------------------------
+*/
+GridGraph::GridGraph()
+    : m_topology(INVALID_TOPOLOGY),
+      m_numEdges(0),
+      m_width(0.0),
+      m_height(0.0),
+      m_neighborOffsets(1, 0),
+      m_entrance(INVALID_CELL),
+      m_exit(INVALID_CELL),
+      m_sideOffsets(1, 0)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * polarRingSizes()
+ * 
+ * Returns the number of cells in each ring of a polar maze, the center cell being ring 0
+ *     A ring splits each cell of the ring inside it into as many cells as fit across its 
+ *     inner circumference, so its cells stay about one ring high and one ring wide
+ * 
+ * @param[in] numRings Number of rings, the center included
+ * @return the number of cells of every ring
+ * --------------------------------------------------------------------------------------
+*/
+std::vector<std::uint64_t> polarRingSizes(int numRings)
+{
+    std::vector<std::uint64_t> ringSizes(1, 1);
+    for(int ring = 1; ring < numRings; ring++)
+    {
+        const double cellWidth = 2.0 * GRID_GRAPH_PI * ring / static_cast<double>(ringSizes.back());
+        const std::uint64_t ratio = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::llround(cellWidth)));
+        ringSizes.push_back(ringSizes.back() * ratio);
+    }
+    return ringSizes;
+}
+
+/**--------------------------------------------------------------------------------------
+ * build()
+ * 
+ * Replaces the graph with an empty maze on the given grid: no entrance, exit or path 
+ * cells, and every wall closed
+ * 
+ * @param[in] topology  Grid to build, see SQUARE_TOPOLOGY
+ * @param[in] numRows   Number of rows, or of rings around the center for POLAR_TOPOLOGY
+ * @param[in] numCols   Number of columns, ignored for POLAR_TOPOLOGY
+ * @return false if the topology is unknown, the grid is empty or too big, or it falls 
+ * apart into pieces no maze can join
+ * --------------------------------------------------------------------------------------
+*/
+bool GridGraph::build(int topology, int numRows, int numCols)
+{
+    std::uint64_t numCells = 0;
+    if(topology == POLAR_TOPOLOGY)
+    {
+        // Rings grow by about 2 pi cells each, so past MAX_POLAR_RINGS the grid is too big without sizing every ring
+        if(numRows >= 1 && numRows <= MAX_POLAR_RINGS)
+        {
+            for(std::uint64_t ringSize : polarRingSizes(numRows))
+            {
+                numCells += ringSize;
+            }
+        }
+        else if(numRows > MAX_POLAR_RINGS)
+        {
+            numCells = MAX_GRID_GRAPH_CELLS + 1;
+        }
+    }
+    else if(topology == SQUARE_TOPOLOGY || topology == HEX_TOPOLOGY || topology == TRIANGLE_TOPOLOGY)
+    {
+        if(numRows >= 1 && numCols >= 1)
+        {
+            numCells = static_cast<std::uint64_t>(numRows) * static_cast<std::uint64_t>(numCols);
+        }
+    }
+    else
+    {
+        std::cerr << "ERROR: GridGraph::build() was given an unknown topology: " << topology << std::endl;
+        return false;
+    }
+
+    if(numCells == 0 || numCells > MAX_GRID_GRAPH_CELLS)
+    {
+        std::cerr << "ERROR: GridGraph::build() needs between 1 and " << MAX_GRID_GRAPH_CELLS << " cells, not a " << numRows << "x" << numCols \
+                  << " " << topologyName(topology) << " grid" << std::endl;
+        return false;
+    }
+
+    // One column of triangles only pairs up rows 0 and 1, 2 and 3 and so on, so taller grids fall apart
+    if(topology == TRIANGLE_TOPOLOGY && numCols < 2 && numRows > 2)
+    {
+        std::cerr << "ERROR: GridGraph::build() needs at least 2 columns for a " << topologyName(topology) << " grid of more than 2 rows, not a " \
+                  << numRows << "x" << numCols << " " << topologyName(topology) << " grid" << std::endl;
+        return false;
+    }
+
+    m_topology = topology;
+    m_neighborOffsets.assign(1, 0);
+    m_neighbors.clear();
+    m_sideOffsets.assign(1, 0);
+    m_sideX.clear();
+    m_sideY.clear();
+    m_sideSlots.clear();
+    m_centerX.clear();
+    m_centerY.clear();
+
+    switch(topology)
+    {
+        case SQUARE_TOPOLOGY:
+            buildSquare(numRows, numCols);
+            break;
+        case HEX_TOPOLOGY:
+            buildHex(numRows, numCols);
+            break;
+        case TRIANGLE_TOPOLOGY:
+            buildTriangle(numRows, numCols);
+            break;
+        default:
+            buildPolar(numRows);
+            break;
+    }
+
+    finishEdges();
+    reset();
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * reset()
+ * 
+ * Returns the maze to the state build() left it in, keeping the grid and its storage
+ * --------------------------------------------------------------------------------------
+*/
+void GridGraph::reset()
+{
+    m_openEdges.assign((m_numEdges + 63) / 64, 0);
+    m_pathBits.assign((getNumCells() + 63) / 64, 0);
+    m_entrance = INVALID_CELL;
+    m_exit = INVALID_CELL;
+}
+
+/**--------------------------------------------------------------------------------------
+ * clearPath()
+ * 
+ * Removes the path label from every cell
+ * --------------------------------------------------------------------------------------
+*/
+void GridGraph::clearPath()
+{
+    std::fill(m_pathBits.begin(), m_pathBits.end(), std::uint64_t(0));
+}
+
+/**--------------------------------------------------------------------------------------
+ * topologyFromName() / topologyName()
+ * 
+ * Converts between topologies and the names main() takes with --topology
+ * 
+ * @param[in] name      "square", "hex", "triangle" or "polar"
+ * @param[in] topology  Topology, see SQUARE_TOPOLOGY
+ * @return the topology, INVALID_TOPOLOGY for an unknown name / the name, "invalid" for 
+ * an unknown topology
+ * --------------------------------------------------------------------------------------
+*/
+int GridGraph::topologyFromName(const std::string& name)
+{
+    for(int topology : {SQUARE_TOPOLOGY, HEX_TOPOLOGY, TRIANGLE_TOPOLOGY, POLAR_TOPOLOGY})
+    {
+        if(name == topologyName(topology))
+        {
+            return topology;
+        }
+    }
+    return INVALID_TOPOLOGY;
+}
+
+const char* GridGraph::topologyName(int topology)
+{
+    switch(topology)
+    {
+        case SQUARE_TOPOLOGY:
+            return "square";
+        case HEX_TOPOLOGY:
+            return "hex";
+        case TRIANGLE_TOPOLOGY:
+            return "triangle";
+        case POLAR_TOPOLOGY:
+            return "polar";
+        default:
+            return "invalid";
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * addNeighbor() / addSide() / addCell()
+ * 
+ * Add the neighbors and the sides of the next cell, then the cell itself with its center
+ *     Neighbors with a lower index than the cell must list it too, the edges are numbered 
+ *     from those pairs by finishEdges()
+ * 
+ * @param[in] neighbor  Index of the neighbor
+ * @param[in] x, y      Start of the side
+ * @param[in] slot      Neighbor slot the side is shared with, or BORDER_SIDE
+ * --------------------------------------------------------------------------------------
+*/
+void GridGraph::addNeighbor(std::uint32_t neighbor)
+{
+    m_neighbors.push_back(neighbor);
+}
+
+void GridGraph::addSide(double x, double y, int slot)
+{
+    m_sideX.push_back(static_cast<float>(x));
+    m_sideY.push_back(static_cast<float>(y));
+    m_sideSlots.push_back(static_cast<std::int8_t>(slot));
+}
+
+void GridGraph::addCell(double centerX, double centerY)
+{
+    m_neighborOffsets.push_back(static_cast<std::uint32_t>(m_neighbors.size()));
+    m_sideOffsets.push_back(static_cast<std::uint32_t>(m_sideX.size()));
+    m_centerX.push_back(static_cast<float>(centerX));
+    m_centerY.push_back(static_cast<float>(centerY));
+}
+
+/**--------------------------------------------------------------------------------------
+ * buildSquare()
+ * 
+ * Adds rows x columns of unit squares, neighbors in the order North, South, East, West 
+ * like Maze, sides from the top left corner
+ * --------------------------------------------------------------------------------------
+*/
+void GridGraph::buildSquare(int numRows, int numCols)
+{
+    for(int row = 0; row < numRows; row++)
+    {
+        for(int col = 0; col < numCols; col++)
+        {
+            const std::uint32_t cell = static_cast<std::uint32_t>(row) * static_cast<std::uint32_t>(numCols) + static_cast<std::uint32_t>(col);
+            int slots[4] = { BORDER_SIDE, BORDER_SIDE, BORDER_SIDE, BORDER_SIDE };
+            int numNeighbors = 0;
+            if(row > 0)
+            {
+                slots[0] = numNeighbors++;
+                addNeighbor(cell - static_cast<std::uint32_t>(numCols));
+            }
+            if(row < numRows - 1)
+            {
+                slots[1] = numNeighbors++;
+                addNeighbor(cell + static_cast<std::uint32_t>(numCols));
+            }
+            if(col < numCols - 1)
+            {
+                slots[2] = numNeighbors++;
+                addNeighbor(cell + 1);
+            }
+            if(col > 0)
+            {
+                slots[3] = numNeighbors++;
+                addNeighbor(cell - 1);
+            }
+
+            // Clockwise: top, right, bottom, left
+            addSide(col, row, slots[0]);
+            addSide(col + 1, row, slots[2]);
+            addSide(col + 1, row + 1, slots[1]);
+            addSide(col, row + 1, slots[3]);
+            addCell(col + 0.5, row + 0.5);
+        }
+    }
+
+    m_width = numCols;
+    m_height = numRows;
+}
+
+/**--------------------------------------------------------------------------------------
+ * buildHex()
+ * 
+ * Adds rows x columns of pointy-top hexagons one unit wide, odd rows shifted half a unit 
+ * east, neighbors in the order East, South-East, South-West, West, North-West, North-East
+ * --------------------------------------------------------------------------------------
+*/
+void GridGraph::buildHex(int numRows, int numCols)
+{
+    const double radius = 1.0 / std::sqrt(3.0);
+
+    for(int row = 0; row < numRows; row++)
+    {
+        // Rows above and below an odd row reach half a cell further east, see the shift
+        const int diagonalShift = row & 1;
+        for(int col = 0; col < numCols; col++)
+        {
+            const int neighborRows[6] = { row, row + 1, row + 1, row, row - 1, row - 1 };
+            const int neighborCols[6] = { col + 1, col + diagonalShift, col + diagonalShift - 1, col - 1, col + diagonalShift - 1, col + diagonalShift };
+            int slots[6];
+            int numNeighbors = 0;
+            for(int dir = 0; dir < 6; dir++)
+            {
+                slots[dir] = BORDER_SIDE;
+                if(neighborRows[dir] >= 0 && neighborRows[dir] < numRows && neighborCols[dir] >= 0 && neighborCols[dir] < numCols)
+                {
+                    slots[dir] = numNeighbors++;
+                    addNeighbor(static_cast<std::uint32_t>(neighborRows[dir]) * static_cast<std::uint32_t>(numCols) + static_cast<std::uint32_t>(neighborCols[dir]));
+                }
+            }
+
+            // Side dir starts at the corner 60 * dir - 30 degrees clockwise from east, so side 0 faces east
+            const double centerX = col + 0.5 * diagonalShift + 0.5;
+            const double centerY = radius + 1.5 * radius * row;
+            for(int dir = 0; dir < 6; dir++)
+            {
+                const double angle = GRID_GRAPH_PI / 180.0 * (60.0 * dir - 30.0);
+                addSide(centerX + radius * std::cos(angle), centerY + radius * std::sin(angle), slots[dir]);
+            }
+            addCell(centerX, centerY);
+        }
+    }
+
+    m_width = numCols + ((numRows > 1) ? 0.5 : 0.0);
+    m_height = radius * (1.5 * numRows + 0.5);
+}
+
+/**--------------------------------------------------------------------------------------
+ * buildTriangle()
+ * 
+ * Adds rows x columns of equilateral triangles with unit sides, cell (row, col) pointing 
+ * up when row + col is even, neighbors in the order West, East, then North or South
+ * --------------------------------------------------------------------------------------
+*/
+void GridGraph::buildTriangle(int numRows, int numCols)
+{
+    const double height = std::sqrt(3.0) / 2.0;
+
+    for(int row = 0; row < numRows; row++)
+    {
+        for(int col = 0; col < numCols; col++)
+        {
+            const std::uint32_t cell = static_cast<std::uint32_t>(row) * static_cast<std::uint32_t>(numCols) + static_cast<std::uint32_t>(col);
+            const bool isUp = ((row + col) & 1) == 0;
+            int westSlot = BORDER_SIDE;
+            int eastSlot = BORDER_SIDE;
+            int verticalSlot = BORDER_SIDE;
+            int numNeighbors = 0;
+            if(col > 0)
+            {
+                westSlot = numNeighbors++;
+                addNeighbor(cell - 1);
+            }
+            if(col < numCols - 1)
+            {
+                eastSlot = numNeighbors++;
+                addNeighbor(cell + 1);
+            }
+            if(isUp && row < numRows - 1)
+            {
+                verticalSlot = numNeighbors++;
+                addNeighbor(cell + static_cast<std::uint32_t>(numCols));
+            }
+            else if(!isUp && row > 0)
+            {
+                verticalSlot = numNeighbors++;
+                addNeighbor(cell - static_cast<std::uint32_t>(numCols));
+            }
+
+            const double left = 0.5 * col;
+            const double top = height * row;
+            if(isUp)
+            {
+                // Clockwise from the apex: east side, base, west side
+                addSide(left + 0.5, top, eastSlot);
+                addSide(left + 1.0, top + height, verticalSlot);
+                addSide(left, top + height, westSlot);
+                addCell(left + 0.5, top + height * 2.0 / 3.0);
+            }
+            else
+            {
+                // Clockwise from the top left corner: top, east side, west side
+                addSide(left, top, verticalSlot);
+                addSide(left + 1.0, top, eastSlot);
+                addSide(left + 0.5, top + height, westSlot);
+                addCell(left + 0.5, top + height / 3.0);
+            }
+        }
+    }
+
+    m_width = 0.5 * (numCols + 1);
+    m_height = height * numRows;
+}
+
+/**--------------------------------------------------------------------------------------
+ * buildPolar()
+ * 
+ * Adds a center cell and numRings - 1 rings around it, each one unit high, see 
+ * polarRingSizes()
+ *     Cell s of a ring spans the angles from s to s + 1 of the ring's cells clockwise from 
+ *     east, and its neighbors are in the order inward, clockwise, counterclockwise, then 
+ *     each cell of the next ring over it
+ *     The center cell is a polygon with one side per cell of the first ring
+ * --------------------------------------------------------------------------------------
+*/
+void GridGraph::buildPolar(int numRings)
+{
+    const std::vector<std::uint64_t> ringSizes = polarRingSizes(numRings);
+    std::vector<std::uint32_t> ringStarts(1, 0);
+    for(int ring = 0; ring < numRings; ring++)
+    {
+        ringStarts.push_back(ringStarts.back() + static_cast<std::uint32_t>(ringSizes[ring]));
+    }
+
+    const double center = numRings;
+    auto pointAt = [&](double radius, std::uint64_t step, std::uint64_t numSteps, double& x, double& y)
+    {
+        const double angle = 2.0 * GRID_GRAPH_PI * static_cast<double>(step) / static_cast<double>(numSteps);
+        x = center + radius * std::cos(angle);
+        y = center + radius * std::sin(angle);
+    };
+    double x = 0.0;
+    double y = 0.0;
+
+    // Center cell, neighbors in the order of the first ring
+    const std::uint64_t numCenterSides = (numRings > 1) ? ringSizes[1] : POLAR_CENTER_SIDES;
+    for(std::uint64_t side = 0; side < numCenterSides; side++)
+    {
+        if(numRings > 1)
+        {
+            addNeighbor(ringStarts[1] + static_cast<std::uint32_t>(side));
+        }
+        pointAt(1.0, side, numCenterSides, x, y);
+        addSide(x, y, (numRings > 1) ? static_cast<int>(side) : BORDER_SIDE);
+    }
+    addCell(center, center);
+
+    for(int ring = 1; ring < numRings; ring++)
+    {
+        const std::uint64_t numCells = ringSizes[ring];
+        const std::uint64_t inwardRatio = numCells / ringSizes[ring - 1];
+        const std::uint64_t outwardRatio = (ring + 1 < numRings) ? ringSizes[ring + 1] / numCells : 0;
+        for(std::uint64_t cell = 0; cell < numCells; cell++)
+        {
+            addNeighbor(ringStarts[ring - 1] + static_cast<std::uint32_t>(cell / inwardRatio));
+            addNeighbor(ringStarts[ring] + static_cast<std::uint32_t>((cell + 1) % numCells));
+            addNeighbor(ringStarts[ring] + static_cast<std::uint32_t>((cell + numCells - 1) % numCells));
+            for(std::uint64_t outward = 0; outward < outwardRatio; outward++)
+            {
+                addNeighbor(ringStarts[ring + 1] + static_cast<std::uint32_t>(cell * outwardRatio + outward));
+            }
+
+            // Clockwise: inner side, clockwise side, outer sides backwards, counterclockwise side
+            pointAt(ring, cell, numCells, x, y);
+            addSide(x, y, 0);
+            pointAt(ring, cell + 1, numCells, x, y);
+            addSide(x, y, 1);
+            if(outwardRatio == 0)
+            {
+                pointAt(ring + 1, cell + 1, numCells, x, y);
+                addSide(x, y, BORDER_SIDE);
+            }
+            for(std::uint64_t outward = outwardRatio; outward > 0; outward--)
+            {
+                pointAt(ring + 1, cell * outwardRatio + outward, numCells * outwardRatio, x, y);
+                addSide(x, y, static_cast<int>(2 + outward));
+            }
+            pointAt(ring + 1, cell, numCells, x, y);
+            addSide(x, y, 2);
+
+            pointAt(ring + 0.5, 2 * cell + 1, 2 * numCells, x, y);
+            addCell(x, y);
+        }
+    }
+
+    m_width = 2.0 * numRings;
+    m_height = 2.0 * numRings;
+}
+
+/**--------------------------------------------------------------------------------------
+ * finishEdges()
+ * 
+ * Numbers the edges, giving both entries of a pair of neighbors the same edge, and 
+ * lists the border cells
+ * --------------------------------------------------------------------------------------
+*/
+void GridGraph::finishEdges()
+{
+    const std::uint32_t numCells = static_cast<std::uint32_t>(getNumCells());
+    m_neighborEdges.assign(m_neighbors.size(), 0);
+    m_numEdges = 0;
+
+    for(std::uint32_t cell = 0; cell < numCells; cell++)
+    {
+        for(std::uint32_t entry = m_neighborOffsets[cell]; entry < m_neighborOffsets[cell + 1]; entry++)
+        {
+            const std::uint32_t neighbor = m_neighbors[entry];
+            if(neighbor > cell)
+            {
+                m_neighborEdges[entry] = static_cast<std::uint32_t>(m_numEdges++);
+                continue;
+            }
+
+            // The neighbor came first, so its entry for this cell already has the edge
+            for(std::uint32_t neighborEntry = m_neighborOffsets[neighbor]; neighborEntry < m_neighborOffsets[neighbor + 1]; neighborEntry++)
+            {
+                if(m_neighbors[neighborEntry] == cell)
+                {
+                    m_neighborEdges[entry] = m_neighborEdges[neighborEntry];
+                    break;
+                }
+            }
+        }
+    }
+
+    m_borderCells.clear();
+    for(std::uint32_t cell = 0; cell < numCells; cell++)
+    {
+        for(int side = 0; side < getNumSides(cell); side++)
+        {
+            if(getSideSlot(cell, side) == BORDER_SIDE)
+            {
+                m_borderCells.push_back(cell);
+                break;
+            }
+        }
+    }
+}
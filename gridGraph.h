@@ -0,0 +1,410 @@
+/*gridGraph.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Grid graph
+ * 
+ * Maze on a square, hexagonal, triangular or polar grid, stored as a graph with
+ * compressed sparse row adjacency
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * GridGraph class
+ * 
+ * Maze on any grid of cells, stored as a graph: each cell lists its neighbors, and each 
+ * pair of neighbors shares one wall, which is open or closed
+ *     Adjacency is compressed sparse rows: the neighbors of every cell sit back to back in 
+ *     one array, cell c owning entries getNeighborOffset(c) up to getNeighborOffset(c + 1), 
+ *     and the edge (wall) of each entry is in a parallel array. Open walls are a bitset 
+ *     indexed by edge, so a step of a walk is two array reads whatever the grid
+ *     build() fills the arrays from the neighbor rules of one topology: square, hexagonal, 
+ *     triangular or polar. Square mazes are still generated and solved as a Maze, which 
+ *     has faster bitplane walls; the square topology here is for code that works on any 
+ *     grid
+ *     Each cell also keeps its outline for drawing, one side per neighbor and one per 
+ *     piece of the maze border, in cell units, see getSideX()
+ * --------------------------------------------------------------------------------------
+*/
+class GridGraph
+{
+public:
+    /**
+     * Integers representing the topologies build() can make
+     *     SQUARE_TOPOLOGY: rows x columns of squares, 4 neighbors each, in the order North, 
+     *     South, East, West like Maze
+     *     HEX_TOPOLOGY: rows x columns of pointy-top hexagons, odd rows shifted half a cell 
+     *     east, 6 neighbors each
+     *     TRIANGLE_TOPOLOGY: rows x columns of triangles, alternately pointing up and down, 
+     *     3 neighbors each
+     *     POLAR_TOPOLOGY: rows rings of cells around a center cell, a ring having twice as 
+     *     many cells as the ring inside it whenever its cells would get twice as wide, 
+     *     columns is ignored
+    */
+    static const int INVALID_TOPOLOGY = -1;
+    static const int SQUARE_TOPOLOGY = 0;
+    static const int HEX_TOPOLOGY = 1;
+    static const int TRIANGLE_TOPOLOGY = 2;
+    static const int POLAR_TOPOLOGY = 3;
+
+    /**
+     * Cell index standing for no cell, e.g. no entrance yet
+    */
+    static const std::uint32_t INVALID_CELL = 0xFFFFFFFF;
+
+    /**
+     * Neighbor slot of a side of a cell's outline that faces the maze border
+    */
+    static const int BORDER_SIDE = -1;
+
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates a graph with no cells, see build()
+     * --------------------------------------------------------------------------------------
+    */
+    GridGraph();
+
+    /**--------------------------------------------------------------------------------------
+     * build()
+     * 
+     * Replaces the graph with an empty maze on the given grid: no entrance, exit or path 
+     * cells, and every wall closed
+     * 
+     * @param[in] topology  Grid to build, see SQUARE_TOPOLOGY
+     * @param[in] numRows   Number of rows, or of rings around the center for POLAR_TOPOLOGY
+     * @param[in] numCols   Number of columns, ignored for POLAR_TOPOLOGY
+     * @return false if the topology is unknown or the grid is empty or too big
+     * --------------------------------------------------------------------------------------
+    */
+    bool build(int topology, int numRows, int numCols);
+
+    /**--------------------------------------------------------------------------------------
+     * reset()
+     * 
+     * Returns the maze to the state build() left it in, keeping the grid and its storage
+     * --------------------------------------------------------------------------------------
+    */
+    void reset();
+
+    /**--------------------------------------------------------------------------------------
+     * topologyFromName() / topologyName()
+     * 
+     * Converts between topologies and the names main() takes with --topology
+     * 
+     * @param[in] name      "square", "hex", "triangle" or "polar"
+     * @param[in] topology  Topology, see SQUARE_TOPOLOGY
+     * @return the topology, INVALID_TOPOLOGY for an unknown name / the name, "invalid" for 
+     * an unknown topology
+     * --------------------------------------------------------------------------------------
+    */
+    static int topologyFromName(const std::string& name);
+    static const char* topologyName(int topology);
+
+    int getTopology() const
+    {
+        return m_topology;
+    }
+
+    std::size_t getNumCells() const
+    {
+        return m_neighborOffsets.size() - 1;
+    }
+
+    std::size_t getNumEdges() const
+    {
+        return m_numEdges;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getNeighborOffset() / getDegree()
+     * 
+     * Returns where a cell's entries start in the neighbor and edge arrays, and how many 
+     * neighbors it has
+     * 
+     * @param[in] cell Index of the cell
+     * --------------------------------------------------------------------------------------
+    */
+    std::size_t getNeighborOffset(std::uint32_t cell) const
+    {
+        return m_neighborOffsets[cell];
+    }
+
+    int getDegree(std::uint32_t cell) const
+    {
+        return static_cast<int>(m_neighborOffsets[cell + 1] - m_neighborOffsets[cell]);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getNeighbor() / getEdge()
+     * 
+     * Returns one of a cell's neighbors, or the edge (wall) between the cell and it
+     * 
+     * @param[in] cell Index of the cell
+     * @param[in] slot Index of the neighbor, from 0 to getDegree() - 1
+     * --------------------------------------------------------------------------------------
+    */
+    std::uint32_t getNeighbor(std::uint32_t cell, int slot) const
+    {
+        return m_neighbors[m_neighborOffsets[cell] + static_cast<std::size_t>(slot)];
+    }
+
+    std::uint32_t getEdge(std::uint32_t cell, int slot) const
+    {
+        return m_neighborEdges[m_neighborOffsets[cell] + static_cast<std::size_t>(slot)];
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * openEdge() / isEdgeOpen() / isPassageOpen()
+     * 
+     * Opens the wall of an edge, checks it, or checks the wall between a cell and one of 
+     * its neighbors
+     * --------------------------------------------------------------------------------------
+    */
+    void openEdge(std::uint32_t edge)
+    {
+        m_openEdges[edge >> 6] |= std::uint64_t(1) << (edge & 63);
+    }
+
+    bool isEdgeOpen(std::uint32_t edge) const
+    {
+        return (m_openEdges[edge >> 6] >> (edge & 63)) & 1;
+    }
+
+    bool isPassageOpen(std::uint32_t cell, int slot) const
+    {
+        return isEdgeOpen(getEdge(cell, slot));
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getBorderCells()
+     * 
+     * Returns the cells with a side on the maze border, where the entrance and exit go
+     * 
+     * @return the cell indices, in increasing order
+     * --------------------------------------------------------------------------------------
+    */
+    const std::vector<std::uint32_t>& getBorderCells() const
+    {
+        return m_borderCells;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * labelEntrance() / labelExit() / getEntrance() / getExit()
+     * 
+     * Labels a cell as the entrance or the exit of the maze, or returns it
+     *     INVALID_CELL until one is labeled
+     * --------------------------------------------------------------------------------------
+    */
+    void labelEntrance(std::uint32_t cell)
+    {
+        m_entrance = cell;
+    }
+
+    void labelExit(std::uint32_t cell)
+    {
+        m_exit = cell;
+    }
+
+    std::uint32_t getEntrance() const
+    {
+        return m_entrance;
+    }
+
+    std::uint32_t getExit() const
+    {
+        return m_exit;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * labelCellAsPath() / isCellOnPath() / clearPath()
+     * 
+     * Labels a cell as part of the path from the maze entrance to the maze exit, checks the 
+     * label, or removes it from every cell
+     * --------------------------------------------------------------------------------------
+    */
+    void labelCellAsPath(std::uint32_t cell)
+    {
+        m_pathBits[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+    }
+
+    bool isCellOnPath(std::uint32_t cell) const
+    {
+        return (m_pathBits[cell >> 6] >> (cell & 63)) & 1;
+    }
+
+    void clearPath();
+
+    /**--------------------------------------------------------------------------------------
+     * getNumSides() / getSideX() / getSideY() / getSideSlot()
+     * 
+     * Returns the outline of a cell, a polygon whose sides go clockwise around the cell
+     *     Side k starts at (getSideX(), getSideY()) and ends where side k + 1 starts, the 
+     *     last side ending where the first one starts
+     *     Coordinates are in cell units from the top left corner of the maze, y pointing down
+     * 
+     * @param[in] cell Index of the cell
+     * @param[in] side Index of the side, from 0 to getNumSides() - 1
+     * @return the number of sides / the start of the side / the neighbor slot the side is 
+     * shared with, or BORDER_SIDE
+     * --------------------------------------------------------------------------------------
+    */
+    int getNumSides(std::uint32_t cell) const
+    {
+        return static_cast<int>(m_sideOffsets[cell + 1] - m_sideOffsets[cell]);
+    }
+
+    float getSideX(std::uint32_t cell, int side) const
+    {
+        return m_sideX[m_sideOffsets[cell] + static_cast<std::size_t>(side)];
+    }
+
+    float getSideY(std::uint32_t cell, int side) const
+    {
+        return m_sideY[m_sideOffsets[cell] + static_cast<std::size_t>(side)];
+    }
+
+    int getSideSlot(std::uint32_t cell, int side) const
+    {
+        return m_sideSlots[m_sideOffsets[cell] + static_cast<std::size_t>(side)];
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getCenterX() / getCenterY()
+     * 
+     * Returns the center of a cell, in the same units as its outline
+     * --------------------------------------------------------------------------------------
+    */
+    float getCenterX(std::uint32_t cell) const
+    {
+        return m_centerX[cell];
+    }
+
+    float getCenterY(std::uint32_t cell) const
+    {
+        return m_centerY[cell];
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getWidth() / getHeight()
+     * 
+     * Returns the size of the box around every cell outline, in cell units
+     * --------------------------------------------------------------------------------------
+    */
+    double getWidth() const
+    {
+        return m_width;
+    }
+
+    double getHeight() const
+    {
+        return m_height;
+    }
+
+private:
+    /**--------------------------------------------------------------------------------------
+     * buildSquare() / buildHex() / buildTriangle() / buildPolar()
+     * 
+     * Add every cell of one topology, with its neighbors and outline, see addCell()
+     * --------------------------------------------------------------------------------------
+    */
+    void buildSquare(int numRows, int numCols);
+    void buildHex(int numRows, int numCols);
+    void buildTriangle(int numRows, int numCols);
+    void buildPolar(int numRings);
+
+    /**--------------------------------------------------------------------------------------
+     * addNeighbor() / addSide() / addCell()
+     * 
+     * Add the neighbors and the sides of the next cell, then the cell itself with its center
+     *     Neighbors with a lower index than the cell must list it too, the edges are numbered 
+     *     from those pairs by finishEdges()
+     * 
+     * @param[in] neighbor  Index of the neighbor
+     * @param[in] x, y      Start of the side
+     * @param[in] slot      Neighbor slot the side is shared with, or BORDER_SIDE
+     * --------------------------------------------------------------------------------------
+    */
+    void addNeighbor(std::uint32_t neighbor);
+    void addSide(double x, double y, int slot);
+    void addCell(double centerX, double centerY);
+
+    /**--------------------------------------------------------------------------------------
+     * finishEdges()
+     * 
+     * Numbers the edges, giving both entries of a pair of neighbors the same edge, and 
+     * lists the border cells
+     * --------------------------------------------------------------------------------------
+    */
+    void finishEdges();
+
+    int m_topology;
+    std::size_t m_numEdges;
+    double m_width;
+    double m_height;
+
+    /**
+     * Adjacency, compressed sparse rows
+     *     m_neighborOffsets: start of each cell's entries, one more entry than cells
+     *     m_neighbors: neighbor of each entry
+     *     m_neighborEdges: edge of each entry, both entries of a pair share it
+    */
+    std::vector<std::uint32_t> m_neighborOffsets;
+    std::vector<std::uint32_t> m_neighbors;
+    std::vector<std::uint32_t> m_neighborEdges;
+
+    /**
+     * Maze state
+     *     m_openEdges: one bit per edge, set if its wall is open
+     *     m_pathBits: one bit per cell, set if the cell is labeled as part of the path
+    */
+    std::vector<std::uint64_t> m_openEdges;
+    std::vector<std::uint64_t> m_pathBits;
+    std::vector<std::uint32_t> m_borderCells;
+    std::uint32_t m_entrance;
+    std::uint32_t m_exit;
+
+    /**
+     * Outlines for drawing, compressed sparse rows like the adjacency, only read by renderers
+     *     m_sideOffsets: start of each cell's sides, one more entry than cells
+     *     m_sideX, m_sideY: start of each side
+     *     m_sideSlots: neighbor slot of each side, or BORDER_SIDE
+     *     m_centerX, m_centerY: center of each cell
+    */
+    std::vector<std::uint32_t> m_sideOffsets;
+    std::vector<float> m_sideX;
+    std::vector<float> m_sideY;
+    std::vector<std::int8_t> m_sideSlots;
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+};
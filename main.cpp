@@ -33,168 +33,1003 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <stdlib.h>
 
+#include "batch.h"
+#include "eller.h"
+#include "gridGraph.h"
 #include "maze.h"
-#include "wilson.h"
+#include "mazeGenerators.h"
+#include "mazeReader.h"
+#include "mazeRenderer.h"
+#include "mazeSizing.h"
+#include "mazeSolver.h"
+#include "mazeTiles.h"
+#include "mazeWriter.h"
+#include "rng.h"
 #include "tremaux.h"
+#include "wilson.h"
 #include "logger.h"
 
+// Memory budget of --out-of-core when --memory is not given
+const std::uint64_t DEFAULT_MEMORY_BUDGET_MIB = 64;
+
+/**
+ * Options given to main() on the command line
+ *     numRows, numCols: number of rows and columns in the maze, numCols is numRows unless given, 
+ *     with --load only given for the grid of png images, 0 to find it
+ *     hasSeed, seed: seed for the random number engine, if the user supplied one with --seed
+ *     numMazes: number of mazes to generate in batch mode (--count), 0 for a single maze
+ *     hasMazeIndex, mazeIndex: generate the single maze as maze mazeIndex of a batch with the same 
+ *     seed would (--maze-index), see makeStreamEngine()
+ *     numThreads: number of threads in batch mode or with --parallel (--threads), 0 for one per core
+ *     solverType: solver engine used to find the path (--solver), see MazeSolver
+ *     generatorType: generator filling out the maze (--generator), see mazeGenerators.h, --parallel
+ *     is short for --generator parallel, which runs runParallelWilson() on numThreads threads
+ *     topology: grid of the maze (--topology), see GridGraph. Square mazes are a Maze, every other 
+ *     topology is a GridGraph generated with Wilson's Algorithm, solved with Tremaux's Algorithm 
+ *     and only drawn as svg images, see runGridGraphMaze()
+ *     hasAldousBroderFraction, aldousBroderFraction: fraction of the cells --generator hybrid adds 
+ *     with the Aldous-Broder Algorithm before switching to Wilson's Algorithm, if the user supplied 
+ *     one with --aldous-broder
+ *     isOutOfCore, memoryBudgetMiB: stream a single maze to disk with runStreamingEller() instead,
+ *     in at most memoryBudgetMiB MiB of memory (--out-of-core, --memory)
+ *     outputPrefix: prefix of the shard files written in batch mode (--output)
+ *     loadPath, isLoadDirectory: maze file to load and solve instead of generating a maze, or 
+ *     directory of maze files to load and solve like a batch (--load), see MazeReader
+ *     isPipelined: run batch mode as a pipeline of generator, solver and writer stages, writing 
+ *     one file (--pipeline), see runPipelinedBatch()
+ *     outputFormat: format of the maze data written (--format), see mazeWriter.h
+ *     writeToStdout: write the maze data to stdout instead of to mazeData.csv or mazeData.mzb (--stdout)
+ *     isRendered, renderFormat: also draw the unsolved and solved maze images (--render), see mazeRenderer.h
+ *     tileDirectory: directory to draw a pyramid of png tiles to (--tiles), empty for none, see mazeTiles.h
+ *     asciiFileName: file to draw the solved maze to as text (--ascii), "-" for stdout, empty for none
+ *     cellSize: pixels per cell in the images (--cell-size), 0 for defaultRenderCellSize(), or 
+ *     DEFAULT_TILE_CELL_SIZE for the deepest level of the tiles
+*/
+struct MazeOptions
+{
+    int numRows = 0;
+    int numCols = 0;
+    bool hasSeed = false;
+    std::uint64_t seed = 0;
+    std::uint64_t numMazes = 0;
+    bool hasMazeIndex = false;
+    std::uint64_t mazeIndex = 0;
+    int numThreads = 0;
+    int solverType = MazeSolver::TREMAUX_SOLVER;
+    int generatorType = MAZE_GENERATOR_WILSON;
+    int topology = GridGraph::SQUARE_TOPOLOGY;
+    bool hasAldousBroderFraction = false;
+    double aldousBroderFraction = DEFAULT_ALDOUS_BRODER_FRACTION;
+    bool isOutOfCore = false;
+    std::uint64_t memoryBudgetMiB = DEFAULT_MEMORY_BUDGET_MIB;
+    std::string outputPrefix = "mazeBatch";
+    std::string loadPath;
+    bool isLoadDirectory = false;
+    bool isPipelined = false;
+    int outputFormat = MAZE_FORMAT_CSV;
+    bool writeToStdout = false;
+    bool isRendered = false;
+    int renderFormat = MAZE_RENDER_SVG;
+    std::string tileDirectory;
+    std::string asciiFileName;
+    int cellSize = 0;
+};
+
+// Pixels per cell at the deepest level of the tiles when --cell-size is not given
+const int DEFAULT_TILE_CELL_SIZE = 8;
+
+// Rows and columns of a Maze are ints, the number of cells is not limited to an int
+const std::uint64_t MAX_MAZE_SIDE = 0x7FFFFFFF;
+
+// Estimated run time past which main() warns before starting
+const double LONG_RUN_SECONDS = 60.0;
+
 /**--------------------------------------------------------------------------------------
- * writeMazeDataCSV()
+ * parseUnsigned()
  * 
- * Write the completed and solved maze data to a csv file
+ * Parses a non-negative integer command line value, reporting an error if it is not one
  * 
- * @param[in,out]   outfile     Csv file to be modified, filled with solved maze information
- * @param[in]       solvedMaze  Maze object with path from entrance to exit
+ * @param[in]   optionName  Name of the option the value belongs to, used in the error
+ * @param[in]   text        Text of the value
+ * @param[out]  value       Parsed value
+ * @return true if the text is not a non-negative integer
  * --------------------------------------------------------------------------------------
 */
-void writeMazeDataCSV(std::fstream& outfile, Maze& solvedMaze)
+bool parseUnsigned(const std::string& optionName, const char* text, std::uint64_t& value)
 {
-    outfile << solvedMaze.getROWCELLS() << "," << solvedMaze.getCOLCELLS() << ",\n";
-    std::tuple<int, int> entranceCoords = solvedMaze.getEntrance();
-    int entranceRow = std::get<0>(entranceCoords);
-    int entranceCol = std::get<1>(entranceCoords);
-
-    std::tuple<int, int> exitCoords = solvedMaze.getExit();
-    int exitRow = std::get<0>(exitCoords);
-    int exitCol = std::get<1>(exitCoords);
+    char* parseEnd = nullptr;
+    value = std::strtoull(text, &parseEnd, 10);
 
-    std::map<std::tuple<int, int, int, int>, Wall>& neighborsToWallsMap = solvedMaze.getWallsMap();
+    if(parseEnd == text || *parseEnd != '\0' || text[0] == '-')
+    {
+        std::cerr << "ERROR: " << optionName << " must be a non-negative integer: " << text << std::endl;
+        return true;
+    }
+    return false;
+}
 
-    for(int row = 0; row < solvedMaze.getROWCELLS(); row++)
+/**--------------------------------------------------------------------------------------
+ * printUsage()
+ * 
+ * Checks if the arguments is passed to main() are correct/usable, and fills out the 
+ * options they describe
+ *     Usage: main.exe <rows> [<columns>] [--seed <seed>] [--solver <tremaux|bfs|bidirectional|deadend|bitboard>] [--threads <threads>] [--generator <wilson|parallel|eller|sidewinder|kruskal|backtracker|hybrid> [--aldous-broder <fraction>]] [--topology <square|hex|triangle|polar>] [--format <csv|binary>] [--render <svg|png>] [--tiles <directory>] [--cell-size <pixels>] [--ascii <file>] [--parallel | --out-of-core [--memory <MiB>]] [--stdout | --maze-index <index> | --count <mazes> [--output <prefix>] [--pipeline]]
+ *     Usage: main.exe [<rows> [<columns>]] --load <file|directory> [--solver <tremaux|bfs|bidirectional|deadend|bitboard>] [--threads <threads>] [--format <csv|binary>] [--output <prefix>] [--render <svg|png>] [--tiles <directory>] [--cell-size <pixels>] [--ascii <file>] [--stdout]
+ * 
+ * @param[in]   argc    Number of arguments passed
+ * @param[in]   argv    String vector of arguments passed
+ * @param[out]  options Options parsed from the arguments
+ * @return true if the overall program should be terminated
+ * --------------------------------------------------------------------------------------
+*/
+bool printUsage(int argc, const char** argv, MazeOptions& options)
+{
+    bool shouldTerminate = false;
+    int firstOption = 2;
+    if(argc < 2)
     {
-        std::string rowData = "";
+        std::cerr << "ERROR: Incorrect number of arguments passed to main()" << std::endl;
+        shouldTerminate = true;
+    }
+    else
+    {
+        std::uint64_t numRows = 0;
+        std::uint64_t numCols = 0;
+
+        // Loaded mazes have their own size, it is only given for the grid of png images
+        const bool hasSize = argv[1][0] != '-';
+        if(hasSize)
+        {
+            shouldTerminate = parseUnsigned("Number of rows", argv[1], numRows);
+        }
+        else
+        {
+            firstOption = 1;
+        }
 
-        for(int col = 0; col < solvedMaze.getCOLCELLS(); col++)
+        // A second number gives the columns, otherwise the maze is square
+        if(hasSize && !shouldTerminate && argc > 2 && argv[2][0] != '-')
+        {
+            shouldTerminate = parseUnsigned("Number of columns", argv[2], numCols);
+            firstOption = 3;
+        }
+        else
         {
-            // Cells
-            if(row == entranceRow && col == entranceCol)
+            numCols = numRows;
+        }
+
+        if(hasSize && !shouldTerminate)
+        {
+            if(numRows < 1 || numCols < 1)
             {
-                rowData += "CellEntrance";
+                std::cerr << "ERROR: Number of cells is too low" << std::endl;
+                shouldTerminate = true;
             }
-            else if(row == exitRow && col == exitCol)
+            else if(numRows > MAX_MAZE_SIDE || numCols > MAX_MAZE_SIDE)
             {
-                rowData += "CellExit";
+                std::cerr << "ERROR: Number of rows and number of columns must each be at most " << MAX_MAZE_SIDE << std::endl;
+                shouldTerminate = true;
             }
-            else if(solvedMaze.findCell(row, col).isCellOnPath())
+            else if(numRows < 3 || numCols < 3)
             {
-                rowData += "CellPath";
+                std::cerr << "WARNING: Maze may be too small to be of value" << std::endl;
             }
-            else
+            options.numRows = static_cast<int>(std::min(numRows, MAX_MAZE_SIDE));
+            options.numCols = static_cast<int>(std::min(numCols, MAX_MAZE_SIDE));
+        }
+
+        for(int i = firstOption; i < argc && !shouldTerminate; i++)
+        {
+            std::string arg = argv[i];
+            if(arg == "--seed" && i + 1 < argc)
             {
-                rowData += "CellRegular";
+                shouldTerminate = parseUnsigned("Seed", argv[i + 1], options.seed);
+                options.hasSeed = true;
+                i++;
             }
-
-            // Horizontal walls
-            auto horizWallIter = neighborsToWallsMap.find(std::make_tuple(row, col, row + 1, col));
-            if(horizWallIter != neighborsToWallsMap.end()){
-                if(!horizWallIter->second.checkIsOpen()){ // South wall is closed
-                    rowData += "S";
+            else if(arg == "--count" && i + 1 < argc)
+            {
+                shouldTerminate = parseUnsigned("Count", argv[i + 1], options.numMazes);
+                if(!shouldTerminate && options.numMazes == 0)
+                {
+                    std::cerr << "ERROR: Count must be at least 1" << std::endl;
+                    shouldTerminate = true;
                 }
+                i++;
             }
-
-            // Vertical walls
-            auto vertWallIter = neighborsToWallsMap.find(std::make_tuple(row, col, row, col + 1));
-            if(vertWallIter != neighborsToWallsMap.end()){
-                if(!vertWallIter->second.checkIsOpen()){  // East wall is closed
-                    rowData += "E,";
+            else if(arg == "--maze-index" && i + 1 < argc)
+            {
+                shouldTerminate = parseUnsigned("Maze index", argv[i + 1], options.mazeIndex);
+                options.hasMazeIndex = true;
+                i++;
+            }
+            else if(arg == "--threads" && i + 1 < argc)
+            {
+                std::uint64_t numThreads = 0;
+                shouldTerminate = parseUnsigned("Threads", argv[i + 1], numThreads);
+                if(!shouldTerminate && (numThreads == 0 || numThreads > 1024))
+                {
+                    std::cerr << "ERROR: Threads must be between 1 and 1024" << std::endl;
+                    shouldTerminate = true;
+                }
+                options.numThreads = static_cast<int>(numThreads);
+                i++;
+            }
+            else if(arg == "--solver" && i + 1 < argc)
+            {
+                options.solverType = MazeSolver::solverTypeFromName(argv[i + 1]);
+                if(options.solverType == MazeSolver::INVALID_SOLVER)
+                {
+                    std::cerr << "ERROR: Unrecognized solver: " << argv[i + 1] << std::endl;
+                    shouldTerminate = true;
+                }
+                i++;
+            }
+            else if(arg == "--format" && i + 1 < argc)
+            {
+                std::string format = argv[i + 1];
+                if(format == "csv")
+                {
+                    options.outputFormat = MAZE_FORMAT_CSV;
+                }
+                else if(format == "binary")
+                {
+                    options.outputFormat = MAZE_FORMAT_BINARY;
+                }
+                else
+                {
+                    std::cerr << "ERROR: Unrecognized format: " << format << std::endl;
+                    shouldTerminate = true;
+                }
+                i++;
+            }
+            else if(arg == "--render" && i + 1 < argc)
+            {
+                std::string format = argv[i + 1];
+                options.isRendered = true;
+                if(format == "svg")
+                {
+                    options.renderFormat = MAZE_RENDER_SVG;
+                }
+                else if(format == "png")
+                {
+                    options.renderFormat = MAZE_RENDER_PNG;
+                }
+                else
+                {
+                    std::cerr << "ERROR: Unrecognized image format: " << format << std::endl;
+                    shouldTerminate = true;
                 }
-                else                                      // East wall is open
+                i++;
+            }
+            else if(arg == "--tiles" && i + 1 < argc)
+            {
+                options.tileDirectory = argv[i + 1];
+                i++;
+            }
+            else if(arg == "--ascii" && i + 1 < argc)
+            {
+                options.asciiFileName = argv[i + 1];
+                i++;
+            }
+            else if(arg == "--cell-size" && i + 1 < argc)
+            {
+                std::uint64_t cellSize = 0;
+                shouldTerminate = parseUnsigned("Cell size", argv[i + 1], cellSize);
+                if(!shouldTerminate && (cellSize < 2 || cellSize > 1024))
+                {
+                    std::cerr << "ERROR: Cell size must be between 2 and 1024" << std::endl;
+                    shouldTerminate = true;
+                }
+                options.cellSize = static_cast<int>(cellSize);
+                i++;
+            }
+            else if(arg == "--generator" && i + 1 < argc)
+            {
+                options.generatorType = mazeGeneratorFromName(argv[i + 1]);
+                if(options.generatorType == MAZE_GENERATOR_INVALID)
+                {
+                    std::cerr << "ERROR: Unrecognized generator: " << argv[i + 1] << std::endl;
+                    shouldTerminate = true;
+                }
+                i++;
+            }
+            else if(arg == "--topology" && i + 1 < argc)
+            {
+                options.topology = GridGraph::topologyFromName(argv[i + 1]);
+                if(options.topology == GridGraph::INVALID_TOPOLOGY)
+                {
+                    std::cerr << "ERROR: Unrecognized topology: " << argv[i + 1] << std::endl;
+                    shouldTerminate = true;
+                }
+                i++;
+            }
+            else if(arg == "--aldous-broder" && i + 1 < argc)
+            {
+                char* parseEnd = nullptr;
+                options.aldousBroderFraction = std::strtod(argv[i + 1], &parseEnd);
+                options.hasAldousBroderFraction = true;
+                if(parseEnd == argv[i + 1] || *parseEnd != '\0' || !(options.aldousBroderFraction >= 0.0 && options.aldousBroderFraction <= 1.0))
+                {
+                    std::cerr << "ERROR: Aldous-Broder fraction must be between 0 and 1: " << argv[i + 1] << std::endl;
+                    shouldTerminate = true;
+                }
+                i++;
+            }
+            else if(arg == "--parallel")
+            {
+                options.generatorType = MAZE_GENERATOR_PARALLEL_WILSON;
+            }
+            else if(arg == "--out-of-core")
+            {
+                options.isOutOfCore = true;
+            }
+            else if(arg == "--memory" && i + 1 < argc)
+            {
+                shouldTerminate = parseUnsigned("Memory budget", argv[i + 1], options.memoryBudgetMiB);
+                if(!shouldTerminate && (options.memoryBudgetMiB < 1 || options.memoryBudgetMiB > (std::uint64_t(1) << 30)))
                 {
-                    rowData += ",";
+                    std::cerr << "ERROR: Memory budget must be between 1 and " << (std::uint64_t(1) << 30) << " MiB" << std::endl;
+                    shouldTerminate = true;
                 }
+                i++;
+            }
+            else if(arg == "--stdout")
+            {
+                options.writeToStdout = true;
+            }
+            else if(arg == "--pipeline")
+            {
+                options.isPipelined = true;
+            }
+            else if(arg == "--output" && i + 1 < argc)
+            {
+                options.outputPrefix = argv[i + 1];
+                i++;
+            }
+            else if(arg == "--load" && i + 1 < argc)
+            {
+                options.loadPath = argv[i + 1];
+                i++;
+            }
+            else
+            {
+                std::cerr << "ERROR: Unrecognized argument passed to main(): " << arg << std::endl;
+                shouldTerminate = true;
             }
         }
-        
-        rowData += ",";
-        
-        if(row < solvedMaze.getROWCELLS() - 1)
+    }
+
+    if(!shouldTerminate && options.numRows == 0 && options.loadPath.empty())
+    {
+        std::cerr << "ERROR: Number of rows is missing" << std::endl;
+        shouldTerminate = true;
+    }
+
+    // Loaded mazes are only solved, a directory of them like a batch
+    if(!shouldTerminate && !options.loadPath.empty())
+    {
+        std::error_code pathError;
+        options.isLoadDirectory = std::filesystem::is_directory(options.loadPath, pathError);
+        if(options.hasSeed || options.hasMazeIndex || options.numMazes > 0 || options.isOutOfCore || options.isPipelined || \
+           options.generatorType != MAZE_GENERATOR_WILSON || options.hasAldousBroderFraction || options.topology != GridGraph::SQUARE_TOPOLOGY)
         {
-            rowData += "\n";
+            std::cerr << "ERROR: --load solves mazes made elsewhere, it cannot be combined with --seed, --maze-index, --count, --out-of-core, --pipeline, --generator, --parallel, --aldous-broder or --topology" << std::endl;
+            shouldTerminate = true;
         }
+        else if(options.isLoadDirectory && (options.isRendered || options.writeToStdout || !options.asciiFileName.empty() || !options.tileDirectory.empty()))
+        {
+            std::cerr << "ERROR: --load <directory> writes the solved mazes to shard files, it cannot be combined with --render, --stdout, --ascii or --tiles" << std::endl;
+            shouldTerminate = true;
+        }
+    }
 
-        outfile << rowData;
+    if(!shouldTerminate && options.generatorType == MAZE_GENERATOR_PARALLEL_WILSON && options.numMazes > 0)
+    {
+        std::cerr << "ERROR: --parallel cannot be combined with --count" << std::endl;
+        shouldTerminate = true;
     }
-}
 
-/**--------------------------------------------------------------------------------------
- * printUsage()
- * 
- * Checks if the arguments is passed to main() are correct/usable
- * 
- * @param[in] argc Number of arguments passed
- * @param[in] argv String vector of arguments passed
- * @return true if the overall program should be terminated
- * --------------------------------------------------------------------------------------
-*/
-bool printUsage(int argc, const char** argv)
-{
-    bool shouldTerminate = false;
-    int numRows = 0;
-    if(argc != 2)
+    if(!shouldTerminate && options.hasAldousBroderFraction && options.generatorType != MAZE_GENERATOR_HYBRID_WILSON)
     {
-        std::cerr << "ERROR: Incorrect number of arguments passed to main()" << std::endl;
+        std::cerr << "ERROR: --aldous-broder only works with --generator hybrid" << std::endl;
         shouldTerminate = true;
     }
-    else
+
+    if(!shouldTerminate && options.isRendered && options.numMazes > 0)
+    {
+        std::cerr << "ERROR: --render cannot be combined with --count" << std::endl;
+        shouldTerminate = true;
+    }
+
+    if(!shouldTerminate && options.writeToStdout && options.numMazes > 0)
+    {
+        std::cerr << "ERROR: --stdout cannot be combined with --count" << std::endl;
+        shouldTerminate = true;
+    }
+
+    if(!shouldTerminate && options.hasMazeIndex && (options.numMazes > 0 || options.isOutOfCore))
+    {
+        std::cerr << "ERROR: --maze-index cannot be combined with --count or --out-of-core" << std::endl;
+        shouldTerminate = true;
+    }
+
+    if(!shouldTerminate && options.isPipelined && options.numMazes == 0)
+    {
+        std::cerr << "ERROR: --pipeline only works with --count" << std::endl;
+        shouldTerminate = true;
+    }
+
+    // Other grids only have Wilson's and Tremaux's Algorithms and svg images so far
+    if(!shouldTerminate && options.topology != GridGraph::SQUARE_TOPOLOGY)
     {
-        numRows = atoi(argv[1]);
+        if(options.generatorType != MAZE_GENERATOR_WILSON || options.solverType != MazeSolver::TREMAUX_SOLVER || options.outputFormat != MAZE_FORMAT_CSV ||
+           (options.isRendered && options.renderFormat != MAZE_RENDER_SVG) || options.writeToStdout || !options.asciiFileName.empty() ||
+           !options.tileDirectory.empty() || options.isOutOfCore || options.numMazes > 0)
+        {
+            std::cerr << "ERROR: --topology " << GridGraph::topologyName(options.topology) << " only works with the wilson generator, the tremaux solver and svg images, "
+                      << "it cannot be combined with another --generator or --solver, --format, --render png, --stdout, --ascii, --tiles, --out-of-core or --count" << std::endl;
+            shouldTerminate = true;
+        }
+    }
 
-        if(numRows < 1)
+    // Text drawings are only made of the single maze in memory
+    if(!shouldTerminate && !options.asciiFileName.empty())
+    {
+        if(options.isOutOfCore || options.numMazes > 0)
+        {
+            std::cerr << "ERROR: --ascii cannot be combined with --out-of-core or --count" << std::endl;
+            shouldTerminate = true;
+        }
+        else if(options.asciiFileName == "-" && options.writeToStdout)
         {
-            std::cerr << "ERROR: Number of cells is too low" << std::endl;
+            std::cerr << "ERROR: --ascii - cannot be combined with --stdout, the maze data is already written to stdout" << std::endl;
             shouldTerminate = true;
         }
-        else if(numRows < 3)
+    }
+
+    // Out-of-core mazes never exist in memory, they are only ever written as binary records
+    if(!shouldTerminate && options.isOutOfCore)
+    {
+        if(options.outputFormat != MAZE_FORMAT_BINARY)
         {
-            std::cout << "WARNING: Maze may be too small to be of value" << std::endl;
+            std::cerr << "ERROR: --out-of-core needs --format binary" << std::endl;
+            shouldTerminate = true;
         }
-        else if(numRows >= 100)
+        else if((options.generatorType != MAZE_GENERATOR_WILSON && options.generatorType != MAZE_GENERATOR_ELLER) || options.isRendered || options.numMazes > 0)
         {
-            std::cout << "WARNING: Maze will be big, from here on out SVG quality may decrease and program may take a long time to complete" << std::endl;
+            std::cerr << "ERROR: --out-of-core always uses Eller's algorithm, it cannot be combined with another --generator, --parallel, --render or --count" << std::endl;
+            shouldTerminate = true;
         }
     }
 
+    // Tiles are drawn from the mapped mazeData.mzb, so never from stdout or a batch
+    if(!shouldTerminate && !options.tileDirectory.empty())
+    {
+        if(options.outputFormat != MAZE_FORMAT_BINARY)
+        {
+            std::cerr << "ERROR: --tiles needs --format binary" << std::endl;
+            shouldTerminate = true;
+        }
+        else if(options.writeToStdout || options.numMazes > 0)
+        {
+            std::cerr << "ERROR: --tiles cannot be combined with --stdout or --count" << std::endl;
+            shouldTerminate = true;
+        }
+        else if((options.cellSize & (options.cellSize - 1)) != 0)
+        {
+            std::cerr << "ERROR: Cell size must be a power of 2 with --tiles" << std::endl;
+            shouldTerminate = true;
+        }
+    }
+
+    if(shouldTerminate)
+    {
+        std::cerr << "Usage: main.exe <rows> [<columns>] [--seed <seed>] [--solver <tremaux|bfs|bidirectional|deadend|bitboard>] [--threads <threads>] [--generator <wilson|parallel|eller|sidewinder|kruskal|backtracker|hybrid> [--aldous-broder <fraction>]] [--topology <square|hex|triangle|polar>] [--format <csv|binary>] [--render <svg|png>] [--tiles <directory>] [--cell-size <pixels>] [--ascii <file>] [--parallel | --out-of-core [--memory <MiB>]] [--stdout | --maze-index <index> | --count <mazes> [--output <prefix>] [--pipeline]]" << std::endl;
+        std::cerr << "       main.exe [<rows> [<columns>]] --load <file|directory> [--solver <tremaux|bfs|bidirectional|deadend|bitboard>] [--threads <threads>] [--format <csv|binary>] [--output <prefix>] [--render <svg|png>] [--tiles <directory>] [--cell-size <pixels>] [--ascii <file>] [--stdout]" << std::endl;
+    }
+
     return shouldTerminate;
 }
 
+/**--------------------------------------------------------------------------------------
+ * drawMazeTiles()
+ * 
+ * Draws the tiles asked for with --tiles from mazeData.mzb, see renderMazeTiles()
+ * 
+ * @param[in]       options     Options parsed from the arguments
+ * @param[in]       numThreads  Number of threads to draw the tiles on
+ * @param[in,out]   infoStream  Stream to report progress to
+ * @return true if no tiles were asked for, or if every tile was drawn
+ * --------------------------------------------------------------------------------------
+*/
+bool drawMazeTiles(const MazeOptions& options, int numThreads, std::ostream& infoStream)
+{
+    if(options.tileDirectory.empty())
+    {
+        return true;
+    }
+
+    MappedMaze mappedMaze;
+    if(!mappedMaze.open("mazeData.mzb"))
+    {
+        return false;
+    }
+
+    auto tilesStart = std::chrono::steady_clock::now();
+    int cellSize = (options.cellSize > 0) ? options.cellSize : DEFAULT_TILE_CELL_SIZE;
+    if(!renderMazeTiles(mappedMaze, options.tileDirectory, cellSize, numThreads))
+    {
+        return false;
+    }
+    std::chrono::duration<double> tilesTime = std::chrono::steady_clock::now() - tilesStart;
+    infoStream << "Drew the tiles to " << options.tileDirectory << " using " << numThreads << " threads in " << tilesTime.count() << " s" << std::endl;
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * makeRenderFileNames()
+ * 
+ * Names the unsolved and solved images after the current time, like the ones 
+ * maze_img_displayer.py draws
+ * 
+ * @param[in]   extension           Extension of the images, with its dot
+ * @param[out]  unsolvedFileName    Name of the image without the path
+ * @param[out]  solvedFileName      Name of the image with the path
+ * --------------------------------------------------------------------------------------
+*/
+void makeRenderFileNames(const std::string& extension, std::string& unsolvedFileName, std::string& solvedFileName)
+{
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H-%M-%S", std::localtime(&now));
+    unsolvedFileName = std::string("maze_") + timestamp + extension;
+    solvedFileName = std::string("maze_with_exit_path_") + timestamp + extension;
+}
+
+/**--------------------------------------------------------------------------------------
+ * runGridGraphMaze()
+ * 
+ * Generates, solves and draws a maze on a grid other than squares, with --topology
+ *     Generated with Wilson's Algorithm and solved with Tremaux's Algorithm on a GridGraph, 
+ *     then drawn as svg images with --render svg. There is no maze data file for these grids
+ * 
+ * @param[in]       options     Options parsed from the arguments
+ * @param[in,out]   rng         Random number engine driving the generator
+ * @param[in,out]   infoStream  Stream to report progress to
+ * @return true if the maze was generated and solved, and drawn if asked for
+ * --------------------------------------------------------------------------------------
+*/
+bool runGridGraphMaze(const MazeOptions& options, DefaultRng& rng, std::ostream& infoStream)
+{
+    GridGraph mainGraph;
+    if(!mainGraph.build(options.topology, options.numRows, options.numCols))
+    {
+        return false;
+    }
+
+    runWilson(mainGraph, rng);
+    LOG_DEBUG("Generator wilson Finished")
+    if(mainGraph.getEntrance() == GridGraph::INVALID_CELL)
+    {
+        return false;
+    }
+
+    if(!runTremaux(mainGraph))
+    {
+        std::cerr << "ERROR: Solver did not find a path from the maze entrance to the maze exit" << std::endl;
+        return false;
+    }
+    LOG_DEBUG("Solver Finished")
+    infoStream << "Generated and solved a " << GridGraph::topologyName(options.topology) << " maze of " << mainGraph.getNumCells() << " cells" << std::endl;
+
+    if(options.isRendered)
+    {
+        std::string unsolvedFileName;
+        std::string solvedFileName;
+        makeRenderFileNames(".svg", unsolvedFileName, solvedFileName);
+        int cellSize = (options.cellSize > 0) ? options.cellSize : defaultRenderCellSize(mainGraph);
+
+        if(!renderGridGraphImages(mainGraph, unsolvedFileName, solvedFileName, cellSize))
+        {
+            return false;
+        }
+        infoStream << "Drew " << unsolvedFileName << " and " << solvedFileName << std::endl;
+    }
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * isShardFileName()
+ * 
+ * Checks if a file is one of the shard files "<outputPrefix>_<worker>" with the extension 
+ * of the output format, so solving a directory does not load the mazes it solved before
+ * 
+ * @param[in] fileName      File to check
+ * @param[in] outputPrefix  Prefix of the shard files
+ * @param[in] outputFormat  Format of the shard files, MAZE_FORMAT_CSV or MAZE_FORMAT_BINARY
+ * @return true if the file is a shard file
+ * --------------------------------------------------------------------------------------
+*/
+bool isShardFileName(const std::string& fileName, const std::string& outputPrefix, int outputFormat)
+{
+    std::error_code pathError;
+    const std::filesystem::path filePath = std::filesystem::absolute(fileName, pathError).lexically_normal();
+    const std::filesystem::path prefixPath = std::filesystem::absolute(outputPrefix, pathError).lexically_normal();
+    if(pathError || filePath.parent_path() != prefixPath.parent_path())
+    {
+        return false;
+    }
+
+    const std::string name = filePath.filename().string();
+    const std::string start = prefixPath.filename().string() + "_";
+    const std::string extension = mazeFormatExtension(outputFormat);
+    if(name.size() <= start.size() + extension.size() || name.compare(0, start.size(), start) != 0 || \
+       name.compare(name.size() - extension.size(), extension.size(), extension) != 0)
+    {
+        return false;
+    }
+    return std::all_of(name.begin() + start.size(), name.end() - extension.size(), [](unsigned char letter) { return std::isdigit(letter) != 0; });
+}
+
+/**--------------------------------------------------------------------------------------
+ * solveMazeDirectory()
+ * 
+ * Loads and solves every maze file of the directory given with --load, spread across the 
+ * worker threads, see runLoadedBatch()
+ * 
+ * @param[in]       options     Options parsed from the arguments
+ * @param[in]       numThreads  Number of worker threads, fewer if there are fewer files
+ * @param[in,out]   infoStream  Stream to report progress to
+ * @return true if every maze of every file was loaded and solved
+ * --------------------------------------------------------------------------------------
+*/
+bool solveMazeDirectory(const MazeOptions& options, int numThreads, std::ostream& infoStream)
+{
+    std::vector<std::string> fileNames;
+    if(!listMazeFiles(options.loadPath, fileNames))
+    {
+        return false;
+    }
+    fileNames.erase(std::remove_if(fileNames.begin(), fileNames.end(), [&options](const std::string& fileName) \
+                    { return isShardFileName(fileName, options.outputPrefix, options.outputFormat); }), fileNames.end());
+    if(fileNames.empty())
+    {
+        std::cerr << "ERROR: Found no .csv, .mzb or .png maze files in " << options.loadPath << std::endl;
+        return false;
+    }
+
+    // A worker loads whole files, more workers than files would only write empty shards
+    numThreads = std::max(1, std::min(numThreads, static_cast<int>(std::min<std::size_t>(fileNames.size(), 1024))));
+
+    auto batchStart = std::chrono::steady_clock::now();
+    std::uint64_t numFailed = 0;
+    std::uint64_t numWritten = runLoadedBatch(fileNames, numThreads, options.numRows, options.numCols, options.solverType, options.outputPrefix, options.outputFormat, numFailed);
+    std::chrono::duration<double> batchTime = std::chrono::steady_clock::now() - batchStart;
+
+    infoStream << "Solved " << numWritten << " mazes of " << fileNames.size() << " files to " << options.outputPrefix << "_<0-" << (numThreads - 1) \
+               << ">" << mazeFormatExtension(options.outputFormat) << " using " << numThreads << " threads in " << batchTime.count() << " s" << std::endl;
+    if(numFailed > 0)
+    {
+        std::cerr << "ERROR: " << numFailed << " files or mazes could not be loaded or solved" << std::endl;
+    }
+    return numFailed == 0;
+}
+
 static int actualROWCELLS;
 static int actualCOLCELLS;
 
 int main(int argc, const char** argv)
 {
-    if(printUsage(argc, argv))
+    MazeOptions options;
+    if(printUsage(argc, argv, options))
     {
         return -1;
     }
 
-    actualROWCELLS= atoi(argv[1]);
-    actualCOLCELLS = atoi(argv[1]);
+    actualROWCELLS = options.numRows;
+    actualCOLCELLS = options.numCols;
+
+    // With --stdout the maze data owns stdout, so everything else goes to stderr
+    std::ostream& infoStream = options.writeToStdout ? std::cerr : std::cout;
+
+    // The same seed always produces the same maze
+    std::uint64_t seed = options.hasSeed ? options.seed : makeRandomSeed();
+    if(options.loadPath.empty())
+    {
+        infoStream << "Seed: " << seed << std::endl;
+    }
+
+    int numThreads = options.numThreads;
+    if(numThreads == 0)
+    {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+        numThreads = (numThreads > 0) ? numThreads : 1;
+    }
+
+    // A directory of mazes is loaded and solved like a batch
+    if(options.isLoadDirectory)
+    {
+        return solveMazeDirectory(options, numThreads, infoStream) ? 0 : -1;
+    }
+
+    // A loaded maze takes its size from the file instead
+    MazeReader mazeReader;
+    if(!options.loadPath.empty())
+    {
+        if(!mazeReader.open(options.loadPath, options.numRows, options.numCols) || !mazeReader.nextMaze())
+        {
+            return -1;
+        }
+        actualROWCELLS = mazeReader.getNumRows();
+        actualCOLCELLS = mazeReader.getNumCols();
+        infoStream << "Loaded a maze of " << actualROWCELLS << " x " << actualCOLCELLS << " cells from " << options.loadPath << std::endl;
+    }
+    else
+    {
+        // Sizing the run before anything is allocated, huge mazes can take more memory than the machine has
+        MazeSizeEstimate estimate;
+        if(options.isOutOfCore)
+        {
+            estimate = estimateStreamingMazeSize(actualROWCELLS, actualCOLCELLS, options.memoryBudgetMiB << 20);
+        }
+        else
+        {
+            bool isMultithreaded = options.generatorType == MAZE_GENERATOR_PARALLEL_WILSON || options.numMazes > 0;
+            estimate = estimateMazeSize(actualROWCELLS, actualCOLCELLS, options.generatorType, isMultithreaded ? numThreads : 1, options.numMazes);
+        }
+        char estimateText[128];
+        std::snprintf(estimateText, sizeof(estimateText), "Estimated memory: %.1f MiB, estimated time: %.2f s", \
+                      static_cast<double>(estimate.numBytes) / (1 << 20), estimate.numSeconds);
+        infoStream << estimateText << std::endl;
+
+        std::uint64_t physicalBytes = physicalMemoryBytes();
+        if(physicalBytes > 0 && estimate.numBytes > physicalBytes)
+        {
+            std::cerr << "WARNING: Maze needs more memory than the " << (physicalBytes >> 20) << " MiB this machine has, the program may fail or slow down badly" << std::endl;
+        }
+        else if(estimate.numSeconds >= LONG_RUN_SECONDS)
+        {
+            std::cerr << "WARNING: Maze will be big, the program may take a long time to complete" << std::endl;
+        }
+    }
+
+    // Batch mode, generating and solving many mazes across a pool of worker threads
+    if(options.numMazes > 0)
+    {
+        auto batchStart = std::chrono::steady_clock::now();
+        std::uint64_t numWritten = 0;
+        if(options.isPipelined)
+        {
+            numWritten = runPipelinedBatch(actualROWCELLS, actualCOLCELLS, options.numMazes, numThreads, options.generatorType, options.aldousBroderFraction, options.solverType, seed, \
+                                           options.outputPrefix, options.outputFormat);
+        }
+        else
+        {
+            numWritten = runBatch(actualROWCELLS, actualCOLCELLS, options.numMazes, numThreads, options.generatorType, options.aldousBroderFraction, options.solverType, seed, \
+                                  options.outputPrefix, options.outputFormat);
+        }
+        std::chrono::duration<double> batchTime = std::chrono::steady_clock::now() - batchStart;
+
+        if(options.isPipelined)
+        {
+            int numGenerators = 0;
+            int numSolvers = 0;
+            splitPipelineThreads(numThreads, numGenerators, numSolvers);
+            std::cout << "Wrote " << numWritten << " mazes to " << options.outputPrefix << mazeFormatExtension(options.outputFormat) << " using " << numGenerators \
+                      << " generator threads, " << numSolvers << " solver threads and a writer thread in " << batchTime.count() << " s" << std::endl;
+        }
+        else
+        {
+            std::cout << "Wrote " << numWritten << " mazes to " << options.outputPrefix << "_<0-" << (numThreads - 1) \
+                      << ">" << mazeFormatExtension(options.outputFormat) << " using " << numThreads << " threads in " << batchTime.count() << " s" << std::endl;
+        }
+
+        return (numWritten == options.numMazes) ? 0 : -1;
+    }
+
+    // Out-of-core mode, streaming the maze out one row at a time so it never has to fit in memory
+    if(options.isOutOfCore)
+    {
+        const std::size_t budgetBytes = static_cast<std::size_t>(options.memoryBudgetMiB << 20);
+        const std::size_t rowStateBytes = ellerRowStateBytes(actualCOLCELLS);
+        const std::size_t rowBytes = 16 * ((static_cast<std::size_t>(actualCOLCELLS) + 63) / 64);
+        if(rowStateBytes + rowBytes > budgetBytes)
+        {
+            std::cerr << "ERROR: One row of the maze needs " << ((rowStateBytes + rowBytes + (1 << 20) - 1) >> 20) \
+                      << " MiB, more than the memory budget of " << options.memoryBudgetMiB << " MiB" << std::endl;
+            return -1;
+        }
+
+        DefaultRng rng(seed);
+        auto streamStart = std::chrono::steady_clock::now();
+        const std::string mazeDataFileName = options.writeToStdout ? "stdout" : "mazeData.mzb";
+        bool isWritten = false;
+        {
+            std::ofstream mazeData;
+            if(!options.writeToStdout)
+            {
+                mazeData.open(mazeDataFileName, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+            }
+            else
+            {
+                std::ios_base::sync_with_stdio(false);
+            }
+            std::ostream& mazeDataStream = options.writeToStdout ? static_cast<std::ostream&>(std::cout) : mazeData;
+
+            // Whatever the budget leaves after the row state buffers the output
+            MazeOutputBuffer mazeDataBuffer(mazeDataStream, budgetBytes - rowStateBytes);
+            runStreamingEller(actualROWCELLS, actualCOLCELLS, rng, mazeDataBuffer, true, seed);
+            isWritten = mazeDataBuffer.flush();
+        }
+        if(!isWritten)
+        {
+            std::cerr << "ERROR: Could not write " << mazeDataFileName << std::endl;
+            return -1;
+        }
+
+        std::chrono::duration<double> streamTime = std::chrono::steady_clock::now() - streamStart;
+        infoStream << "Streamed the maze to " << mazeDataFileName << " in " << streamTime.count() << " s" << std::endl;
+
+        return drawMazeTiles(options, numThreads, infoStream) ? 0 : -1;
+    }
+
+    // A maze index picks the same stream a batch gives that maze, so one maze of a batch can be looked at on its own
+    DefaultRng rng = options.hasMazeIndex ? makeStreamEngine(seed, options.mazeIndex) : DefaultRng(seed);
+
+    if(options.topology != GridGraph::SQUARE_TOPOLOGY)
+    {
+        return runGridGraphMaze(options, rng, infoStream) ? 0 : -1;
+    }
 
     // Creating maze grid
     Maze mainMaze(actualROWCELLS, actualCOLCELLS);
     mainMaze.printMaze();
 
-    // Running Wilson's Algorithm to fill out the maze
-    runWilson(mainMaze);
-    LOG_DEBUG("Wilson Finished")
+    if(!options.loadPath.empty())
+    {
+        // Loading the walls, entrance and exit of the maze instead of generating it
+        if(!mazeReader.readMaze(mainMaze))
+        {
+            return -1;
+        }
+        if(mazeReader.nextMaze())
+        {
+            std::cerr << "WARNING: " << options.loadPath << " holds more than one maze, only the first one is solved, load its directory to solve them all" << std::endl;
+        }
+
+        // Closing the file before mazeData is written, it may be the file loaded
+        mazeReader.close();
+        LOG_DEBUG("Loaded " << options.loadPath)
+    }
+    else
+    {
+        // Running the chosen generator (Wilson's Algorithm by default) to fill out the maze
+        runMazeGenerator(mainMaze, options.generatorType, rng, numThreads, options.aldousBroderFraction);
+        LOG_DEBUG("Generator " << mazeGeneratorName(options.generatorType) << " Finished")
+    }
     mainMaze.printMaze();
 
-    // Running Tremaux's Algorithm to find a path from the entrance to the exit
-    runTremaux(mainMaze);
-    LOG_DEBUG("Tremaux Finished")
+    // Running the chosen solver (Tremaux's Algorithm by default) to find a path from the entrance to the exit
+    MazeSolver solver(actualROWCELLS, actualCOLCELLS);
+    if(!solveMaze(mainMaze, options.solverType, solver))
+    {
+        std::cerr << "ERROR: Solver did not find a path from the maze entrance to the maze exit" << std::endl;
+        return -1;
+    }
+    LOG_DEBUG("Solver Finished")
 
     LOG_DEBUG("Path from maze entrance to maze exit:")
     mainMaze.printMaze();
     
-    // Writing finished maze data to a csv file
-    std::fstream mazeData("mazeData.csv", std::fstream::out | std::fstream::trunc);
-    writeMazeDataCSV(mazeData, mainMaze);
-    mazeData.close();
+    // Writing finished maze data to a csv file, or a binary file with --format binary, or to stdout with --stdout
+    if(options.writeToStdout)
+    {
+        std::ios_base::sync_with_stdio(false);
+        if(options.outputFormat == MAZE_FORMAT_BINARY)
+        {
+            writeMazeDataBinary(std::cout, mainMaze, options.loadPath.empty(), seed);
+        }
+        else
+        {
+            writeMazeDataCSV(std::cout, mainMaze);
+        }
+    }
+    else
+    {
+        const std::string mazeDataFileName = "mazeData" + mazeFormatExtension(options.outputFormat);
+        std::ios_base::openmode mazeDataMode = std::ofstream::out | std::ofstream::trunc;
+        if(options.outputFormat == MAZE_FORMAT_BINARY)
+        {
+            mazeDataMode |= std::ofstream::binary;
+        }
+
+        std::ofstream mazeData(mazeDataFileName, mazeDataMode);
+        if(options.outputFormat == MAZE_FORMAT_BINARY)
+        {
+            writeMazeDataBinary(mazeData, mainMaze, options.loadPath.empty(), seed);
+        }
+        else
+        {
+            writeMazeDataCSV(mazeData, mainMaze);
+        }
+
+        if(!mazeData)
+        {
+            std::cerr << "ERROR: Could not write " << mazeDataFileName << std::endl;
+            return -1;
+        }
+
+        // The path on its own too, so readers that only want the path skip the maze grid
+        if(options.outputFormat == MAZE_FORMAT_BINARY)
+        {
+            MazePath mainPath;
+            solver.getCompactPath(mainPath);
+            std::ofstream pathData("mazePath.mzp", std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+            writeMazePathBinary(pathData, mainPath);
+            if(!pathData)
+            {
+                std::cerr << "ERROR: Could not write mazePath.mzp" << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    // Drawing the solved maze as text, only when asked for since it is as big as the csv file
+    if(!options.asciiFileName.empty())
+    {
+        if(options.asciiFileName == "-")
+        {
+            writeMazeAscii(std::cout, mainMaze);
+        }
+        else
+        {
+            std::ofstream asciiFile(options.asciiFileName, std::ofstream::out | std::ofstream::trunc);
+            writeMazeAscii(asciiFile, mainMaze);
+            if(!asciiFile)
+            {
+                std::cerr << "ERROR: Could not write " << options.asciiFileName << std::endl;
+                return -1;
+            }
+            infoStream << "Drew the maze as text to " << options.asciiFileName << std::endl;
+        }
+    }
+
+    // Drawing the unsolved and solved maze images, named like the ones maze_img_displayer.py draws
+    if(options.isRendered)
+    {
+        std::string unsolvedFileName;
+        std::string solvedFileName;
+        makeRenderFileNames((options.renderFormat == MAZE_RENDER_PNG) ? ".png" : ".svg", unsolvedFileName, solvedFileName);
+        int cellSize = (options.cellSize > 0) ? options.cellSize : defaultRenderCellSize(mainMaze);
+
+        if(!renderMazeImages(mainMaze, options.renderFormat, unsolvedFileName, solvedFileName, cellSize))
+        {
+            return -1;
+        }
+        infoStream << "Drew " << unsolvedFileName << " and " << solvedFileName << std::endl;
+    }
+
+    // Drawing the tiles from the mazeData.mzb just written, which is closed by now
+    if(!drawMazeTiles(options, numThreads, infoStream))
+    {
+        return -1;
+    }
 
     LOG_DEBUG("Program finished")
 
@@ -0,0 +1,150 @@
+/*mappedFile.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Mapped File
+ * 
+ * Read-only memory mapping of a whole file, shared by the binary and external maze readers
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mappedFile.h"
+
+#include <fstream>
+#include <iostream>
+
+#if defined(_WIN32)
+#define MAPPED_FILE_NO_MMAP
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates a view with no file mapped
+ * --------------------------------------------------------------------------------------
+*/
+MappedFile::MappedFile()
+    : m_data(nullptr), m_size(0)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * Destructor
+ * 
+ * Unmaps the file, if one is mapped
+ * --------------------------------------------------------------------------------------
+*/
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+/**--------------------------------------------------------------------------------------
+ * open()
+ * 
+ * Maps a file, unmapping the one mapped before
+ * 
+ * @param[in] fileName Name of the file to map
+ * @return true if the file was mapped, false if it could not be or is empty
+ * --------------------------------------------------------------------------------------
+*/
+bool MappedFile::open(const std::string& fileName)
+{
+    close();
+
+#if defined(MAPPED_FILE_NO_MMAP)
+    std::ifstream infile(fileName, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+    if(!infile)
+    {
+        std::cerr << "ERROR: Could not open " << fileName << std::endl;
+        return false;
+    }
+    m_fallbackBuffer.resize(static_cast<std::size_t>(infile.tellg()));
+    if(m_fallbackBuffer.empty())
+    {
+        std::cerr << "ERROR: Found " << fileName << " to be empty" << std::endl;
+        return false;
+    }
+    infile.seekg(0);
+    infile.read(reinterpret_cast<char*>(m_fallbackBuffer.data()), static_cast<std::streamsize>(m_fallbackBuffer.size()));
+    m_data = m_fallbackBuffer.data();
+    m_size = m_fallbackBuffer.size();
+#else
+    int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    if(fileDescriptor < 0)
+    {
+        std::cerr << "ERROR: Could not open " << fileName << std::endl;
+        return false;
+    }
+
+    struct stat fileStats;
+    if(fstat(fileDescriptor, &fileStats) != 0 || fileStats.st_size <= 0)
+    {
+        std::cerr << "ERROR: Found " << fileName << " to be empty" << std::endl;
+        ::close(fileDescriptor);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, static_cast<std::size_t>(fileStats.st_size), PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    ::close(fileDescriptor);
+    if(mapping == MAP_FAILED)
+    {
+        std::cerr << "ERROR: Could not map " << fileName << std::endl;
+        return false;
+    }
+    m_data = static_cast<const std::uint8_t*>(mapping);
+    m_size = static_cast<std::size_t>(fileStats.st_size);
+#endif
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * close()
+ * 
+ * Unmaps the file, if one is mapped
+ * --------------------------------------------------------------------------------------
+*/
+void MappedFile::close()
+{
+#if defined(MAPPED_FILE_NO_MMAP)
+    m_fallbackBuffer.clear();
+    m_fallbackBuffer.shrink_to_fit();
+#else
+    if(m_data != nullptr)
+    {
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
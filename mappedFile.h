@@ -0,0 +1,98 @@
+/*mappedFile.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Mapped File
+ * 
+ * Read-only memory mapping of a whole file, shared by the binary and external maze readers
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * MappedFile class
+ * 
+ * Read-only view of a whole file, mapped into memory instead of being read in
+ *     On platforms without mmap the file is read into memory instead
+ * --------------------------------------------------------------------------------------
+*/
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**--------------------------------------------------------------------------------------
+     * open()
+     * 
+     * Maps a file, unmapping the one mapped before
+     * 
+     * @param[in] fileName Name of the file to map
+     * @return true if the file was mapped, false if it could not be or is empty
+     * --------------------------------------------------------------------------------------
+    */
+    bool open(const std::string& fileName);
+
+    /**--------------------------------------------------------------------------------------
+     * close()
+     * 
+     * Unmaps the file, if one is mapped
+     * --------------------------------------------------------------------------------------
+    */
+    void close();
+
+    /**--------------------------------------------------------------------------------------
+     * getData() / getSize()
+     * 
+     * Returns the mapped bytes and their number
+     * 
+     * @return the start of the file, nullptr if none is mapped, or its size in bytes
+     * --------------------------------------------------------------------------------------
+    */
+    const std::uint8_t* getData() const
+    {
+        return m_data;
+    }
+
+    std::size_t getSize() const
+    {
+        return m_size;
+    }
+
+private:
+    const std::uint8_t* m_data;
+    std::size_t m_size;
+    std::vector<std::uint8_t> m_fallbackBuffer;
+};
@@ -6,7 +6,7 @@
  * 
  * Maze class
  * 
- * Contains a 2d array of Cell objects, and a map of cell indices to Wall objects
+ * Contains the packed state of every cell, and a bit-packed grid of the walls between them
  * 
  * Allows operation of Wilson's Algorithm to generate a random unbiased maze
  * Allows operation of Tremaux's Algorithm to find a path from the entrance to the exit of a maze
@@ -34,6 +34,7 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -50,60 +51,46 @@
  * --------------------------------------------------------------------------------------
 */
 Maze::Maze(int uRows, int uCols)
-    : ROWCELLS(uRows), COLCELLS(uCols)
+    : m_cellStates(static_cast<std::size_t>(uRows) * static_cast<std::size_t>(uCols), 0),
+      ROWCELLS(uRows), COLCELLS(uCols),
+      m_wordsPerRow((static_cast<std::size_t>(uCols) + 63) / 64),
+      m_southWalls(static_cast<std::size_t>(uRows) * m_wordsPerRow, 0),
+      m_eastWalls(static_cast<std::size_t>(uRows) * m_wordsPerRow, 0)
 {
-    m_cellsGrid = new Cell*[ROWCELLS];
-    for(int i = 0; i < ROWCELLS; i++)
-    {
-        m_cellsGrid[i] = new Cell[COLCELLS];
-    }
-
-    // Populating cell grid
-    for(int row = 0; row < ROWCELLS; row++){
-        for(int col = 0; col < COLCELLS; col++){
-            m_cellsGrid[row][col] = Cell(row, col);
-        }
-    }
-
-    // Creating vertical walls
-    for(int row = 0; row < ROWCELLS; row++){
-        for(int col = 0; col < COLCELLS - 1; col++){
-            m_neighborsToWallMap.emplace(std::make_tuple(row, col, row, col + 1), Wall(row, col, row, col + 1));
-        }
-    }
-
-    // Creating horizontal walls
-    for(int row = 0; row < ROWCELLS - 1; row++){
-        for(int col = 0; col < COLCELLS; col++){
-            m_neighborsToWallMap.emplace(std::make_tuple(row, col, row + 1, col), Wall(row, col, row + 1, col));
-        }
-    }
+    // Every cell starts out with no exits, and every wall starts out closed
 }
 
 /**--------------------------------------------------------------------------------------
- * Destructor
+ * reset()
  * 
- * Destroys cellsGrid
+ * Returns the maze to the state it was constructed in: no exits, path cells, 
+ * entrance or exit, and every wall closed
+ *     Keeps the existing storage, so a maze can be reused for another of the same 
+ *     dimensions without allocating
  * --------------------------------------------------------------------------------------
 */
-Maze::~Maze()
+void Maze::reset()
 {
-    for(int i = 0; i < ROWCELLS; i++)
-    {
-        delete m_cellsGrid[i];
-    }
+    std::fill(m_cellStates.begin(), m_cellStates.end(), 0);
+    std::fill(m_southWalls.begin(), m_southWalls.end(), 0);
+    std::fill(m_eastWalls.begin(), m_eastWalls.end(), 0);
 
-    delete[] m_cellsGrid;
+    m_entranceCoords[0] = INVALID_ROW_COL;
+    m_entranceCoords[1] = INVALID_ROW_COL;
+    m_exitCoords[0] = INVALID_ROW_COL;
+    m_exitCoords[1] = INVALID_ROW_COL;
 }
 
 /**--------------------------------------------------------------------------------------
  * print()
  * 
  * Prints the contents of the maze in text format to the terminal
+ *     Only prints in debug builds (-DDO_DEBUG), otherwise it does nothing
  * --------------------------------------------------------------------------------------
 */
 void Maze::printMaze() const
 {
+#ifdef DO_DEBUG
     for(int row = 0; row < ROWCELLS; row++){
         std::string cellsAndVertWalls = "";
         std::string horizWalls = "";
@@ -117,7 +104,7 @@ void Maze::printMaze() const
             {
                 cellsAndVertWalls += "O ";
             }
-            else if(m_cellsGrid[row][col].isCellOnPath())
+            else if(m_cellStates[cellIndex(row, col)] & Cell::PATH_BIT)
             {
                 cellsAndVertWalls += "W ";
             }
@@ -127,23 +114,21 @@ void Maze::printMaze() const
             }
 
             // Printing existing vertical walls
-            auto vertWallIter = m_neighborsToWallMap.find(std::make_tuple(row, col, row, col + 1));
-            if(vertWallIter != m_neighborsToWallMap.end()){
-                if(vertWallIter->second.checkIsOpen()){ // Wall is open
+            if(col < COLCELLS - 1){
+                if(isWallOpen(row, col, EAST_DIRECTION)){ // Wall is open
                     cellsAndVertWalls += "  ";
                 }
-                else{                                 // Wall is closed
+                else{                                     // Wall is closed
                     cellsAndVertWalls += "| ";
                 }
             }
 
             // Finding existing horizontal walls
-            auto horizWallIter = m_neighborsToWallMap.find(std::make_tuple(row, col, row + 1, col));
-            if(horizWallIter != m_neighborsToWallMap.end()){
-                if(horizWallIter->second.checkIsOpen()){ // Wall is open
+            if(row < ROWCELLS - 1){
+                if(isWallOpen(row, col, SOUTH_DIRECTION)){ // Wall is open
                     horizWalls += "    ";
                 }
-                else{                                  // Wall is closed
+                else{                                      // Wall is closed
                     horizWalls += "-   ";
                 }
             }
@@ -161,6 +146,7 @@ void Maze::printMaze() const
     {
         LOG_DEBUG("Exit O: (" << m_exitCoords[0] << ", " << m_exitCoords[1] << ")")
     }
+#endif
 }
 
 /**--------------------------------------------------------------------------------------
@@ -178,9 +164,64 @@ void Maze::updateCellExits(int row, int col, int dir)
     if(row < 0 || row >= ROWCELLS || col < 0 || col >= COLCELLS)
     {
        std::cerr << "ERROR: updateCellExits() did not find the cell (" << row << ", " << col << ")" << std::endl;  
+       return;
     }
 
-    m_cellsGrid[row][col].updateMyExit(dir);
+    m_cellStates[cellIndex(row, col)] |= static_cast<std::uint8_t>(1 << dir);
+}
+
+/**--------------------------------------------------------------------------------------
+ * labelCellAsPath()
+ * 
+ * Labels a cell as part of the path from the maze entrance to the maze exit
+ * 
+ * @param[in] row Row index of cell to be labeled
+ * @param[in] col Column index of cell to be labeled
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::labelCellAsPath(int row, int col)
+{
+    if(row < 0 || row >= ROWCELLS || col < 0 || col >= COLCELLS)
+    {
+       std::cerr << "ERROR: labelCellAsPath() did not find the cell (" << row << ", " << col << ")" << std::endl;  
+       return;
+    }
+
+    m_cellStates[cellIndex(row, col)] |= Cell::PATH_BIT;
+}
+
+/**--------------------------------------------------------------------------------------
+ * unlabelCellAsPath()
+ * 
+ * Removes the path label from a cell, see labelCellAsPath()
+ * 
+ * @param[in] row Row index of cell to be unlabeled
+ * @param[in] col Column index of cell to be unlabeled
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::unlabelCellAsPath(int row, int col)
+{
+    if(row < 0 || row >= ROWCELLS || col < 0 || col >= COLCELLS)
+    {
+       std::cerr << "ERROR: unlabelCellAsPath() did not find the cell (" << row << ", " << col << ")" << std::endl;  
+       return;
+    }
+
+    m_cellStates[cellIndex(row, col)] &= static_cast<std::uint8_t>(~Cell::PATH_BIT);
+}
+
+/**--------------------------------------------------------------------------------------
+ * clearPath()
+ * 
+ * Removes the path label from every cell, so the maze can be labeled with another path
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::clearPath()
+{
+    for(std::uint8_t& cellState : m_cellStates)
+    {
+        cellState &= static_cast<std::uint8_t>(~Cell::PATH_BIT);
+    }
 }
 
 /**--------------------------------------------------------------------------------------
@@ -195,10 +236,18 @@ void Maze::updateCellExits(int row, int col, int dir)
 */
 void Maze::connectNeighbors(std::tuple<int, int, int, int> neighborCells)
 {
-    auto iter = m_neighborsToWallMap.find(neighborCells);
-    if(iter != m_neighborsToWallMap.end())
+    int aRow = std::get<0>(neighborCells);
+    int aCol = std::get<1>(neighborCells);
+    int bRow = std::get<2>(neighborCells);
+    int bCol = std::get<3>(neighborCells);
+
+    if(aRow == bRow && aCol + 1 == bCol)        // Vertical wall, cell B is to the East of cell A
     {
-        iter->second.openWall();
+        openWall(aRow, aCol, EAST_DIRECTION);
+    }
+    else if(aRow + 1 == bRow && aCol == bCol)   // Horizontal wall, cell B is to the South of cell A
+    {
+        openWall(aRow, aCol, SOUTH_DIRECTION);
     }
     else
     {
@@ -206,6 +255,206 @@ void Maze::connectNeighbors(std::tuple<int, int, int, int> neighborCells)
     }
 }
 
+/**--------------------------------------------------------------------------------------
+ * disconnectNeighbors()
+ * 
+ * Closes the wall between the two cells, undoing connectNeighbors()
+ * 
+ * @param[in] neighborCells Tuple<int, int, int, int> representing cell indices for two 
+ * cells first pair of ints are the row and col of the "first" cell second pair of ints 
+ * are the row and col of the "second" cell order of cells is from left->right, top->bottom
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::disconnectNeighbors(std::tuple<int, int, int, int> neighborCells)
+{
+    int aRow = std::get<0>(neighborCells);
+    int aCol = std::get<1>(neighborCells);
+    int bRow = std::get<2>(neighborCells);
+    int bCol = std::get<3>(neighborCells);
+
+    if(aRow == bRow && aCol + 1 == bCol)        // Vertical wall, cell B is to the East of cell A
+    {
+        closeWall(aRow, aCol, EAST_DIRECTION);
+    }
+    else if(aRow + 1 == bRow && aCol == bCol)   // Horizontal wall, cell B is to the South of cell A
+    {
+        closeWall(aRow, aCol, SOUTH_DIRECTION);
+    }
+    else
+    {
+       std::cerr << "ERROR: disconnectNeighbors() did not find a wall" << std::endl;   
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * openWall()
+ * 
+ * Opens the wall on the given side of a cell
+ * 
+ * @param[in] row Row index of cell
+ * @param[in] col Column index of cell
+ * @param[in] dir Cardinal direction of the wall to open, must not face the maze border
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::openWall(int row, int col, int dir)
+{
+    if(row < 0 || row >= ROWCELLS || col < 0 || col >= COLCELLS)
+    {
+       std::cerr << "ERROR: openWall() did not find the cell (" << row << ", " << col << ")" << std::endl;
+       return;
+    }
+
+    switch(dir)
+    {
+        case NORTH_DIRECTION:
+            if(row > 0)
+            {
+                m_southWalls[wallWordIndex(row - 1, col)] |= wallBitMask(col);
+                return;
+            }
+            break;
+        case SOUTH_DIRECTION:
+            if(row < ROWCELLS - 1)
+            {
+                m_southWalls[wallWordIndex(row, col)] |= wallBitMask(col);
+                return;
+            }
+            break;
+        case EAST_DIRECTION:
+            if(col < COLCELLS - 1)
+            {
+                m_eastWalls[wallWordIndex(row, col)] |= wallBitMask(col);
+                return;
+            }
+            break;
+        case WEST_DIRECTION:
+            if(col > 0)
+            {
+                m_eastWalls[wallWordIndex(row, col - 1)] |= wallBitMask(col - 1);
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+
+    std::cerr << "ERROR: openWall() did not find a wall in direction " << dir << " of the cell (" << row << ", " << col << ")" << std::endl;
+}
+
+/**--------------------------------------------------------------------------------------
+ * openPassage()
+ * 
+ * Opens the wall on the given side of a cell, and adds the exits through it to the cell 
+ * and to its neighbor on that side
+ *     Does everything a generator does to join two cells, see openWall() to only open 
+ *     the wall
+ * 
+ * @param[in] row Row index of cell
+ * @param[in] col Column index of cell
+ * @param[in] dir Cardinal direction of the passage to open, must not face the maze border
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::openPassage(int row, int col, int dir)
+{
+    int nextRow = row + (dir == SOUTH_DIRECTION) - (dir == NORTH_DIRECTION);
+    int nextCol = col + (dir == EAST_DIRECTION) - (dir == WEST_DIRECTION);
+    if(dir < NORTH_DIRECTION || dir > WEST_DIRECTION || row < 0 || row >= ROWCELLS || col < 0 || col >= COLCELLS || \
+       nextRow < 0 || nextRow >= ROWCELLS || nextCol < 0 || nextCol >= COLCELLS)
+    {
+       std::cerr << "ERROR: openPassage() did not find a passage in direction " << dir << " of the cell (" << row << ", " << col << ")" << std::endl;
+       return;
+    }
+
+    openWall(row, col, dir);
+
+    // Opposite directions only differ in their lowest bit
+    m_cellStates[cellIndex(row, col)] |= static_cast<std::uint8_t>(1 << dir);
+    m_cellStates[cellIndex(nextRow, nextCol)] |= static_cast<std::uint8_t>(1 << (dir ^ 1));
+}
+
+/**--------------------------------------------------------------------------------------
+ * closeWall()
+ * 
+ * Closes the wall on the given side of a cell, undoing openWall()
+ * 
+ * @param[in] row Row index of cell
+ * @param[in] col Column index of cell
+ * @param[in] dir Cardinal direction of the wall to close, must not face the maze border
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::closeWall(int row, int col, int dir)
+{
+    if(row < 0 || row >= ROWCELLS || col < 0 || col >= COLCELLS)
+    {
+       std::cerr << "ERROR: closeWall() did not find the cell (" << row << ", " << col << ")" << std::endl;
+       return;
+    }
+
+    switch(dir)
+    {
+        case NORTH_DIRECTION:
+            if(row > 0)
+            {
+                m_southWalls[wallWordIndex(row - 1, col)] &= ~wallBitMask(col);
+                return;
+            }
+            break;
+        case SOUTH_DIRECTION:
+            if(row < ROWCELLS - 1)
+            {
+                m_southWalls[wallWordIndex(row, col)] &= ~wallBitMask(col);
+                return;
+            }
+            break;
+        case EAST_DIRECTION:
+            if(col < COLCELLS - 1)
+            {
+                m_eastWalls[wallWordIndex(row, col)] &= ~wallBitMask(col);
+                return;
+            }
+            break;
+        case WEST_DIRECTION:
+            if(col > 0)
+            {
+                m_eastWalls[wallWordIndex(row, col - 1)] &= ~wallBitMask(col - 1);
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+
+    std::cerr << "ERROR: closeWall() did not find a wall in direction " << dir << " of the cell (" << row << ", " << col << ")" << std::endl;
+}
+
+/**--------------------------------------------------------------------------------------
+ * closePassage()
+ * 
+ * Closes the wall on the given side of a cell, and removes the exits through it from the 
+ * cell and from its neighbor on that side, undoing openPassage()
+ * 
+ * @param[in] row Row index of cell
+ * @param[in] col Column index of cell
+ * @param[in] dir Cardinal direction of the passage to close, must not face the maze border
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::closePassage(int row, int col, int dir)
+{
+    int nextRow = row + (dir == SOUTH_DIRECTION) - (dir == NORTH_DIRECTION);
+    int nextCol = col + (dir == EAST_DIRECTION) - (dir == WEST_DIRECTION);
+    if(dir < NORTH_DIRECTION || dir > WEST_DIRECTION || row < 0 || row >= ROWCELLS || col < 0 || col >= COLCELLS || \
+       nextRow < 0 || nextRow >= ROWCELLS || nextCol < 0 || nextCol >= COLCELLS)
+    {
+       std::cerr << "ERROR: closePassage() did not find a passage in direction " << dir << " of the cell (" << row << ", " << col << ")" << std::endl;
+       return;
+    }
+
+    closeWall(row, col, dir);
+
+    m_cellStates[cellIndex(row, col)] &= static_cast<std::uint8_t>(~(1 << dir));
+    m_cellStates[cellIndex(nextRow, nextCol)] &= static_cast<std::uint8_t>(~(1 << (dir ^ 1)));
+}
+
 /**--------------------------------------------------------------------------------------
  * getEntrance()
  * 
@@ -232,6 +481,77 @@ std::tuple<int, int> Maze::getExit() const
     return std::make_tuple(m_exitCoords[0], m_exitCoords[1]);
 }
 
+/**--------------------------------------------------------------------------------------
+ * setWallRow()
+ * 
+ * Replaces the open walls of a whole row at once, in the layout of getSouthWallRow() 
+ * and getEastWallRow()
+ *     Walls facing the maze border stay closed, and so do the bits past the last column
+ *     Cell exits are not updated, see updateExitsFromWalls()
+ * 
+ * @param[in] row           Row index
+ * @param[in] southWalls    getWallWordsPerRow() words, bits set for the open south walls
+ * @param[in] eastWalls     getWallWordsPerRow() words, bits set for the open east walls
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::setWallRow(int row, const std::uint64_t* southWalls, const std::uint64_t* eastWalls)
+{
+    if(row < 0 || row >= ROWCELLS)
+    {
+       std::cerr << "ERROR: setWallRow() did not find the row " << row << std::endl;
+       return;
+    }
+
+    // Bits of the columns in the last word, the ones past it are padding
+    const std::uint64_t lastWordMask = (COLCELLS & 63) ? (std::uint64_t(1) << (COLCELLS & 63)) - 1 : ~std::uint64_t(0);
+    std::uint64_t* southRow = m_southWalls.data() + static_cast<std::size_t>(row) * m_wordsPerRow;
+    std::uint64_t* eastRow = m_eastWalls.data() + static_cast<std::size_t>(row) * m_wordsPerRow;
+    for(std::size_t word = 0; word < m_wordsPerRow; word++)
+    {
+        std::uint64_t wordMask = (word == m_wordsPerRow - 1) ? lastWordMask : ~std::uint64_t(0);
+        southRow[word] = (row < ROWCELLS - 1) ? (southWalls[word] & wordMask) : 0;
+        eastRow[word] = eastWalls[word] & wordMask;
+    }
+
+    // The last column's east wall is the maze border
+    eastRow[(COLCELLS - 1) >> 6] &= ~wallBitMask(COLCELLS - 1);
+}
+
+/**--------------------------------------------------------------------------------------
+ * updateExitsFromWalls()
+ * 
+ * Sets the exits of every cell to the open walls around it, once the walls were set 
+ * with setWallRow(). Path labels are kept
+ * --------------------------------------------------------------------------------------
+*/
+void Maze::updateExitsFromWalls()
+{
+    for(int row = 0; row < ROWCELLS; row++)
+    {
+        const std::uint64_t* southRow = getSouthWallRow(row);
+        const std::uint64_t* northRow = (row > 0) ? getSouthWallRow(row - 1) : nullptr;
+        const std::uint64_t* eastRow = getEastWallRow(row);
+        std::uint8_t* cellStates = m_cellStates.data() + cellIndex(row, 0);
+
+        for(std::size_t word = 0; word < m_wordsPerRow; word++)
+        {
+            // A cell's west wall is the east wall of the cell before it
+            std::uint64_t northWord = northRow ? northRow[word] : 0;
+            std::uint64_t westWord = (eastRow[word] << 1) | ((word > 0) ? eastRow[word - 1] >> 63 : 0);
+            int firstCol = static_cast<int>(word * 64);
+            int lastCol = std::min(firstCol + 64, COLCELLS);
+
+            for(int col = firstCol; col < lastCol; col++)
+            {
+                int bit = col - firstCol;
+                std::uint8_t exits = static_cast<std::uint8_t>(((northWord >> bit) & 1) << NORTH_DIRECTION | ((southRow[word] >> bit) & 1) << SOUTH_DIRECTION | \
+                                                               ((eastRow[word] >> bit) & 1) << EAST_DIRECTION | ((westWord >> bit) & 1) << WEST_DIRECTION);
+                cellStates[col] = static_cast<std::uint8_t>((cellStates[col] & ~Cell::EXITS_MASK) | exits);
+            }
+        }
+    }
+}
+
 /**--------------------------------------------------------------------------------------
  * labelMazeEntrance()
  * 
@@ -275,32 +595,62 @@ void Maze::labelMazeExit(int row, int col)
 /**--------------------------------------------------------------------------------------
  * findCell()
  * 
- * Given a row and column, returns a reference to the corresponding cell in the maze
+ * Given a row and column, returns a read-only view of the corresponding cell in the maze, 
+ * paired with Tremaux marks kept by the caller
  * 
- * @param[in] row Row index of cell
- * @param[in] col Column index of cell
- * @return a reference to a Cell object in the maze
+ * @param[in] row   Row index of cell
+ * @param[in] col   Column index of cell
+ * @param[in] marks Packed Tremaux marks byte of the cell, kept outside the maze
+ * @return a Cell object viewing the cell's state in the maze
  * --------------------------------------------------------------------------------------
 */
-Cell& Maze::findCell(int row, int col)
+Cell Maze::findCell(int row, int col, std::uint8_t& marks) const
 {
     if(row < 0 || row >= ROWCELLS || col < 0 || col >= COLCELLS)
     {
        std::cout << "ERROR: findCell() did not find the cell(" << row << ", " << col << ")" << std::endl;  
     }
 
-    return m_cellsGrid[row][col];
+    std::size_t index = cellIndex(row, col);
+    return Cell(m_cellStates[index], marks, row, col);
 }
 
 /**--------------------------------------------------------------------------------------
  * getWallsMap()
  * 
- * Returns a reference to the map of walls in the maze
+ * Returns a snapshot of the walls in the maze as a map of cell indices to Wall objects
+ *     Compatibility adapter for callers of the old map-based wall storage, builds a new
+ *     map on every call. Prefer isWallOpen() for lookups
  * 
- * @return a reference to a Map of tuple<int, int, int, int> to Wall objects
+ * @return a Map of tuple<int, int, int, int> to Wall objects
  * --------------------------------------------------------------------------------------
 */
-std::map<std::tuple<int, int, int, int>, Wall>& Maze::getWallsMap()
+std::map<std::tuple<int, int, int, int>, Wall> Maze::getWallsMap() const
 {
-    return m_neighborsToWallMap;
+    // Tuple: <cellA row index, cellA col index, cellB row index, cellB col index>
+    std::map<std::tuple<int, int, int, int>, Wall> neighborsToWallMap;
+
+    // Vertical walls
+    for(int row = 0; row < ROWCELLS; row++){
+        for(int col = 0; col < COLCELLS - 1; col++){
+            Wall vertWall(row, col, row, col + 1);
+            if(isWallOpen(row, col, EAST_DIRECTION)){
+                vertWall.openWall();
+            }
+            neighborsToWallMap.emplace(std::make_tuple(row, col, row, col + 1), vertWall);
+        }
+    }
+
+    // Horizontal walls
+    for(int row = 0; row < ROWCELLS - 1; row++){
+        for(int col = 0; col < COLCELLS; col++){
+            Wall horizWall(row, col, row + 1, col);
+            if(isWallOpen(row, col, SOUTH_DIRECTION)){
+                horizWall.openWall();
+            }
+            neighborsToWallMap.emplace(std::make_tuple(row, col, row + 1, col), horizWall);
+        }
+    }
+
+    return neighborsToWallMap;
 }
\ No newline at end of file
@@ -6,7 +6,7 @@
  * 
  * Maze class
  * 
- * Contains a 2d array of Cell objects, and a map of cell indices to Wall objects
+ * Contains the packed state of every cell, and a bit-packed grid of the walls between them
  * 
  * Allows operation of Wilson's Algorithm to generate a random unbiased maze
  * Allows operation of Tremaux's Algorithm to find a path from the entrance to the exit of a maze
@@ -39,13 +39,20 @@
 #include "cell.h"
 #include "wall.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <tuple>
+#include <vector>
 
 /**--------------------------------------------------------------------------------------
  * Maze class
  * 
- * Contains a 2d array of Cell objects, and a map of cell indices to Wall objects
+ * Contains the packed state of every cell, and a bit-packed grid of the walls between them
+ *     Cell state is stored row-major in a contiguous array, findCell() returns a Cell view
+ *     into it
+ *     Rows and columns are ints, but cell counts and row-major cell indices are 64-bit 
+ *     (std::size_t), so a maze can have far more than 2^31 cells
  * Dimenstions are ROWCELLS x COLCELLS
  * --------------------------------------------------------------------------------------
 */
@@ -64,17 +71,21 @@ public:
     Maze(int uRows, int uCols);
 
     /**--------------------------------------------------------------------------------------
-     * Destructor
+     * reset()
      * 
-     * Destroys cellsGrid
+     * Returns the maze to the state it was constructed in: no exits, path cells, 
+     * entrance or exit, and every wall closed
+     *     Keeps the existing storage, so a maze can be reused for another of the same 
+     *     dimensions without allocating
      * --------------------------------------------------------------------------------------
     */
-    ~Maze();
+    void reset();
 
     /**--------------------------------------------------------------------------------------
      * print()
      * 
      * Prints the contents of the maze in text format to the terminal
+     *     Only prints in debug builds (-DDO_DEBUG), otherwise it does nothing
      * --------------------------------------------------------------------------------------
     */
     void printMaze() const;
@@ -91,6 +102,51 @@ public:
     */
     void updateCellExits(int row, int col, int dir);
 
+    /**--------------------------------------------------------------------------------------
+     * labelCellAsPath()
+     * 
+     * Labels a cell as part of the path from the maze entrance to the maze exit
+     * 
+     * @param[in] row Row index of cell to be labeled
+     * @param[in] col Column index of cell to be labeled
+     * --------------------------------------------------------------------------------------
+    */
+    void labelCellAsPath(int row, int col);
+
+    /**--------------------------------------------------------------------------------------
+     * isCellOnPath()
+     * 
+     * Checks if a cell is labeled as part of the path from the maze entrance to the maze exit
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @return true if the cell is on the path, false otherwise
+     * --------------------------------------------------------------------------------------
+    */
+    bool isCellOnPath(int row, int col) const
+    {
+        return (m_cellStates[cellIndex(row, col)] & Cell::PATH_BIT) != 0;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * unlabelCellAsPath()
+     * 
+     * Removes the path label from a cell, see labelCellAsPath()
+     * 
+     * @param[in] row Row index of cell to be unlabeled
+     * @param[in] col Column index of cell to be unlabeled
+     * --------------------------------------------------------------------------------------
+    */
+    void unlabelCellAsPath(int row, int col);
+
+    /**--------------------------------------------------------------------------------------
+     * clearPath()
+     * 
+     * Removes the path label from every cell, so the maze can be labeled with another path
+     * --------------------------------------------------------------------------------------
+    */
+    void clearPath();
+
     /**--------------------------------------------------------------------------------------
      * connectNeighbors()
      * 
@@ -103,6 +159,123 @@ public:
     */
     void connectNeighbors(std::tuple<int, int, int, int> neighborCells);
 
+    /**--------------------------------------------------------------------------------------
+     * disconnectNeighbors()
+     * 
+     * Closes the wall between the two cells, undoing connectNeighbors()
+     * 
+     * @param[in] neighborCells Tuple<int, int, int, int> representing cell indices for two 
+     * cells first pair of ints are the row and col of the "first" cell second pair of ints 
+     * are the row and col of the "second" cell order of cells is from left->right, top->bottom
+     * --------------------------------------------------------------------------------------
+    */
+    void disconnectNeighbors(std::tuple<int, int, int, int> neighborCells);
+
+    /**--------------------------------------------------------------------------------------
+     * openWall()
+     * 
+     * Opens the wall on the given side of a cell
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @param[in] dir Cardinal direction of the wall to open, must not face the maze border
+     * --------------------------------------------------------------------------------------
+    */
+    void openWall(int row, int col, int dir);
+
+    /**--------------------------------------------------------------------------------------
+     * openPassage()
+     * 
+     * Opens the wall on the given side of a cell, and adds the exits through it to the cell 
+     * and to its neighbor on that side
+     *     Does everything a generator does to join two cells, see openWall() to only open 
+     *     the wall
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @param[in] dir Cardinal direction of the passage to open, must not face the maze border
+     * --------------------------------------------------------------------------------------
+    */
+    void openPassage(int row, int col, int dir);
+
+    /**--------------------------------------------------------------------------------------
+     * closeWall()
+     * 
+     * Closes the wall on the given side of a cell, undoing openWall()
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @param[in] dir Cardinal direction of the wall to close, must not face the maze border
+     * --------------------------------------------------------------------------------------
+    */
+    void closeWall(int row, int col, int dir);
+
+    /**--------------------------------------------------------------------------------------
+     * closePassage()
+     * 
+     * Closes the wall on the given side of a cell, and removes the exits through it from the 
+     * cell and from its neighbor on that side, undoing openPassage()
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @param[in] dir Cardinal direction of the passage to close, must not face the maze border
+     * --------------------------------------------------------------------------------------
+    */
+    void closePassage(int row, int col, int dir);
+
+    /**--------------------------------------------------------------------------------------
+     * setWallRow()
+     * 
+     * Replaces the open walls of a whole row at once, in the layout of getSouthWallRow() 
+     * and getEastWallRow()
+     *     Walls facing the maze border stay closed, and so do the bits past the last column
+     *     Cell exits are not updated, see updateExitsFromWalls()
+     * 
+     * @param[in] row           Row index
+     * @param[in] southWalls    getWallWordsPerRow() words, bits set for the open south walls
+     * @param[in] eastWalls     getWallWordsPerRow() words, bits set for the open east walls
+     * --------------------------------------------------------------------------------------
+    */
+    void setWallRow(int row, const std::uint64_t* southWalls, const std::uint64_t* eastWalls);
+
+    /**--------------------------------------------------------------------------------------
+     * updateExitsFromWalls()
+     * 
+     * Sets the exits of every cell to the open walls around it, once the walls were set 
+     * with setWallRow(). Path labels are kept
+     * --------------------------------------------------------------------------------------
+    */
+    void updateExitsFromWalls();
+
+    /**--------------------------------------------------------------------------------------
+     * isWallOpen()
+     * 
+     * Checks if the wall on the given side of a cell is open
+     *     Walls facing the maze border are always closed
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @param[in] dir Cardinal direction of the wall to check
+     * @return true if there is a passageway in the given direction, false otherwise
+     * --------------------------------------------------------------------------------------
+    */
+    bool isWallOpen(int row, int col, int dir) const
+    {
+        switch(dir)
+        {
+            case NORTH_DIRECTION:
+                return row > 0 && isBitSet(m_southWalls, row - 1, col);
+            case SOUTH_DIRECTION:
+                return isBitSet(m_southWalls, row, col);
+            case EAST_DIRECTION:
+                return isBitSet(m_eastWalls, row, col);
+            case WEST_DIRECTION:
+                return col > 0 && isBitSet(m_eastWalls, row, col - 1);
+            default:
+                return false;
+        }
+    }
+
     /**--------------------------------------------------------------------------------------
      * getEntrance()
      * 
@@ -148,24 +321,28 @@ public:
     /**--------------------------------------------------------------------------------------
      * findCell()
      * 
-     * Given a row and column, returns a reference to the corresponding cell in the maze
+     * Given a row and column, returns a read-only view of the corresponding cell in the maze, 
+     * paired with Tremaux marks kept by the caller
      * 
-     * @param[in] row Row index of cell
-     * @param[in] col Column index of cell
-     * @return a reference to a Cell object in the maze
+     * @param[in] row   Row index of cell
+     * @param[in] col   Column index of cell
+     * @param[in] marks Packed Tremaux marks byte of the cell, kept outside the maze
+     * @return a Cell object viewing the cell's state in the maze
      * --------------------------------------------------------------------------------------
     */
-    Cell& findCell(int row, int col);
+    Cell findCell(int row, int col, std::uint8_t& marks) const;
 
     /**--------------------------------------------------------------------------------------
      * getWallsMap()
      * 
-     * Returns a reference to the map of walls in the maze
+     * Returns a snapshot of the walls in the maze as a map of cell indices to Wall objects
+     *     Compatibility adapter for callers of the old map-based wall storage, builds a new
+     *     map on every call. Prefer isWallOpen() for lookups
      * 
-     * @return a reference to a Map of tuple<int, int, int, int> to Wall objects
+     * @return a Map of tuple<int, int, int, int> to Wall objects
      * --------------------------------------------------------------------------------------
     */
-    std::map<std::tuple<int, int, int, int>, Wall>& getWallsMap();
+    std::map<std::tuple<int, int, int, int>, Wall> getWallsMap() const;
 
     /**--------------------------------------------------------------------------------------
      * getROWCELLS()
@@ -192,32 +369,112 @@ public:
     {
         return COLCELLS;
     }
-    
+
+    /**--------------------------------------------------------------------------------------
+     * getNumCells()
+     * 
+     * Returns the number of cells in the maze
+     * 
+     * @return ROWCELLS x COLCELLS, computed without overflowing an int
+     * --------------------------------------------------------------------------------------
+    */
+    std::size_t getNumCells() const
+    {
+        return m_cellStates.size();
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getWallWordsPerRow()
+     * 
+     * Returns the number of 64-bit words in one row of a wall bitplane
+     * 
+     * @return the number of words per row, (COLCELLS + 63) / 64
+     * --------------------------------------------------------------------------------------
+    */
+    std::size_t getWallWordsPerRow() const
+    {
+        return m_wordsPerRow;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getSouthWallRow() / getEastWallRow()
+     * 
+     * Returns one row of the south or east wall bitplane, getWallWordsPerRow() words long
+     *     Bit (col % 64) of word (col / 64) is set if the wall on that side of the cell is open
+     * 
+     * @param[in] row Row index
+     * @return a pointer to the first word of the row
+     * --------------------------------------------------------------------------------------
+    */
+    const std::uint64_t* getSouthWallRow(int row) const
+    {
+        return m_southWalls.data() + static_cast<std::size_t>(row) * m_wordsPerRow;
+    }
+
+    const std::uint64_t* getEastWallRow(int row) const
+    {
+        return m_eastWalls.data() + static_cast<std::size_t>(row) * m_wordsPerRow;
+    }
+
     /**
      * Integers representing the four cardinal directions
      *     0: North, 1: South, 2: East, 3: West
     */
-    static const int NORTH_DIRECTION = 0;
-    static const int SOUTH_DIRECTION = 1;
-    static const int EAST_DIRECTION = 2;
-    static const int WEST_DIRECTION = 3;
+    static constexpr int NORTH_DIRECTION = 0;
+    static constexpr int SOUTH_DIRECTION = 1;
+    static constexpr int EAST_DIRECTION = 2;
+    static constexpr int WEST_DIRECTION = 3;
 
     /**
      * Placeholder values denoting invalid or uninitialized variables
     */
-    static const int INVALID_CARDINAL_DIRECTION = -1;
-    static const int INVALID_ROW_COL = -1;
+    static constexpr int INVALID_CARDINAL_DIRECTION = -1;
+    static constexpr int INVALID_ROW_COL = -1;
 
 private:
-    Cell** m_cellsGrid;
+    /**
+     * Packed cell state, one byte per cell, stored row-major
+     *     m_cellStates: exits and path label of each cell, see Cell::EXITS_MASK and Cell::PATH_BIT
+     *     Tremaux marks are not part of the maze, solvers keep their own (see TremauxContext)
+    */
+    std::vector<std::uint8_t> m_cellStates;
     
     // Number of rows and number of columns should each always be at least 2 in order to ensure a suitable maze
     const int ROWCELLS;
     const int COLCELLS;
 
-    // Tuple: <cellA row index, cellA col index, cellB row index, cellB col index>
-    std::map<std::tuple<int, int, int, int>, Wall> m_neighborsToWallMap;
+    /**
+     * Bitplanes of open walls, one bit per cell, stored row-major with each row padded to a
+     * whole number of 64-bit words
+     *     m_southWalls: bit (row, col) is set if the wall between (row, col) and (row + 1, col) is open
+     *     m_eastWalls: bit (row, col) is set if the wall between (row, col) and (row, col + 1) is open
+    */
+    std::size_t m_wordsPerRow;
+    std::vector<std::uint64_t> m_southWalls;
+    std::vector<std::uint64_t> m_eastWalls;
 
     int m_entranceCoords[2] = {INVALID_ROW_COL, INVALID_ROW_COL};
     int m_exitCoords[2] = {INVALID_ROW_COL, INVALID_ROW_COL};
+
+    // Index of cell (row, col) in the packed cell state arrays
+    std::size_t cellIndex(int row, int col) const
+    {
+        return static_cast<std::size_t>(row) * static_cast<std::size_t>(COLCELLS) + static_cast<std::size_t>(col);
+    }
+
+    // Word index and bit mask of cell (row, col) in a wall bitplane
+    std::size_t wallWordIndex(int row, int col) const
+    {
+        return static_cast<std::size_t>(row) * m_wordsPerRow + (static_cast<std::size_t>(col) >> 6);
+    }
+
+    static std::uint64_t wallBitMask(int col)
+    {
+        return std::uint64_t(1) << (col & 63);
+    }
+
+    bool isBitSet(const std::vector<std::uint64_t>& bitplane, int row, int col) const
+    {
+        return (bitplane[wallWordIndex(row, col)] & wallBitMask(col)) != 0;
+    }
 };
\ No newline at end of file
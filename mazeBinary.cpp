@@ -0,0 +1,423 @@
+/*mazeBinary.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Binary Maze Format
+ * 
+ * Versioned, compact binary file format for mazes, and a memory-mapped reader for it
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazeBinary.h"
+#include "maze.h"
+
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <tuple>
+
+const char MAZE_BINARY_MAGIC[8] = { 'M', 'A', 'Z', 'E', 'G', 'R', 'I', 'D' };
+const char MAZE_PATH_BINARY_MAGIC[8] = { 'M', 'A', 'Z', 'E', 'P', 'A', 'T', 'H' };
+
+/**--------------------------------------------------------------------------------------
+ * storeLittleEndian() / loadLittleEndian()
+ * 
+ * Encodes or decodes an unsigned integer of numBytes bytes as little-endian, whatever the 
+ * byte order of the machine
+ * --------------------------------------------------------------------------------------
+*/
+void storeLittleEndian(std::uint8_t* bytes, std::uint64_t value, int numBytes)
+{
+    for(int i = 0; i < numBytes; i++)
+    {
+        bytes[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+std::uint64_t loadLittleEndian(const std::uint8_t* bytes, int numBytes)
+{
+    std::uint64_t value = 0;
+    for(int i = 0; i < numBytes; i++)
+    {
+        value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**--------------------------------------------------------------------------------------
+ * makeMazeBinaryHeader()
+ * 
+ * Fills out the section offsets and record size of a header from its dimensions and flags
+ * 
+ * @param[in,out] header Header with its dimensions and flags set, updated with the path 
+ * offset and the size of the record
+ * --------------------------------------------------------------------------------------
+*/
+void makeMazeBinaryHeader(MazeBinaryHeader& header)
+{
+    std::uint64_t wallBytes = header.numRows * 16 * header.wordsPerRow();
+    std::uint64_t pathBytes = header.numRows * 8 * header.wordsPerRow();
+
+    if(header.flags & MAZE_BINARY_HAS_PATH)
+    {
+        header.pathOffset = MAZE_BINARY_HEADER_BYTES + wallBytes;
+        header.totalBytes = header.pathOffset + pathBytes;
+    }
+    else
+    {
+        header.pathOffset = 0;
+        header.totalBytes = MAZE_BINARY_HEADER_BYTES + wallBytes;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * encodeMazeBinaryHeader()
+ * 
+ * Encodes a header into MAZE_BINARY_HEADER_BYTES bytes
+ * 
+ * @param[in]   header  Header to encode, see makeMazeBinaryHeader()
+ * @param[out]  bytes   Buffer of at least MAZE_BINARY_HEADER_BYTES bytes
+ * --------------------------------------------------------------------------------------
+*/
+void encodeMazeBinaryHeader(const MazeBinaryHeader& header, std::uint8_t* bytes)
+{
+    std::memset(bytes, 0, MAZE_BINARY_HEADER_BYTES);
+    std::memcpy(bytes, MAZE_BINARY_MAGIC, sizeof(MAZE_BINARY_MAGIC));
+    storeLittleEndian(bytes + 8, MAZE_BINARY_VERSION, 4);
+    storeLittleEndian(bytes + 12, MAZE_BINARY_HEADER_BYTES, 4);
+    storeLittleEndian(bytes + 16, header.numRows, 8);
+    storeLittleEndian(bytes + 24, header.numCols, 8);
+    storeLittleEndian(bytes + 32, static_cast<std::uint64_t>(header.entranceRow), 8);
+    storeLittleEndian(bytes + 40, static_cast<std::uint64_t>(header.entranceCol), 8);
+    storeLittleEndian(bytes + 48, static_cast<std::uint64_t>(header.exitRow), 8);
+    storeLittleEndian(bytes + 56, static_cast<std::uint64_t>(header.exitCol), 8);
+    storeLittleEndian(bytes + 64, header.seed, 8);
+    storeLittleEndian(bytes + 72, header.flags, 4);
+    storeLittleEndian(bytes + 80, header.pathOffset, 8);
+    storeLittleEndian(bytes + 88, header.totalBytes, 8);
+}
+
+/**--------------------------------------------------------------------------------------
+ * writeMazeBinaryHeader()
+ * 
+ * Writes an encoded header to a stream
+ * 
+ * @param[in,out]   outfile Stream to write to
+ * @param[in]       header  Header to write, see makeMazeBinaryHeader()
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazeBinaryHeader(std::ostream& outfile, const MazeBinaryHeader& header)
+{
+    std::uint8_t bytes[MAZE_BINARY_HEADER_BYTES];
+    encodeMazeBinaryHeader(header, bytes);
+    outfile.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+/**--------------------------------------------------------------------------------------
+ * parseMazeBinaryHeader()
+ * 
+ * Decodes and checks the header of a binary maze record
+ * 
+ * @param[in]   data    Start of the record
+ * @param[in]   size    Number of bytes available from the start of the record
+ * @param[out]  header  Decoded header
+ * @return true if the header is valid and the whole record fits in size bytes
+ * --------------------------------------------------------------------------------------
+*/
+bool parseMazeBinaryHeader(const std::uint8_t* data, std::size_t size, MazeBinaryHeader& header)
+{
+    if(size < MAZE_BINARY_HEADER_BYTES || std::memcmp(data, MAZE_BINARY_MAGIC, sizeof(MAZE_BINARY_MAGIC)) != 0)
+    {
+        std::cerr << "ERROR: parseMazeBinaryHeader() did not find a binary maze header" << std::endl;
+        return false;
+    }
+
+    std::uint64_t version = loadLittleEndian(data + 8, 4);
+    std::uint64_t headerBytes = loadLittleEndian(data + 12, 4);
+    if(version != MAZE_BINARY_VERSION || headerBytes != MAZE_BINARY_HEADER_BYTES)
+    {
+        std::cerr << "ERROR: parseMazeBinaryHeader() does not support binary maze version " << version << std::endl;
+        return false;
+    }
+
+    header.numRows = loadLittleEndian(data + 16, 8);
+    header.numCols = loadLittleEndian(data + 24, 8);
+    header.entranceRow = static_cast<std::int64_t>(loadLittleEndian(data + 32, 8));
+    header.entranceCol = static_cast<std::int64_t>(loadLittleEndian(data + 40, 8));
+    header.exitRow = static_cast<std::int64_t>(loadLittleEndian(data + 48, 8));
+    header.exitCol = static_cast<std::int64_t>(loadLittleEndian(data + 56, 8));
+    header.seed = loadLittleEndian(data + 64, 8);
+    header.flags = static_cast<std::uint32_t>(loadLittleEndian(data + 72, 4));
+
+    // The offsets must match the ones the dimensions and flags give
+    MazeBinaryHeader expected = header;
+    makeMazeBinaryHeader(expected);
+    header.pathOffset = loadLittleEndian(data + 80, 8);
+    header.totalBytes = loadLittleEndian(data + 88, 8);
+    if(header.numRows == 0 || header.numCols == 0 || header.numCols > (std::uint64_t(1) << 58) || header.numRows > (std::uint64_t(1) << 58) / header.wordsPerRow() || \
+       header.pathOffset != expected.pathOffset || header.totalBytes != expected.totalBytes)
+    {
+        std::cerr << "ERROR: parseMazeBinaryHeader() found inconsistent dimensions or offsets" << std::endl;
+        return false;
+    }
+
+    if(header.totalBytes > size)
+    {
+        std::cerr << "ERROR: parseMazeBinaryHeader() found a truncated record, " << size << " of " << header.totalBytes << " bytes" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * mazePathBinaryBytes()
+ * 
+ * Returns the size of the binary path record of a path
+ * 
+ * @param[in] path Path to be encoded
+ * @return the size of the record in bytes, header included
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t mazePathBinaryBytes(const MazePath& path)
+{
+    return MAZE_PATH_BINARY_HEADER_BYTES + 8 * ((path.getNumMoves() + 31) / 32);
+}
+
+/**--------------------------------------------------------------------------------------
+ * encodeMazePathBinary()
+ * 
+ * Encodes a path into a binary path record, see the format description in mazeBinary.h
+ * 
+ * @param[in]   path    Path to encode
+ * @param[out]  bytes   Buffer of at least mazePathBinaryBytes(path) bytes
+ * --------------------------------------------------------------------------------------
+*/
+void encodeMazePathBinary(const MazePath& path, std::uint8_t* bytes)
+{
+    std::tuple<int, int> startCoords = path.getStart();
+
+    std::memset(bytes, 0, MAZE_PATH_BINARY_HEADER_BYTES);
+    std::memcpy(bytes, MAZE_PATH_BINARY_MAGIC, sizeof(MAZE_PATH_BINARY_MAGIC));
+    storeLittleEndian(bytes + 8, MAZE_PATH_BINARY_VERSION, 4);
+    storeLittleEndian(bytes + 12, MAZE_PATH_BINARY_HEADER_BYTES, 4);
+    storeLittleEndian(bytes + 16, static_cast<std::uint64_t>(static_cast<std::int64_t>(std::get<0>(startCoords))), 8);
+    storeLittleEndian(bytes + 24, static_cast<std::uint64_t>(static_cast<std::int64_t>(std::get<1>(startCoords))), 8);
+    storeLittleEndian(bytes + 32, path.getNumMoves(), 8);
+
+    const std::vector<std::uint64_t>& moveWords = path.getMoveWords();
+    for(std::size_t word = 0; word < moveWords.size(); word++)
+    {
+        storeLittleEndian(bytes + MAZE_PATH_BINARY_HEADER_BYTES + 8 * word, moveWords[word], 8);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * parseMazePathBinary()
+ * 
+ * Decodes and checks a binary path record
+ *     Every cell of the path must have a row and column an int can hold
+ * 
+ * @param[in]   data    Start of the record
+ * @param[in]   size    Number of bytes available from the start of the record
+ * @param[out]  path    Decoded path, left empty if the record is not valid
+ * @return true if the record is valid and fits in size bytes
+ * --------------------------------------------------------------------------------------
+*/
+bool parseMazePathBinary(const std::uint8_t* data, std::size_t size, MazePath& path)
+{
+    path.clear();
+    if(size < MAZE_PATH_BINARY_HEADER_BYTES || std::memcmp(data, MAZE_PATH_BINARY_MAGIC, sizeof(MAZE_PATH_BINARY_MAGIC)) != 0)
+    {
+        std::cerr << "ERROR: parseMazePathBinary() did not find a binary path header" << std::endl;
+        return false;
+    }
+
+    std::uint64_t version = loadLittleEndian(data + 8, 4);
+    std::uint64_t headerBytes = loadLittleEndian(data + 12, 4);
+    if(version != MAZE_PATH_BINARY_VERSION || headerBytes != MAZE_PATH_BINARY_HEADER_BYTES)
+    {
+        std::cerr << "ERROR: parseMazePathBinary() does not support binary path version " << version << std::endl;
+        return false;
+    }
+
+    std::int64_t row = static_cast<std::int64_t>(loadLittleEndian(data + 16, 8));
+    std::int64_t col = static_cast<std::int64_t>(loadLittleEndian(data + 24, 8));
+    std::uint64_t numMoves = loadLittleEndian(data + 32, 8);
+    const std::int64_t maxRowCol = std::numeric_limits<int>::max();
+    bool isEmpty = row == Maze::INVALID_ROW_COL && col == Maze::INVALID_ROW_COL && numMoves == 0;
+    if(!isEmpty && (row < 0 || col < 0 || row > maxRowCol || col > maxRowCol))
+    {
+        std::cerr << "ERROR: parseMazePathBinary() found a start cell outside of any maze: (Row: " << row << ", Col: " << col << ")" << std::endl;
+        return false;
+    }
+
+    if(numMoves > (size - MAZE_PATH_BINARY_HEADER_BYTES) / 8 * 32)
+    {
+        std::cerr << "ERROR: parseMazePathBinary() found a truncated record of " << numMoves << " moves in " << size << " bytes" << std::endl;
+        return false;
+    }
+
+    if(isEmpty)
+    {
+        return true;
+    }
+
+    path.reset(static_cast<int>(row), static_cast<int>(col));
+    std::uint64_t word = 0;
+    for(std::uint64_t position = 0; position < numMoves; position++)
+    {
+        if((position & 31) == 0)
+        {
+            word = loadLittleEndian(data + MAZE_PATH_BINARY_HEADER_BYTES + 8 * (position >> 5), 8);
+        }
+        int dir = static_cast<int>((word >> (2 * (position & 31))) & 3);
+
+        // Checked in 64 bits so a bad path cannot overflow the int row and column
+        int nextRow = 0;
+        int nextCol = 0;
+        MazePath::stepRowCol(dir, nextRow, nextCol);
+        row += nextRow;
+        col += nextCol;
+        if(row < 0 || col < 0 || row > maxRowCol || col > maxRowCol)
+        {
+            std::cerr << "ERROR: parseMazePathBinary() found a path leaving every maze at move " << position << std::endl;
+            path.clear();
+            return false;
+        }
+        path.appendMove(dir);
+    }
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates a view with no file mapped
+ * --------------------------------------------------------------------------------------
+*/
+MappedMaze::MappedMaze()
+    : m_data(nullptr)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * Destructor
+ * 
+ * Unmaps the file, if one is mapped
+ * --------------------------------------------------------------------------------------
+*/
+MappedMaze::~MappedMaze()
+{
+    close();
+}
+
+/**--------------------------------------------------------------------------------------
+ * open()
+ * 
+ * Maps a binary maze file and checks its first record
+ * 
+ * @param[in] fileName Name of the file to map
+ * @return true if the file was mapped and holds a valid maze record
+ * --------------------------------------------------------------------------------------
+*/
+bool MappedMaze::open(const std::string& fileName)
+{
+    close();
+
+    if(!m_file.open(fileName))
+    {
+        return false;
+    }
+    m_data = m_file.getData();
+
+    if(!parseMazeBinaryHeader(m_data, m_file.getSize(), m_header))
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * close()
+ * 
+ * Unmaps the file, if one is mapped
+ * --------------------------------------------------------------------------------------
+*/
+void MappedMaze::close()
+{
+    m_file.close();
+    m_data = nullptr;
+    m_header = MazeBinaryHeader();
+}
+
+/**--------------------------------------------------------------------------------------
+ * isWallOpen()
+ * 
+ * Checks if the wall on the given side of a cell is open
+ *     Walls facing the maze border are always closed
+ * 
+ * @param[in] row Row index of cell
+ * @param[in] col Column index of cell
+ * @param[in] dir Cardinal direction of the wall to check, see Maze
+ * @return true if there is a passageway in the given direction, false otherwise
+ * --------------------------------------------------------------------------------------
+*/
+bool MappedMaze::isWallOpen(std::uint64_t row, std::uint64_t col, int dir) const
+{
+    switch(dir)
+    {
+        case Maze::NORTH_DIRECTION:
+            return row > 0 && isBitSet(getSouthWallRow(row - 1), col);
+        case Maze::SOUTH_DIRECTION:
+            return row + 1 < m_header.numRows && isBitSet(getSouthWallRow(row), col);
+        case Maze::EAST_DIRECTION:
+            return col + 1 < m_header.numCols && isBitSet(getEastWallRow(row), col);
+        case Maze::WEST_DIRECTION:
+            return col > 0 && isBitSet(getEastWallRow(row), col - 1);
+        default:
+            return false;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * isCellOnPath()
+ * 
+ * Checks if a cell is on the path stored in the file
+ * 
+ * @param[in] row Row index of cell
+ * @param[in] col Column index of cell
+ * @return true if the file has a path and the cell is on it, false otherwise
+ * --------------------------------------------------------------------------------------
+*/
+bool MappedMaze::isCellOnPath(std::uint64_t row, std::uint64_t col) const
+{
+    const std::uint8_t* pathRow = getPathRow(row);
+    return pathRow != nullptr && isBitSet(pathRow, col);
+}
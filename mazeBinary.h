@@ -0,0 +1,330 @@
+/*mazeBinary.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Binary Maze Format
+ * 
+ * Versioned, compact binary file format for mazes, and a memory-mapped reader for it
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "mappedFile.h"
+#include "mazePath.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Binary maze file format, version 1 (".mzb")
+ *     Every multi-byte value is little-endian. A file holds one maze record; batch shards 
+ *     hold several records back to back, each totalBytes long
+ * 
+ *     Header, MAZE_BINARY_HEADER_BYTES bytes:
+ *         offset  0: char[8]  magic, "MAZEGRID"
+ *         offset  8: uint32   version, MAZE_BINARY_VERSION
+ *         offset 12: uint32   header size in bytes
+ *         offset 16: uint64   number of rows
+ *         offset 24: uint64   number of columns
+ *         offset 32: int64    entrance row, -1 if there is no entrance
+ *         offset 40: int64    entrance column, -1 if there is no entrance
+ *         offset 48: int64    exit row, -1 if there is no exit
+ *         offset 56: int64    exit column, -1 if there is no exit
+ *         offset 64: uint64   seed the maze was generated from, see MAZE_BINARY_HAS_SEED
+ *         offset 72: uint32   flags, MAZE_BINARY_HAS_SEED | MAZE_BINARY_HAS_PATH
+ *         offset 76: uint32   reserved, 0
+ *         offset 80: uint64   offset of the path section from the start of the record, 0 
+ *                             if there is no path
+ *         offset 88: uint64   size of the whole record in bytes
+ * 
+ *     Wall section, right after the header:
+ *         For every row, wordsPerRow south words, then wordsPerRow east words, where 
+ *         wordsPerRow = (columns + 63) / 64. Bit (col % 64) of word (col / 64) is set if 
+ *         the wall on that side of the cell is open. Since words are little-endian, this is 
+ *         bit (col % 8) of byte (col / 8) of the row's plane
+ * 
+ *     Path section, if MAZE_BINARY_HAS_PATH is set:
+ *         For every row, wordsPerRow words, with the bit of a cell set if it is on the path
+ * 
+ * Every section is made of whole 64-bit words and rows can be found without reading the 
+ * rows before them, so a mapped file can be read in place
+*/
+const std::uint32_t MAZE_BINARY_VERSION = 1;
+const std::size_t MAZE_BINARY_HEADER_BYTES = 96;
+const std::uint32_t MAZE_BINARY_HAS_SEED = 1;
+const std::uint32_t MAZE_BINARY_HAS_PATH = 2;
+
+/**
+ * Binary path format, version 1 (".mzp")
+ *     A path record holds the ordered path of a solved maze on its own, see MazePath, so 
+ *     it can be read without the maze grid. Every multi-byte value is little-endian
+ * 
+ *     Header, MAZE_PATH_BINARY_HEADER_BYTES bytes:
+ *         offset  0: char[8]  magic, "MAZEPATH"
+ *         offset  8: uint32   version, MAZE_PATH_BINARY_VERSION
+ *         offset 12: uint32   header size in bytes
+ *         offset 16: int64    start row, -1 if the path is empty
+ *         offset 24: int64    start column, -1 if the path is empty
+ *         offset 32: uint64   number of moves, one fewer than the number of cells
+ * 
+ *     Move section, right after the header:
+ *         (moves + 31) / 32 words, move i in bits 2 * (i % 32) and up of word i / 32, one 
+ *         of the Maze directions. The unused bits of the last word are 0
+*/
+const std::uint32_t MAZE_PATH_BINARY_VERSION = 1;
+const std::size_t MAZE_PATH_BINARY_HEADER_BYTES = 40;
+
+/**--------------------------------------------------------------------------------------
+ * MazeBinaryHeader struct
+ * 
+ * Decoded header of a binary maze record, see the format description above
+ * --------------------------------------------------------------------------------------
+*/
+struct MazeBinaryHeader
+{
+    std::uint64_t numRows = 0;
+    std::uint64_t numCols = 0;
+    std::int64_t entranceRow = -1;
+    std::int64_t entranceCol = -1;
+    std::int64_t exitRow = -1;
+    std::int64_t exitCol = -1;
+    std::uint64_t seed = 0;
+    std::uint32_t flags = 0;
+    std::uint64_t pathOffset = 0;
+    std::uint64_t totalBytes = 0;
+
+    // Number of 64-bit words in one row of one bitplane
+    std::uint64_t wordsPerRow() const
+    {
+        return (numCols + 63) / 64;
+    }
+};
+
+/**--------------------------------------------------------------------------------------
+ * storeLittleEndian() / loadLittleEndian()
+ * 
+ * Encodes or decodes an unsigned integer of numBytes bytes as little-endian, whatever the 
+ * byte order of the machine
+ * --------------------------------------------------------------------------------------
+*/
+void storeLittleEndian(std::uint8_t* bytes, std::uint64_t value, int numBytes);
+std::uint64_t loadLittleEndian(const std::uint8_t* bytes, int numBytes);
+
+/**--------------------------------------------------------------------------------------
+ * makeMazeBinaryHeader()
+ * 
+ * Fills out the section offsets and record size of a header from its dimensions and flags
+ * 
+ * @param[in,out] header Header with its dimensions and flags set, updated with the path 
+ * offset and the size of the record
+ * --------------------------------------------------------------------------------------
+*/
+void makeMazeBinaryHeader(MazeBinaryHeader& header);
+
+/**--------------------------------------------------------------------------------------
+ * encodeMazeBinaryHeader()
+ * 
+ * Encodes a header into MAZE_BINARY_HEADER_BYTES bytes
+ * 
+ * @param[in]   header  Header to encode, see makeMazeBinaryHeader()
+ * @param[out]  bytes   Buffer of at least MAZE_BINARY_HEADER_BYTES bytes
+ * --------------------------------------------------------------------------------------
+*/
+void encodeMazeBinaryHeader(const MazeBinaryHeader& header, std::uint8_t* bytes);
+
+/**--------------------------------------------------------------------------------------
+ * writeMazeBinaryHeader()
+ * 
+ * Writes an encoded header to a stream
+ * 
+ * @param[in,out]   outfile Stream to write to
+ * @param[in]       header  Header to write, see makeMazeBinaryHeader()
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazeBinaryHeader(std::ostream& outfile, const MazeBinaryHeader& header);
+
+/**--------------------------------------------------------------------------------------
+ * parseMazeBinaryHeader()
+ * 
+ * Decodes and checks the header of a binary maze record
+ * 
+ * @param[in]   data    Start of the record
+ * @param[in]   size    Number of bytes available from the start of the record
+ * @param[out]  header  Decoded header
+ * @return true if the header is valid and the whole record fits in size bytes
+ * --------------------------------------------------------------------------------------
+*/
+bool parseMazeBinaryHeader(const std::uint8_t* data, std::size_t size, MazeBinaryHeader& header);
+
+/**--------------------------------------------------------------------------------------
+ * mazePathBinaryBytes()
+ * 
+ * Returns the size of the binary path record of a path
+ * 
+ * @param[in] path Path to be encoded
+ * @return the size of the record in bytes, header included
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t mazePathBinaryBytes(const MazePath& path);
+
+/**--------------------------------------------------------------------------------------
+ * encodeMazePathBinary()
+ * 
+ * Encodes a path into a binary path record, see the format description above
+ * 
+ * @param[in]   path    Path to encode
+ * @param[out]  bytes   Buffer of at least mazePathBinaryBytes(path) bytes
+ * --------------------------------------------------------------------------------------
+*/
+void encodeMazePathBinary(const MazePath& path, std::uint8_t* bytes);
+
+/**--------------------------------------------------------------------------------------
+ * parseMazePathBinary()
+ * 
+ * Decodes and checks a binary path record
+ * 
+ * @param[in]   data    Start of the record
+ * @param[in]   size    Number of bytes available from the start of the record
+ * @param[out]  path    Decoded path, left empty if the record is not valid
+ * @return true if the record is valid and fits in size bytes
+ * --------------------------------------------------------------------------------------
+*/
+bool parseMazePathBinary(const std::uint8_t* data, std::size_t size, MazePath& path);
+
+/**--------------------------------------------------------------------------------------
+ * MappedMaze class
+ * 
+ * Read-only view of a binary maze file, mapped into memory instead of being read in
+ *     Walls and path cells are read straight from the mapped bytes, nothing is copied, 
+ *     see MappedFile
+ * --------------------------------------------------------------------------------------
+*/
+class MappedMaze
+{
+public:
+    MappedMaze();
+    ~MappedMaze();
+
+    MappedMaze(const MappedMaze&) = delete;
+    MappedMaze& operator=(const MappedMaze&) = delete;
+
+    /**--------------------------------------------------------------------------------------
+     * open()
+     * 
+     * Maps a binary maze file and checks its first record
+     * 
+     * @param[in] fileName Name of the file to map
+     * @return true if the file was mapped and holds a valid maze record
+     * --------------------------------------------------------------------------------------
+    */
+    bool open(const std::string& fileName);
+
+    /**--------------------------------------------------------------------------------------
+     * close()
+     * 
+     * Unmaps the file, if one is mapped
+     * --------------------------------------------------------------------------------------
+    */
+    void close();
+
+    /**--------------------------------------------------------------------------------------
+     * getHeader()
+     * 
+     * Returns the decoded header of the mapped record
+     * 
+     * @return a constant reference to the header
+     * --------------------------------------------------------------------------------------
+    */
+    const MazeBinaryHeader& getHeader() const
+    {
+        return m_header;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * isWallOpen()
+     * 
+     * Checks if the wall on the given side of a cell is open
+     *     Walls facing the maze border are always closed
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @param[in] dir Cardinal direction of the wall to check, see Maze
+     * @return true if there is a passageway in the given direction, false otherwise
+     * --------------------------------------------------------------------------------------
+    */
+    bool isWallOpen(std::uint64_t row, std::uint64_t col, int dir) const;
+
+    /**--------------------------------------------------------------------------------------
+     * isCellOnPath()
+     * 
+     * Checks if a cell is on the path stored in the file
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @return true if the file has a path and the cell is on it, false otherwise
+     * --------------------------------------------------------------------------------------
+    */
+    bool isCellOnPath(std::uint64_t row, std::uint64_t col) const;
+
+    /**--------------------------------------------------------------------------------------
+     * getSouthWallRow() / getEastWallRow() / getPathRow()
+     * 
+     * Returns the start of a row of one of the bitplanes, wordsPerRow little-endian words
+     * 
+     * @param[in] row Row index
+     * @return a pointer into the mapped file, or nullptr for the path of a file without one
+     * --------------------------------------------------------------------------------------
+    */
+    const std::uint8_t* getSouthWallRow(std::uint64_t row) const
+    {
+        return m_data + MAZE_BINARY_HEADER_BYTES + row * 16 * m_header.wordsPerRow();
+    }
+
+    const std::uint8_t* getEastWallRow(std::uint64_t row) const
+    {
+        return getSouthWallRow(row) + 8 * m_header.wordsPerRow();
+    }
+
+    const std::uint8_t* getPathRow(std::uint64_t row) const
+    {
+        return (m_header.flags & MAZE_BINARY_HAS_PATH) ? m_data + m_header.pathOffset + row * 8 * m_header.wordsPerRow() : nullptr;
+    }
+
+private:
+    // Returns bit col of a row of a bitplane
+    static bool isBitSet(const std::uint8_t* planeRow, std::uint64_t col)
+    {
+        return (planeRow[col >> 3] >> (col & 7)) & 1;
+    }
+
+    MappedFile m_file;
+    const std::uint8_t* m_data;
+    MazeBinaryHeader m_header;
+};
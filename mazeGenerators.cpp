@@ -0,0 +1,553 @@
+/*mazeGenerators.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze generators
+ * 
+ * Registry of the maze generators selectable from main(), and the fast generators that 
+ * trade Wilson's Algorithm's lack of bias for speed: Sidewinder, Kruskal's Algorithm and a 
+ * recursive backtracker
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazeGenerators.h"
+#include "eller.h"
+#include "metrics.h"
+#include "parallelWilson.h"
+#include "wilson.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+/**--------------------------------------------------------------------------------------
+ * mazeGeneratorFromName()
+ * 
+ * Returns the maze generator with the given name
+ * 
+ * @param[in] name One of "wilson", "parallel", "eller", "sidewinder", "kruskal", 
+ *                 "backtracker" or "hybrid"
+ * @return the matching generator, or MAZE_GENERATOR_INVALID if there is none
+ * --------------------------------------------------------------------------------------
+*/
+int mazeGeneratorFromName(const std::string& name)
+{
+    for(int generatorType = MAZE_GENERATOR_WILSON; generatorType <= MAZE_GENERATOR_HYBRID_WILSON; generatorType++)
+    {
+        if(name == mazeGeneratorName(generatorType))
+        {
+            return generatorType;
+        }
+    }
+
+    return MAZE_GENERATOR_INVALID;
+}
+
+/**--------------------------------------------------------------------------------------
+ * mazeGeneratorName()
+ * 
+ * Returns the name of a maze generator, as given to mazeGeneratorFromName()
+ * 
+ * @param[in] generatorType One of the MAZE_GENERATOR_ constants
+ * @return the name, or "invalid"
+ * --------------------------------------------------------------------------------------
+*/
+const char* mazeGeneratorName(int generatorType)
+{
+    switch(generatorType)
+    {
+        case MAZE_GENERATOR_WILSON:
+            return "wilson";
+        case MAZE_GENERATOR_PARALLEL_WILSON:
+            return "parallel";
+        case MAZE_GENERATOR_ELLER:
+            return "eller";
+        case MAZE_GENERATOR_SIDEWINDER:
+            return "sidewinder";
+        case MAZE_GENERATOR_KRUSKAL:
+            return "kruskal";
+        case MAZE_GENERATOR_BACKTRACKER:
+            return "backtracker";
+        case MAZE_GENERATOR_HYBRID_WILSON:
+            return "hybrid";
+        default:
+            return "invalid";
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * runSidewinder()
+ * 
+ * Given an empty (blank) maze, fills it out row by row with the Sidewinder Algorithm
+ *     The first row is opened into one passage. In every other row, runs of cells are 
+ *     joined eastward, and each run ends at random with a passage north from one of its 
+ *     cells, so every row joins the rows above it
+ * 
+ * @param[in,out]   blankMaze   Maze object with every wall closed, is filled out
+ * @param[in,out]   rng         Random number engine driving the generation
+ * @return the number of walls opened
+ * 
+ * Instantiated in mazeGenerators.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runSidewinder(Maze& blankMaze, RngEngine& rng)
+{
+    METRIC_TIMER(METRIC_SIDEWINDER_TIMER)
+    const int numRows = blankMaze.getROWCELLS();
+    const int numCols = blankMaze.getCOLCELLS();
+    std::uint64_t numOpened = 0;
+
+    for(int col = 0; col + 1 < numCols; col++)
+    {
+        blankMaze.openPassage(0, col, Maze::EAST_DIRECTION);
+        numOpened++;
+    }
+
+    // Coin flips deciding where runs end, taken one bit at a time from 32-bit draws
+    std::uint32_t randomBits = 0;
+    int numRandomBits = 0;
+
+    for(int row = 1; row < numRows; row++)
+    {
+        int runStart = 0;
+        for(int col = 0; col < numCols; col++)
+        {
+            if(numRandomBits == 0)
+            {
+                randomBits = randomBits32(rng);
+                numRandomBits = 32;
+            }
+            bool isRunEnded = (col == numCols - 1) || (randomBits & 1) != 0;
+            randomBits >>= 1;
+            numRandomBits--;
+
+            if(isRunEnded)
+            {
+                int northCol = runStart + static_cast<int>(randomBelow(rng, static_cast<std::uint32_t>(col - runStart + 1)));
+                blankMaze.openPassage(row, northCol, Maze::NORTH_DIRECTION);
+                runStart = col + 1;
+            }
+            else
+            {
+                blankMaze.openPassage(row, col, Maze::EAST_DIRECTION);
+            }
+            numOpened++;
+        }
+    }
+
+    createEntranceAndExit(blankMaze, rng);
+    return numOpened;
+}
+
+/**--------------------------------------------------------------------------------------
+ * KruskalSets struct
+ * 
+ * Union-find over the cells of a maze, in flat arrays of cell indices taken from a 
+ * ScratchArena
+ *     parents: parent of each cell, a cell is the root of its set if it is its own parent
+ *     ranks: upper bound on the height of each root's tree, never more than 64
+ * --------------------------------------------------------------------------------------
+*/
+template <typename CellIndex>
+struct KruskalSets
+{
+    CellIndex* parents;
+    std::uint8_t* ranks;
+
+    KruskalSets(std::size_t numCells, ScratchArena& scratch)
+        : parents(scratch.allocate<CellIndex>(numCells)), ranks(scratch.allocate<std::uint8_t>(numCells))
+    {
+        for(std::size_t cellIndex = 0; cellIndex < numCells; cellIndex++)
+        {
+            parents[cellIndex] = static_cast<CellIndex>(cellIndex);
+            ranks[cellIndex] = 0;
+        }
+    }
+
+    // Root of the set of a cell, halving the path to it on the way
+    CellIndex findSet(CellIndex cellIndex)
+    {
+        while(parents[cellIndex] != cellIndex)
+        {
+            parents[cellIndex] = parents[parents[cellIndex]];
+            cellIndex = parents[cellIndex];
+        }
+        return cellIndex;
+    }
+
+    // Joins the sets of two roots, returns false if they are the same set
+    bool joinSets(CellIndex firstRoot, CellIndex secondRoot)
+    {
+        if(firstRoot == secondRoot)
+        {
+            return false;
+        }
+        if(ranks[firstRoot] < ranks[secondRoot])
+        {
+            std::swap(firstRoot, secondRoot);
+        }
+        parents[secondRoot] = firstRoot;
+        ranks[firstRoot] += (ranks[firstRoot] == ranks[secondRoot]);
+        return true;
+    }
+};
+
+/**--------------------------------------------------------------------------------------
+ * runKruskalWithIndex()
+ * 
+ * Body of runKruskal(), with cell indices stored as the given integer type
+ *     Walls are numbered 2 * cell index for the wall south of the cell and 2 * cell index 
+ *     + 1 for the wall east of it
+ * 
+ * @param[in,out]   blankMaze   Maze object with every wall closed, is filled out
+ * @param[in,out]   rng         Random number engine driving the generation
+ * @param[in,out]   scratch     Arena to take the walls and the union-find from
+ * @return the number of walls visited
+ * --------------------------------------------------------------------------------------
+*/
+template <typename CellIndex, typename RngEngine>
+std::uint64_t runKruskalWithIndex(Maze& blankMaze, RngEngine& rng, ScratchArena& scratch)
+{
+    const int numRows = blankMaze.getROWCELLS();
+    const int numCols = blankMaze.getCOLCELLS();
+    const std::size_t cols = static_cast<std::size_t>(numCols);
+    const std::size_t numCells = blankMaze.getNumCells();
+
+    // Every inner wall, in random order
+    const std::size_t numWalls = 2 * numCells - static_cast<std::size_t>(numRows) - cols;
+    CellIndex* walls = scratch.allocate<CellIndex>(numWalls);
+    std::size_t wallCount = 0;
+    for(std::size_t cellIndex = 0; cellIndex < numCells; cellIndex++)
+    {
+        if(cellIndex + cols < numCells)
+        {
+            walls[wallCount++] = static_cast<CellIndex>(2 * cellIndex);
+        }
+        if(cellIndex % cols != cols - 1)
+        {
+            walls[wallCount++] = static_cast<CellIndex>(2 * cellIndex + 1);
+        }
+    }
+    for(std::size_t i = numWalls; i > 1; i--)
+    {
+        std::swap(walls[i - 1], walls[randomBelow64(rng, i)]);
+    }
+
+    KruskalSets<CellIndex> sets(numCells, scratch);
+    std::size_t numJoined = 0;
+    std::uint64_t numVisited = 0;
+    for(std::size_t i = 0; i < numWalls; i++)
+    {
+        CellIndex wall = walls[i];
+        numVisited++;
+        CellIndex cellIndex = wall >> 1;
+        bool isEastWall = (wall & 1) != 0;
+        CellIndex neighborIndex = isEastWall ? cellIndex + 1 : static_cast<CellIndex>(cellIndex + cols);
+
+        if(sets.joinSets(sets.findSet(cellIndex), sets.findSet(neighborIndex)))
+        {
+            blankMaze.openPassage(static_cast<int>(cellIndex / cols), static_cast<int>(cellIndex % cols), isEastWall ? Maze::EAST_DIRECTION : Maze::SOUTH_DIRECTION);
+
+            // A spanning tree has one wall fewer than cells, the rest of the walls stay closed
+            if(++numJoined == numCells - 1)
+            {
+                break;
+            }
+        }
+    }
+
+    return numVisited;
+}
+
+/**--------------------------------------------------------------------------------------
+ * runKruskal()
+ * 
+ * Given an empty (blank) maze, fills it out with Kruskal's Algorithm
+ *     Every inner wall is visited once in random order, and opened if the cells on either 
+ *     side are not connected yet. Connections are tracked by a union-find over flat 
+ *     arrays, with union by rank and path halving
+ *     Cell indices are 32-bit when the maze is small enough, halving the memory
+ * 
+ * @param[in,out]   blankMaze   Maze object with every wall closed, is filled out
+ * @param[in,out]   rng         Random number engine driving the generation
+ * @param[in,out]   scratch     Arena to take the walls and the union-find from, see 
+ *                              mazeGeneratorScratchBytes(), or nullptr to allocate them 
+ *                              for this maze alone
+ * @return the number of walls visited
+ * 
+ * Instantiated in mazeGenerators.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runKruskal(Maze& blankMaze, RngEngine& rng, ScratchArena* scratch)
+{
+    METRIC_TIMER(METRIC_KRUSKAL_TIMER)
+    std::uint64_t numVisited = 0;
+
+    ScratchArena localScratch;
+    if(scratch == nullptr)
+    {
+        localScratch.reserve(mazeGeneratorScratchBytes(MAZE_GENERATOR_KRUSKAL, blankMaze.getROWCELLS(), blankMaze.getCOLCELLS()));
+        scratch = &localScratch;
+    }
+
+    // Wall numbers go up to twice the number of cells
+    if(blankMaze.getNumCells() <= 0x7FFFFFFFu)
+    {
+        numVisited = runKruskalWithIndex<std::uint32_t>(blankMaze, rng, *scratch);
+    }
+    else
+    {
+        numVisited = runKruskalWithIndex<std::uint64_t>(blankMaze, rng, *scratch);
+    }
+
+    createEntranceAndExit(blankMaze, rng);
+    return numVisited;
+}
+
+/**--------------------------------------------------------------------------------------
+ * runRecursiveBacktracker()
+ * 
+ * Given an empty (blank) maze, fills it out with a randomized depth-first search
+ *     From a random cell, keeps moving to a random neighbor not in the maze yet, and backs 
+ *     up when there is none, until it is back where it started
+ *     Iterative, the explicit stack only holds the direction of each move, one byte each
+ * 
+ * @param[in,out]   blankMaze   Maze object with every wall closed, is filled out
+ * @param[in,out]   rng         Random number engine driving the generation
+ * @param[in,out]   scratch     Arena to take the inMaze bits and the move stack from, see 
+ *                              mazeGeneratorScratchBytes(), or nullptr to allocate them 
+ *                              for this maze alone
+ * @return the number of moves, forward and back
+ * 
+ * Instantiated in mazeGenerators.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runRecursiveBacktracker(Maze& blankMaze, RngEngine& rng, ScratchArena* scratch)
+{
+    METRIC_TIMER(METRIC_BACKTRACKER_TIMER)
+    const int numRows = blankMaze.getROWCELLS();
+    const int numCols = blankMaze.getCOLCELLS();
+    const std::size_t cols = static_cast<std::size_t>(numCols);
+
+    ScratchArena localScratch;
+    if(scratch == nullptr)
+    {
+        localScratch.reserve(mazeGeneratorScratchBytes(MAZE_GENERATOR_BACKTRACKER, numRows, numCols));
+        scratch = &localScratch;
+    }
+
+    // One bit per cell, set once the cell is in the maze
+    const std::size_t numInMazeWords = (blankMaze.getNumCells() + 63) / 64;
+    std::uint64_t* inMaze = scratch->allocate<std::uint64_t>(numInMazeWords);
+    std::fill(inMaze, inMaze + numInMazeWords, std::uint64_t(0));
+    auto isInMaze = [&](std::size_t cellIndex)
+    {
+        return (inMaze[cellIndex >> 6] >> (cellIndex & 63)) & 1;
+    };
+
+    // Directions of the moves that led to the current cell, backing up undoes the last one
+    // Every move forward enters a new cell, so there are fewer moves on the stack than cells
+    std::uint8_t* moves = scratch->allocate<std::uint8_t>(blankMaze.getNumCells());
+    std::size_t numMovesOnStack = 0;
+    std::uint64_t numMoves = 0;
+
+    int curRow = static_cast<int>(randomBelow(rng, static_cast<std::uint32_t>(numRows)));
+    int curCol = static_cast<int>(randomBelow(rng, static_cast<std::uint32_t>(numCols)));
+    std::size_t curIndex = static_cast<std::size_t>(curRow) * cols + static_cast<std::size_t>(curCol);
+    inMaze[curIndex >> 6] |= std::uint64_t(1) << (curIndex & 63);
+
+    while(true)
+    {
+        int validDirs[4];
+        int numValidDirs = 0;
+        if(curRow > 0 && !isInMaze(curIndex - cols))
+        {
+            validDirs[numValidDirs++] = Maze::NORTH_DIRECTION;
+        }
+        if(curRow < numRows - 1 && !isInMaze(curIndex + cols))
+        {
+            validDirs[numValidDirs++] = Maze::SOUTH_DIRECTION;
+        }
+        if(curCol < numCols - 1 && !isInMaze(curIndex + 1))
+        {
+            validDirs[numValidDirs++] = Maze::EAST_DIRECTION;
+        }
+        if(curCol > 0 && !isInMaze(curIndex - 1))
+        {
+            validDirs[numValidDirs++] = Maze::WEST_DIRECTION;
+        }
+
+        int dir = Maze::INVALID_CARDINAL_DIRECTION;
+        if(numValidDirs > 0)
+        {
+            // Moving forward into a new cell
+            dir = (numValidDirs == 1) ? validDirs[0] : validDirs[randomBelow(rng, static_cast<std::uint32_t>(numValidDirs))];
+            blankMaze.openPassage(curRow, curCol, dir);
+            moves[numMovesOnStack++] = static_cast<std::uint8_t>(dir);
+        }
+        else if(numMovesOnStack > 0)
+        {
+            // Backing up, opposite directions only differ in their lowest bit
+            dir = moves[--numMovesOnStack] ^ 1;
+        }
+        else
+        {
+            break;
+        }
+
+        switch(dir)
+        {
+            case Maze::NORTH_DIRECTION:
+                curRow--;
+                curIndex -= cols;
+                break;
+            case Maze::SOUTH_DIRECTION:
+                curRow++;
+                curIndex += cols;
+                break;
+            case Maze::EAST_DIRECTION:
+                curCol++;
+                curIndex++;
+                break;
+            default:
+                curCol--;
+                curIndex--;
+                break;
+        }
+        inMaze[curIndex >> 6] |= std::uint64_t(1) << (curIndex & 63);
+        numMoves++;
+    }
+
+    createEntranceAndExit(blankMaze, rng);
+    return numMoves;
+}
+
+/**--------------------------------------------------------------------------------------
+ * runMazeGenerator()
+ * 
+ * Given an empty (blank) maze, fills it out with the given generator and places its 
+ * entrance and exit
+ * 
+ * @param[in,out]   blankMaze               Maze object with every wall closed, is filled out
+ * @param[in]       generatorType           One of the MAZE_GENERATOR_ constants
+ * @param[in,out]   rng                     Random number engine driving the generation
+ * @param[in]       numThreads              Number of threads for MAZE_GENERATOR_PARALLEL_WILSON, 
+ *                                          every other generator runs on the calling thread
+ * @param[in]       aldousBroderFraction    Fraction of the cells MAZE_GENERATOR_HYBRID_WILSON 
+ *                                          adds before switching to Wilson's Algorithm
+ * @param[in,out]   scratch                 Arena the Wilson, Kruskal and backtracker 
+ *                                          generators take their scratch from, reset by 
+ *                                          the caller between mazes, or nullptr
+ * @return the work done by the generator: random walk steps for Wilson's Algorithm, 
+ * otherwise what the generator returns
+ * 
+ * Instantiated in mazeGenerators.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runMazeGenerator(Maze& blankMaze, int generatorType, RngEngine& rng, int numThreads, double aldousBroderFraction, ScratchArena* scratch)
+{
+    switch(generatorType)
+    {
+        case MAZE_GENERATOR_WILSON:
+            return runWilson(blankMaze, rng, 0.0, scratch);
+        case MAZE_GENERATOR_PARALLEL_WILSON:
+            return runParallelWilson(blankMaze, rng, numThreads);
+        case MAZE_GENERATOR_ELLER:
+            return runEller(blankMaze, rng);
+        case MAZE_GENERATOR_SIDEWINDER:
+            return runSidewinder(blankMaze, rng);
+        case MAZE_GENERATOR_KRUSKAL:
+            return runKruskal(blankMaze, rng, scratch);
+        case MAZE_GENERATOR_BACKTRACKER:
+            return runRecursiveBacktracker(blankMaze, rng, scratch);
+        case MAZE_GENERATOR_HYBRID_WILSON:
+            return runWilson(blankMaze, rng, aldousBroderFraction, scratch);
+        default:
+            std::cerr << "ERROR: runMazeGenerator() was given an unknown generator: " << generatorType << std::endl;
+            return 0;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * mazeGeneratorScratchBytes()
+ * 
+ * Returns the room the given generator takes from the scratch arena of runMazeGenerator(), 
+ * so an arena reserved up front with it fills out every maze of that size without 
+ * allocating
+ * 
+ * @param[in] generatorType One of the MAZE_GENERATOR_ constants
+ * @param[in] numRows       Number of rows in the maze
+ * @param[in] numCols       Number of columns in the maze
+ * @return the room in bytes, 0 for the generators that do not use the arena
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t mazeGeneratorScratchBytes(int generatorType, int numRows, int numCols)
+{
+    const std::size_t numCells = static_cast<std::size_t>(numRows) * static_cast<std::size_t>(numCols);
+    switch(generatorType)
+    {
+        case MAZE_GENERATOR_WILSON:
+        case MAZE_GENERATOR_HYBRID_WILSON:
+            return wilsonScratchBytes(numRows, numCols);
+        case MAZE_GENERATOR_KRUSKAL:
+        {
+            // Wall list plus parents and ranks, with the wider cell index past 2^31 cells
+            const std::size_t numWalls = numCells > 0 ? 2 * numCells - static_cast<std::size_t>(numRows) - numCols : 0;
+            if(numCells <= 0x7FFFFFFFu)
+            {
+                return ScratchArena::bytesFor<std::uint32_t>(numWalls) + ScratchArena::bytesFor<std::uint32_t>(numCells) + \
+                       ScratchArena::bytesFor<std::uint8_t>(numCells);
+            }
+            return ScratchArena::bytesFor<std::uint64_t>(numWalls) + ScratchArena::bytesFor<std::uint64_t>(numCells) + \
+                   ScratchArena::bytesFor<std::uint8_t>(numCells);
+        }
+        case MAZE_GENERATOR_BACKTRACKER:
+            return ScratchArena::bytesFor<std::uint64_t>((numCells + 63) / 64) + ScratchArena::bytesFor<std::uint8_t>(numCells);
+        default:
+            return 0;
+    }
+}
+
+// Explicit instantiations for the engines in rng.h
+template std::uint64_t runSidewinder<SplitMix64>(Maze& blankMaze, SplitMix64& rng);
+template std::uint64_t runSidewinder<Xoshiro256StarStar>(Maze& blankMaze, Xoshiro256StarStar& rng);
+template std::uint64_t runSidewinder<Pcg32>(Maze& blankMaze, Pcg32& rng);
+
+template std::uint64_t runKruskal<SplitMix64>(Maze& blankMaze, SplitMix64& rng, ScratchArena* scratch);
+template std::uint64_t runKruskal<Xoshiro256StarStar>(Maze& blankMaze, Xoshiro256StarStar& rng, ScratchArena* scratch);
+template std::uint64_t runKruskal<Pcg32>(Maze& blankMaze, Pcg32& rng, ScratchArena* scratch);
+
+template std::uint64_t runRecursiveBacktracker<SplitMix64>(Maze& blankMaze, SplitMix64& rng, ScratchArena* scratch);
+template std::uint64_t runRecursiveBacktracker<Xoshiro256StarStar>(Maze& blankMaze, Xoshiro256StarStar& rng, ScratchArena* scratch);
+template std::uint64_t runRecursiveBacktracker<Pcg32>(Maze& blankMaze, Pcg32& rng, ScratchArena* scratch);
+
+template std::uint64_t runMazeGenerator<SplitMix64>(Maze& blankMaze, int generatorType, SplitMix64& rng, int numThreads, double aldousBroderFraction, ScratchArena* scratch);
+template std::uint64_t runMazeGenerator<Xoshiro256StarStar>(Maze& blankMaze, int generatorType, Xoshiro256StarStar& rng, int numThreads, double aldousBroderFraction, ScratchArena* scratch);
+template std::uint64_t runMazeGenerator<Pcg32>(Maze& blankMaze, int generatorType, Pcg32& rng, int numThreads, double aldousBroderFraction, ScratchArena* scratch);
@@ -0,0 +1,192 @@
+/*mazeGenerators.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze generators
+ * 
+ * Registry of the maze generators selectable from main(), and the fast generators that 
+ * trade Wilson's Algorithm's lack of bias for speed: Sidewinder, Kruskal's Algorithm and a 
+ * recursive backtracker
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "maze.h"
+#include "rng.h"
+#include "scratchArena.h"
+#include "wilson.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Integers representing the maze generators selectable from main(), see runMazeGenerator()
+ *     MAZE_GENERATOR_WILSON: runWilson(), unbiased, the default
+ *     MAZE_GENERATOR_PARALLEL_WILSON: runParallelWilson(), unbiased, spread over threads
+ *     MAZE_GENERATOR_ELLER: runEller(), linear time, passages favor running along the rows
+ *     MAZE_GENERATOR_SIDEWINDER: runSidewinder(), linear time, the first row is one long 
+ *     passage and every other row has a passage up, so paths north are straight
+ *     MAZE_GENERATOR_KRUSKAL: runKruskal(), close to linear time, many short dead ends
+ *     MAZE_GENERATOR_BACKTRACKER: runRecursiveBacktracker(), linear time, long winding 
+ *     passages with few dead ends
+ *     MAZE_GENERATOR_HYBRID_WILSON: runWilson() started off with the Aldous-Broder 
+ *     Algorithm, about twice as fast but biased, not every maze is equally likely
+*/
+const int MAZE_GENERATOR_WILSON = 0;
+const int MAZE_GENERATOR_PARALLEL_WILSON = 1;
+const int MAZE_GENERATOR_ELLER = 2;
+const int MAZE_GENERATOR_SIDEWINDER = 3;
+const int MAZE_GENERATOR_KRUSKAL = 4;
+const int MAZE_GENERATOR_BACKTRACKER = 5;
+const int MAZE_GENERATOR_HYBRID_WILSON = 6;
+const int MAZE_GENERATOR_INVALID = -1;
+
+/**--------------------------------------------------------------------------------------
+ * mazeGeneratorFromName()
+ * 
+ * Returns the maze generator with the given name
+ * 
+ * @param[in] name One of "wilson", "parallel", "eller", "sidewinder", "kruskal", 
+ *                 "backtracker" or "hybrid"
+ * @return the matching generator, or MAZE_GENERATOR_INVALID if there is none
+ * --------------------------------------------------------------------------------------
+*/
+int mazeGeneratorFromName(const std::string& name);
+
+/**--------------------------------------------------------------------------------------
+ * mazeGeneratorName()
+ * 
+ * Returns the name of a maze generator, as given to mazeGeneratorFromName()
+ * 
+ * @param[in] generatorType One of the MAZE_GENERATOR_ constants
+ * @return the name, or "invalid"
+ * --------------------------------------------------------------------------------------
+*/
+const char* mazeGeneratorName(int generatorType);
+
+/**--------------------------------------------------------------------------------------
+ * runSidewinder()
+ * 
+ * Given an empty (blank) maze, fills it out row by row with the Sidewinder Algorithm
+ *     The first row is opened into one passage. In every other row, runs of cells are 
+ *     joined eastward, and each run ends at random with a passage north from one of its 
+ *     cells, so every row joins the rows above it
+ * 
+ * @param[in,out]   blankMaze   Maze object with every wall closed, is filled out
+ * @param[in,out]   rng         Random number engine driving the generation
+ * @return the number of walls opened
+ * 
+ * Instantiated in mazeGenerators.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runSidewinder(Maze& blankMaze, RngEngine& rng);
+
+/**--------------------------------------------------------------------------------------
+ * runKruskal()
+ * 
+ * Given an empty (blank) maze, fills it out with Kruskal's Algorithm
+ *     Every inner wall is visited once in random order, and opened if the cells on either 
+ *     side are not connected yet. Connections are tracked by a union-find over flat 
+ *     arrays, with union by rank and path halving
+ *     Cell indices are 32-bit when the maze is small enough, halving the memory
+ * 
+ * @param[in,out]   blankMaze   Maze object with every wall closed, is filled out
+ * @param[in,out]   rng         Random number engine driving the generation
+ * @param[in,out]   scratch     Arena to take the walls and the union-find from, see 
+ *                              mazeGeneratorScratchBytes(), or nullptr to allocate them 
+ *                              for this maze alone
+ * @return the number of walls visited
+ * 
+ * Instantiated in mazeGenerators.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runKruskal(Maze& blankMaze, RngEngine& rng, ScratchArena* scratch = nullptr);
+
+/**--------------------------------------------------------------------------------------
+ * runRecursiveBacktracker()
+ * 
+ * Given an empty (blank) maze, fills it out with a randomized depth-first search
+ *     From a random cell, keeps moving to a random neighbor not in the maze yet, and backs 
+ *     up when there is none, until it is back where it started
+ *     Iterative, the explicit stack only holds the direction of each move, one byte each
+ * 
+ * @param[in,out]   blankMaze   Maze object with every wall closed, is filled out
+ * @param[in,out]   rng         Random number engine driving the generation
+ * @param[in,out]   scratch     Arena to take the inMaze bits and the move stack from, see 
+ *                              mazeGeneratorScratchBytes(), or nullptr to allocate them 
+ *                              for this maze alone
+ * @return the number of moves, forward and back
+ * 
+ * Instantiated in mazeGenerators.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runRecursiveBacktracker(Maze& blankMaze, RngEngine& rng, ScratchArena* scratch = nullptr);
+
+/**--------------------------------------------------------------------------------------
+ * runMazeGenerator()
+ * 
+ * Given an empty (blank) maze, fills it out with the given generator and places its 
+ * entrance and exit
+ * 
+ * @param[in,out]   blankMaze               Maze object with every wall closed, is filled out
+ * @param[in]       generatorType           One of the MAZE_GENERATOR_ constants
+ * @param[in,out]   rng                     Random number engine driving the generation
+ * @param[in]       numThreads              Number of threads for MAZE_GENERATOR_PARALLEL_WILSON, 
+ *                                          every other generator runs on the calling thread
+ * @param[in]       aldousBroderFraction    Fraction of the cells MAZE_GENERATOR_HYBRID_WILSON 
+ *                                          adds before switching to Wilson's Algorithm
+ * @param[in,out]   scratch                 Arena the Wilson, Kruskal and backtracker 
+ *                                          generators take their scratch from, reset by 
+ *                                          the caller between mazes, or nullptr
+ * @return the work done by the generator: random walk steps for Wilson's Algorithm, 
+ * otherwise what the generator returns
+ * 
+ * Instantiated in mazeGenerators.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runMazeGenerator(Maze& blankMaze, int generatorType, RngEngine& rng, int numThreads, double aldousBroderFraction = DEFAULT_ALDOUS_BRODER_FRACTION, \
+                               ScratchArena* scratch = nullptr);
+
+/**--------------------------------------------------------------------------------------
+ * mazeGeneratorScratchBytes()
+ * 
+ * Returns the room the given generator takes from the scratch arena of runMazeGenerator(), 
+ * so an arena reserved up front with it fills out every maze of that size without 
+ * allocating
+ * 
+ * @param[in] generatorType One of the MAZE_GENERATOR_ constants
+ * @param[in] numRows       Number of rows in the maze
+ * @param[in] numCols       Number of columns in the maze
+ * @return the room in bytes, 0 for the generators that do not use the arena
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t mazeGeneratorScratchBytes(int generatorType, int numRows, int numCols);
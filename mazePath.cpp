@@ -0,0 +1,200 @@
+/*mazePath.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze Path
+ * 
+ * Ordered path through a maze, packed as its start cell and 2 bits per move
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazePath.h"
+
+#include <iostream>
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates an empty path, with no start cell
+ * --------------------------------------------------------------------------------------
+*/
+MazePath::MazePath()
+    : m_startRow(Maze::INVALID_ROW_COL),
+      m_startCol(Maze::INVALID_ROW_COL),
+      m_endRow(Maze::INVALID_ROW_COL),
+      m_endCol(Maze::INVALID_ROW_COL),
+      m_numMoves(0)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * clear()
+ * 
+ * Empties the path, keeping its storage for the next path
+ * --------------------------------------------------------------------------------------
+*/
+void MazePath::clear()
+{
+    m_startRow = Maze::INVALID_ROW_COL;
+    m_startCol = Maze::INVALID_ROW_COL;
+    m_endRow = Maze::INVALID_ROW_COL;
+    m_endCol = Maze::INVALID_ROW_COL;
+    m_numMoves = 0;
+    m_moveWords.clear();
+}
+
+/**--------------------------------------------------------------------------------------
+ * reset()
+ * 
+ * Empties the path and starts it again at the given cell
+ * 
+ * @param[in] startRow Row index of the start cell
+ * @param[in] startCol Column index of the start cell
+ * --------------------------------------------------------------------------------------
+*/
+void MazePath::reset(int startRow, int startCol)
+{
+    clear();
+    m_startRow = startRow;
+    m_startCol = startCol;
+    m_endRow = startRow;
+    m_endCol = startCol;
+}
+
+/**--------------------------------------------------------------------------------------
+ * appendMove()
+ * 
+ * Extends the path by one move from its end cell
+ * 
+ * @param[in] dir Cardinal direction of the move, see Maze
+ * --------------------------------------------------------------------------------------
+*/
+void MazePath::appendMove(int dir)
+{
+    if((m_numMoves & 31) == 0)
+    {
+        m_moveWords.push_back(0);
+    }
+    m_moveWords.back() |= static_cast<std::uint64_t>(dir & 3) << (2 * (m_numMoves & 31));
+    m_numMoves++;
+    stepRowCol(dir, m_endRow, m_endCol);
+}
+
+/**--------------------------------------------------------------------------------------
+ * appendCell()
+ * 
+ * Extends the path to a cell next to its end cell, or starts an empty path at the cell
+ * 
+ * @param[in] row Row index of the cell
+ * @param[in] col Column index of the cell
+ * @return false if the cell is not next to the end cell, the path is left as it was
+ * --------------------------------------------------------------------------------------
+*/
+bool MazePath::appendCell(int row, int col)
+{
+    if(empty())
+    {
+        reset(row, col);
+        return true;
+    }
+
+    int dir = Maze::INVALID_CARDINAL_DIRECTION;
+    if(col == m_endCol && row == m_endRow - 1)
+    {
+        dir = Maze::NORTH_DIRECTION;
+    }
+    else if(col == m_endCol && row == m_endRow + 1)
+    {
+        dir = Maze::SOUTH_DIRECTION;
+    }
+    else if(row == m_endRow && col == m_endCol + 1)
+    {
+        dir = Maze::EAST_DIRECTION;
+    }
+    else if(row == m_endRow && col == m_endCol - 1)
+    {
+        dir = Maze::WEST_DIRECTION;
+    }
+    else
+    {
+        std::cerr << "ERROR: MazePath::appendCell() was given (Row: " << row << ", Col: " << col << "), which is not next to the end of the path" << std::endl;
+        return false;
+    }
+
+    appendMove(dir);
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * assignCells()
+ * 
+ * Replaces the path with the given ordered list of cells
+ * 
+ * @param[in] cells     Row-major indices of the cells on the path, in order, each one 
+ * next to the one before it
+ * @param[in] numCols   Number of columns of the maze the indices are into
+ * @return false if two cells in a row are not next to each other, the path is left empty
+ * --------------------------------------------------------------------------------------
+*/
+bool MazePath::assignCells(const std::vector<std::size_t>& cells, int numCols)
+{
+    clear();
+    if(cells.empty())
+    {
+        return true;
+    }
+
+    const std::size_t cols = static_cast<std::size_t>(numCols);
+    m_moveWords.reserve((cells.size() + 30) / 32);
+    reset(static_cast<int>(cells.front() / cols), static_cast<int>(cells.front() % cols));
+    for(std::size_t position = 1; position < cells.size(); position++)
+    {
+        if(!appendCell(static_cast<int>(cells[position] / cols), static_cast<int>(cells[position] % cols)))
+        {
+            clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * labelPath()
+ * 
+ * Labels every cell on the path as a path cell of the maze
+ * 
+ * @param[in,out] maze Maze the path goes through, updated so the cells on the path are 
+ * labeled as path cells
+ * --------------------------------------------------------------------------------------
+*/
+void MazePath::labelPath(Maze& maze) const
+{
+    for(const_iterator step = begin(); step != end(); ++step)
+    {
+        maze.labelCellAsPath(step.getRow(), step.getCol());
+    }
+}
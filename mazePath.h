@@ -0,0 +1,329 @@
+/*mazePath.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze Path
+ * 
+ * Ordered path through a maze, packed as its start cell and 2 bits per move
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "maze.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * MazePath class
+ * 
+ * Ordered path through a maze, kept as its start cell and the direction of every move 
+ * after it, 2 bits per move packed 32 to a word
+ *     Move i is bits 2 * (i % 32) and up of word i / 32, one of the Maze directions
+ *     Iterating visits the cells of the path in order, from the start cell to the end cell, 
+ *     so consumers of the path never need to scan the grid for path cells
+ *     Takes a quarter of a byte per cell on the path, see mazeBinary.h for its binary 
+ *     format
+ * --------------------------------------------------------------------------------------
+*/
+class MazePath
+{
+public:
+    /**--------------------------------------------------------------------------------------
+     * const_iterator class
+     * 
+     * Forward iterator over the cells of a path, dereferences to the <row, col> of a cell
+     * --------------------------------------------------------------------------------------
+    */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::tuple<int, int>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = value_type;
+
+        const_iterator()
+            : m_path(nullptr), m_position(0), m_row(Maze::INVALID_ROW_COL), m_col(Maze::INVALID_ROW_COL)
+        {
+        }
+
+        const_iterator(const MazePath* path, std::size_t position, int row, int col)
+            : m_path(path), m_position(position), m_row(row), m_col(col)
+        {
+        }
+
+        std::tuple<int, int> operator*() const
+        {
+            return std::make_tuple(m_row, m_col);
+        }
+
+        int getRow() const
+        {
+            return m_row;
+        }
+
+        int getCol() const
+        {
+            return m_col;
+        }
+
+        // Position of the cell on the path, 0 for the start cell
+        std::size_t getPosition() const
+        {
+            return m_position;
+        }
+
+        const_iterator& operator++()
+        {
+            // The end cell has no move after it
+            if(m_position < m_path->getNumMoves())
+            {
+                stepRowCol(m_path->getMove(m_position), m_row, m_col);
+            }
+            m_position++;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return m_path == other.m_path && m_position == other.m_position;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        const MazePath* m_path;
+        std::size_t m_position;
+        int m_row;
+        int m_col;
+    };
+
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates an empty path, with no start cell
+     * --------------------------------------------------------------------------------------
+    */
+    MazePath();
+
+    /**--------------------------------------------------------------------------------------
+     * clear()
+     * 
+     * Empties the path, keeping its storage for the next path
+     * --------------------------------------------------------------------------------------
+    */
+    void clear();
+
+    /**--------------------------------------------------------------------------------------
+     * reset()
+     * 
+     * Empties the path and starts it again at the given cell
+     * 
+     * @param[in] startRow Row index of the start cell
+     * @param[in] startCol Column index of the start cell
+     * --------------------------------------------------------------------------------------
+    */
+    void reset(int startRow, int startCol);
+
+    /**--------------------------------------------------------------------------------------
+     * appendMove()
+     * 
+     * Extends the path by one move from its end cell
+     * 
+     * @param[in] dir Cardinal direction of the move, see Maze
+     * --------------------------------------------------------------------------------------
+    */
+    void appendMove(int dir);
+
+    /**--------------------------------------------------------------------------------------
+     * appendCell()
+     * 
+     * Extends the path to a cell next to its end cell, or starts an empty path at the cell
+     * 
+     * @param[in] row Row index of the cell
+     * @param[in] col Column index of the cell
+     * @return false if the cell is not next to the end cell, the path is left as it was
+     * --------------------------------------------------------------------------------------
+    */
+    bool appendCell(int row, int col);
+
+    /**--------------------------------------------------------------------------------------
+     * assignCells()
+     * 
+     * Replaces the path with the given ordered list of cells
+     * 
+     * @param[in] cells     Row-major indices of the cells on the path, in order, each one 
+     * next to the one before it
+     * @param[in] numCols   Number of columns of the maze the indices are into
+     * @return false if two cells in a row are not next to each other, the path is left empty
+     * --------------------------------------------------------------------------------------
+    */
+    bool assignCells(const std::vector<std::size_t>& cells, int numCols);
+
+    /**--------------------------------------------------------------------------------------
+     * labelPath()
+     * 
+     * Labels every cell on the path as a path cell of the maze
+     * 
+     * @param[in,out] maze Maze the path goes through, updated so the cells on the path are 
+     * labeled as path cells
+     * --------------------------------------------------------------------------------------
+    */
+    void labelPath(Maze& maze) const;
+
+    /**--------------------------------------------------------------------------------------
+     * begin() / end()
+     * 
+     * Returns iterators to the start cell of the path and past its end cell
+     * --------------------------------------------------------------------------------------
+    */
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0, m_startRow, m_startCol);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, getLength(), m_endRow, m_endCol);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * empty() / getLength() / getNumMoves()
+     * 
+     * Returns whether the path has no cells, its number of cells, or its number of moves, 
+     * one fewer than its number of cells
+     * --------------------------------------------------------------------------------------
+    */
+    bool empty() const
+    {
+        return m_startRow == Maze::INVALID_ROW_COL;
+    }
+
+    std::size_t getLength() const
+    {
+        return empty() ? 0 : m_numMoves + 1;
+    }
+
+    std::size_t getNumMoves() const
+    {
+        return m_numMoves;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getMove()
+     * 
+     * Returns the direction of a move of the path
+     * 
+     * @param[in] position Index of the move, less than getNumMoves()
+     * @return the cardinal direction out of the cell at the given position, see Maze
+     * --------------------------------------------------------------------------------------
+    */
+    int getMove(std::size_t position) const
+    {
+        return static_cast<int>((m_moveWords[position >> 5] >> (2 * (position & 31))) & 3);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getMoveWords()
+     * 
+     * Returns the packed moves, (getNumMoves() + 31) / 32 words, the unused bits of the 
+     * last word are 0
+     * --------------------------------------------------------------------------------------
+    */
+    const std::vector<std::uint64_t>& getMoveWords() const
+    {
+        return m_moveWords;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getStart() / getEnd()
+     * 
+     * Returns the <row, col> of the start or end cell, INVALID_ROW_COL for an empty path
+     * --------------------------------------------------------------------------------------
+    */
+    std::tuple<int, int> getStart() const
+    {
+        return std::make_tuple(m_startRow, m_startCol);
+    }
+
+    std::tuple<int, int> getEnd() const
+    {
+        return std::make_tuple(m_endRow, m_endCol);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * stepRowCol()
+     * 
+     * Moves a row and column one cell in the given direction
+     * 
+     * @param[in]       dir Cardinal direction to move in, see Maze
+     * @param[in,out]   row Row index, updated to the row of the next cell
+     * @param[in,out]   col Column index, updated to the column of the next cell
+     * --------------------------------------------------------------------------------------
+    */
+    static void stepRowCol(int dir, int& row, int& col)
+    {
+        switch(dir)
+        {
+            case Maze::NORTH_DIRECTION:
+                row--;
+                break;
+            case Maze::SOUTH_DIRECTION:
+                row++;
+                break;
+            case Maze::EAST_DIRECTION:
+                col++;
+                break;
+            case Maze::WEST_DIRECTION:
+                col--;
+                break;
+        }
+    }
+
+private:
+    int m_startRow;
+    int m_startCol;
+    int m_endRow;
+    int m_endCol;
+    std::size_t m_numMoves;
+    std::vector<std::uint64_t> m_moveWords;
+};
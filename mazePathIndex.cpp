@@ -0,0 +1,368 @@
+/*mazePathIndex.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze Path Index
+ * 
+ * Indexes a perfect maze once so the path and path length between any two cells can be
+ * found without solving the maze again, using the lowest common ancestor of the cells in
+ * the spanning tree of the maze
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazePathIndex.h"
+#include "bitOps.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <tuple>
+
+// Parent direction of the root of the tree
+const std::uint8_t NO_PARENT_DIRECTION = 4;
+
+// First visit of a cell the depth-first search has not reached yet
+const std::uint32_t UNVISITED_TOUR_POSITION = std::numeric_limits<std::uint32_t>::max();
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates an empty index, see build()
+ * --------------------------------------------------------------------------------------
+*/
+MazePathIndex::MazePathIndex()
+    : m_numCols(0),
+      m_entranceIndex(0),
+      m_exitIndex(0),
+      m_hasEntranceAndExit(false)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * build()
+ * 
+ * Indexes a perfect maze, replacing whatever was indexed before
+ *     The tree is rooted at the entrance, or at cell (0, 0) if the maze has none
+ * 
+ * @param[in] maze Perfect maze with fewer than 2^31 cells, not modified
+ * @return false if the maze is too big, has a loop or has cells that cannot be reached
+ * --------------------------------------------------------------------------------------
+*/
+bool MazePathIndex::build(const Maze& maze)
+{
+    const std::size_t numCells = maze.getNumCells();
+    if(numCells == 0 || numCells >= (static_cast<std::size_t>(1) << 31))
+    {
+        std::cerr << "ERROR: MazePathIndex can only index mazes with at least 1 and fewer than 2^31 cells" << std::endl;
+        return false;
+    }
+
+    m_numCols = maze.getCOLCELLS();
+
+    int entranceRow = std::get<0>(maze.getEntrance());
+    int entranceCol = std::get<1>(maze.getEntrance());
+    int exitRow = std::get<0>(maze.getExit());
+    int exitCol = std::get<1>(maze.getExit());
+    m_hasEntranceAndExit = entranceRow != Maze::INVALID_ROW_COL && entranceCol != Maze::INVALID_ROW_COL && \
+                           exitRow != Maze::INVALID_ROW_COL && exitCol != Maze::INVALID_ROW_COL;
+    m_entranceIndex = m_hasEntranceAndExit ? cellIndex(entranceRow, entranceCol) : 0;
+    m_exitIndex = m_hasEntranceAndExit ? cellIndex(exitRow, exitCol) : 0;
+
+    m_parentDirs.assign(numCells, NO_PARENT_DIRECTION);
+    m_depths.assign(numCells, 0);
+    m_firstVisits.assign(numCells, UNVISITED_TOUR_POSITION);
+    m_eulerTour.clear();
+    m_eulerTour.reserve(2 * numCells - 1);
+    m_tourDepths.clear();
+    m_tourDepths.reserve(2 * numCells - 1);
+
+    // Iterative depth-first search from the root, each cell keeping the directions of the 
+    // children it has not gone down yet as a bit mask
+    std::vector<std::uint8_t> childDirs(numCells, 0);
+    std::vector<std::uint32_t> cellStack;
+    cellStack.reserve(numCells);
+
+    const std::size_t rootIndex = m_entranceIndex;
+    m_firstVisits[rootIndex] = 0;
+    m_eulerTour.push_back(static_cast<std::uint32_t>(rootIndex));
+    m_tourDepths.push_back(0);
+    childDirs[rootIndex] = openDirections(maze, rootIndex);
+    cellStack.push_back(static_cast<std::uint32_t>(rootIndex));
+    std::size_t numReached = 1;
+
+    while(!cellStack.empty())
+    {
+        std::size_t curIndex = cellStack.back();
+        if(childDirs[curIndex] == 0)
+        {
+            // Every child is done, going back up to the parent
+            cellStack.pop_back();
+            if(!cellStack.empty())
+            {
+                m_eulerTour.push_back(cellStack.back());
+                m_tourDepths.push_back(m_depths[cellStack.back()]);
+            }
+            continue;
+        }
+
+        int dir = countTrailingZeros(childDirs[curIndex]);
+        childDirs[curIndex] &= static_cast<std::uint8_t>(childDirs[curIndex] - 1);
+
+        std::size_t nextIndex = neighborIndex(curIndex, dir);
+        if(m_firstVisits[nextIndex] != UNVISITED_TOUR_POSITION)
+        {
+            std::cerr << "ERROR: MazePathIndex was given a maze with a loop" << std::endl;
+            return false;
+        }
+
+        m_parentDirs[nextIndex] = static_cast<std::uint8_t>(dir ^ 1);
+        m_depths[nextIndex] = m_depths[curIndex] + 1;
+        m_firstVisits[nextIndex] = static_cast<std::uint32_t>(m_eulerTour.size());
+        m_eulerTour.push_back(static_cast<std::uint32_t>(nextIndex));
+        m_tourDepths.push_back(m_depths[nextIndex]);
+        childDirs[nextIndex] = openDirections(maze, nextIndex) & static_cast<std::uint8_t>(~(1 << (dir ^ 1)));
+        cellStack.push_back(static_cast<std::uint32_t>(nextIndex));
+        numReached++;
+    }
+
+    if(numReached != numCells)
+    {
+        std::cerr << "ERROR: MazePathIndex was given a maze with cells that cannot be reached from the entrance" << std::endl;
+        return false;
+    }
+
+    // Shallowest position of each block of the tour, then of each run of 2^level blocks
+    const std::size_t tourLength = m_eulerTour.size();
+    const std::size_t numBlocks = (tourLength + TOUR_BLOCK_SIZE - 1) / TOUR_BLOCK_SIZE;
+
+    m_blockMinimums.assign(1, std::vector<std::uint32_t>(numBlocks));
+    for(std::size_t block = 0; block < numBlocks; block++)
+    {
+        std::uint32_t blockStart = static_cast<std::uint32_t>(block * TOUR_BLOCK_SIZE);
+        std::uint32_t blockEnd = static_cast<std::uint32_t>(std::min(tourLength, (block + 1) * TOUR_BLOCK_SIZE));
+        std::uint32_t best = blockStart;
+        for(std::uint32_t pos = blockStart + 1; pos < blockEnd; pos++)
+        {
+            best = shallowerTourPosition(best, pos);
+        }
+        m_blockMinimums[0][block] = best;
+    }
+
+    for(std::size_t level = 1; (static_cast<std::size_t>(1) << level) <= numBlocks; level++)
+    {
+        const std::vector<std::uint32_t>& lower = m_blockMinimums[level - 1];
+        const std::size_t halfSpan = static_cast<std::size_t>(1) << (level - 1);
+        std::vector<std::uint32_t> upper(numBlocks - 2 * halfSpan + 1);
+        for(std::size_t block = 0; block < upper.size(); block++)
+        {
+            upper[block] = shallowerTourPosition(lower[block], lower[block + halfSpan]);
+        }
+        m_blockMinimums.push_back(std::move(upper));
+    }
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * lowestCommonAncestor()
+ * 
+ * Returns the cell where the paths from two cells to the root of the tree meet
+ *     Finds the shallowest cell of the Euler tour between the first visits of the two 
+ *     cells, scanning the tour inside the first and last block and looking up the 
+ *     blocks in between
+ * 
+ * @param[in] fromIndex Row-major index of the first cell
+ * @param[in] toIndex   Row-major index of the second cell
+ * @return the row-major index of the lowest common ancestor
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t MazePathIndex::lowestCommonAncestor(std::size_t fromIndex, std::size_t toIndex) const
+{
+    std::uint32_t first = std::min(m_firstVisits[fromIndex], m_firstVisits[toIndex]);
+    std::uint32_t last = std::max(m_firstVisits[fromIndex], m_firstVisits[toIndex]);
+    std::uint32_t firstBlock = first / TOUR_BLOCK_SIZE;
+    std::uint32_t lastBlock = last / TOUR_BLOCK_SIZE;
+
+    std::uint32_t best = first;
+    if(firstBlock == lastBlock)
+    {
+        for(std::uint32_t pos = first + 1; pos <= last; pos++)
+        {
+            best = shallowerTourPosition(best, pos);
+        }
+        return m_eulerTour[best];
+    }
+
+    // Partial blocks at both ends
+    for(std::uint32_t pos = first + 1; pos < (firstBlock + 1) * TOUR_BLOCK_SIZE; pos++)
+    {
+        best = shallowerTourPosition(best, pos);
+    }
+    for(std::uint32_t pos = lastBlock * TOUR_BLOCK_SIZE; pos <= last; pos++)
+    {
+        best = shallowerTourPosition(best, pos);
+    }
+
+    // Whole blocks in between, covered by two overlapping runs of 2^level blocks
+    if(lastBlock - firstBlock > 1)
+    {
+        std::uint32_t spanStart = firstBlock + 1;
+        std::uint32_t spanLength = lastBlock - spanStart;
+        int level = 0;
+        while((static_cast<std::uint32_t>(2) << level) <= spanLength)
+        {
+            level++;
+        }
+        best = shallowerTourPosition(best, m_blockMinimums[level][spanStart]);
+        best = shallowerTourPosition(best, m_blockMinimums[level][lastBlock - (static_cast<std::uint32_t>(1) << level)]);
+    }
+
+    return m_eulerTour[best];
+}
+
+/**--------------------------------------------------------------------------------------
+ * pathLength()
+ * 
+ * Returns the number of cells on the path between two cells, both ends included, in 
+ * constant time
+ * 
+ * @param[in] fromIndex Row-major index of the first cell
+ * @param[in] toIndex   Row-major index of the second cell
+ * @return the number of cells on the path, 1 if the cells are the same
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t MazePathIndex::pathLength(std::size_t fromIndex, std::size_t toIndex) const
+{
+    std::size_t ancestorIndex = lowestCommonAncestor(fromIndex, toIndex);
+    return static_cast<std::size_t>(m_depths[fromIndex]) + m_depths[toIndex] - 2 * static_cast<std::size_t>(m_depths[ancestorIndex]) + 1;
+}
+
+/**--------------------------------------------------------------------------------------
+ * findPath()
+ * 
+ * Finds the path between two cells in time proportional to its length, following 
+ * parent directions up from both cells to their lowest common ancestor
+ * 
+ * @param[in]   fromIndex   Row-major index of the cell the path starts at
+ * @param[in]   toIndex     Row-major index of the cell the path ends at
+ * @param[out]  path        Row-major indices of the cells on the path, ordered from 
+ * fromIndex to toIndex
+ * --------------------------------------------------------------------------------------
+*/
+void MazePathIndex::findPath(std::size_t fromIndex, std::size_t toIndex, std::vector<std::size_t>& path) const
+{
+    std::size_t ancestorIndex = lowestCommonAncestor(fromIndex, toIndex);
+    std::size_t fromSideLength = m_depths[fromIndex] - m_depths[ancestorIndex];
+    std::size_t toSideLength = m_depths[toIndex] - m_depths[ancestorIndex];
+    path.resize(fromSideLength + toSideLength + 1);
+
+    // The start side fills the path forwards, the end side backwards, meeting at the ancestor
+    std::size_t curIndex = fromIndex;
+    for(std::size_t pos = 0; pos < fromSideLength; pos++)
+    {
+        path[pos] = curIndex;
+        curIndex = neighborIndex(curIndex, m_parentDirs[curIndex]);
+    }
+    path[fromSideLength] = ancestorIndex;
+
+    curIndex = toIndex;
+    for(std::size_t pos = path.size() - 1; pos > fromSideLength; pos--)
+    {
+        path[pos] = curIndex;
+        curIndex = neighborIndex(curIndex, m_parentDirs[curIndex]);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * findEntranceToExitPath()
+ * 
+ * Finds the path from the entrance to the exit of the indexed maze, as given by 
+ * Maze::getEntrance() and Maze::getExit() when it was indexed
+ * 
+ * @param[out] path Row-major indices of the cells on the path, ordered from the entrance 
+ * to the exit
+ * @return false if the indexed maze has no entrance or exit
+ * --------------------------------------------------------------------------------------
+*/
+bool MazePathIndex::findEntranceToExitPath(std::vector<std::size_t>& path) const
+{
+    if(!m_hasEntranceAndExit)
+    {
+        std::cerr << "ERROR: MazePathIndex has no maze with an entrance and exit indexed" << std::endl;
+        return false;
+    }
+
+    findPath(m_entranceIndex, m_exitIndex, path);
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * openDirections()
+ * 
+ * Returns the directions a cell has open walls in as a bit mask
+ * 
+ * @param[in] maze      Maze being indexed
+ * @param[in] cellIndex Row-major index of the cell
+ * @return bit dir set for each open direction dir, see Maze::NORTH_DIRECTION
+ * --------------------------------------------------------------------------------------
+*/
+std::uint8_t MazePathIndex::openDirections(const Maze& maze, std::size_t cellIndex) const
+{
+    int row = static_cast<int>(cellIndex / static_cast<std::size_t>(m_numCols));
+    int col = static_cast<int>(cellIndex % static_cast<std::size_t>(m_numCols));
+
+    std::uint8_t openDirs = 0;
+    for(int dir = Maze::NORTH_DIRECTION; dir <= Maze::WEST_DIRECTION; dir++)
+    {
+        openDirs |= static_cast<std::uint8_t>(maze.isWallOpen(row, col, dir) ? (1 << dir) : 0);
+    }
+    return openDirs;
+}
+
+/**--------------------------------------------------------------------------------------
+ * neighborIndex()
+ * 
+ * Returns the row-major index of the neighbor of a cell in the given direction
+ * 
+ * @param[in] cellIndex Row-major index of the cell
+ * @param[in] dir       Direction of the neighbor, must stay inside the maze
+ * @return the row-major index of the neighbor
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t MazePathIndex::neighborIndex(std::size_t cellIndex, int dir) const
+{
+    switch(dir)
+    {
+        case Maze::NORTH_DIRECTION:
+            return cellIndex - static_cast<std::size_t>(m_numCols);
+        case Maze::SOUTH_DIRECTION:
+            return cellIndex + static_cast<std::size_t>(m_numCols);
+        case Maze::EAST_DIRECTION:
+            return cellIndex + 1;
+        default:
+            return cellIndex - 1;
+    }
+}
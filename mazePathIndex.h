@@ -0,0 +1,206 @@
+/*mazePathIndex.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze Path Index
+ * 
+ * Indexes a perfect maze once so the path and path length between any two cells can be
+ * found without solving the maze again, using the lowest common ancestor of the cells in
+ * the spanning tree of the maze
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "maze.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * MazePathIndex class
+ * 
+ * Index of a perfect maze, built once, that answers path queries between any two cells 
+ * without solving the maze again
+ *     A perfect maze is a spanning tree, so the path between two cells is unique: it goes 
+ *     up from each cell to their lowest common ancestor in the tree
+ *     Keeps a flattened tree rooted at the entrance (parent direction and depth of every 
+ *     cell) and an Euler tour of it, with a table of block minimums over the tour for 
+ *     constant time lowest common ancestor queries
+ *     Only reads the maze, about 30 bytes per cell
+ * --------------------------------------------------------------------------------------
+*/
+class MazePathIndex
+{
+public:
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates an empty index, see build()
+     * --------------------------------------------------------------------------------------
+    */
+    MazePathIndex();
+
+    /**--------------------------------------------------------------------------------------
+     * build()
+     * 
+     * Indexes a perfect maze, replacing whatever was indexed before
+     *     The tree is rooted at the entrance, or at cell (0, 0) if the maze has none
+     * 
+     * @param[in] maze Perfect maze with fewer than 2^31 cells, not modified
+     * @return false if the maze is too big, has a loop or has cells that cannot be reached
+     * --------------------------------------------------------------------------------------
+    */
+    bool build(const Maze& maze);
+
+    /**--------------------------------------------------------------------------------------
+     * lowestCommonAncestor()
+     * 
+     * Returns the cell where the paths from two cells to the root of the tree meet
+     *     Finds the shallowest cell of the Euler tour between the first visits of the two 
+     *     cells, scanning the tour inside the first and last block and looking up the 
+     *     blocks in between
+     * 
+     * @param[in] fromIndex Row-major index of the first cell
+     * @param[in] toIndex   Row-major index of the second cell
+     * @return the row-major index of the lowest common ancestor
+     * --------------------------------------------------------------------------------------
+    */
+    std::size_t lowestCommonAncestor(std::size_t fromIndex, std::size_t toIndex) const;
+
+    /**--------------------------------------------------------------------------------------
+     * pathLength()
+     * 
+     * Returns the number of cells on the path between two cells, both ends included, in 
+     * constant time
+     * 
+     * @param[in] fromIndex Row-major index of the first cell
+     * @param[in] toIndex   Row-major index of the second cell
+     * @return the number of cells on the path, 1 if the cells are the same
+     * --------------------------------------------------------------------------------------
+    */
+    std::size_t pathLength(std::size_t fromIndex, std::size_t toIndex) const;
+
+    /**--------------------------------------------------------------------------------------
+     * findPath()
+     * 
+     * Finds the path between two cells in time proportional to its length, following 
+     * parent directions up from both cells to their lowest common ancestor
+     * 
+     * @param[in]   fromIndex   Row-major index of the cell the path starts at
+     * @param[in]   toIndex     Row-major index of the cell the path ends at
+     * @param[out]  path        Row-major indices of the cells on the path, ordered from 
+     * fromIndex to toIndex
+     * --------------------------------------------------------------------------------------
+    */
+    void findPath(std::size_t fromIndex, std::size_t toIndex, std::vector<std::size_t>& path) const;
+
+    /**--------------------------------------------------------------------------------------
+     * findEntranceToExitPath()
+     * 
+     * Finds the path from the entrance to the exit of the indexed maze, as given by 
+     * Maze::getEntrance() and Maze::getExit() when it was indexed
+     * 
+     * @param[out] path Row-major indices of the cells on the path, ordered from the entrance 
+     * to the exit
+     * @return false if the indexed maze has no entrance or exit
+     * --------------------------------------------------------------------------------------
+    */
+    bool findEntranceToExitPath(std::vector<std::size_t>& path) const;
+
+    /**--------------------------------------------------------------------------------------
+     * cellIndex()
+     * 
+     * Returns the row-major index of a cell of the indexed maze, as taken by the queries
+     * 
+     * @param[in] row Row index of the cell
+     * @param[in] col Column index of the cell
+     * @return row * COLCELLS + col
+     * --------------------------------------------------------------------------------------
+    */
+    std::size_t cellIndex(int row, int col) const
+    {
+        return static_cast<std::size_t>(row) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(col);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getDepth()
+     * 
+     * Returns the number of moves from the root of the tree to a cell
+     * 
+     * @param[in] cellIndex Row-major index of the cell
+     * @return the depth of the cell, 0 for the root
+     * --------------------------------------------------------------------------------------
+    */
+    std::uint32_t getDepth(std::size_t cellIndex) const
+    {
+        return m_depths[cellIndex];
+    }
+
+private:
+    // Directions cellIndex has open walls in, one bit per direction
+    std::uint8_t openDirections(const Maze& maze, std::size_t cellIndex) const;
+
+    // Index of the neighbor of cellIndex in the given direction
+    std::size_t neighborIndex(std::size_t cellIndex, int dir) const;
+
+    // Position of the shallower of two positions of the Euler tour
+    std::uint32_t shallowerTourPosition(std::uint32_t first, std::uint32_t second) const
+    {
+        return (m_tourDepths[second] < m_tourDepths[first]) ? second : first;
+    }
+
+    // Number of Euler tour positions in each block of m_blockMinimums
+    static const std::uint32_t TOUR_BLOCK_SIZE = 32;
+
+    int m_numCols;
+    std::size_t m_entranceIndex;
+    std::size_t m_exitIndex;
+    bool m_hasEntranceAndExit;
+
+    /**
+     * Flattened tree, one entry per cell, stored row-major
+     *     m_parentDirs: direction from each cell to its parent, NO_PARENT_DIRECTION for the root
+     *     m_depths: number of moves from the root to each cell
+     *     m_firstVisits: position of the first visit to each cell in m_eulerTour
+    */
+    std::vector<std::uint8_t> m_parentDirs;
+    std::vector<std::uint32_t> m_depths;
+    std::vector<std::uint32_t> m_firstVisits;
+
+    /**
+     * Euler tour of the tree, every cell listed each time the depth-first search is at it, 
+     * 2 x cells - 1 entries
+     *     m_tourDepths: depth of each cell of the tour, so lowest common ancestor queries scan 
+     *     contiguous memory
+     *     m_blockMinimums[level][block]: position of the shallowest cell of the tour among 
+     *     the 2^level blocks of TOUR_BLOCK_SIZE positions starting at block
+    */
+    std::vector<std::uint32_t> m_eulerTour;
+    std::vector<std::uint32_t> m_tourDepths;
+    std::vector<std::vector<std::uint32_t>> m_blockMinimums;
+};
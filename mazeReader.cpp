@@ -0,0 +1,817 @@
+/*mazeReader.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze reader
+ * 
+ * Loads mazes made elsewhere to be solved: mazeData.csv files, binary maze files and
+ * batch shards of either, and png images of mazes
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazeReader.h"
+#include "mazeRenderer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+
+// Shortest cell of a maze csv file, "CellPath," or "CellExit,", to bound sizes by the file size
+const std::size_t MIN_CSV_CELL_BYTES = 9;
+
+// Largest sum of channel differences from the entrance or exit color a marked cell can have
+const int IMAGE_MARKER_COLOR_DISTANCE = 96;
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates a reader with no file open
+ * --------------------------------------------------------------------------------------
+*/
+MazeReader::MazeReader()
+    : m_format(INVALID_FORMAT), m_offset(0), m_hasFailed(false), m_hasFoundMaze(false), m_numRows(0), m_numCols(0), m_imageRows(0), m_imageCols(0), \
+      m_gridLeft(0), m_gridTop(0), m_cellWidth(0), m_cellHeight(0), m_wallThickness(0)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * fail()
+ * 
+ * Reports a problem with the file and marks it as not valid, see hasFailed()
+ * 
+ * @param[in] problem What is wrong with the file, following its name
+ * @return false, to be returned by the caller
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::fail(const std::string& problem)
+{
+    std::cerr << "ERROR: " << m_fileName << " " << problem << std::endl;
+    m_hasFailed = true;
+    return false;
+}
+
+/**--------------------------------------------------------------------------------------
+ * open()
+ * 
+ * Maps a maze file and finds out its format from its first bytes, see nextMaze()
+ * 
+ * @param[in] fileName  Name of the file to load mazes from
+ * @param[in] imageRows Number of rows of cells of a png image, 0 to find it from the 
+ *                      spacing of the walls
+ * @param[in] imageCols Number of columns of cells of a png image, 0 to find it too
+ * @return true if the file was mapped and is in one of the formats read
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::open(const std::string& fileName, int imageRows, int imageCols)
+{
+    close();
+    m_fileName = fileName;
+    m_imageRows = imageRows;
+    m_imageCols = imageCols;
+
+    if(!m_file.open(fileName))
+    {
+        m_hasFailed = true;
+        return false;
+    }
+
+    static const std::uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    const std::uint8_t* data = m_file.getData();
+    const std::size_t size = m_file.getSize();
+    if(size >= 8 && std::memcmp(data, "MAZEGRID", 8) == 0)
+    {
+        m_format = BINARY_FORMAT;
+    }
+    else if(size >= 8 && std::memcmp(data, PNG_SIGNATURE, 8) == 0)
+    {
+        m_format = PNG_FORMAT;
+    }
+    else if(data[0] >= '0' && data[0] <= '9')
+    {
+        m_format = CSV_FORMAT;
+    }
+    else
+    {
+        return fail("is not a maze csv, binary or png file");
+    }
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * close()
+ * 
+ * Unmaps the file, if one is mapped
+ * --------------------------------------------------------------------------------------
+*/
+void MazeReader::close()
+{
+    m_file.close();
+    m_format = INVALID_FORMAT;
+    m_offset = 0;
+    m_hasFailed = false;
+    m_hasFoundMaze = false;
+    m_numRows = 0;
+    m_numCols = 0;
+}
+
+/**--------------------------------------------------------------------------------------
+ * nextMaze()
+ * 
+ * Finds the next maze of the file and reads its size, see getNumRows()
+ *     Each maze found must be loaded with readMaze() before looking for the next one
+ * 
+ * @return true if there is another maze, false at the end of the file or if the file 
+ * is not valid, see hasFailed()
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::nextMaze()
+{
+    if(m_hasFailed)
+    {
+        return false;
+    }
+
+    switch(m_format)
+    {
+        case CSV_FORMAT:
+            return nextCsvMaze();
+        case BINARY_FORMAT:
+            return nextBinaryMaze();
+        case PNG_FORMAT:
+            // An image holds a single maze
+            return m_offset == 0 && findImageGrid();
+        default:
+            return false;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * readMaze()
+ * 
+ * Loads the maze found by nextMaze() into a maze of its size
+ * 
+ * @param[in,out] maze Maze of getNumRows() x getNumCols() cells, reset and filled out 
+ * with the walls, entrance and exit of the maze in the file
+ * @return true if the maze was loaded, false if it is not valid, see hasFailed()
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::readMaze(Maze& maze)
+{
+    if(m_hasFailed || m_numRows == 0 || maze.getROWCELLS() != m_numRows || maze.getCOLCELLS() != m_numCols)
+    {
+        std::cerr << "ERROR: readMaze() needs the " << m_numRows << " x " << m_numCols << " maze found by nextMaze()" << std::endl;
+        return false;
+    }
+
+    maze.reset();
+    m_southWalls.assign(maze.getWallWordsPerRow(), 0);
+    m_eastWalls.assign(maze.getWallWordsPerRow(), 0);
+
+    bool isRead = false;
+    switch(m_format)
+    {
+        case CSV_FORMAT:
+            isRead = readCsvMaze(maze);
+            break;
+        case BINARY_FORMAT:
+            isRead = readBinaryMaze(maze);
+            break;
+        case PNG_FORMAT:
+            isRead = readImageMaze(maze);
+            break;
+        default:
+            break;
+    }
+
+    m_numRows = 0;
+    m_numCols = 0;
+    if(!isRead)
+    {
+        return false;
+    }
+
+    maze.updateExitsFromWalls();
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * nextCsvMaze()
+ * 
+ * Reads the "<rows>,<columns>," line starting the next maze of a csv file, see 
+ * writeMazeDataCSV(). Mazes of batch shards are separated by newlines
+ * 
+ * @return true if there is another maze with a valid size
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::nextCsvMaze()
+{
+    const char* text = reinterpret_cast<const char*>(m_file.getData());
+    const char* position = text + m_offset;
+    const char* end = text + m_file.getSize();
+    while(position < end && (*position == '\n' || *position == '\r' || *position == ' ' || *position == '\t'))
+    {
+        position++;
+    }
+    if(position == end)
+    {
+        m_offset = m_file.getSize();
+        return m_hasFoundMaze ? false : fail("holds no maze");
+    }
+
+    std::uint64_t sizes[2] = { 0, 0 };
+    for(std::uint64_t& side : sizes)
+    {
+        const char* digitsStart = position;
+        while(position < end && *position >= '0' && *position <= '9' && side <= static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+        {
+            side = side * 10 + static_cast<std::uint64_t>(*position - '0');
+            position++;
+        }
+        if(position == digitsStart || position == end || *position != ',')
+        {
+            return fail("does not start a maze with a \"<rows>,<columns>,\" line at byte " + std::to_string(digitsStart - text));
+        }
+        position++;
+    }
+    position += (position < end && *position == '\r');
+    if(position == end || *position != '\n')
+    {
+        return fail("does not start a maze with a \"<rows>,<columns>,\" line at byte " + std::to_string(position - text));
+    }
+    position++;
+
+    const std::uint64_t maxSide = static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+    if(sizes[0] < 1 || sizes[1] < 1 || sizes[0] > maxSide || sizes[1] > maxSide)
+    {
+        return fail("has a maze of " + std::to_string(sizes[0]) + " x " + std::to_string(sizes[1]) + " cells, which cannot be loaded");
+    }
+
+    // Checked before the maze is allocated, so a broken size line cannot ask for more memory than the file backs
+    if(sizes[0] > static_cast<std::uint64_t>(end - position) / MIN_CSV_CELL_BYTES / sizes[1])
+    {
+        return fail("is cut short, it is too small to hold a " + std::to_string(sizes[0]) + " x " + std::to_string(sizes[1]) + " maze");
+    }
+
+    m_offset = static_cast<std::size_t>(position - text);
+    m_hasFoundMaze = true;
+    m_numRows = static_cast<int>(sizes[0]);
+    m_numCols = static_cast<int>(sizes[1]);
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * readCsvMaze()
+ * 
+ * Parses the cells of a maze in a csv file, see writeMazeDataCSV()
+ *     Each cell is "Cell" and one of "Regular", "Path", "Entrance" or "Exit", then an S if 
+ *     its south wall is closed and an E if its east wall is closed, then a comma
+ *     The cells are matched in place, a row at a time into the wall bitplane rows
+ *     An entrance with no exit is both, writeMazeDataCSV() only writes the entrance when 
+ *     the two share a cell, as they can in mazes a single cell wide
+ * 
+ * @param[in,out] maze Maze of the size read by nextCsvMaze(), freshly reset
+ * @return true if every cell is valid and the maze has an entrance
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::readCsvMaze(Maze& maze)
+{
+    const char* text = reinterpret_cast<const char*>(m_file.getData());
+    const char* position = text + m_offset;
+    const char* end = text + m_file.getSize();
+    int entrance[2] = { Maze::INVALID_ROW_COL, Maze::INVALID_ROW_COL };
+    int exit[2] = { Maze::INVALID_ROW_COL, Maze::INVALID_ROW_COL };
+
+    for(int row = 0; row < m_numRows; row++)
+    {
+        std::fill(m_southWalls.begin(), m_southWalls.end(), 0);
+        std::fill(m_eastWalls.begin(), m_eastWalls.end(), 0);
+
+        for(int col = 0; col < m_numCols; col++)
+        {
+            // "Cell" and the first letter of its kind
+            if(end - position < 5 || std::memcmp(position, "Cell", 4) != 0)
+            {
+                return fail("has no cell at row " + std::to_string(row) + " column " + std::to_string(col));
+            }
+            position += 4;
+
+            const char* kind = "Regular";
+            if(*position == 'P')
+            {
+                kind = "Path";
+            }
+            else if(*position == 'E')
+            {
+                bool isEntrance = (end - position > 1 && position[1] == 'n');
+                kind = isEntrance ? "Entrance" : "Exit";
+                int* coords = isEntrance ? entrance : exit;
+                coords[0] = row;
+                coords[1] = col;
+            }
+            const std::size_t kindLength = std::strlen(kind);
+            if(static_cast<std::size_t>(end - position) < kindLength + 1 || std::memcmp(position, kind, kindLength) != 0)
+            {
+                return fail("has an unknown cell at row " + std::to_string(row) + " column " + std::to_string(col));
+            }
+            position += kindLength;
+
+            // Closed walls are written, open ones are left out
+            bool isSouthClosed = (*position == 'S');
+            position += isSouthClosed;
+            bool isEastClosed = (position < end && *position == 'E');
+            position += isEastClosed;
+            if(position == end || *position != ',')
+            {
+                return fail("has an unknown cell at row " + std::to_string(row) + " column " + std::to_string(col));
+            }
+            position++;
+
+            const std::uint64_t wallBit = std::uint64_t(1) << (col & 63);
+            m_southWalls[col >> 6] |= isSouthClosed ? 0 : wallBit;
+            m_eastWalls[col >> 6] |= isEastClosed ? 0 : wallBit;
+        }
+
+        if(row < m_numRows - 1)
+        {
+            position += (position < end && *position == '\r');
+            if(position == end || *position != '\n')
+            {
+                return fail("has more than " + std::to_string(m_numCols) + " cells in row " + std::to_string(row));
+            }
+            position++;
+        }
+
+        // Walls facing the border are dropped by setWallRow()
+        maze.setWallRow(row, m_southWalls.data(), m_eastWalls.data());
+    }
+    m_offset = static_cast<std::size_t>(position - text);
+
+    if(entrance[0] != Maze::INVALID_ROW_COL && exit[0] == Maze::INVALID_ROW_COL)
+    {
+        exit[0] = entrance[0];
+        exit[1] = entrance[1];
+    }
+    if(entrance[0] == Maze::INVALID_ROW_COL || exit[0] == Maze::INVALID_ROW_COL)
+    {
+        return fail("has a maze without an entrance and an exit");
+    }
+    maze.labelMazeEntrance(entrance[0], entrance[1]);
+    maze.labelMazeExit(exit[0], exit[1]);
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * nextBinaryMaze()
+ * 
+ * Checks the header of the next record of a binary maze file, see parseMazeBinaryHeader()
+ * 
+ * @return true if there is another record with a valid header
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::nextBinaryMaze()
+{
+    if(m_offset == m_file.getSize())
+    {
+        return false;
+    }
+
+    if(!parseMazeBinaryHeader(m_file.getData() + m_offset, m_file.getSize() - m_offset, m_binaryHeader))
+    {
+        return fail("has no valid binary maze record at byte " + std::to_string(m_offset));
+    }
+
+    const std::uint64_t maxSide = static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+    if(m_binaryHeader.numRows < 1 || m_binaryHeader.numCols < 1 || m_binaryHeader.numRows > maxSide || m_binaryHeader.numCols > maxSide)
+    {
+        return fail("has a maze of " + std::to_string(m_binaryHeader.numRows) + " x " + std::to_string(m_binaryHeader.numCols) + " cells, which cannot be loaded");
+    }
+
+    m_numRows = static_cast<int>(m_binaryHeader.numRows);
+    m_numCols = static_cast<int>(m_binaryHeader.numCols);
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * readBinaryMaze()
+ * 
+ * Copies the wall bitplanes of a binary maze record, which have the same layout as the 
+ * ones of a Maze, a row at a time
+ * 
+ * @param[in,out] maze Maze of the size read by nextBinaryMaze(), freshly reset
+ * @return true if the record has an entrance and an exit inside the maze
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::readBinaryMaze(Maze& maze)
+{
+    const std::uint8_t* record = m_file.getData() + m_offset;
+    const std::size_t wordsPerRow = m_southWalls.size();
+    m_offset += static_cast<std::size_t>(m_binaryHeader.totalBytes);
+
+    const MazeBinaryHeader& header = m_binaryHeader;
+    if(header.entranceRow < 0 || header.entranceRow >= m_numRows || header.entranceCol < 0 || header.entranceCol >= m_numCols || \
+       header.exitRow < 0 || header.exitRow >= m_numRows || header.exitCol < 0 || header.exitCol >= m_numCols)
+    {
+        return fail("has a maze without an entrance and an exit");
+    }
+
+    for(int row = 0; row < m_numRows; row++)
+    {
+        const std::uint8_t* southRow = record + MAZE_BINARY_HEADER_BYTES + static_cast<std::size_t>(row) * 16 * wordsPerRow;
+        const std::uint8_t* eastRow = southRow + 8 * wordsPerRow;
+        for(std::size_t word = 0; word < wordsPerRow; word++)
+        {
+            m_southWalls[word] = loadLittleEndian(southRow + 8 * word, 8);
+            m_eastWalls[word] = loadLittleEndian(eastRow + 8 * word, 8);
+        }
+        maze.setWallRow(row, m_southWalls.data(), m_eastWalls.data());
+    }
+
+    maze.labelMazeEntrance(static_cast<int>(header.entranceRow), static_cast<int>(header.entranceCol));
+    maze.labelMazeExit(static_cast<int>(header.exitRow), static_cast<int>(header.exitCol));
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * findImageGrid()
+ * 
+ * Decodes a png image and finds the grid of cells in it
+ *     Dark pixels are walls, except brightly colored ones, which mark the entrance and exit 
+ *     The outer wall is the box around every wall pixel, and its left and top sides give 
+ *     the thickness of a wall
+ *     Unless the number of rows and columns was given, a column of pixels crossing a line 
+ *     of vertical walls is mostly walls, since about half of those walls are closed, while 
+ *     a column crossing cells only meets the horizontal walls. The number of columns is 
+ *     the one whose evenly spaced lines hold the most walls against the cells between 
+ *     them, and the same goes for rows
+ * 
+ * @return true if the image was decoded and has a grid of at least one cell
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::findImageGrid()
+{
+    m_offset = m_file.getSize();
+    if(!m_decoder.decode(m_file.getData(), m_file.getSize(), m_fileName))
+    {
+        m_hasFailed = true;
+        return false;
+    }
+
+    const std::uint32_t width = m_decoder.getWidth();
+    const std::uint32_t height = m_decoder.getHeight();
+    m_wallPixels.resize(static_cast<std::size_t>(width) * height);
+    std::uint32_t minX = width;
+    std::uint32_t maxX = 0;
+    std::uint32_t minY = height;
+    std::uint32_t maxY = 0;
+    for(std::uint32_t y = 0; y < height; y++)
+    {
+        const std::uint8_t* pixel = m_decoder.getPixelRow(y);
+        std::uint8_t* wallRow = m_wallPixels.data() + static_cast<std::size_t>(y) * width;
+        for(std::uint32_t x = 0; x < width; x++, pixel += 3)
+        {
+            int luminance = (77 * pixel[0] + 150 * pixel[1] + 29 * pixel[2]) >> 8;
+            int brightest = std::max(pixel[0], std::max(pixel[1], pixel[2]));
+            int darkest = std::min(pixel[0], std::min(pixel[1], pixel[2]));
+            bool isMarker = brightest >= 192 && brightest - darkest >= 128;
+            wallRow[x] = (luminance < 128 && !isMarker) ? 1 : 0;
+            if(wallRow[x])
+            {
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x);
+                minY = std::min(minY, y);
+                maxY = std::max(maxY, y);
+            }
+        }
+    }
+    if(minX > maxX)
+    {
+        return fail("has no dark pixels to take as walls");
+    }
+
+    const std::uint32_t gridWidth = maxX - minX + 1;
+    const std::uint32_t gridHeight = maxY - minY + 1;
+    auto isWallPixel = [&](std::uint32_t x, std::uint32_t y)
+    {
+        return m_wallPixels[static_cast<std::size_t>(y) * width + x] != 0;
+    };
+
+    // Thickness of the outer wall, the median of its runs of wall pixels on each row and column
+    std::vector<std::uint32_t> runLengths;
+    for(std::uint32_t y = minY; y <= maxY; y++)
+    {
+        std::uint32_t x = minX;
+        while(x <= maxX && isWallPixel(x, y))
+        {
+            x++;
+        }
+        if(x > minX)
+        {
+            runLengths.push_back(x - minX);
+        }
+    }
+    for(std::uint32_t x = minX; x <= maxX; x++)
+    {
+        std::uint32_t y = minY;
+        while(y <= maxY && isWallPixel(x, y))
+        {
+            y++;
+        }
+        if(y > minY)
+        {
+            runLengths.push_back(y - minY);
+        }
+    }
+    std::nth_element(runLengths.begin(), runLengths.begin() + runLengths.size() / 2, runLengths.end());
+    m_wallThickness = runLengths[runLengths.size() / 2];
+
+    // Cells along one side, from the evenly spaced lines of walls that best split the wall 
+    // pixels from the cells. Each number of cells is scored by the between-class variance 
+    // of the share of wall pixels on its lines and off them, so lines that miss the walls, 
+    // and lines so few that they only hold the outer wall, both score low
+    auto countCells = [&](bool isAlongX)
+    {
+        const std::uint32_t length = isAlongX ? gridWidth : gridHeight;
+        const std::uint32_t depth = isAlongX ? gridHeight : gridWidth;
+        const std::uint32_t thickness = static_cast<std::uint32_t>(m_wallThickness);
+        std::vector<std::uint64_t> wallPixelSums(length + 1, 0);
+        for(std::uint32_t j = 0; j < depth; j++)
+        {
+            for(std::uint32_t i = 0; i < length; i++)
+            {
+                wallPixelSums[i + 1] += isAlongX ? isWallPixel(minX + i, minY + j) : isWallPixel(minX + j, minY + i);
+            }
+        }
+        for(std::uint32_t i = 0; i < length; i++)
+        {
+            wallPixelSums[i + 1] += wallPixelSums[i];
+        }
+
+        // The outer wall is a wall whatever the number of cells, so only the lines inside it count
+        const double innerPixels = static_cast<double>(length - 2 * thickness) * depth;
+        const double innerWallPixels = static_cast<double>(wallPixelSums[length - thickness] - wallPixelSums[thickness]);
+        int bestNumCells = 1;
+        double bestScore = 0.0;
+        for(std::uint32_t numCells = 2; numCells * (thickness + 1) + thickness <= length; numCells++)
+        {
+            const double spacing = static_cast<double>(length - thickness) / numCells;
+            std::uint64_t lineWallPixels = 0;
+            for(std::uint32_t line = 1; line < numCells; line++)
+            {
+                std::uint32_t lineStart = static_cast<std::uint32_t>(std::lround(line * spacing));
+                lineWallPixels += wallPixelSums[lineStart + thickness] - wallPixelSums[lineStart];
+            }
+
+            const double linePixels = static_cast<double>(numCells - 1) * thickness * depth;
+            const double cellPixels = innerPixels - linePixels;
+            const double lineShare = lineWallPixels / linePixels;
+            const double cellShare = (innerWallPixels - lineWallPixels) / cellPixels;
+            const double score = (lineShare - cellShare) * (lineShare - cellShare) * (linePixels / innerPixels) * (cellPixels / innerPixels);
+            if(lineShare > cellShare && score > bestScore)
+            {
+                bestScore = score;
+                bestNumCells = static_cast<int>(numCells);
+            }
+        }
+        return bestNumCells;
+    };
+
+    m_numRows = (m_imageRows > 0) ? m_imageRows : countCells(false);
+    m_numCols = (m_imageCols > 0) ? m_imageCols : countCells(true);
+    if(m_numRows < 1 || m_numCols < 1)
+    {
+        m_numRows = 0;
+        m_numCols = 0;
+        return fail("has no grid of walls to load a maze from");
+    }
+
+    m_gridLeft = minX;
+    m_gridTop = minY;
+    m_cellWidth = (gridWidth - m_wallThickness) / m_numCols;
+    m_cellHeight = (gridHeight - m_wallThickness) / m_numRows;
+    if(m_cellWidth < 1.0 || m_cellHeight < 1.0)
+    {
+        m_numRows = 0;
+        m_numCols = 0;
+        return fail("is too small for a maze of that many cells");
+    }
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * isImageWallClosed()
+ * 
+ * Checks if a wall of an image is closed, from the pixels along the middle half of it
+ * 
+ * @param[in] x         Column of the first pixel of the wall
+ * @param[in] y         Row of the first pixel of the wall
+ * @param[in] length    Length of the wall in pixels
+ * @param[in] isAlongX  true for a horizontal wall, false for a vertical one
+ * @return true if at least half of the pixels checked are wall pixels
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::isImageWallClosed(double x, double y, double length, bool isAlongX) const
+{
+    const std::uint32_t width = m_decoder.getWidth();
+    const std::uint32_t height = m_decoder.getHeight();
+    int numChecked = 0;
+    int numWallPixels = 0;
+    for(double offset = length / 4; offset < 3 * length / 4 || numChecked == 0; offset += 1.0)
+    {
+        double pixelX = isAlongX ? x + offset : x;
+        double pixelY = isAlongX ? y : y + offset;
+        std::uint32_t column = static_cast<std::uint32_t>(std::min<double>(std::max(pixelX, 0.0), width - 1));
+        std::uint32_t row = static_cast<std::uint32_t>(std::min<double>(std::max(pixelY, 0.0), height - 1));
+        numWallPixels += m_wallPixels[static_cast<std::size_t>(row) * width + column];
+        numChecked++;
+    }
+    return 2 * numWallPixels >= numChecked;
+}
+
+/**--------------------------------------------------------------------------------------
+ * findImageCellOfColor()
+ * 
+ * Finds the cell whose center pixel is closest to a color, like the entrance and exit 
+ * colors of the rendered images
+ * 
+ * @param[in] color RGB color to look for
+ * @return the index row * columns + col of the cell, or -1 if no cell is close enough
+ * --------------------------------------------------------------------------------------
+*/
+std::int64_t MazeReader::findImageCellOfColor(const std::uint8_t* color) const
+{
+    std::int64_t closestCell = -1;
+    int closestDistance = IMAGE_MARKER_COLOR_DISTANCE;
+    for(int row = 0; row < m_numRows; row++)
+    {
+        std::uint32_t centerY = static_cast<std::uint32_t>(m_gridTop + row * m_cellHeight + (m_cellHeight + m_wallThickness) / 2);
+        const std::uint8_t* pixelRow = m_decoder.getPixelRow(std::min(centerY, m_decoder.getHeight() - 1));
+        for(int col = 0; col < m_numCols; col++)
+        {
+            std::uint32_t centerX = static_cast<std::uint32_t>(m_gridLeft + col * m_cellWidth + (m_cellWidth + m_wallThickness) / 2);
+            const std::uint8_t* pixel = pixelRow + 3 * static_cast<std::size_t>(std::min(centerX, m_decoder.getWidth() - 1));
+            int distance = std::abs(pixel[0] - color[0]) + std::abs(pixel[1] - color[1]) + std::abs(pixel[2] - color[2]);
+            if(distance < closestDistance)
+            {
+                closestDistance = distance;
+                closestCell = static_cast<std::int64_t>(row) * m_numCols + col;
+            }
+        }
+    }
+    return closestCell;
+}
+
+/**--------------------------------------------------------------------------------------
+ * readImageMaze()
+ * 
+ * Reads the walls of the grid found by findImageGrid()
+ *     The entrance and exit are the cells colored like the ones of the rendered images 
+ *     (coral and red), or else the first two cells with an opening in the outer wall
+ * 
+ * @param[in,out] maze Maze of the size found by findImageGrid(), freshly reset
+ * @return true if the image has an entrance and an exit
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeReader::readImageMaze(Maze& maze)
+{
+    const double halfThickness = m_wallThickness / 2;
+    const double cellInsideWidth = m_cellWidth - m_wallThickness;
+    const double cellInsideHeight = m_cellHeight - m_wallThickness;
+    for(int row = 0; row < m_numRows; row++)
+    {
+        std::fill(m_southWalls.begin(), m_southWalls.end(), 0);
+        std::fill(m_eastWalls.begin(), m_eastWalls.end(), 0);
+        const double cellTop = m_gridTop + row * m_cellHeight + m_wallThickness;
+        for(int col = 0; col < m_numCols; col++)
+        {
+            const double cellLeft = m_gridLeft + col * m_cellWidth + m_wallThickness;
+            const std::uint64_t wallBit = std::uint64_t(1) << (col & 63);
+            if(row < m_numRows - 1 && !isImageWallClosed(cellLeft, cellTop + cellInsideHeight + halfThickness, cellInsideWidth, true))
+            {
+                m_southWalls[col >> 6] |= wallBit;
+            }
+            if(col < m_numCols - 1 && !isImageWallClosed(cellLeft + cellInsideWidth + halfThickness, cellTop, cellInsideHeight, false))
+            {
+                m_eastWalls[col >> 6] |= wallBit;
+            }
+        }
+        maze.setWallRow(row, m_southWalls.data(), m_eastWalls.data());
+    }
+
+    std::int64_t entranceCell = findImageCellOfColor(MAZE_PALETTE + 3 * MAZE_ENTRANCE_COLOR);
+    std::int64_t exitCell = findImageCellOfColor(MAZE_PALETTE + 3 * MAZE_EXIT_COLOR);
+    if(entranceCell < 0 || exitCell < 0 || entranceCell == exitCell)
+    {
+        // Openings in the outer wall, clockwise from the top left corner
+        entranceCell = -1;
+        exitCell = -1;
+        const std::int64_t numBorderCells = 2 * static_cast<std::int64_t>(m_numRows) + 2 * static_cast<std::int64_t>(m_numCols);
+        for(std::int64_t side = 0; side < numBorderCells && exitCell < 0; side++)
+        {
+            int row = 0;
+            int col = 0;
+            bool isOpen = false;
+            if(side < m_numCols)
+            {
+                col = static_cast<int>(side);
+                isOpen = !isImageWallClosed(m_gridLeft + col * m_cellWidth + m_wallThickness, m_gridTop + halfThickness, cellInsideWidth, true);
+            }
+            else if(side < m_numCols + m_numRows)
+            {
+                row = static_cast<int>(side - m_numCols);
+                col = m_numCols - 1;
+                isOpen = !isImageWallClosed(m_gridLeft + m_numCols * m_cellWidth + halfThickness, m_gridTop + row * m_cellHeight + m_wallThickness, cellInsideHeight, false);
+            }
+            else if(side < 2 * m_numCols + m_numRows)
+            {
+                row = m_numRows - 1;
+                col = static_cast<int>(2 * m_numCols + m_numRows - 1 - side);
+                isOpen = !isImageWallClosed(m_gridLeft + col * m_cellWidth + m_wallThickness, m_gridTop + m_numRows * m_cellHeight + halfThickness, cellInsideWidth, true);
+            }
+            else
+            {
+                row = static_cast<int>(numBorderCells - 1 - side);
+                isOpen = !isImageWallClosed(m_gridLeft + halfThickness, m_gridTop + row * m_cellHeight + m_wallThickness, cellInsideHeight, false);
+            }
+
+            std::int64_t cell = static_cast<std::int64_t>(row) * m_numCols + col;
+            if(isOpen && entranceCell < 0)
+            {
+                entranceCell = cell;
+            }
+            else if(isOpen && cell != entranceCell)
+            {
+                exitCell = cell;
+            }
+        }
+    }
+    if(entranceCell < 0 || exitCell < 0)
+    {
+        return fail("has no entrance and exit, color them coral and red like the rendered images do, or leave openings in the outer wall");
+    }
+
+    maze.labelMazeEntrance(static_cast<int>(entranceCell / m_numCols), static_cast<int>(entranceCell % m_numCols));
+    maze.labelMazeExit(static_cast<int>(exitCell / m_numCols), static_cast<int>(exitCell % m_numCols));
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * listMazeFiles()
+ * 
+ * Lists the maze files of a directory that a MazeReader loads, found by their extension 
+ * (.csv, .mzb or .png), sorted by name
+ * 
+ * @param[in]   directory   Directory to list, not searched recursively
+ * @param[out]  fileNames   Paths of the maze files
+ * @return false if the directory could not be read
+ * --------------------------------------------------------------------------------------
+*/
+bool listMazeFiles(const std::string& directory, std::vector<std::string>& fileNames)
+{
+    fileNames.clear();
+    std::error_code directoryError;
+    for(std::filesystem::directory_iterator entry(directory, directoryError), last; !directoryError && entry != last; entry.increment(directoryError))
+    {
+        std::error_code fileError;
+        std::string extension = entry->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char letter) { return static_cast<char>(std::tolower(letter)); });
+        if(entry->is_regular_file(fileError) && (extension == ".csv" || extension == ".mzb" || extension == ".png"))
+        {
+            fileNames.push_back(entry->path().string());
+        }
+    }
+    if(directoryError)
+    {
+        std::cerr << "ERROR: Could not read the directory " << directory << ": " << directoryError.message() << std::endl;
+        return false;
+    }
+
+    std::sort(fileNames.begin(), fileNames.end());
+    return true;
+}
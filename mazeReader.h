@@ -0,0 +1,213 @@
+/*mazeReader.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze reader
+ * 
+ * Loads mazes made elsewhere to be solved: mazeData.csv files, binary maze files and
+ * batch shards of either, and png images of mazes
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "mappedFile.h"
+#include "maze.h"
+#include "mazeBinary.h"
+#include "pngReader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * MazeReader class
+ * 
+ * Loads mazes from maze data files, so mazes made elsewhere can be solved
+ *     Reads mazeData.csv files, binary maze files (.mzb), batch shards of either holding 
+ *     many mazes one after another, and png images of mazes, whether rendered with 
+ *     --render png or scanned
+ *     The file is mapped and parsed in place, one row at a time straight into the wall 
+ *     bitplanes of a Maze, see Maze::setWallRow(), so nothing is allocated per cell
+ *     Paths stored in the files are not loaded, the mazes are loaded to be solved
+ *     The buffers are kept from one file to the next, so one reader can load many files
+ * --------------------------------------------------------------------------------------
+*/
+class MazeReader
+{
+public:
+    /**
+     * Integers representing the file formats read
+    */
+    static const int CSV_FORMAT = 0;
+    static const int BINARY_FORMAT = 1;
+    static const int PNG_FORMAT = 2;
+    static const int INVALID_FORMAT = -1;
+
+    MazeReader();
+
+    /**--------------------------------------------------------------------------------------
+     * open()
+     * 
+     * Maps a maze file and finds out its format from its first bytes, see nextMaze()
+     * 
+     * @param[in] fileName  Name of the file to load mazes from
+     * @param[in] imageRows Number of rows of cells of a png image, 0 to find it from the 
+     *                      spacing of the walls
+     * @param[in] imageCols Number of columns of cells of a png image, 0 to find it too
+     * @return true if the file was mapped and is in one of the formats read
+     * --------------------------------------------------------------------------------------
+    */
+    bool open(const std::string& fileName, int imageRows = 0, int imageCols = 0);
+
+    /**--------------------------------------------------------------------------------------
+     * close()
+     * 
+     * Unmaps the file, if one is mapped
+     * --------------------------------------------------------------------------------------
+    */
+    void close();
+
+    /**--------------------------------------------------------------------------------------
+     * nextMaze()
+     * 
+     * Finds the next maze of the file and reads its size, see getNumRows()
+     *     Each maze found must be loaded with readMaze() before looking for the next one
+     * 
+     * @return true if there is another maze, false at the end of the file or if the file 
+     * is not valid, see hasFailed()
+     * --------------------------------------------------------------------------------------
+    */
+    bool nextMaze();
+
+    /**--------------------------------------------------------------------------------------
+     * readMaze()
+     * 
+     * Loads the maze found by nextMaze() into a maze of its size
+     * 
+     * @param[in,out] maze Maze of getNumRows() x getNumCols() cells, reset and filled out 
+     * with the walls, entrance and exit of the maze in the file
+     * @return true if the maze was loaded, false if it is not valid, see hasFailed()
+     * --------------------------------------------------------------------------------------
+    */
+    bool readMaze(Maze& maze);
+
+    /**--------------------------------------------------------------------------------------
+     * hasFailed()
+     * 
+     * Checks if the file turned out not to be valid, each error is reported as it is found
+     * 
+     * @return true if open(), nextMaze() or readMaze() found the file not to be valid
+     * --------------------------------------------------------------------------------------
+    */
+    bool hasFailed() const
+    {
+        return m_hasFailed;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getFormat() / getNumRows() / getNumCols()
+     * 
+     * Returns the format of the file, and the size of the maze found by nextMaze()
+     * --------------------------------------------------------------------------------------
+    */
+    int getFormat() const
+    {
+        return m_format;
+    }
+
+    int getNumRows() const
+    {
+        return m_numRows;
+    }
+
+    int getNumCols() const
+    {
+        return m_numCols;
+    }
+
+private:
+    bool fail(const std::string& problem);
+
+    bool nextCsvMaze();
+    bool readCsvMaze(Maze& maze);
+    bool nextBinaryMaze();
+    bool readBinaryMaze(Maze& maze);
+    bool findImageGrid();
+    bool readImageMaze(Maze& maze);
+
+    // true if at least half of the middle of a wall, length pixels from (x, y) along x (or y), are wall pixels
+    bool isImageWallClosed(double x, double y, double length, bool isAlongX) const;
+
+    // Cell of the image whose center is closest to a palette color, or -1 if none is close
+    std::int64_t findImageCellOfColor(const std::uint8_t* color) const;
+
+    MappedFile m_file;
+    std::string m_fileName;
+    int m_format;
+    std::size_t m_offset;
+    bool m_hasFailed;
+    bool m_hasFoundMaze;
+    int m_numRows;
+    int m_numCols;
+
+    // One row of each wall bitplane, see Maze::setWallRow()
+    std::vector<std::uint64_t> m_southWalls;
+    std::vector<std::uint64_t> m_eastWalls;
+
+    MazeBinaryHeader m_binaryHeader;
+
+    /**
+     * Png images
+     *     m_wallPixels: 1 for every dark pixel, which is taken to be part of a wall
+     *     m_gridLeft, m_gridTop: top left corner of the outer wall
+     *     m_cellWidth, m_cellHeight: distance between the walls, in pixels
+     *     m_wallThickness: thickness of a wall, in pixels
+    */
+    int m_imageRows;
+    int m_imageCols;
+    PngDecoder m_decoder;
+    std::vector<std::uint8_t> m_wallPixels;
+    double m_gridLeft;
+    double m_gridTop;
+    double m_cellWidth;
+    double m_cellHeight;
+    double m_wallThickness;
+};
+
+/**--------------------------------------------------------------------------------------
+ * listMazeFiles()
+ * 
+ * Lists the maze files of a directory that a MazeReader loads, found by their extension 
+ * (.csv, .mzb or .png), sorted by name
+ * 
+ * @param[in]   directory   Directory to list, not searched recursively
+ * @param[out]  fileNames   Paths of the maze files
+ * @return false if the directory could not be read
+ * --------------------------------------------------------------------------------------
+*/
+bool listMazeFiles(const std::string& directory, std::vector<std::string>& fileNames);
@@ -0,0 +1,636 @@
+/*mazeRenderer.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze renderer
+ * 
+ * Draws the unsolved and solved versions of a maze as SVG or PNG image files, straight
+ * from the Maze, without going through mazeData.csv and maze_img_displayer.py
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazeRenderer.h"
+#include "bitOps.h"
+#include "mazeWriter.h"
+#include "metrics.h"
+#include "pngWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+/**
+ * Margin around the maze and default image size in pixels, the same as maze_img_displayer.py
+*/
+const int RENDER_PADDING = 10;
+const int RENDER_DEFAULT_SIZE = 800;
+
+const std::uint8_t MAZE_PALETTE[3 * NUM_MAZE_COLORS] = { 255, 255, 255,    // White
+                                                         0, 0, 0,          // Walls
+                                                         144, 238, 144,    // Path, lightgreen
+                                                         255, 127, 80,     // Entrance, coral
+                                                         255, 0, 0 };      // Exit, red
+
+
+/**--------------------------------------------------------------------------------------
+ * defaultRenderCellSize()
+ * 
+ * Returns the number of pixels per cell that makes a maze about 800 pixels on its longer 
+ * side, the size maze_img_displayer.py draws, or 2 pixels for mazes too big for that
+ * 
+ * @param[in] maze Maze to be rendered
+ * @return the number of pixels per cell
+ * --------------------------------------------------------------------------------------
+*/
+int defaultRenderCellSize(const Maze& maze)
+{
+    int longerSide = std::max(maze.getROWCELLS(), maze.getCOLCELLS());
+    return std::max(2, RENDER_DEFAULT_SIZE / std::max(longerSide, 1));
+}
+
+/**--------------------------------------------------------------------------------------
+ * defaultRenderCellSize()
+ * 
+ * Returns the number of pixels per cell unit that makes a GridGraph about 800 pixels on 
+ * its longer side, or 2 pixels for mazes too big for that
+ * 
+ * @param[in] graph GridGraph to be rendered
+ * @return the number of pixels per cell unit
+ * --------------------------------------------------------------------------------------
+*/
+int defaultRenderCellSize(const GridGraph& graph)
+{
+    double longerSide = std::max(graph.getWidth(), graph.getHeight());
+    return std::max(2, static_cast<int>(RENDER_DEFAULT_SIZE / std::max(longerSide, 1.0)));
+}
+
+/**--------------------------------------------------------------------------------------
+ * wallWidthForCellSize()
+ * 
+ * Returns the width of a wall in pixels, about the same fraction of a cell at every size
+ * 
+ * @param[in] cellSize Pixels per cell
+ * @return the wall width in pixels, at least 1 and less than cellSize
+ * --------------------------------------------------------------------------------------
+*/
+int wallWidthForCellSize(int cellSize)
+{
+    return std::max(1, std::min(cellSize / 6, cellSize - 1));
+}
+
+/**--------------------------------------------------------------------------------------
+ * findNextWall()
+ * 
+ * Finds the next column, from col on, whose wall in a row of a wall bitplane is closed 
+ * (or open)
+ * 
+ * @param[in] wallRow   Row of a wall bitplane, see Maze::getSouthWallRow()
+ * @param[in] col       First column to check
+ * @param[in] numCols   Number of columns to check, walls past it are ignored
+ * @param[in] isClosed  true to find a closed wall, false to find an open one
+ * @return the column of the wall found, or numCols if there is none
+ * --------------------------------------------------------------------------------------
+*/
+int findNextWall(const std::uint64_t* wallRow, int col, int numCols, bool isClosed)
+{
+    while(col < numCols)
+    {
+        // Set bits are open walls, so closed walls are found in the inverted word
+        std::uint64_t word = isClosed ? ~wallRow[col >> 6] : wallRow[col >> 6];
+        word &= ~std::uint64_t(0) << (col & 63);
+        if(word != 0)
+        {
+            return std::min((col & ~63) + countTrailingZeros(word), numCols);
+        }
+        col = (col & ~63) + 64;
+    }
+    return numCols;
+}
+
+/**--------------------------------------------------------------------------------------
+ * appendSvgPreamble()
+ * 
+ * Adds the opening svg element and the wall style, with the maze drawn in cell units
+ * 
+ * @param[in,out]   svg         Buffer of the svg file
+ * @param[in]       mazeWidth   Width of the maze in cells
+ * @param[in]       mazeHeight  Height of the maze in cells
+ * @param[in]       cellSize    Pixels per cell
+ * --------------------------------------------------------------------------------------
+*/
+void appendSvgPreamble(MazeOutputBuffer& svg, double mazeWidth, double mazeHeight, int cellSize)
+{
+    double padding = static_cast<double>(RENDER_PADDING) / cellSize;
+    double wallWidth = static_cast<double>(wallWidthForCellSize(cellSize)) / cellSize;
+    long long width = static_cast<long long>(std::ceil(mazeWidth * cellSize)) + 2 * RENDER_PADDING;
+    long long height = static_cast<long long>(std::ceil(mazeHeight * cellSize)) + 2 * RENDER_PADDING;
+
+    char text[512];
+    int textLength = std::snprintf(text, sizeof(text), \
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n" \
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%lld\" height=\"%lld\" viewBox=\"%g %g %g %g\" style=\"background: white\">\n" \
+        "<defs>\n<style type=\"text/css\"><![CDATA[\n" \
+        "path.walls {\n    fill: none;\n    stroke: #000000;\n    stroke-linecap: square;\n    stroke-width: %g;\n}\n" \
+        "]]></style>\n</defs>\n", \
+        width, height, -padding, -padding, mazeWidth + 2 * padding, mazeHeight + 2 * padding, wallWidth);
+    svg.append(text, static_cast<std::size_t>(textLength));
+}
+
+/**--------------------------------------------------------------------------------------
+ * appendSvgSquare()
+ * 
+ * Adds a colored square inside a cell
+ * 
+ * @param[in,out]   svg     Buffer of the svg file
+ * @param[in]       row     Row index of cell
+ * @param[in]       col     Column index of cell
+ * @param[in]       color   SVG color name
+ * --------------------------------------------------------------------------------------
+*/
+void appendSvgSquare(MazeOutputBuffer& svg, int row, int col, const char* color)
+{
+    if(row == Maze::INVALID_ROW_COL || col == Maze::INVALID_ROW_COL)
+    {
+        return;
+    }
+
+    svg.append("<rect x=\"");
+    svg.appendUnsigned(static_cast<std::uint64_t>(col));
+    svg.append(".05\" y=\"");
+    svg.appendUnsigned(static_cast<std::uint64_t>(row));
+    svg.append(".05\" width=\".9\" height=\".9\" fill=\"");
+    svg.append(color);
+    svg.append("\"/>\n");
+}
+
+/**--------------------------------------------------------------------------------------
+ * renderMazeSVG()
+ * 
+ * Writes the unsolved and solved svg images of a maze
+ *     Closed walls are merged into horizontal and vertical runs, each drawn as one "M x y h"
+ *     or "M x y v" command of a single path, in cell units with integer coordinates
+ *     Path cells are merged into horizontal runs the same way
+ * 
+ * @param[in] solvedMaze        Maze object with path from entrance to exit
+ * @param[in] unsolvedFile      Stream of the image without the path
+ * @param[in] solvedFile        Stream of the image with the path
+ * @param[in] cellSize          Pixels per cell
+ * --------------------------------------------------------------------------------------
+*/
+void renderMazeSVG(const Maze& solvedMaze, std::ostream& unsolvedFile, std::ostream& solvedFile, int cellSize)
+{
+    const int numRows = solvedMaze.getROWCELLS();
+    const int numCols = solvedMaze.getCOLCELLS();
+    MazeOutputBuffer unsolvedSvg(unsolvedFile);
+    MazeOutputBuffer solvedSvg(solvedFile);
+
+    auto appendToBoth = [&](const char* text)
+    {
+        unsolvedSvg.append(text);
+        solvedSvg.append(text);
+    };
+    auto appendUnsignedToBoth = [&](std::uint64_t value)
+    {
+        unsolvedSvg.appendUnsigned(value);
+        solvedSvg.appendUnsigned(value);
+    };
+
+    appendSvgPreamble(unsolvedSvg, numCols, numRows, cellSize);
+    appendSvgPreamble(solvedSvg, numCols, numRows, cellSize);
+
+    // Drawing the entrance, exit and path first, so that the maze walls are overlaid on top
+    std::tuple<int, int> entranceCoords = solvedMaze.getEntrance();
+    std::tuple<int, int> exitCoords = solvedMaze.getExit();
+    for(MazeOutputBuffer* svg : {&unsolvedSvg, &solvedSvg})
+    {
+        appendSvgSquare(*svg, std::get<0>(entranceCoords), std::get<1>(entranceCoords), "coral");
+        appendSvgSquare(*svg, std::get<0>(exitCoords), std::get<1>(exitCoords), "red");
+    }
+
+    // Path runs are lines through the middle of the cells, as tall as the squares
+    solvedSvg.append("<path fill=\"none\" stroke=\"lightgreen\" stroke-width=\".9\" d=\"");
+    for(int row = 0; row < numRows; row++)
+    {
+        int col = 0;
+        while(col < numCols)
+        {
+            bool isPathCell = solvedMaze.isCellOnPath(row, col) && std::make_tuple(row, col) != entranceCoords && std::make_tuple(row, col) != exitCoords;
+            if(!isPathCell)
+            {
+                col++;
+                continue;
+            }
+
+            int runStart = col;
+            while(col < numCols && solvedMaze.isCellOnPath(row, col) && std::make_tuple(row, col) != entranceCoords && std::make_tuple(row, col) != exitCoords)
+            {
+                col++;
+            }
+
+            // From runStart + 0.05 to col - 0.05
+            solvedSvg.append('M');
+            solvedSvg.appendUnsigned(static_cast<std::uint64_t>(runStart));
+            solvedSvg.append(".05 ");
+            solvedSvg.appendUnsigned(static_cast<std::uint64_t>(row));
+            solvedSvg.append(".5h");
+            solvedSvg.appendUnsigned(static_cast<std::uint64_t>(col - runStart - 1));
+            solvedSvg.append(".9");
+        }
+    }
+    solvedSvg.append("\"/>\n");
+
+    // Maze borders, then runs of closed southern walls row by row, then runs of closed 
+    // eastern walls column by column
+    appendToBoth("<path class=\"walls\" d=\"M0 0H");
+    appendUnsignedToBoth(static_cast<std::uint64_t>(numCols));
+    appendToBoth("V");
+    appendUnsignedToBoth(static_cast<std::uint64_t>(numRows));
+    appendToBoth("H0Z");
+
+    for(int row = 0; row < numRows - 1; row++)
+    {
+        const std::uint64_t* southWalls = solvedMaze.getSouthWallRow(row);
+        int runStart = findNextWall(southWalls, 0, numCols, true);
+        while(runStart < numCols)
+        {
+            int runEnd = findNextWall(southWalls, runStart, numCols, false);
+            appendToBoth("M");
+            appendUnsignedToBoth(static_cast<std::uint64_t>(runStart));
+            appendToBoth(" ");
+            appendUnsignedToBoth(static_cast<std::uint64_t>(row + 1));
+            appendToBoth("h");
+            appendUnsignedToBoth(static_cast<std::uint64_t>(runEnd - runStart));
+            runStart = findNextWall(southWalls, runEnd, numCols, true);
+        }
+    }
+
+    // Vertical runs are tracked with the row each open run started on, so the bitplanes are
+    // still read row by row
+    std::vector<int> runStartRows(numCols, Maze::INVALID_ROW_COL);
+    auto appendVerticalRun = [&](int col, int runEnd)
+    {
+        appendToBoth("M");
+        appendUnsignedToBoth(static_cast<std::uint64_t>(col + 1));
+        appendToBoth(" ");
+        appendUnsignedToBoth(static_cast<std::uint64_t>(runStartRows[col]));
+        appendToBoth("v");
+        appendUnsignedToBoth(static_cast<std::uint64_t>(runEnd - runStartRows[col]));
+        runStartRows[col] = Maze::INVALID_ROW_COL;
+    };
+
+    for(int row = 0; row < numRows; row++)
+    {
+        const std::uint64_t* eastWalls = solvedMaze.getEastWallRow(row);
+        for(int col = 0; col < numCols - 1; col++)
+        {
+            bool isClosed = !((eastWalls[col >> 6] >> (col & 63)) & 1);
+            if(isClosed && runStartRows[col] == Maze::INVALID_ROW_COL)
+            {
+                runStartRows[col] = row;
+            }
+            else if(!isClosed && runStartRows[col] != Maze::INVALID_ROW_COL)
+            {
+                appendVerticalRun(col, row);
+            }
+        }
+    }
+
+    for(int col = 0; col < numCols - 1; col++)
+    {
+        if(runStartRows[col] != Maze::INVALID_ROW_COL)
+        {
+            appendVerticalRun(col, numRows);
+        }
+    }
+
+    appendToBoth("\"/>\n</svg>\n");
+}
+
+/**--------------------------------------------------------------------------------------
+ * renderMazePNG()
+ * 
+ * Writes the unsolved and solved png images of a maze
+ *     Each row of cells is rasterized as one scanline crossing the walls above it and one 
+ *     scanline crossing the cells, each repeated to fill its height
+ *     The scanlines are compressed once; the unsolved image uses the same data with path 
+ *     cells colored white in its palette
+ * 
+ * @param[in] solvedMaze        Maze object with path from entrance to exit
+ * @param[in] unsolvedFile      Stream of the image without the path
+ * @param[in] solvedFile        Stream of the image with the path
+ * @param[in] cellSize          Pixels per cell
+ * @return true if the image is small enough to be a png
+ * --------------------------------------------------------------------------------------
+*/
+bool renderMazePNG(const Maze& solvedMaze, std::ostream& unsolvedFile, std::ostream& solvedFile, int cellSize)
+{
+    const int numRows = solvedMaze.getROWCELLS();
+    const int numCols = solvedMaze.getCOLCELLS();
+    const int wallWidth = wallWidthForCellSize(cellSize);
+
+    const std::uint64_t width = static_cast<std::uint64_t>(numCols) * cellSize + wallWidth;
+    const std::uint64_t height = static_cast<std::uint64_t>(numRows) * cellSize + wallWidth;
+    if(width > 0x7FFFFFFFu || height > 0x7FFFFFFFu)
+    {
+        std::cerr << "ERROR: renderMazeImages() cannot make a " << width << " x " << height << " png, use a smaller cell size" << std::endl;
+        return false;
+    }
+
+    std::tuple<int, int> entranceCoords = solvedMaze.getEntrance();
+    std::tuple<int, int> exitCoords = solvedMaze.getExit();
+    auto cellColor = [&](int row, int col)
+    {
+        if(std::make_tuple(row, col) == entranceCoords)
+        {
+            return MAZE_ENTRANCE_COLOR;
+        }
+        else if(std::make_tuple(row, col) == exitCoords)
+        {
+            return MAZE_EXIT_COLOR;
+        }
+        return solvedMaze.isCellOnPath(row, col) ? MAZE_PATH_COLOR : MAZE_WHITE_COLOR;
+    };
+
+    // An open wall between two cells on the path is part of the path
+    auto passageColor = [&](int row, int col, int neighborRow, int neighborCol)
+    {
+        return (cellColor(row, col) != MAZE_WHITE_COLOR && cellColor(neighborRow, neighborCol) != MAZE_WHITE_COLOR) ? MAZE_PATH_COLOR : MAZE_WHITE_COLOR;
+    };
+
+    std::vector<std::uint8_t> compressed;
+    PngDeflater deflater(compressed);
+    std::vector<std::uint8_t> scanline(width + 1);
+    auto putScanline = [&](int numRepeats)
+    {
+        // The first copy is stored as is, the others with the Up filter, which makes them zeros
+        scanline[0] = 0;
+        deflater.put(scanline.data(), scanline.size());
+        for(int repeat = 1; repeat < numRepeats; repeat++)
+        {
+            deflater.putRepeated(2, 1);
+            deflater.putRepeated(0, width);
+        }
+    };
+
+    for(int row = 0; row <= numRows; row++)
+    {
+        // Walls above the row, the southern maze border below the last row
+        std::fill(scanline.begin() + 1, scanline.end(), MAZE_WALL_COLOR);
+        for(int col = 0; row > 0 && row < numRows && col < numCols; col++)
+        {
+            if(solvedMaze.isWallOpen(row, col, Maze::NORTH_DIRECTION))
+            {
+                std::fill_n(scanline.begin() + 1 + static_cast<std::size_t>(col) * cellSize + wallWidth, cellSize - wallWidth, passageColor(row, col, row - 1, col));
+            }
+        }
+        putScanline(wallWidth);
+
+        if(row == numRows)
+        {
+            break;
+        }
+
+        // Cells of the row, with the walls to their west
+        for(int col = 0; col < numCols; col++)
+        {
+            std::uint8_t* cellPixels = scanline.data() + 1 + static_cast<std::size_t>(col) * cellSize;
+            std::uint8_t westColor = solvedMaze.isWallOpen(row, col, Maze::WEST_DIRECTION) ? passageColor(row, col, row, col - 1) : MAZE_WALL_COLOR;
+            std::fill_n(cellPixels, wallWidth, westColor);
+            std::fill_n(cellPixels + wallWidth, cellSize - wallWidth, cellColor(row, col));
+        }
+        std::fill(scanline.end() - wallWidth, scanline.end(), MAZE_WALL_COLOR);
+        putScanline(cellSize - wallWidth);
+    }
+    deflater.finish();
+
+    std::uint8_t palette[3 * NUM_MAZE_COLORS];
+    std::copy(MAZE_PALETTE, MAZE_PALETTE + 3 * NUM_MAZE_COLORS, palette);
+    writePngFile(solvedFile, static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), palette, NUM_MAZE_COLORS, compressed);
+
+    std::copy(palette + 3 * MAZE_WHITE_COLOR, palette + 3 * MAZE_WHITE_COLOR + 3, palette + 3 * MAZE_PATH_COLOR);
+    writePngFile(unsolvedFile, static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), palette, NUM_MAZE_COLORS, compressed);
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * renderMazeImages()
+ * 
+ * Renders the unsolved and the solved version of a maze, reading the Maze directly
+ *     Both images are made in one pass over the maze: for SVG the wall runs are found once
+ *     and written to both files, for PNG the pixels are rasterized and compressed once 
+ *     and the two files only differ in the palette color of the path cells
+ *     The images look the same as the ones drawn by maze_img_displayer.py: 
+ *         entrance in coral, exit in red, path in light green
+ * 
+ * @param[in] solvedMaze        Maze object with path from entrance to exit
+ * @param[in] renderFormat      MAZE_RENDER_SVG or MAZE_RENDER_PNG
+ * @param[in] unsolvedFileName  Name of the image file without the path
+ * @param[in] solvedFileName    Name of the image file with the path
+ * @param[in] cellSize          Pixels per cell, at least 2, see defaultRenderCellSize()
+ * @return true if both images were written
+ * --------------------------------------------------------------------------------------
+*/
+bool renderMazeImages(const Maze& solvedMaze, int renderFormat, const std::string& unsolvedFileName, const std::string& solvedFileName, int cellSize)
+{
+    METRIC_TIMER(METRIC_RENDER_TIMER)
+    if(cellSize < 2)
+    {
+        std::cerr << "ERROR: renderMazeImages() needs at least 2 pixels per cell" << std::endl;
+        return false;
+    }
+
+    std::ofstream unsolvedFile(unsolvedFileName, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    std::ofstream solvedFile(solvedFileName, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    if(!unsolvedFile || !solvedFile)
+    {
+        std::cerr << "ERROR: renderMazeImages() could not open " << unsolvedFileName << " and " << solvedFileName << std::endl;
+        return false;
+    }
+
+    if(renderFormat == MAZE_RENDER_PNG)
+    {
+        if(!renderMazePNG(solvedMaze, unsolvedFile, solvedFile, cellSize))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        renderMazeSVG(solvedMaze, unsolvedFile, solvedFile, cellSize);
+    }
+
+    unsolvedFile.flush();
+    solvedFile.flush();
+    if(!unsolvedFile || !solvedFile)
+    {
+        std::cerr << "ERROR: renderMazeImages() could not write " << unsolvedFileName << " and " << solvedFileName << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * appendSvgPoint()
+ * 
+ * Adds an "M x y" or "L x y" command to a path, in cell units
+ * 
+ * @param[in,out]   svg     Buffer of the svg file
+ * @param[in]       command 'M' or 'L'
+ * @param[in]       x, y    Point to move or draw to
+ * --------------------------------------------------------------------------------------
+*/
+void appendSvgPoint(MazeOutputBuffer& svg, char command, float x, float y)
+{
+    char text[64];
+    int textLength = std::snprintf(text, sizeof(text), "%c%g %g", command, static_cast<double>(x), static_cast<double>(y));
+    svg.append(text, static_cast<std::size_t>(textLength));
+}
+
+/**--------------------------------------------------------------------------------------
+ * appendSvgCell()
+ * 
+ * Adds the outline of a GridGraph cell to a path as one closed polygon
+ * 
+ * @param[in,out]   svg     Buffer of the svg file
+ * @param[in]       graph   GridGraph being rendered
+ * @param[in]       cell    Index of the cell
+ * --------------------------------------------------------------------------------------
+*/
+void appendSvgCell(MazeOutputBuffer& svg, const GridGraph& graph, std::uint32_t cell)
+{
+    for(int side = 0; side < graph.getNumSides(cell); side++)
+    {
+        appendSvgPoint(svg, (side == 0) ? 'M' : 'L', graph.getSideX(cell, side), graph.getSideY(cell, side));
+    }
+    svg.append('Z');
+}
+
+/**--------------------------------------------------------------------------------------
+ * renderGridGraphImages()
+ * 
+ * Renders the unsolved and the solved version of a GridGraph maze as svg images
+ *     Cells are drawn from their outlines: the entrance, exit and path cells filled, then 
+ *     every border side and every closed wall, the latter once from its lower cell, as 
+ *     lines of a single path
+ *     Same colors as renderMazeImages()
+ * 
+ * @param[in] solvedGraph       GridGraph with path from entrance to exit
+ * @param[in] unsolvedFileName  Name of the image file without the path
+ * @param[in] solvedFileName    Name of the image file with the path
+ * @param[in] cellSize          Pixels per cell unit, at least 2, see defaultRenderCellSize()
+ * @return true if both images were written
+ * --------------------------------------------------------------------------------------
+*/
+bool renderGridGraphImages(const GridGraph& solvedGraph, const std::string& unsolvedFileName, const std::string& solvedFileName, int cellSize)
+{
+    METRIC_TIMER(METRIC_RENDER_TIMER)
+    if(cellSize < 2)
+    {
+        std::cerr << "ERROR: renderGridGraphImages() needs at least 2 pixels per cell" << std::endl;
+        return false;
+    }
+
+    std::ofstream unsolvedFile(unsolvedFileName, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    std::ofstream solvedFile(solvedFileName, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    if(!unsolvedFile || !solvedFile)
+    {
+        std::cerr << "ERROR: renderGridGraphImages() could not open " << unsolvedFileName << " and " << solvedFileName << std::endl;
+        return false;
+    }
+
+    {
+        const std::uint32_t numCells = static_cast<std::uint32_t>(solvedGraph.getNumCells());
+        const std::uint32_t entrance = solvedGraph.getEntrance();
+        const std::uint32_t exit = solvedGraph.getExit();
+        MazeOutputBuffer unsolvedSvg(unsolvedFile);
+        MazeOutputBuffer solvedSvg(solvedFile);
+
+        // Drawing the entrance, exit and path first, so that the maze walls are overlaid on top
+        for(MazeOutputBuffer* svg : {&unsolvedSvg, &solvedSvg})
+        {
+            appendSvgPreamble(*svg, solvedGraph.getWidth(), solvedGraph.getHeight(), cellSize);
+            if(entrance != GridGraph::INVALID_CELL)
+            {
+                svg->append("<path fill=\"coral\" d=\"");
+                appendSvgCell(*svg, solvedGraph, entrance);
+                svg->append("\"/>\n");
+            }
+            if(exit != GridGraph::INVALID_CELL)
+            {
+                svg->append("<path fill=\"red\" d=\"");
+                appendSvgCell(*svg, solvedGraph, exit);
+                svg->append("\"/>\n");
+            }
+        }
+
+        solvedSvg.append("<path fill=\"lightgreen\" d=\"");
+        for(std::uint32_t cell = 0; cell < numCells; cell++)
+        {
+            if(solvedGraph.isCellOnPath(cell) && cell != entrance && cell != exit)
+            {
+                appendSvgCell(solvedSvg, solvedGraph, cell);
+            }
+        }
+        solvedSvg.append("\"/>\n");
+
+        // Walls are the same in both images, so they are formatted once and copied
+        MazeOutputBuffer walls;
+        walls.append("<path class=\"walls\" d=\"");
+        for(std::uint32_t cell = 0; cell < numCells; cell++)
+        {
+            const int numSides = solvedGraph.getNumSides(cell);
+            for(int side = 0; side < numSides; side++)
+            {
+                const int slot = solvedGraph.getSideSlot(cell, side);
+                const bool isWall = (slot == GridGraph::BORDER_SIDE) || \
+                                    (solvedGraph.getNeighbor(cell, slot) > cell && !solvedGraph.isPassageOpen(cell, slot));
+                if(isWall)
+                {
+                    const int nextSide = (side + 1 < numSides) ? side + 1 : 0;
+                    appendSvgPoint(walls, 'M', solvedGraph.getSideX(cell, side), solvedGraph.getSideY(cell, side));
+                    appendSvgPoint(walls, 'L', solvedGraph.getSideX(cell, nextSide), solvedGraph.getSideY(cell, nextSide));
+                }
+            }
+        }
+        walls.append("\"/>\n</svg>\n");
+
+        unsolvedSvg.append(walls.getData(), walls.getSize());
+        solvedSvg.append(walls.getData(), walls.getSize());
+    }
+
+    unsolvedFile.flush();
+    solvedFile.flush();
+    if(!unsolvedFile || !solvedFile)
+    {
+        std::cerr << "ERROR: renderGridGraphImages() could not write " << unsolvedFileName << " and " << solvedFileName << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,133 @@
+/*mazeRenderer.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze renderer
+ * 
+ * Draws the unsolved and solved versions of a maze as SVG or PNG image files, straight
+ * from the Maze, without going through mazeData.csv and maze_img_displayer.py
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "gridGraph.h"
+#include "maze.h"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Integers representing the image formats selectable from main()
+ *     MAZE_RENDER_SVG: vector image, walls merged into runs and drawn as one path
+ *     MAZE_RENDER_PNG: raster image, cellSize pixels per cell
+*/
+const int MAZE_RENDER_SVG = 0;
+const int MAZE_RENDER_PNG = 1;
+
+/**
+ * Palette indices of the colors in PNG images, see MAZE_PALETTE for their RGB values
+*/
+const std::uint8_t MAZE_WHITE_COLOR = 0;
+const std::uint8_t MAZE_WALL_COLOR = 1;
+const std::uint8_t MAZE_PATH_COLOR = 2;
+const std::uint8_t MAZE_ENTRANCE_COLOR = 3;
+const std::uint8_t MAZE_EXIT_COLOR = 4;
+const int NUM_MAZE_COLORS = 5;
+extern const std::uint8_t MAZE_PALETTE[3 * NUM_MAZE_COLORS];
+
+/**--------------------------------------------------------------------------------------
+ * defaultRenderCellSize()
+ * 
+ * Returns the number of pixels per cell that makes a maze about 800 pixels on its longer 
+ * side, the size maze_img_displayer.py draws, or 2 pixels for mazes too big for that
+ * 
+ * @param[in] maze Maze to be rendered
+ * @return the number of pixels per cell
+ * --------------------------------------------------------------------------------------
+*/
+int defaultRenderCellSize(const Maze& maze);
+
+/**--------------------------------------------------------------------------------------
+ * defaultRenderCellSize()
+ * 
+ * Returns the number of pixels per cell unit that makes a GridGraph about 800 pixels on 
+ * its longer side, or 2 pixels for mazes too big for that
+ * 
+ * @param[in] graph GridGraph to be rendered
+ * @return the number of pixels per cell unit
+ * --------------------------------------------------------------------------------------
+*/
+int defaultRenderCellSize(const GridGraph& graph);
+
+/**--------------------------------------------------------------------------------------
+ * wallWidthForCellSize()
+ * 
+ * Returns the width of a wall in pixels, about the same fraction of a cell at every size
+ * 
+ * @param[in] cellSize Pixels per cell
+ * @return the wall width in pixels, at least 1 and less than cellSize
+ * --------------------------------------------------------------------------------------
+*/
+int wallWidthForCellSize(int cellSize);
+
+/**--------------------------------------------------------------------------------------
+ * renderMazeImages()
+ * 
+ * Renders the unsolved and the solved version of a maze, reading the Maze directly
+ *     Both images are made in one pass over the maze: for SVG the wall runs are found once
+ *     and written to both files, for PNG the pixels are rasterized and compressed once 
+ *     and the two files only differ in the palette color of the path cells
+ *     The images look the same as the ones drawn by maze_img_displayer.py: 
+ *         entrance in coral, exit in red, path in light green
+ * 
+ * @param[in] solvedMaze        Maze object with path from entrance to exit
+ * @param[in] renderFormat      MAZE_RENDER_SVG or MAZE_RENDER_PNG
+ * @param[in] unsolvedFileName  Name of the image file without the path
+ * @param[in] solvedFileName    Name of the image file with the path
+ * @param[in] cellSize          Pixels per cell, at least 2, see defaultRenderCellSize()
+ * @return true if both images were written
+ * --------------------------------------------------------------------------------------
+*/
+bool renderMazeImages(const Maze& solvedMaze, int renderFormat, const std::string& unsolvedFileName, const std::string& solvedFileName, int cellSize);
+
+/**--------------------------------------------------------------------------------------
+ * renderGridGraphImages()
+ * 
+ * Renders the unsolved and the solved version of a GridGraph maze as svg images
+ *     Cells are drawn from their outlines: the entrance, exit and path cells filled, then 
+ *     every border side and every closed wall, the latter once from its lower cell, as 
+ *     lines of a single path
+ *     Same colors as renderMazeImages()
+ * 
+ * @param[in] solvedGraph       GridGraph with path from entrance to exit
+ * @param[in] unsolvedFileName  Name of the image file without the path
+ * @param[in] solvedFileName    Name of the image file with the path
+ * @param[in] cellSize          Pixels per cell unit, at least 2, see defaultRenderCellSize()
+ * @return true if both images were written
+ * --------------------------------------------------------------------------------------
+*/
+bool renderGridGraphImages(const GridGraph& solvedGraph, const std::string& unsolvedFileName, const std::string& solvedFileName, int cellSize);
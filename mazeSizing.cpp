@@ -0,0 +1,207 @@
+/*mazeSizing.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze sizing
+ * 
+ * Estimates the memory and time a run takes from the maze dimensions, so huge mazes can
+ * be sized before anything is allocated
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazeSizing.h"
+#include "eller.h"
+#include "mazeGenerators.h"
+#include "mazeWriter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/**
+ * Bytes of memory per cell, following the arrays each part of the program allocates
+ *     Maze: one state byte, and one bit in each of the two wall bitplanes
+ *     runWilson(): one inMaze bool, and 2 bits of walk direction
+ *     runParallelWilson(): one 32-bit claim and one 32-bit pop count
+ *     runKruskal(): two 32-bit walls, a 32-bit parent and a rank, twice as much for mazes 
+ *     past 2^31 cells
+ *     runRecursiveBacktracker(): one in-maze bit, and up to one byte of stack
+ *     runEller() and runSidewinder() only keep a row, see ellerRowStateBytes()
+ *     MazeSolver: queue entry, parent direction and visit stamp, plus the Tremaux marks 
+ *     and path bit of its TremauxContext
+*/
+const double MAZE_BYTES_PER_CELL = 1.0 + 2.0 / 8.0;
+const double WILSON_BYTES_PER_CELL = 1.0 + 2.0 / 8.0;
+const double PARALLEL_WILSON_BYTES_PER_CELL = 8.0;
+const double KRUSKAL_BYTES_PER_CELL = 2.0 * 4.0 + 4.0 + 1.0;
+const double BACKTRACKER_BYTES_PER_CELL = 1.0 / 8.0 + 1.0;
+const double SOLVER_BYTES_PER_CELL = sizeof(std::size_t) + 1.0 + 4.0 + 1.0 + 1.0 / 8.0;
+
+// runWilson() points into its flat inMaze array with one row pointer per row
+const double WILSON_BYTES_PER_ROW = sizeof(bool*);
+
+/**
+ * Nanoseconds per cell to generate and solve a maze of about a million cells on one core,
+ * including writing it out
+ *     runParallelWilson() does about twice the work of runWilson(), spread over its threads
+ *     The hybrid generator skips the longest walks of runWilson() with the Aldous-Broder Algorithm
+ *     The other generators never walk, most of their time goes to solving and writing
+*/
+const double WILSON_NS_PER_CELL = 250.0;
+const double PARALLEL_WILSON_NS_PER_CELL = 500.0;
+const double IN_MEMORY_ELLER_NS_PER_CELL = 100.0;
+const double SIDEWINDER_NS_PER_CELL = 120.0;
+const double KRUSKAL_NS_PER_CELL = 180.0;
+const double BACKTRACKER_NS_PER_CELL = 80.0;
+const double HYBRID_WILSON_NS_PER_CELL = 150.0;
+const double NS_PER_CELL_MEASURED_AT = 1.0e6;
+
+// runStreamingEller() takes the same time per cell however big the maze is
+const double ELLER_NS_PER_CELL = 40.0;
+
+/**--------------------------------------------------------------------------------------
+ * estimateMazeSize()
+ * 
+ * Works out the memory and time a run will take, from the same options main() runs with
+ *     Memory counts the Maze, the generator's and solver's work arrays and the output 
+ *     buffers, a single maze never needs the generator and the solver at the same time
+ *     Time grows with the number of cells, random walks make it grow slightly faster
+ * 
+ * @param[in] numRows       Number of rows in each maze
+ * @param[in] numCols       Number of columns in each maze
+ * @param[in] generatorType Generator filling out each maze, see mazeGenerators.h
+ * @param[in] numThreads    Number of threads generating, at least 1
+ * @param[in] numMazes      Number of mazes in batch mode, 0 for a single maze
+ * @return the estimate
+ * --------------------------------------------------------------------------------------
+*/
+MazeSizeEstimate estimateMazeSize(std::uint64_t numRows, std::uint64_t numCols, int generatorType, int numThreads, std::uint64_t numMazes)
+{
+    MazeSizeEstimate estimate;
+    estimate.numCells = numRows * numCols;
+    numThreads = std::max(numThreads, 1);
+
+    const double numCells = static_cast<double>(estimate.numCells);
+    double generatorBytes = 0.0;
+    double nsPerCell = 0.0;
+    switch(generatorType)
+    {
+        case MAZE_GENERATOR_PARALLEL_WILSON:
+            generatorBytes = PARALLEL_WILSON_BYTES_PER_CELL * numCells;
+            nsPerCell = PARALLEL_WILSON_NS_PER_CELL / numThreads;
+            break;
+        case MAZE_GENERATOR_ELLER:
+            generatorBytes = static_cast<double>(ellerRowStateBytes(static_cast<int>(numCols)));
+            nsPerCell = IN_MEMORY_ELLER_NS_PER_CELL;
+            break;
+        case MAZE_GENERATOR_SIDEWINDER:
+            nsPerCell = SIDEWINDER_NS_PER_CELL;
+            break;
+        case MAZE_GENERATOR_KRUSKAL:
+            generatorBytes = KRUSKAL_BYTES_PER_CELL * numCells * (numCells > 0x7FFFFFFF ? 2.0 : 1.0);
+            nsPerCell = KRUSKAL_NS_PER_CELL;
+            break;
+        case MAZE_GENERATOR_BACKTRACKER:
+            generatorBytes = BACKTRACKER_BYTES_PER_CELL * numCells;
+            nsPerCell = BACKTRACKER_NS_PER_CELL;
+            break;
+        case MAZE_GENERATOR_HYBRID_WILSON:
+            generatorBytes = WILSON_BYTES_PER_CELL * numCells + WILSON_BYTES_PER_ROW * numRows;
+            nsPerCell = HYBRID_WILSON_NS_PER_CELL;
+            break;
+        default:
+            generatorBytes = WILSON_BYTES_PER_CELL * numCells + WILSON_BYTES_PER_ROW * numRows;
+            nsPerCell = WILSON_NS_PER_CELL;
+            break;
+    }
+    double solverBytes = SOLVER_BYTES_PER_CELL * numCells;
+    double mazeBytes = MAZE_BYTES_PER_CELL * numCells;
+
+    // Work on big mazes takes a little longer per cell as the maze grows, about log(cells)
+    double walkGrowth = std::max(1.0, std::log2(std::max(numCells, 2.0)) / std::log2(NS_PER_CELL_MEASURED_AT));
+    double mazeSeconds = numCells * nsPerCell * walkGrowth * 1.0e-9;
+
+    double numBytes = 0.0;
+    if(numMazes > 0)
+    {
+        // Each batch worker keeps its own maze, solver and output buffer while it generates
+        numBytes = numThreads * (mazeBytes + generatorBytes + solverBytes + MazeOutputBuffer::DEFAULT_CAPACITY);
+        estimate.numSeconds = mazeSeconds * static_cast<double>(numMazes) / std::min<double>(numThreads, static_cast<double>(numMazes));
+    }
+    else
+    {
+        numBytes = mazeBytes + std::max(generatorBytes, solverBytes) + MazeOutputBuffer::DEFAULT_CAPACITY;
+        estimate.numSeconds = mazeSeconds;
+    }
+    estimate.numBytes = static_cast<std::uint64_t>(numBytes);
+
+    return estimate;
+}
+
+/**--------------------------------------------------------------------------------------
+ * estimateStreamingMazeSize()
+ * 
+ * Works out the memory and time runStreamingEller() will take
+ *     Memory is the whole budget, the row state and an output buffer filling the rest of it
+ * 
+ * @param[in] numRows           Number of rows in the maze
+ * @param[in] numCols           Number of columns in the maze
+ * @param[in] memoryBudgetBytes Memory budget of the run
+ * @return the estimate
+ * --------------------------------------------------------------------------------------
+*/
+MazeSizeEstimate estimateStreamingMazeSize(std::uint64_t numRows, std::uint64_t numCols, std::uint64_t memoryBudgetBytes)
+{
+    MazeSizeEstimate estimate;
+    estimate.numCells = numRows * numCols;
+    estimate.numBytes = memoryBudgetBytes;
+    estimate.numSeconds = static_cast<double>(estimate.numCells) * ELLER_NS_PER_CELL * 1.0e-9;
+    return estimate;
+}
+
+/**--------------------------------------------------------------------------------------
+ * physicalMemoryBytes()
+ * 
+ * Returns the amount of physical memory on this machine
+ * 
+ * @return the number of bytes of physical memory, 0 if it cannot be found
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t physicalMemoryBytes()
+{
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+    long numPages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if(numPages > 0 && pageSize > 0)
+    {
+        return static_cast<std::uint64_t>(numPages) * static_cast<std::uint64_t>(pageSize);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*mazeSizing.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze sizing
+ * 
+ * Estimates the memory and time a run takes from the maze dimensions, so huge mazes can
+ * be sized before anything is allocated
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**--------------------------------------------------------------------------------------
+ * MazeSizeEstimate struct
+ * 
+ * Expected cost of a run of main(), worked out from the maze size before anything is 
+ * allocated
+ *     numCells: number of cells in each maze
+ *     numBytes: peak memory used by the mazes and all of the work arrays
+ *     numSeconds: time to generate and solve every maze, on cores like the ones the 
+ *     NS_PER_CELL constants in mazeSizing.cpp were measured on
+ * --------------------------------------------------------------------------------------
+*/
+struct MazeSizeEstimate
+{
+    std::uint64_t numCells = 0;
+    std::uint64_t numBytes = 0;
+    double numSeconds = 0.0;
+};
+
+/**--------------------------------------------------------------------------------------
+ * estimateMazeSize()
+ * 
+ * Works out the memory and time a run will take, from the same options main() runs with
+ *     Memory counts the Maze, the generator's and solver's work arrays and the output 
+ *     buffers, a single maze never needs the generator and the solver at the same time
+ *     Time grows with the number of cells, random walks make it grow slightly faster
+ * 
+ * @param[in] numRows       Number of rows in each maze
+ * @param[in] numCols       Number of columns in each maze
+ * @param[in] generatorType Generator filling out each maze, see mazeGenerators.h
+ * @param[in] numThreads    Number of threads generating, at least 1
+ * @param[in] numMazes      Number of mazes in batch mode, 0 for a single maze
+ * @return the estimate
+ * --------------------------------------------------------------------------------------
+*/
+MazeSizeEstimate estimateMazeSize(std::uint64_t numRows, std::uint64_t numCols, int generatorType, int numThreads, std::uint64_t numMazes);
+
+/**--------------------------------------------------------------------------------------
+ * estimateStreamingMazeSize()
+ * 
+ * Works out the memory and time runStreamingEller() will take
+ *     Memory is the whole budget, the row state and an output buffer filling the rest of it
+ * 
+ * @param[in] numRows           Number of rows in the maze
+ * @param[in] numCols           Number of columns in the maze
+ * @param[in] memoryBudgetBytes Memory budget of the run
+ * @return the estimate
+ * --------------------------------------------------------------------------------------
+*/
+MazeSizeEstimate estimateStreamingMazeSize(std::uint64_t numRows, std::uint64_t numCols, std::uint64_t memoryBudgetBytes);
+
+/**--------------------------------------------------------------------------------------
+ * physicalMemoryBytes()
+ * 
+ * Returns the amount of physical memory on this machine
+ * 
+ * @return the number of bytes of physical memory, 0 if it cannot be found
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t physicalMemoryBytes();
@@ -0,0 +1,1102 @@
+/*mazeSolver.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze Solvers
+ * 
+ * Given a maze, finds a shortest path from the entrance of the maze to the exit without
+ * modifying the maze, using breadth-first search, bidirectional breadth-first search or
+ * dead-end filling
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazeSolver.h"
+#include "metrics.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <tuple>
+
+// Parent direction of the cell a search started from
+const std::uint8_t NO_PARENT_DIRECTION = 4;
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates a solver with work arrays for mazes of up to uRows x uCols cells
+ * 
+ * @param[in] uRows Number of rows to preallocate for
+ * @param[in] uCols Number of columns to preallocate for
+ * --------------------------------------------------------------------------------------
+*/
+MazeSolver::MazeSolver(int uRows, int uCols)
+    : m_numCols(uCols),
+      m_queue(static_cast<std::size_t>(uRows) * static_cast<std::size_t>(uCols)),
+      m_parentDirs(static_cast<std::size_t>(uRows) * static_cast<std::size_t>(uCols)),
+      m_visitStamps(static_cast<std::size_t>(uRows) * static_cast<std::size_t>(uCols), 0),
+      m_epoch(0),
+      m_tremauxContext(uRows, uCols)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * solverTypeFromName()
+ * 
+ * Returns the solver engine with the given name
+ * 
+ * @param[in] name One of "tremaux", "bfs", "bidirectional", "deadend" or "bitboard"
+ * @return the matching solver engine, or INVALID_SOLVER if there is none
+ * --------------------------------------------------------------------------------------
+*/
+int MazeSolver::solverTypeFromName(const std::string& name)
+{
+    if(name == "tremaux")
+    {
+        return TREMAUX_SOLVER;
+    }
+    else if(name == "bfs")
+    {
+        return BFS_SOLVER;
+    }
+    else if(name == "bidirectional")
+    {
+        return BIDIRECTIONAL_BFS_SOLVER;
+    }
+    else if(name == "deadend")
+    {
+        return DEAD_END_FILLING_SOLVER;
+    }
+    else if(name == "bitboard")
+    {
+        return BITBOARD_DEAD_END_SOLVER;
+    }
+
+    return INVALID_SOLVER;
+}
+
+/**--------------------------------------------------------------------------------------
+ * solve()
+ * 
+ * Finds a path from the maze entrance to the maze exit with the given engine, a shortest
+ * one for every engine except TREMAUX_SOLVER
+ * 
+ * @param[in] maze          Maze with an entrance and an exit, not modified
+ * @param[in] solverType    Solver engine to use, one of the MazeSolver constants
+ * @return true if a path was found, see getPath()
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeSolver::solve(const Maze& maze, int solverType)
+{
+    switch(solverType)
+    {
+        case TREMAUX_SOLVER:
+            m_path.clear();
+            if(!runTremaux(maze, m_tremauxContext))
+            {
+                return false;
+            }
+            m_numCols = maze.getCOLCELLS();
+            m_path = m_tremauxContext.getPath();
+            return true;
+        case BFS_SOLVER:
+            return solveBFS(maze);
+        case BIDIRECTIONAL_BFS_SOLVER:
+            return solveBidirectionalBFS(maze);
+        case DEAD_END_FILLING_SOLVER:
+            return solveDeadEndFilling(maze);
+        case BITBOARD_DEAD_END_SOLVER:
+            return solveBitboardDeadEndFilling(maze);
+        default:
+            std::cerr << "ERROR: MazeSolver::solve() does not know the solver engine " << solverType << std::endl;
+            m_path.clear();
+            return false;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * solveBFS()
+ * 
+ * Finds a shortest path with a breadth-first search from the entrance
+ * 
+ * @param[in] maze Maze with an entrance and an exit, not modified
+ * @return true if a path was found, see getPath()
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeSolver::solveBFS(const Maze& maze)
+{
+    std::size_t entranceIndex = 0;
+    std::size_t exitIndex = 0;
+    if(!beginSolve(maze, entranceIndex, exitIndex))
+    {
+        return false;
+    }
+
+    // Nothing is stamped as visited from the exit, so nothing is blocked
+    return searchBreadthFirst(maze, entranceIndex, exitIndex, m_epoch + 1);
+}
+
+/**--------------------------------------------------------------------------------------
+ * solveBidirectionalBFS()
+ * 
+ * Finds a shortest path with two breadth-first searches, one from the entrance and one 
+ * from the exit, always growing the one with the smaller frontier, until they meet
+ * 
+ * @param[in] maze Maze with an entrance and an exit, not modified
+ * @return true if a path was found, see getPath()
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeSolver::solveBidirectionalBFS(const Maze& maze)
+{
+    std::size_t entranceIndex = 0;
+    std::size_t exitIndex = 0;
+    if(!beginSolve(maze, entranceIndex, exitIndex))
+    {
+        return false;
+    }
+
+    if(entranceIndex == exitIndex)
+    {
+        m_path.push_back(entranceIndex);
+        return true;
+    }
+
+    const std::uint32_t entranceStamp = m_epoch;
+    const std::uint32_t exitStamp = m_epoch + 1;
+
+    // The entrance search fills the queue from the front, the exit search from the back
+    std::size_t numCells = maze.getNumCells();
+    std::size_t entranceHead = 0;
+    std::size_t entranceTail = 0;
+    std::size_t exitHead = numCells;
+    std::size_t exitTail = numCells;
+
+    m_visitStamps[entranceIndex] = entranceStamp;
+    m_parentDirs[entranceIndex] = NO_PARENT_DIRECTION;
+    m_queue[entranceTail++] = entranceIndex;
+
+    m_visitStamps[exitIndex] = exitStamp;
+    m_parentDirs[exitIndex] = NO_PARENT_DIRECTION;
+    m_queue[--exitTail] = exitIndex;
+
+    // Best meeting found so far, an open wall between a cell of each search
+    std::size_t bestLength = std::numeric_limits<std::size_t>::max();
+    std::size_t bestEntranceSide = 0;
+    std::size_t bestExitSide = 0;
+
+    while(bestLength == std::numeric_limits<std::size_t>::max() && entranceHead < entranceTail && exitTail < exitHead)
+    {
+        // Growing the smaller frontier by one whole layer
+        bool fromEntrance = (entranceTail - entranceHead) <= (exitHead - exitTail);
+        std::uint32_t ownStamp = fromEntrance ? entranceStamp : exitStamp;
+        std::uint32_t otherStamp = fromEntrance ? exitStamp : entranceStamp;
+        std::size_t layerSize = fromEntrance ? (entranceTail - entranceHead) : (exitHead - exitTail);
+
+        for(std::size_t i = 0; i < layerSize; i++)
+        {
+            std::size_t curIndex = fromEntrance ? m_queue[entranceHead++] : m_queue[--exitHead];
+            int curRow = static_cast<int>(curIndex / static_cast<std::size_t>(m_numCols));
+            int curCol = static_cast<int>(curIndex % static_cast<std::size_t>(m_numCols));
+
+            for(int dir = Maze::NORTH_DIRECTION; dir <= Maze::WEST_DIRECTION; dir++)
+            {
+                if(!maze.isWallOpen(curRow, curCol, dir))
+                {
+                    continue;
+                }
+
+                std::size_t nextIndex = neighborIndex(curIndex, dir);
+                if(m_visitStamps[nextIndex] == ownStamp)
+                {
+                    continue;
+                }
+                else if(m_visitStamps[nextIndex] == otherStamp)
+                {
+                    // The searches meet, keeping the shortest meeting of this layer
+                    std::size_t meetLength = m_path.size();
+                    appendPathToStart(curIndex);
+                    appendPathToStart(nextIndex);
+                    meetLength = m_path.size() - meetLength;
+                    m_path.clear();
+
+                    if(meetLength < bestLength)
+                    {
+                        bestLength = meetLength;
+                        bestEntranceSide = fromEntrance ? curIndex : nextIndex;
+                        bestExitSide = fromEntrance ? nextIndex : curIndex;
+                    }
+                }
+                else
+                {
+                    m_visitStamps[nextIndex] = ownStamp;
+                    m_parentDirs[nextIndex] = static_cast<std::uint8_t>(dir ^ 1);
+                    if(fromEntrance)
+                    {
+                        m_queue[entranceTail++] = nextIndex;
+                    }
+                    else
+                    {
+                        m_queue[--exitTail] = nextIndex;
+                    }
+                }
+            }
+        }
+    }
+
+    if(bestLength == std::numeric_limits<std::size_t>::max())
+    {
+        return false;
+    }
+
+    // Entrance half is found backwards, exit half is already in order
+    appendPathToStart(bestEntranceSide);
+    std::reverse(m_path.begin(), m_path.end());
+    appendPathToStart(bestExitSide);
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * solveDeadEndFilling()
+ * 
+ * Finds a path by repeatedly filling in dead ends other than the entrance and exit, 
+ * then following the cells that are left
+ *     In a perfect maze the cells left are exactly the path; in a maze with loops the 
+ *     loops are left too, and a breadth-first search over them picks the shortest path
+ * 
+ * @param[in] maze Maze with an entrance and an exit, not modified
+ * @return true if a path was found, see getPath()
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeSolver::solveDeadEndFilling(const Maze& maze)
+{
+    std::size_t entranceIndex = 0;
+    std::size_t exitIndex = 0;
+    if(!beginSolve(maze, entranceIndex, exitIndex))
+    {
+        return false;
+    }
+
+    const std::uint32_t filledStamp = m_epoch + 1;
+
+    // m_parentDirs holds the number of unfilled open sides of each cell while filling
+    std::size_t queueTail = 0;
+    std::size_t curIndex = 0;
+    for(int row = 0; row < maze.getROWCELLS(); row++)
+    {
+        for(int col = 0; col < maze.getCOLCELLS(); col++, curIndex++)
+        {
+            std::uint8_t numOpenSides = 0;
+            for(int dir = Maze::NORTH_DIRECTION; dir <= Maze::WEST_DIRECTION; dir++)
+            {
+                numOpenSides += maze.isWallOpen(row, col, dir) ? 1 : 0;
+            }
+            m_parentDirs[curIndex] = numOpenSides;
+
+            if(numOpenSides <= 1 && curIndex != entranceIndex && curIndex != exitIndex)
+            {
+                m_visitStamps[curIndex] = filledStamp;
+                m_queue[queueTail++] = curIndex;
+            }
+        }
+    }
+
+    // Filling each dead end may turn the cell it opens onto into a new dead end
+    for(std::size_t queueHead = 0; queueHead < queueTail; queueHead++)
+    {
+        curIndex = m_queue[queueHead];
+        int curRow = static_cast<int>(curIndex / static_cast<std::size_t>(m_numCols));
+        int curCol = static_cast<int>(curIndex % static_cast<std::size_t>(m_numCols));
+
+        for(int dir = Maze::NORTH_DIRECTION; dir <= Maze::WEST_DIRECTION; dir++)
+        {
+            if(!maze.isWallOpen(curRow, curCol, dir))
+            {
+                continue;
+            }
+
+            std::size_t nextIndex = neighborIndex(curIndex, dir);
+            if(m_visitStamps[nextIndex] == filledStamp)
+            {
+                continue;
+            }
+
+            m_parentDirs[nextIndex]--;
+            if(m_parentDirs[nextIndex] <= 1 && nextIndex != entranceIndex && nextIndex != exitIndex)
+            {
+                m_visitStamps[nextIndex] = filledStamp;
+                m_queue[queueTail++] = nextIndex;
+            }
+        }
+    }
+
+    // Following the cells left over, from the entrance to the exit
+    return searchBreadthFirst(maze, entranceIndex, exitIndex, filledStamp);
+}
+
+/**--------------------------------------------------------------------------------------
+ * solveBitboardDeadEndFilling()
+ * 
+ * Finds a path by dead-end filling straight on the wall bitplanes, 64 cells per word
+ *     Keeps one bit per cell for the cells not filled in yet. A cell is a dead end when at 
+ *     most one of its open walls leads to an unfilled cell, which is worked out for a whole 
+ *     word of cells at once from the wall words and the shifted unfilled words around it
+ *     Sweeps over every word once, then only fills in again the words next to a filled cell 
+ *     through an open wall, until no word has dead ends left
+ *     In a perfect maze the cells left are exactly the path, which is followed from the 
+ *     entrance; in a maze with loops a breadth-first search picks the shortest path instead
+ * 
+ * @param[in] maze Maze with an entrance and an exit, not modified
+ * @return true if a path was found, see getPath()
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeSolver::solveBitboardDeadEndFilling(const Maze& maze)
+{
+    std::size_t entranceIndex = 0;
+    std::size_t exitIndex = 0;
+    if(!beginSolve(maze, entranceIndex, exitIndex))
+    {
+        return false;
+    }
+
+    const int numRows = maze.getROWCELLS();
+    const int numCols = maze.getCOLCELLS();
+    const std::size_t wordsPerRow = maze.getWallWordsPerRow();
+    const std::size_t numWords = static_cast<std::size_t>(numRows) * wordsPerRow;
+    if(m_liveCells.size() < numWords)
+    {
+        m_liveCells.resize(numWords);
+        m_wordsToFill.resize(numWords);
+    }
+
+    // Every cell starts unfilled, the padding past the last column never is
+    const std::uint64_t lastWordMask = (numCols % 64 == 0) ? ~std::uint64_t(0) : ((std::uint64_t(1) << (numCols % 64)) - 1);
+    for(std::size_t wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        m_liveCells[wordIndex] = (wordIndex % wordsPerRow == wordsPerRow - 1) ? lastWordMask : ~std::uint64_t(0);
+    }
+
+    // m_queue is a stack of the words to fill in again, each word is on it at most once
+    std::fill(m_wordsToFill.begin(), m_wordsToFill.begin() + numWords, 0);
+    std::size_t stackSize = 0;
+    auto pushWord = [&](std::size_t wordIndex)
+    {
+        if(!m_wordsToFill[wordIndex])
+        {
+            m_wordsToFill[wordIndex] = 1;
+            m_queue[stackSize++] = wordIndex;
+        }
+    };
+
+    // Filled cells may have made dead ends of the cells they open onto, words later in the first sweep are filled in anyway
+    auto pushNeighbors = [&](std::size_t wordIndex, std::uint64_t filled, bool isFirstSweep)
+    {
+        int row = static_cast<int>(wordIndex / wordsPerRow);
+        std::size_t word = wordIndex % wordsPerRow;
+        if(row > 0 && (filled & maze.getSouthWallRow(row - 1)[word]) != 0)
+        {
+            pushWord(wordIndex - wordsPerRow);
+        }
+        if(!isFirstSweep && row < numRows - 1 && (filled & maze.getSouthWallRow(row)[word]) != 0)
+        {
+            pushWord(wordIndex + wordsPerRow);
+        }
+        if(word > 0 && (filled & 1) != 0 && (maze.getEastWallRow(row)[word - 1] >> 63) != 0)
+        {
+            pushWord(wordIndex - 1);
+        }
+        if(!isFirstSweep && word + 1 < wordsPerRow && (filled >> 63) != 0 && (maze.getEastWallRow(row)[word] >> 63) != 0)
+        {
+            pushWord(wordIndex + 1);
+        }
+    };
+
+    // One sweep over every word in order, then back to the words next to cells filled in since
+    for(std::size_t wordIndex = 0; wordIndex < numWords; wordIndex++)
+    {
+        std::uint64_t filled = fillDeadEndsInWord(maze, static_cast<int>(wordIndex / wordsPerRow), wordIndex % wordsPerRow, entranceIndex, exitIndex);
+        if(filled != 0)
+        {
+            pushNeighbors(wordIndex, filled, true);
+        }
+    }
+
+    while(stackSize > 0)
+    {
+        std::size_t wordIndex = m_queue[--stackSize];
+        m_wordsToFill[wordIndex] = 0;
+
+        std::uint64_t filled = fillDeadEndsInWord(maze, static_cast<int>(wordIndex / wordsPerRow), wordIndex % wordsPerRow, entranceIndex, exitIndex);
+        if(filled != 0)
+        {
+            pushNeighbors(wordIndex, filled, false);
+        }
+    }
+
+    // Following the cells left over, from the entrance to the exit
+    std::size_t curIndex = entranceIndex;
+    int cameFromDir = Maze::INVALID_CARDINAL_DIRECTION;
+    m_path.push_back(curIndex);
+    while(curIndex != exitIndex)
+    {
+        int curRow = static_cast<int>(curIndex / static_cast<std::size_t>(numCols));
+        int curCol = static_cast<int>(curIndex % static_cast<std::size_t>(numCols));
+
+        int nextDir = Maze::INVALID_CARDINAL_DIRECTION;
+        int numNextDirs = 0;
+        for(int dir = Maze::NORTH_DIRECTION; dir <= Maze::WEST_DIRECTION; dir++)
+        {
+            if(dir == cameFromDir || !maze.isWallOpen(curRow, curCol, dir))
+            {
+                continue;
+            }
+
+            std::size_t nextIndex = neighborIndex(curIndex, dir);
+            std::size_t nextRow = nextIndex / static_cast<std::size_t>(numCols);
+            std::size_t nextCol = nextIndex % static_cast<std::size_t>(numCols);
+            if((m_liveCells[nextRow * wordsPerRow + (nextCol >> 6)] >> (nextCol & 63)) & 1)
+            {
+                nextDir = dir;
+                numNextDirs++;
+            }
+        }
+
+        if(numNextDirs != 1)
+        {
+            // A loop was left over (or the exit cannot be reached), searching the whole maze instead
+            m_path.clear();
+            return searchBreadthFirst(maze, entranceIndex, exitIndex, m_epoch + 1);
+        }
+
+        curIndex = neighborIndex(curIndex, nextDir);
+        cameFromDir = nextDir ^ 1;
+        m_path.push_back(curIndex);
+    }
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * fillDeadEndsInWord()
+ * 
+ * Fills in every dead end of one word of m_liveCells, over and over until the word has 
+ * none left, for solveBitboardDeadEndFilling()
+ *     Works out which of the four open walls of each cell lead to unfilled cells, then 
+ *     fills in the unfilled cells with at most one of them, other than the entrance and exit
+ *     A corridor running east through the word is filled in all at once by carrying the 
+ *     filled cell along it, see fillCorridorsEast()
+ * 
+ * @param[in] maze          Maze being solved
+ * @param[in] row           Row index of the word
+ * @param[in] word          Index of the word in its row
+ * @param[in] entranceIndex Row-major index of the maze entrance, never filled in
+ * @param[in] exitIndex     Row-major index of the maze exit, never filled in
+ * @return the cells of the word that were filled in, one bit each
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t MazeSolver::fillDeadEndsInWord(const Maze& maze, int row, std::size_t word, std::size_t entranceIndex, std::size_t exitIndex)
+{
+    const std::size_t wordsPerRow = maze.getWallWordsPerRow();
+    const std::size_t wordIndex = static_cast<std::size_t>(row) * wordsPerRow + word;
+    const std::uint64_t eastWalls = maze.getEastWallRow(row)[word];
+    const std::uint64_t westWallsIn = (word > 0) ? (maze.getEastWallRow(row)[word - 1] >> 63) : 0;
+    const std::uint64_t southWalls = (row < maze.getROWCELLS() - 1) ? maze.getSouthWallRow(row)[word] : 0;
+    const std::uint64_t northWalls = (row > 0) ? maze.getSouthWallRow(row - 1)[word] : 0;
+
+    // The neighbors outside the word do not change while it is filled in
+    const std::uint64_t liveEastIn = (word + 1 < wordsPerRow) ? (m_liveCells[wordIndex + 1] << 63) : 0;
+    const std::uint64_t liveWestIn = (word > 0) ? (m_liveCells[wordIndex - 1] >> 63) : 0;
+    const std::uint64_t openSouth = southWalls & ((row < maze.getROWCELLS() - 1) ? m_liveCells[wordIndex + wordsPerRow] : 0);
+    const std::uint64_t openNorth = northWalls & ((row > 0) ? m_liveCells[wordIndex - wordsPerRow] : 0);
+    const std::uint64_t openVertical = openSouth | openNorth;
+    const std::uint64_t openBothVertical = openSouth & openNorth;
+
+    // The entrance and exit are never filled in
+    std::uint64_t keptCells = 0;
+    for(std::size_t endIndex : {entranceIndex, exitIndex})
+    {
+        std::size_t endCol = endIndex % static_cast<std::size_t>(m_numCols);
+        if(endIndex / static_cast<std::size_t>(m_numCols) == static_cast<std::size_t>(row) && (endCol >> 6) == word)
+        {
+            keptCells |= std::uint64_t(1) << (endCol & 63);
+        }
+    }
+
+    const std::uint64_t startLive = m_liveCells[wordIndex];
+    std::uint64_t live = startLive;
+    while(true)
+    {
+        // Open walls leading to unfilled cells, on each side of each cell of the word
+        std::uint64_t openEast = eastWalls & ((live >> 1) | liveEastIn);
+        std::uint64_t openWest = (((eastWalls & live) << 1) | (westWallsIn & liveWestIn));
+
+        std::uint64_t atLeastTwoOpen = ((openEast | openWest) & openVertical) | (openEast & openWest) | openBothVertical;
+        std::uint64_t deadEnds = live & ~atLeastTwoOpen & ~keptCells;
+        if(deadEnds == 0)
+        {
+            break;
+        }
+        live &= ~deadEnds;
+    }
+
+    m_liveCells[wordIndex] = live;
+    return startLive & ~live;
+}
+
+/**--------------------------------------------------------------------------------------
+ * getCompactPath()
+ * 
+ * Packs the path found by the last solve into a start cell and 2 bits per move
+ *     The path object keeps its storage, so one reused for every solve stops allocating
+ * 
+ * @param[out] path Path from the entrance to the exit, empty if no path was found
+ * --------------------------------------------------------------------------------------
+*/
+void MazeSolver::getCompactPath(MazePath& path) const
+{
+    path.assignCells(m_path, m_numCols);
+}
+
+/**--------------------------------------------------------------------------------------
+ * labelPath()
+ * 
+ * Labels every cell on the path found by the last solve as a path cell of the maze
+ * 
+ * @param[in,out] maze Maze that was solved, updated so the cells on the path are labeled
+ * as path cells
+ * --------------------------------------------------------------------------------------
+*/
+void MazeSolver::labelPath(Maze& maze) const
+{
+    for(std::size_t pathIndex : m_path)
+    {
+        maze.labelCellAsPath(static_cast<int>(pathIndex / static_cast<std::size_t>(m_numCols)), static_cast<int>(pathIndex % static_cast<std::size_t>(m_numCols)));
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * applyWallEdits()
+ * 
+ * Opens and closes a batch of walls of a solved maze, then repairs the path found by the 
+ * last solve around them instead of solving the whole maze again
+ *     Every edit is applied first, with Maze::openPassage() or Maze::closePassage()
+ *     A closed wall between two cells next to each other on the path is bridged with a 
+ *     breadth-first search from the cell before it, which never enters the path before 
+ *     that cell and stops at the first cell it reaches further along the path
+ *     An opened wall between two cells on the path cuts out the part of the path between 
+ *     them
+ *     Solves again with solveBFS() only if there was no path from the entrance to the exit
+ *     The path stays a path from the entrance to the exit, but openings away from it can 
+ *     leave it longer than a shortest one, solve again for that
+ * 
+ * @param[in,out]   maze            Maze solved by the last solve, with its path labeled as by 
+ * solveMaze(), updated with the edits and the labels of the repaired path
+ * @param[in]       edits           Walls to open or close, in order, edits that would not 
+ * change a wall are skipped
+ * @param[out]      changedCells    Row-major indices of every cell whose exits or path label 
+ * changed, sorted
+ * @return true if the edited maze still has a path, see getPath()
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeSolver::applyWallEdits(Maze& maze, const std::vector<WallEdit>& edits, std::vector<std::size_t>& changedCells)
+{
+    changedCells.clear();
+    m_numCols = maze.getCOLCELLS();
+
+    // Walls first, so the path is repaired against the maze as it is after every edit
+    // Each edit is recorded as the wall on the south or east side of a cell, so edits of the same wall match
+    std::vector<WallEdit> appliedEdits;
+    for(const WallEdit& edit : edits)
+    {
+        int nextRow = edit.row + (edit.dir == Maze::SOUTH_DIRECTION) - (edit.dir == Maze::NORTH_DIRECTION);
+        int nextCol = edit.col + (edit.dir == Maze::EAST_DIRECTION) - (edit.dir == Maze::WEST_DIRECTION);
+        if(edit.dir < Maze::NORTH_DIRECTION || edit.dir > Maze::WEST_DIRECTION || edit.row < 0 || edit.row >= maze.getROWCELLS() || \
+           edit.col < 0 || edit.col >= m_numCols || nextRow < 0 || nextRow >= maze.getROWCELLS() || nextCol < 0 || nextCol >= m_numCols)
+        {
+            std::cerr << "ERROR: applyWallEdits() did not find a wall in direction " << edit.dir << " of the cell (" << edit.row << ", " << edit.col << ")" << std::endl;
+            continue;
+        }
+        if(maze.isWallOpen(edit.row, edit.col, edit.dir) == edit.open)
+        {
+            continue;
+        }
+
+        if(edit.open)
+        {
+            maze.openPassage(edit.row, edit.col, edit.dir);
+        }
+        else
+        {
+            maze.closePassage(edit.row, edit.col, edit.dir);
+        }
+
+        WallEdit appliedEdit = edit;
+        if(edit.dir == Maze::NORTH_DIRECTION || edit.dir == Maze::WEST_DIRECTION)
+        {
+            appliedEdit.row = nextRow;
+            appliedEdit.col = nextCol;
+            appliedEdit.dir = edit.dir ^ 1;
+        }
+        appliedEdits.push_back(appliedEdit);
+    }
+
+    // A wall edited more than once only changed if it ended up the way its first edit left it
+    std::stable_sort(appliedEdits.begin(), appliedEdits.end(), [](const WallEdit& first, const WallEdit& second)
+    {
+        return std::make_tuple(first.row, first.col, first.dir) < std::make_tuple(second.row, second.col, second.dir);
+    });
+    std::vector<WallEdit> changedWalls;
+    for(std::size_t i = 0; i < appliedEdits.size(); i++)
+    {
+        const WallEdit& edit = appliedEdits[i];
+        if(i > 0 && edit.row == appliedEdits[i - 1].row && edit.col == appliedEdits[i - 1].col && edit.dir == appliedEdits[i - 1].dir)
+        {
+            continue;
+        }
+        if(maze.isWallOpen(edit.row, edit.col, edit.dir) != edit.open)
+        {
+            continue;
+        }
+
+        std::size_t cellIndex = static_cast<std::size_t>(edit.row) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(edit.col);
+        changedCells.push_back(cellIndex);
+        changedCells.push_back(neighborIndex(cellIndex, edit.dir));
+        changedWalls.push_back(edit);
+    }
+
+    std::vector<std::size_t> touchedCells;
+    bool hasPath = repairPath(maze, changedWalls, touchedCells);
+
+    // Relabeling only the cells that joined or left the path
+    for(std::size_t cellIndex : touchedCells)
+    {
+        std::size_t position = 0;
+        int row = static_cast<int>(cellIndex / static_cast<std::size_t>(m_numCols));
+        int col = static_cast<int>(cellIndex % static_cast<std::size_t>(m_numCols));
+        bool isOnPath = findPathPosition(cellIndex, position);
+        if(maze.isCellOnPath(row, col) == isOnPath)
+        {
+            continue;
+        }
+
+        if(isOnPath)
+        {
+            maze.labelCellAsPath(row, col);
+        }
+        else
+        {
+            maze.unlabelCellAsPath(row, col);
+        }
+        changedCells.push_back(cellIndex);
+    }
+
+    std::sort(changedCells.begin(), changedCells.end());
+    changedCells.erase(std::unique(changedCells.begin(), changedCells.end()), changedCells.end());
+    return hasPath;
+}
+
+/**--------------------------------------------------------------------------------------
+ * beginSolve()
+ * 
+ * Prepares the work arrays and epoch for a solve of the given maze
+ *     Only grows the work arrays if the maze has more cells than any maze solved before
+ * 
+ * @param[in]   maze            Maze about to be solved
+ * @param[out]  entranceIndex   Row-major index of the maze entrance
+ * @param[out]  exitIndex       Row-major index of the maze exit
+ * @return false if the maze has no entrance or no exit
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeSolver::beginSolve(const Maze& maze, std::size_t& entranceIndex, std::size_t& exitIndex)
+{
+    m_path.clear();
+
+    int entranceRow = std::get<0>(maze.getEntrance());
+    int entranceCol = std::get<1>(maze.getEntrance());
+    int exitRow = std::get<0>(maze.getExit());
+    int exitCol = std::get<1>(maze.getExit());
+    if(entranceRow == Maze::INVALID_ROW_COL || entranceCol == Maze::INVALID_ROW_COL || exitRow == Maze::INVALID_ROW_COL || exitCol == Maze::INVALID_ROW_COL)
+    {
+        std::cerr << "ERROR: MazeSolver was given a maze without an entrance or exit" << std::endl;
+        return false;
+    }
+
+    std::size_t numCells = maze.getNumCells();
+    if(m_visitStamps.size() < numCells)
+    {
+        m_queue.resize(numCells);
+        m_parentDirs.resize(numCells);
+        m_visitStamps.resize(numCells, 0);
+    }
+    m_numCols = maze.getCOLCELLS();
+
+    advanceEpoch();
+
+    entranceIndex = static_cast<std::size_t>(entranceRow) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(entranceCol);
+    exitIndex = static_cast<std::size_t>(exitRow) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(exitCol);
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * advanceEpoch()
+ * 
+ * Advances m_epoch past the stamps of every earlier search
+ *     Stamps of earlier searches never match the new epoch, so m_visitStamps is only 
+ *     cleared when the epoch wraps around
+ * --------------------------------------------------------------------------------------
+*/
+void MazeSolver::advanceEpoch()
+{
+    if(m_epoch > std::numeric_limits<std::uint32_t>::max() - 2 * STAMPS_PER_SOLVE)
+    {
+        std::fill(m_visitStamps.begin(), m_visitStamps.end(), 0);
+        m_epoch = 0;
+    }
+    m_epoch += STAMPS_PER_SOLVE;
+}
+
+/**--------------------------------------------------------------------------------------
+ * searchBreadthFirst()
+ * 
+ * Breadth-first search from the entrance to the exit, stamping every cell it visits with 
+ * the current epoch, and filling m_path with the shortest path if the exit is reached
+ * 
+ * @param[in] maze          Maze to search, not modified
+ * @param[in] entranceIndex Row-major index of the maze entrance
+ * @param[in] exitIndex     Row-major index of the maze exit
+ * @param[in] blockedStamp  Cells stamped with this value are never entered
+ * @return true if the exit was reached
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeSolver::searchBreadthFirst(const Maze& maze, std::size_t entranceIndex, std::size_t exitIndex, std::uint32_t blockedStamp)
+{
+    std::size_t queueHead = 0;
+    std::size_t queueTail = 0;
+
+    m_visitStamps[entranceIndex] = m_epoch;
+    m_parentDirs[entranceIndex] = NO_PARENT_DIRECTION;
+    m_queue[queueTail++] = entranceIndex;
+
+    while(queueHead < queueTail)
+    {
+        std::size_t curIndex = m_queue[queueHead++];
+        if(curIndex == exitIndex)
+        {
+            appendPathToStart(exitIndex);
+            std::reverse(m_path.begin(), m_path.end());
+            return true;
+        }
+
+        int curRow = static_cast<int>(curIndex / static_cast<std::size_t>(m_numCols));
+        int curCol = static_cast<int>(curIndex % static_cast<std::size_t>(m_numCols));
+        for(int dir = Maze::NORTH_DIRECTION; dir <= Maze::WEST_DIRECTION; dir++)
+        {
+            if(!maze.isWallOpen(curRow, curCol, dir))
+            {
+                continue;
+            }
+
+            std::size_t nextIndex = neighborIndex(curIndex, dir);
+            if(m_visitStamps[nextIndex] != m_epoch && m_visitStamps[nextIndex] != blockedStamp)
+            {
+                m_visitStamps[nextIndex] = m_epoch;
+                m_parentDirs[nextIndex] = static_cast<std::uint8_t>(dir ^ 1);
+                m_queue[queueTail++] = nextIndex;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**--------------------------------------------------------------------------------------
+ * appendPathToStart()
+ * 
+ * Appends the cells from a visited cell back to the start of the search that visited it 
+ * to m_path, following parent directions
+ *     North and South, and East and West, differ only in their lowest bit, so dir ^ 1 is 
+ *     the opposite direction
+ * 
+ * @param[in] cellIndex Row-major index of a visited cell
+ * --------------------------------------------------------------------------------------
+*/
+void MazeSolver::appendPathToStart(std::size_t cellIndex)
+{
+    m_path.push_back(cellIndex);
+    while(m_parentDirs[cellIndex] != NO_PARENT_DIRECTION)
+    {
+        cellIndex = neighborIndex(cellIndex, m_parentDirs[cellIndex]);
+        m_path.push_back(cellIndex);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * repairPath()
+ * 
+ * Repairs m_path after a batch of wall edits, see applyWallEdits()
+ *     Bridges every closed wall the path went through, then takes every shortcut an opened 
+ *     wall makes between two cells of the path
+ * 
+ * @param[in]   maze            Maze with every edit applied, not modified
+ * @param[in]   changedWalls    Walls the edits changed, each given once as the wall on the 
+ * south or east side of a cell, open if it is open now
+ * @param[out]  touchedCells    Row-major indices of every cell that joined or left the path, 
+ * and maybe some that are back where they were
+ * @return true if the maze has a path from the entrance to the exit
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeSolver::repairPath(const Maze& maze, const std::vector<WallEdit>& changedWalls, std::vector<std::size_t>& touchedCells)
+{
+    int entranceRow = std::get<0>(maze.getEntrance());
+    int entranceCol = std::get<1>(maze.getEntrance());
+    int exitRow = std::get<0>(maze.getExit());
+    int exitCol = std::get<1>(maze.getExit());
+    std::size_t entranceIndex = static_cast<std::size_t>(entranceRow) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(entranceCol);
+    std::size_t exitIndex = static_cast<std::size_t>(exitRow) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(exitCol);
+
+    // Nothing to repair without a path from this maze's entrance to its exit
+    if(entranceRow == Maze::INVALID_ROW_COL || exitRow == Maze::INVALID_ROW_COL || m_path.empty() || \
+       m_path.front() != entranceIndex || m_path.back() != exitIndex)
+    {
+        touchedCells.insert(touchedCells.end(), m_path.begin(), m_path.end());
+        bool isSolved = solveBFS(maze);
+        touchedCells.insert(touchedCells.end(), m_path.begin(), m_path.end());
+        if(m_pathPositions.size() < maze.getNumCells())
+        {
+            m_pathPositions.resize(maze.getNumCells());
+        }
+        indexPathFrom(0);
+        return isSolved;
+    }
+
+    // The Tremaux solver does not use the work arrays, so they may not be sized yet
+    std::size_t numCells = maze.getNumCells();
+    if(m_visitStamps.size() < numCells)
+    {
+        m_queue.resize(numCells);
+        m_parentDirs.resize(numCells);
+        m_visitStamps.resize(numCells, 0);
+    }
+    if(m_pathPositions.size() < numCells)
+    {
+        m_pathPositions.resize(numCells);
+    }
+    indexPathFrom(0);
+
+    // Closed walls the path went through
+    std::vector<std::size_t> detour;
+    for(const WallEdit& edit : changedWalls)
+    {
+        std::size_t cellIndex = static_cast<std::size_t>(edit.row) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(edit.col);
+        std::size_t firstPosition = 0;
+        std::size_t secondPosition = 0;
+        if(edit.open || !findPathPosition(cellIndex, firstPosition) || !findPathPosition(neighborIndex(cellIndex, edit.dir), secondPosition) || \
+           (firstPosition + 1 != secondPosition && secondPosition + 1 != firstPosition))
+        {
+            continue;
+        }
+
+        std::size_t startPosition = std::min(firstPosition, secondPosition);
+        std::size_t endPosition = searchDetour(maze, startPosition);
+        if(endPosition == m_path.size())
+        {
+            // The way around may leave the path before the break, only a new solve can tell
+            touchedCells.insert(touchedCells.end(), m_path.begin(), m_path.end());
+            bool isSolved = solveBFS(maze);
+            touchedCells.insert(touchedCells.end(), m_path.begin(), m_path.end());
+            indexPathFrom(0);
+            return isSolved;
+        }
+
+        // Cells of the detour strictly between its ends, from the start of the detour on
+        detour.clear();
+        std::size_t detourIndex = neighborIndex(m_path[endPosition], m_parentDirs[m_path[endPosition]]);
+        while(detourIndex != m_path[startPosition])
+        {
+            detour.push_back(detourIndex);
+            detourIndex = neighborIndex(detourIndex, m_parentDirs[detourIndex]);
+        }
+        std::reverse(detour.begin(), detour.end());
+
+        touchedCells.insert(touchedCells.end(), m_path.begin() + startPosition + 1, m_path.begin() + endPosition);
+        touchedCells.insert(touchedCells.end(), detour.begin(), detour.end());
+        m_path.erase(m_path.begin() + startPosition + 1, m_path.begin() + endPosition);
+        m_path.insert(m_path.begin() + startPosition + 1, detour.begin(), detour.end());
+        indexPathFrom(startPosition + 1);
+    }
+
+    // Opened walls between two cells of the path
+    for(const WallEdit& edit : changedWalls)
+    {
+        std::size_t cellIndex = static_cast<std::size_t>(edit.row) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(edit.col);
+        std::size_t firstPosition = 0;
+        std::size_t secondPosition = 0;
+        if(!edit.open || !findPathPosition(cellIndex, firstPosition) || !findPathPosition(neighborIndex(cellIndex, edit.dir), secondPosition))
+        {
+            continue;
+        }
+
+        std::size_t startPosition = std::min(firstPosition, secondPosition);
+        std::size_t endPosition = std::max(firstPosition, secondPosition);
+        if(endPosition - startPosition > 1)
+        {
+            touchedCells.insert(touchedCells.end(), m_path.begin() + startPosition + 1, m_path.begin() + endPosition);
+            m_path.erase(m_path.begin() + startPosition + 1, m_path.begin() + endPosition);
+            indexPathFrom(startPosition + 1);
+        }
+    }
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * searchDetour()
+ * 
+ * Breadth-first search from a cell of the path to the nearest cell further along the path, 
+ * never entering the cells of the path before it
+ *     Stops as soon as it reaches the path, so it only searches around the cell it starts 
+ *     from unless the path is cut off
+ * 
+ * @param[in] maze          Maze to search, not modified
+ * @param[in] startPosition Position on m_path of the cell to start from
+ * @return the position on m_path of the cell reached, with the detour to it in 
+ * m_parentDirs, or m_path.size() if no cell further along the path can be reached
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t MazeSolver::searchDetour(const Maze& maze, std::size_t startPosition)
+{
+    advanceEpoch();
+
+    std::size_t queueHead = 0;
+    std::size_t queueTail = 0;
+    std::size_t startIndex = m_path[startPosition];
+
+    m_visitStamps[startIndex] = m_epoch;
+    m_parentDirs[startIndex] = NO_PARENT_DIRECTION;
+    m_queue[queueTail++] = startIndex;
+
+    while(queueHead < queueTail)
+    {
+        std::size_t curIndex = m_queue[queueHead++];
+        int curRow = static_cast<int>(curIndex / static_cast<std::size_t>(m_numCols));
+        int curCol = static_cast<int>(curIndex % static_cast<std::size_t>(m_numCols));
+        for(int dir = Maze::NORTH_DIRECTION; dir <= Maze::WEST_DIRECTION; dir++)
+        {
+            if(!maze.isWallOpen(curRow, curCol, dir))
+            {
+                continue;
+            }
+
+            std::size_t nextIndex = neighborIndex(curIndex, dir);
+            if(m_visitStamps[nextIndex] == m_epoch)
+            {
+                continue;
+            }
+
+            std::size_t position = 0;
+            if(findPathPosition(nextIndex, position))
+            {
+                if(position > startPosition)
+                {
+                    m_parentDirs[nextIndex] = static_cast<std::uint8_t>(dir ^ 1);
+                    return position;
+                }
+                continue;
+            }
+
+            m_visitStamps[nextIndex] = m_epoch;
+            m_parentDirs[nextIndex] = static_cast<std::uint8_t>(dir ^ 1);
+            m_queue[queueTail++] = nextIndex;
+        }
+    }
+
+    return m_path.size();
+}
+
+/**--------------------------------------------------------------------------------------
+ * indexPathFrom()
+ * 
+ * Records the position on m_path of every cell of m_path from the given position on, see 
+ * findPathPosition()
+ * 
+ * @param[in] position First position to record
+ * --------------------------------------------------------------------------------------
+*/
+void MazeSolver::indexPathFrom(std::size_t position)
+{
+    for(; position < m_path.size(); position++)
+    {
+        m_pathPositions[m_path[position]] = position;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * neighborIndex()
+ * 
+ * Returns the row-major index of the neighbor of a cell in the given direction
+ * 
+ * @param[in] cellIndex Row-major index of the cell
+ * @param[in] dir       Cardinal direction of the neighbor, must not face the maze border
+ * @return the row-major index of the neighbor
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t MazeSolver::neighborIndex(std::size_t cellIndex, int dir) const
+{
+    switch(dir)
+    {
+        case Maze::NORTH_DIRECTION:
+            return cellIndex - static_cast<std::size_t>(m_numCols);
+        case Maze::SOUTH_DIRECTION:
+            return cellIndex + static_cast<std::size_t>(m_numCols);
+        case Maze::EAST_DIRECTION:
+            return cellIndex + 1;
+        default:
+            return cellIndex - 1;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * solveMaze()
+ * 
+ * Solves a maze with any solver engine, labeling the cells on the path as path cells
+ * 
+ * @param[in,out]   unsolvedMaze    Maze with an entrance and exit, updated so the cells on the 
+ * path from the entrance to the exit are labeled as path cells
+ * @param[in]       solverType      Solver engine to use, one of the MazeSolver constants
+ * @param[in,out]   solver          Solver whose work arrays are used to solve
+ * @return true if a path was found
+ * --------------------------------------------------------------------------------------
+*/
+bool solveMaze(Maze& unsolvedMaze, int solverType, MazeSolver& solver)
+{
+    METRIC_TIMER(METRIC_SOLVE_TIMER)
+    if(!solver.solve(unsolvedMaze, solverType))
+    {
+        return false;
+    }
+
+    solver.labelPath(unsolvedMaze);
+    return true;
+}
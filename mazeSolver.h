@@ -0,0 +1,328 @@
+/*mazeSolver.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze Solvers
+ * 
+ * Given a maze, finds a shortest path from the entrance of the maze to the exit without
+ * modifying the maze, using breadth-first search, bidirectional breadth-first search or
+ * dead-end filling
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "maze.h"
+#include "mazePath.h"
+#include "tremaux.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * WallEdit struct
+ * 
+ * One wall to open or close, see MazeSolver::applyWallEdits()
+ *     row, col: cell the wall belongs to
+ *     dir: side of the cell the wall is on, one of the Maze direction constants
+ *     open: true to open the wall, false to close it
+ * --------------------------------------------------------------------------------------
+*/
+struct WallEdit
+{
+    int row = 0;
+    int col = 0;
+    int dir = Maze::INVALID_CARDINAL_DIRECTION;
+    bool open = false;
+};
+
+/**--------------------------------------------------------------------------------------
+ * MazeSolver class
+ * 
+ * Maze solvers that only read the maze, so the same maze can be solved again and 
+ * again. The path is kept in the solver instead of being labeled on the maze's cells
+ *     Owns every work array the solvers need (queue, parent directions, visit stamps, 
+ *     a TremauxContext), 
+ *     sized once and reused by every solve on mazes of the same size or smaller
+ *     Visit stamps are compared against a per-solve epoch, so nothing is cleared between 
+ *     solves
+ * --------------------------------------------------------------------------------------
+*/
+class MazeSolver
+{
+public:
+    /**
+     * Integers representing the solver engines selectable from main()
+     *     TREMAUX_SOLVER runs runTremaux() in the solver's own TremauxContext
+    */
+    static constexpr int TREMAUX_SOLVER = 0;
+    static constexpr int BFS_SOLVER = 1;
+    static constexpr int BIDIRECTIONAL_BFS_SOLVER = 2;
+    static constexpr int DEAD_END_FILLING_SOLVER = 3;
+    static constexpr int BITBOARD_DEAD_END_SOLVER = 4;
+    static constexpr int INVALID_SOLVER = -1;
+
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates a solver with work arrays for mazes of up to uRows x uCols cells
+     * 
+     * @param[in] uRows Number of rows to preallocate for
+     * @param[in] uCols Number of columns to preallocate for
+     * --------------------------------------------------------------------------------------
+    */
+    MazeSolver(int uRows = 0, int uCols = 0);
+
+    /**--------------------------------------------------------------------------------------
+     * solverTypeFromName()
+     * 
+     * Returns the solver engine with the given name
+     * 
+     * @param[in] name One of "tremaux", "bfs", "bidirectional", "deadend" or "bitboard"
+     * @return the matching solver engine, or INVALID_SOLVER if there is none
+     * --------------------------------------------------------------------------------------
+    */
+    static int solverTypeFromName(const std::string& name);
+
+    /**--------------------------------------------------------------------------------------
+     * solve()
+     * 
+     * Finds a path from the maze entrance to the maze exit with the given engine, a shortest
+     * one for every engine except TREMAUX_SOLVER
+     * 
+     * @param[in] maze          Maze with an entrance and an exit, not modified
+     * @param[in] solverType    Solver engine to use, one of the constants above
+     * @return true if a path was found, see getPath()
+     * --------------------------------------------------------------------------------------
+    */
+    bool solve(const Maze& maze, int solverType);
+
+    /**--------------------------------------------------------------------------------------
+     * solveBFS()
+     * 
+     * Finds a shortest path with a breadth-first search from the entrance
+     * 
+     * @param[in] maze Maze with an entrance and an exit, not modified
+     * @return true if a path was found, see getPath()
+     * --------------------------------------------------------------------------------------
+    */
+    bool solveBFS(const Maze& maze);
+
+    /**--------------------------------------------------------------------------------------
+     * solveBidirectionalBFS()
+     * 
+     * Finds a shortest path with two breadth-first searches, one from the entrance and one 
+     * from the exit, always growing the one with the smaller frontier, until they meet
+     * 
+     * @param[in] maze Maze with an entrance and an exit, not modified
+     * @return true if a path was found, see getPath()
+     * --------------------------------------------------------------------------------------
+    */
+    bool solveBidirectionalBFS(const Maze& maze);
+
+    /**--------------------------------------------------------------------------------------
+     * solveDeadEndFilling()
+     * 
+     * Finds a path by repeatedly filling in dead ends other than the entrance and exit, 
+     * then following the cells that are left
+     *     In a perfect maze the cells left are exactly the path; in a maze with loops the 
+     *     loops are left too, and a breadth-first search over them picks the shortest path
+     * 
+     * @param[in] maze Maze with an entrance and an exit, not modified
+     * @return true if a path was found, see getPath()
+     * --------------------------------------------------------------------------------------
+    */
+    bool solveDeadEndFilling(const Maze& maze);
+
+    /**--------------------------------------------------------------------------------------
+     * solveBitboardDeadEndFilling()
+     * 
+     * Finds a path by dead-end filling straight on the wall bitplanes, 64 cells per word
+     *     Keeps one bit per cell for the cells not filled in yet. A cell is a dead end when at 
+     *     most one of its open walls leads to an unfilled cell, which is worked out for a whole 
+     *     word of cells at once from the wall words and the shifted unfilled words around it
+     *     Sweeps over every word once, then only fills in again the words next to a filled cell 
+     *     through an open wall, until no word has dead ends left
+     *     In a perfect maze the cells left are exactly the path, which is followed from the 
+     *     entrance; in a maze with loops a breadth-first search picks the shortest path instead
+     * 
+     * @param[in] maze Maze with an entrance and an exit, not modified
+     * @return true if a path was found, see getPath()
+     * --------------------------------------------------------------------------------------
+    */
+    bool solveBitboardDeadEndFilling(const Maze& maze);
+
+    /**--------------------------------------------------------------------------------------
+     * applyWallEdits()
+     * 
+     * Opens and closes a batch of walls of a solved maze, then repairs the path found by the 
+     * last solve around them instead of solving the whole maze again
+     *     Every edit is applied first, with Maze::openPassage() or Maze::closePassage()
+     *     A closed wall between two cells next to each other on the path is bridged with a 
+     *     breadth-first search from the cell before it, which never enters the path before 
+     *     that cell and stops at the first cell it reaches further along the path
+     *     An opened wall between two cells on the path cuts out the part of the path between 
+     *     them
+     *     Solves again with solveBFS() only if there was no path from the entrance to the exit
+     *     The path stays a path from the entrance to the exit, but openings away from it can 
+     *     leave it longer than a shortest one, solve again for that
+     * 
+     * @param[in,out]   maze            Maze solved by the last solve, with its path labeled as by 
+     * solveMaze(), updated with the edits and the labels of the repaired path
+     * @param[in]       edits           Walls to open or close, in order, edits that would not 
+     * change a wall are skipped
+     * @param[out]      changedCells    Row-major indices of every cell whose exits or path label 
+     * changed, sorted
+     * @return true if the edited maze still has a path, see getPath()
+     * --------------------------------------------------------------------------------------
+    */
+    bool applyWallEdits(Maze& maze, const std::vector<WallEdit>& edits, std::vector<std::size_t>& changedCells);
+
+    /**--------------------------------------------------------------------------------------
+     * getPath()
+     * 
+     * Returns the path found by the last solve, ordered from entrance to exit
+     * 
+     * @return a constant reference to the row-major indices of the cells on the path
+     * --------------------------------------------------------------------------------------
+    */
+    const std::vector<std::size_t>& getPath() const
+    {
+        return m_path;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getCompactPath()
+     * 
+     * Packs the path found by the last solve into a start cell and 2 bits per move
+     *     The path object keeps its storage, so one reused for every solve stops allocating
+     * 
+     * @param[out] path Path from the entrance to the exit, empty if no path was found
+     * --------------------------------------------------------------------------------------
+    */
+    void getCompactPath(MazePath& path) const;
+
+    /**--------------------------------------------------------------------------------------
+     * labelPath()
+     * 
+     * Labels every cell on the path found by the last solve as a path cell of the maze
+     * 
+     * @param[in,out] maze Maze that was solved, updated so the cells on the path are labeled
+     * as path cells
+     * --------------------------------------------------------------------------------------
+    */
+    void labelPath(Maze& maze) const;
+
+private:
+    // Prepares the work arrays and epoch for a solve of the given maze, returns false if it has no entrance or exit
+    bool beginSolve(const Maze& maze, std::size_t& entranceIndex, std::size_t& exitIndex);
+
+    // Advances m_epoch past the stamps of every earlier search
+    void advanceEpoch();
+
+    // Breadth-first search from the entrance to the exit, skipping cells stamped with blockedStamp
+    bool searchBreadthFirst(const Maze& maze, std::size_t entranceIndex, std::size_t exitIndex, std::uint32_t blockedStamp);
+
+    // Appends the cells from cellIndex to the start of its search, following parent directions
+    void appendPathToStart(std::size_t cellIndex);
+
+    // Repairs m_path after the given wall changes, listing every cell that joined or left it in touchedCells
+    bool repairPath(const Maze& maze, const std::vector<WallEdit>& changedWalls, std::vector<std::size_t>& touchedCells);
+
+    // Breadth-first search from m_path[startPosition] to the nearest cell further along m_path, returns its position or m_path.size()
+    std::size_t searchDetour(const Maze& maze, std::size_t startPosition);
+
+    // Finds the position of a cell on m_path, returns false if it is not on it
+    bool findPathPosition(std::size_t cellIndex, std::size_t& position) const
+    {
+        position = m_pathPositions[cellIndex];
+        return position < m_path.size() && m_path[position] == cellIndex;
+    }
+
+    // Records the position of every cell of m_path from the given position on
+    void indexPathFrom(std::size_t position);
+
+    // Fills in the dead ends of one word of m_liveCells until it has none, returns the cells filled in
+    std::uint64_t fillDeadEndsInWord(const Maze& maze, int row, std::size_t word, std::size_t entranceIndex, std::size_t exitIndex);
+
+    // Index of the neighbor of cellIndex in the given direction
+    std::size_t neighborIndex(std::size_t cellIndex, int dir) const;
+
+    int m_numCols;
+
+    /**
+     * Work arrays, one entry per cell, stored row-major
+     *     m_queue: breadth-first frontier, filled from the front by searches from the 
+     *     entrance and from the back by searches from the exit
+     *     m_parentDirs: direction from each visited cell towards the start of its search
+     *     m_visitStamps: which search of which solve visited each cell, see m_epoch
+    */
+    std::vector<std::size_t> m_queue;
+    std::vector<std::uint8_t> m_parentDirs;
+    std::vector<std::uint32_t> m_visitStamps;
+
+    /**
+     * Stamp of the current solve, advanced by STAMPS_PER_SOLVE on every solve
+     *     m_epoch: cell visited from the entrance (or filled in, for dead-end filling)
+     *     m_epoch + 1: cell visited from the exit (or kept, for dead-end filling)
+    */
+    std::uint32_t m_epoch;
+    static const std::uint32_t STAMPS_PER_SOLVE = 2;
+
+    std::vector<std::size_t> m_path;
+
+    /**
+     * Position of each cell on m_path, kept by applyWallEdits()
+     *     Only meaningful for cells on m_path, see findPathPosition(), so it is never cleared
+    */
+    std::vector<std::size_t> m_pathPositions;
+
+    /**
+     * Work arrays of solveBitboardDeadEndFilling(), laid out like the wall bitplanes
+     *     m_liveCells: bit (row, col) is set while the cell is not filled in
+     *     m_wordsToFill: one entry per word, set while the word is waiting to be filled in
+    */
+    std::vector<std::uint64_t> m_liveCells;
+    std::vector<std::uint8_t> m_wordsToFill;
+
+    TremauxContext m_tremauxContext;
+};
+
+/**--------------------------------------------------------------------------------------
+ * solveMaze()
+ * 
+ * Solves a maze with any solver engine, labeling the cells on the path as path cells
+ * 
+ * @param[in,out]   unsolvedMaze    Maze with an entrance and exit, updated so the cells on the 
+ * path from the entrance to the exit are labeled as path cells
+ * @param[in]       solverType      Solver engine to use, one of the MazeSolver constants
+ * @param[in,out]   solver          Solver whose work arrays are used to solve
+ * @return true if a path was found
+ * --------------------------------------------------------------------------------------
+*/
+bool solveMaze(Maze& unsolvedMaze, int solverType, MazeSolver& solver);
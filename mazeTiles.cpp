@@ -0,0 +1,472 @@
+/*mazeTiles.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Tiled maze renderer
+ * 
+ * Renders binary maze files of any size as a pyramid of fixed-size PNG tiles, reading only
+ * the rows each tile needs, on several threads
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazeTiles.h"
+#include "bitOps.h"
+#include "maze.h"
+#include "mazeRenderer.h"
+#include "metrics.h"
+#include "pngWriter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * Shades of gray used for levels with fewer than 2 pixels per cell, palette indices 
+ * MAZE_GRAY_COLOR to MAZE_GRAY_COLOR + NUM_GRAY_SHADES - 1, from white to black
+*/
+const std::uint8_t MAZE_GRAY_COLOR = NUM_MAZE_COLORS;
+const int NUM_GRAY_SHADES = 16;
+const int NUM_TILE_COLORS = NUM_MAZE_COLORS + NUM_GRAY_SHADES;
+
+/**--------------------------------------------------------------------------------------
+ * TileLevel struct
+ * 
+ * Scale and size of one zoom level of the tile pyramid
+ *     Either pixelsPerCell >= 2, and walls are drawn as in renderMazeImages(), or 
+ *     pixelsPerCell == 0 and each pixel covers cellsPerPixel x cellsPerPixel cells
+ *     Both are powers of 2, so pixels and cells are converted with shifts
+ * --------------------------------------------------------------------------------------
+*/
+struct TileLevel
+{
+    int zoom = 0;
+    int pixelsPerCell = 0;
+    int wallWidth = 0;
+    int scaleShift = 0;
+    std::uint64_t cellsPerPixel = 0;
+    std::uint64_t width = 0;
+    std::uint64_t height = 0;
+    std::uint64_t tilesWide = 0;
+    std::uint64_t tilesHigh = 0;
+};
+
+/**--------------------------------------------------------------------------------------
+ * makeTileLevels()
+ * 
+ * Works out every zoom level of the pyramid, from zoom 0 to the deepest level
+ * 
+ * @param[in] header    Header of the maze file
+ * @param[in] cellSize  Pixels per cell at the deepest zoom level, a power of 2
+ * @return the levels, indexed by zoom
+ * --------------------------------------------------------------------------------------
+*/
+std::vector<TileLevel> makeTileLevels(const MazeBinaryHeader& header, int cellSize)
+{
+    std::vector<TileLevel> levels;
+    for(int halvings = 0; ; halvings++)
+    {
+        TileLevel level;
+        int pixelsPerCell = cellSize >> halvings;
+        if(pixelsPerCell >= 2)
+        {
+            level.pixelsPerCell = pixelsPerCell;
+            level.wallWidth = wallWidthForCellSize(pixelsPerCell);
+            while((1 << level.scaleShift) < pixelsPerCell)
+            {
+                level.scaleShift++;
+            }
+            level.width = header.numCols * pixelsPerCell + level.wallWidth;
+            level.height = header.numRows * pixelsPerCell + level.wallWidth;
+        }
+        else
+        {
+            // Each halving past 1 pixel per cell doubles the cells per pixel
+            int cellSizeShift = 0;
+            while((1 << cellSizeShift) < cellSize)
+            {
+                cellSizeShift++;
+            }
+            level.scaleShift = halvings - cellSizeShift;
+            level.cellsPerPixel = std::uint64_t(1) << level.scaleShift;
+            level.width = (header.numCols + level.cellsPerPixel - 1) >> level.scaleShift;
+            level.height = (header.numRows + level.cellsPerPixel - 1) >> level.scaleShift;
+        }
+        level.tilesWide = (level.width + MAZE_TILE_SIZE - 1) / MAZE_TILE_SIZE;
+        level.tilesHigh = (level.height + MAZE_TILE_SIZE - 1) / MAZE_TILE_SIZE;
+        levels.push_back(level);
+
+        if(level.width <= MAZE_TILE_SIZE && level.height <= MAZE_TILE_SIZE)
+        {
+            break;
+        }
+    }
+
+    // Levels were found from the deepest up, zoom 0 is the last one
+    std::reverse(levels.begin(), levels.end());
+    for(std::size_t zoom = 0; zoom < levels.size(); zoom++)
+    {
+        levels[zoom].zoom = static_cast<int>(zoom);
+    }
+    return levels;
+}
+
+/**--------------------------------------------------------------------------------------
+ * countSetBitsInRow()
+ * 
+ * Counts the set bits of columns [firstCol, firstCol + numCols) in a row of a bitplane of
+ * the mapped file
+ * 
+ * @param[in] planeRow  Row of a bitplane, see MappedMaze::getSouthWallRow()
+ * @param[in] firstCol  First column to count
+ * @param[in] numCols   Number of columns to count
+ * @return the number of set bits
+ * --------------------------------------------------------------------------------------
+*/
+std::uint64_t countSetBitsInRow(const std::uint8_t* planeRow, std::uint64_t firstCol, std::uint64_t numCols)
+{
+    std::uint64_t numSet = 0;
+    std::uint64_t col = firstCol;
+    const std::uint64_t endCol = firstCol + numCols;
+    while(col < endCol)
+    {
+        // Words are little-endian in the file, whatever the machine
+        const std::uint8_t* wordBytes = planeRow + 8 * (col >> 6);
+        std::uint64_t word = 0;
+        for(int byte = 0; byte < 8; byte++)
+        {
+            word |= static_cast<std::uint64_t>(wordBytes[byte]) << (8 * byte);
+        }
+
+        std::uint64_t wordEnd = std::min((col | 63) + 1, endCol);
+        word >>= (col & 63);
+        if(wordEnd - col < 64)
+        {
+            word &= (std::uint64_t(1) << (wordEnd - col)) - 1;
+        }
+        numSet += static_cast<std::uint64_t>(countSetBits(word));
+        col = wordEnd;
+    }
+    return numSet;
+}
+
+/**--------------------------------------------------------------------------------------
+ * MazeTilePainter class
+ * 
+ * Finds the color of any pixel of a zoom level, reading only the mapped rows it covers
+ * --------------------------------------------------------------------------------------
+*/
+class MazeTilePainter
+{
+public:
+    MazeTilePainter(const MappedMaze& mappedMaze, const TileLevel& level)
+        : m_maze(mappedMaze), m_header(mappedMaze.getHeader()), m_level(level)
+    {
+    }
+
+    // Whether every pixel of row y is the same color as the one above it, true for all but
+    // the first row of a wall strip or of the cells below it
+    bool repeatsRowAbove(std::uint64_t y) const
+    {
+        if(m_level.pixelsPerCell == 0 || y >= m_level.height)
+        {
+            return false;
+        }
+        std::uint64_t rowInCell = y & (m_level.pixelsPerCell - 1);
+        return rowInCell != 0 && rowInCell != static_cast<std::uint64_t>(m_level.wallWidth);
+    }
+
+    // Color of pixel (x, y), which must be inside the level
+    std::uint8_t pixelColor(std::uint64_t x, std::uint64_t y) const
+    {
+        return (m_level.pixelsPerCell > 0) ? drawnPixelColor(x, y) : shadedPixelColor(x, y);
+    }
+
+private:
+    std::uint8_t cellColor(std::uint64_t row, std::uint64_t col) const
+    {
+        if(static_cast<std::int64_t>(row) == m_header.entranceRow && static_cast<std::int64_t>(col) == m_header.entranceCol)
+        {
+            return MAZE_ENTRANCE_COLOR;
+        }
+        else if(static_cast<std::int64_t>(row) == m_header.exitRow && static_cast<std::int64_t>(col) == m_header.exitCol)
+        {
+            return MAZE_EXIT_COLOR;
+        }
+        return m_maze.isCellOnPath(row, col) ? MAZE_PATH_COLOR : MAZE_WHITE_COLOR;
+    }
+
+    // An open wall between two cells on the path is part of the path
+    std::uint8_t passageColor(std::uint64_t row, std::uint64_t col, std::uint64_t neighborRow, std::uint64_t neighborCol) const
+    {
+        return (cellColor(row, col) != MAZE_WHITE_COLOR && cellColor(neighborRow, neighborCol) != MAZE_WHITE_COLOR) ? MAZE_PATH_COLOR : MAZE_WHITE_COLOR;
+    }
+
+    // Same layout as renderMazeImages(): each cell has its northern wall along its top and 
+    // its western wall along its left, and the maze border closes the bottom and right
+    std::uint8_t drawnPixelColor(std::uint64_t x, std::uint64_t y) const
+    {
+        std::uint64_t row = y >> m_level.scaleShift;
+        std::uint64_t col = x >> m_level.scaleShift;
+        if(row >= m_header.numRows || col >= m_header.numCols)
+        {
+            return MAZE_WALL_COLOR;
+        }
+
+        bool isInWallRow = (y & (m_level.pixelsPerCell - 1)) < static_cast<std::uint64_t>(m_level.wallWidth);
+        bool isInWallCol = (x & (m_level.pixelsPerCell - 1)) < static_cast<std::uint64_t>(m_level.wallWidth);
+        if(isInWallRow && isInWallCol)
+        {
+            return MAZE_WALL_COLOR;
+        }
+        else if(isInWallRow)
+        {
+            return m_maze.isWallOpen(row, col, Maze::NORTH_DIRECTION) ? passageColor(row, col, row - 1, col) : MAZE_WALL_COLOR;
+        }
+        else if(isInWallCol)
+        {
+            return m_maze.isWallOpen(row, col, Maze::WEST_DIRECTION) ? passageColor(row, col, row, col - 1) : MAZE_WALL_COLOR;
+        }
+        return cellColor(row, col);
+    }
+
+    // Entrance, exit or path if the pixel covers one, otherwise a gray as dark as the share
+    // of closed south and east walls in the cells it covers
+    std::uint8_t shadedPixelColor(std::uint64_t x, std::uint64_t y) const
+    {
+        std::uint64_t firstRow = y << m_level.scaleShift;
+        std::uint64_t firstCol = x << m_level.scaleShift;
+        std::uint64_t numRows = std::min(m_level.cellsPerPixel, m_header.numRows - firstRow);
+        std::uint64_t numCols = std::min(m_level.cellsPerPixel, m_header.numCols - firstCol);
+
+        auto coversCell = [&](std::int64_t row, std::int64_t col)
+        {
+            return row >= static_cast<std::int64_t>(firstRow) && row < static_cast<std::int64_t>(firstRow + numRows) && \
+                   col >= static_cast<std::int64_t>(firstCol) && col < static_cast<std::int64_t>(firstCol + numCols);
+        };
+        if(coversCell(m_header.entranceRow, m_header.entranceCol))
+        {
+            return MAZE_ENTRANCE_COLOR;
+        }
+        else if(coversCell(m_header.exitRow, m_header.exitCol))
+        {
+            return MAZE_EXIT_COLOR;
+        }
+
+        std::uint64_t numOpen = 0;
+        for(std::uint64_t row = firstRow; row < firstRow + numRows; row++)
+        {
+            if(m_maze.getPathRow(row) != nullptr && countSetBitsInRow(m_maze.getPathRow(row), firstCol, numCols) > 0)
+            {
+                return MAZE_PATH_COLOR;
+            }
+            numOpen += countSetBitsInRow(m_maze.getSouthWallRow(row), firstCol, numCols);
+            numOpen += countSetBitsInRow(m_maze.getEastWallRow(row), firstCol, numCols);
+        }
+
+        std::uint64_t numWalls = 2 * numRows * numCols;
+        std::uint64_t shade = (numWalls - numOpen) * (NUM_GRAY_SHADES - 1) / numWalls;
+        return static_cast<std::uint8_t>(MAZE_GRAY_COLOR + shade);
+    }
+
+    const MappedMaze& m_maze;
+    const MazeBinaryHeader& m_header;
+    const TileLevel& m_level;
+};
+
+/**--------------------------------------------------------------------------------------
+ * renderTile()
+ * 
+ * Renders and writes one tile of a zoom level
+ *     Pixels past the edge of the level are white
+ * 
+ * @param[in]       painter     Painter of the tile's level
+ * @param[in]       level       Zoom level of the tile
+ * @param[in]       tileX       Column of the tile in its level
+ * @param[in]       tileY       Row of the tile in its level
+ * @param[in]       palette     NUM_TILE_COLORS RGB colors
+ * @param[in]       fileName    Name of the png file to write
+ * @param[in,out]   scanline    Work buffer for one filtered scanline, reused across tiles
+ * @param[in,out]   compressed  Work buffer for the compressed tile, reused across tiles
+ * @return true if the tile was written
+ * --------------------------------------------------------------------------------------
+*/
+bool renderTile(const MazeTilePainter& painter, const TileLevel& level, std::uint64_t tileX, std::uint64_t tileY, const std::uint8_t* palette, \
+                const std::string& fileName, std::vector<std::uint8_t>& scanline, std::vector<std::uint8_t>& compressed)
+{
+    compressed.clear();
+    PngDeflater deflater(compressed);
+    std::vector<std::uint8_t> previousScanline;
+
+    for(std::uint64_t tileRow = 0; tileRow < MAZE_TILE_SIZE; tileRow++)
+    {
+        std::uint64_t y = tileY * MAZE_TILE_SIZE + tileRow;
+        if(tileRow > 0 && painter.repeatsRowAbove(y))
+        {
+            deflater.putRepeated(2, 1);
+            deflater.putRepeated(0, MAZE_TILE_SIZE);
+            continue;
+        }
+
+        scanline.assign(MAZE_TILE_SIZE + 1, MAZE_WHITE_COLOR);
+        scanline[0] = 0;
+        for(std::uint64_t tileCol = 0; y < level.height && tileCol < MAZE_TILE_SIZE; tileCol++)
+        {
+            std::uint64_t x = tileX * MAZE_TILE_SIZE + tileCol;
+            if(x < level.width)
+            {
+                scanline[1 + tileCol] = painter.pixelColor(x, y);
+            }
+        }
+
+        // A scanline equal to the one above is stored with the Up filter, as zeros
+        if(scanline == previousScanline)
+        {
+            deflater.putRepeated(2, 1);
+            deflater.putRepeated(0, MAZE_TILE_SIZE);
+        }
+        else
+        {
+            deflater.put(scanline.data(), scanline.size());
+            previousScanline = scanline;
+        }
+    }
+    deflater.finish();
+
+    std::ofstream tileFile(fileName, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    writePngFile(tileFile, MAZE_TILE_SIZE, MAZE_TILE_SIZE, palette, NUM_TILE_COLORS, compressed);
+    return static_cast<bool>(tileFile);
+}
+
+/**--------------------------------------------------------------------------------------
+ * renderMazeTiles()
+ * 
+ * Renders a binary maze file as a pyramid of PNG tiles in the XYZ layout, 
+ * "<outputDirectory>/<zoom>/<x>/<y>.png", for map viewers such as Leaflet or OpenLayers
+ *     The deepest zoom level draws cellSize pixels per cell, and every level above it halves 
+ *     the size, until the whole maze fits on one tile at zoom 0
+ *     Levels with fewer than 2 pixels per cell shade each pixel by the share of closed 
+ *     walls among the cells it covers, and color it if it covers the entrance, exit or path
+ *     Tiles are rendered band by band, from the top of a level to its bottom, by numThreads 
+ *     threads taking the next tile in turn. Each tile reads only the rows of the mapped 
+ *     file it covers, so memory stays bounded by the tiles in flight, whatever the maze size
+ *     Also writes "<outputDirectory>/tiles.json", describing the pyramid
+ * 
+ * @param[in] mappedMaze        Mapped binary maze file
+ * @param[in] outputDirectory   Directory to write the tiles to, created if needed
+ * @param[in] cellSize          Pixels per cell at the deepest zoom level, a power of 2 of at
+ *                              least 2
+ * @param[in] numThreads        Number of threads to render tiles on, at least 1
+ * @return true if every tile was written
+ * --------------------------------------------------------------------------------------
+*/
+bool renderMazeTiles(const MappedMaze& mappedMaze, const std::string& outputDirectory, int cellSize, int numThreads)
+{
+    METRIC_TIMER(METRIC_RENDER_TIMER)
+    if(cellSize < 2 || (cellSize & (cellSize - 1)) != 0)
+    {
+        std::cerr << "ERROR: renderMazeTiles() needs a power of 2 of at least 2 pixels per cell" << std::endl;
+        return false;
+    }
+    numThreads = std::max(numThreads, 1);
+
+    const MazeBinaryHeader& header = mappedMaze.getHeader();
+    std::vector<TileLevel> levels = makeTileLevels(header, cellSize);
+
+    std::uint8_t palette[3 * NUM_TILE_COLORS];
+    std::copy(MAZE_PALETTE, MAZE_PALETTE + 3 * NUM_MAZE_COLORS, palette);
+    for(int shade = 0; shade < NUM_GRAY_SHADES; shade++)
+    {
+        std::fill_n(palette + 3 * (MAZE_GRAY_COLOR + shade), 3, static_cast<std::uint8_t>(255 - shade * 255 / (NUM_GRAY_SHADES - 1)));
+    }
+
+    std::error_code directoryError;
+    for(const TileLevel& level : levels)
+    {
+        for(std::uint64_t tileX = 0; tileX < level.tilesWide && !directoryError; tileX++)
+        {
+            std::filesystem::create_directories(outputDirectory + "/" + std::to_string(level.zoom) + "/" + std::to_string(tileX), directoryError);
+        }
+    }
+    if(directoryError)
+    {
+        std::cerr << "ERROR: renderMazeTiles() could not create the tile directories in " << outputDirectory << ": " << directoryError.message() << std::endl;
+        return false;
+    }
+
+    std::atomic<bool> hasFailed(false);
+    for(const TileLevel& level : levels)
+    {
+        MazeTilePainter painter(mappedMaze, level);
+        const std::uint64_t numTiles = level.tilesWide * level.tilesHigh;
+        const std::string levelDirectory = outputDirectory + "/" + std::to_string(level.zoom) + "/";
+        std::atomic<std::uint64_t> nextTile(0);
+
+        // Tiles are taken in row-major order, so the threads work through one band of tile
+        // rows (and so one band of maze rows) at a time
+        auto renderTiles = [&]()
+        {
+            std::vector<std::uint8_t> scanline;
+            std::vector<std::uint8_t> compressed;
+            for(std::uint64_t tile = nextTile.fetch_add(1); tile < numTiles; tile = nextTile.fetch_add(1))
+            {
+                std::uint64_t tileX = tile % level.tilesWide;
+                std::uint64_t tileY = tile / level.tilesWide;
+                std::string fileName = levelDirectory + std::to_string(tileX) + "/" + std::to_string(tileY) + ".png";
+                if(!renderTile(painter, level, tileX, tileY, palette, fileName, scanline, compressed))
+                {
+                    hasFailed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for(int worker = 1; worker < numThreads; worker++)
+        {
+            workers.emplace_back(renderTiles);
+        }
+        renderTiles();
+        for(std::thread& workerThread : workers)
+        {
+            workerThread.join();
+        }
+    }
+
+    std::ofstream metadataFile(outputDirectory + "/tiles.json", std::ofstream::out | std::ofstream::trunc);
+    metadataFile << "{\n    \"format\": \"xyz\",\n    \"tileSize\": " << MAZE_TILE_SIZE << ",\n    \"minZoom\": 0,\n    \"maxZoom\": " << levels.back().zoom \
+                 << ",\n    \"width\": " << levels.back().width << ",\n    \"height\": " << levels.back().height \
+                 << ",\n    \"rows\": " << header.numRows << ",\n    \"cols\": " << header.numCols << ",\n    \"cellSize\": " << cellSize << "\n}\n";
+
+    if(hasFailed || !metadataFile)
+    {
+        std::cerr << "ERROR: renderMazeTiles() could not write every tile to " << outputDirectory << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+/*mazeTiles.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Tiled maze renderer
+ * 
+ * Renders binary maze files of any size as a pyramid of fixed-size PNG tiles, reading only
+ * the rows each tile needs, on several threads
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "mazeBinary.h"
+
+#include <string>
+
+/**
+ * Width and height of every tile in pixels
+*/
+const int MAZE_TILE_SIZE = 256;
+
+/**--------------------------------------------------------------------------------------
+ * renderMazeTiles()
+ * 
+ * Renders a binary maze file as a pyramid of PNG tiles in the XYZ layout, 
+ * "<outputDirectory>/<zoom>/<x>/<y>.png", for map viewers such as Leaflet or OpenLayers
+ *     The deepest zoom level draws cellSize pixels per cell, and every level above it halves 
+ *     the size, until the whole maze fits on one tile at zoom 0
+ *     Levels with fewer than 2 pixels per cell shade each pixel by the share of closed 
+ *     walls among the cells it covers, and color it if it covers the entrance, exit or path
+ *     Tiles are rendered band by band, from the top of a level to its bottom, by numThreads 
+ *     threads taking the next tile in turn. Each tile reads only the rows of the mapped 
+ *     file it covers, so memory stays bounded by the tiles in flight, whatever the maze size
+ *     Also writes "<outputDirectory>/tiles.json", describing the pyramid
+ * 
+ * @param[in] mappedMaze        Mapped binary maze file
+ * @param[in] outputDirectory   Directory to write the tiles to, created if needed
+ * @param[in] cellSize          Pixels per cell at the deepest zoom level, a power of 2 of at
+ *                              least 2
+ * @param[in] numThreads        Number of threads to render tiles on, at least 1
+ * @return true if every tile was written
+ * --------------------------------------------------------------------------------------
+*/
+bool renderMazeTiles(const MappedMaze& mappedMaze, const std::string& outputDirectory, int cellSize, int numThreads);
@@ -0,0 +1,492 @@
+/*mazeWriter.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze writer
+ * 
+ * Writes completed and solved maze data to a .csv file, or to a binary .mzb file, through a
+ * large reusable output buffer
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mazeWriter.h"
+#include "mazeBinary.h"
+#include "metrics.h"
+
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates an empty buffer in front of a stream
+ * 
+ * @param[in,out]   outfile     Stream the buffer is flushed to, must outlive the buffer
+ * @param[in]       capacity    Number of bytes buffered before flushing
+ * --------------------------------------------------------------------------------------
+*/
+MazeOutputBuffer::MazeOutputBuffer(std::ostream& outfile, std::size_t capacity)
+    : m_outfile(&outfile), m_buffer(std::max<std::size_t>(capacity, 64)), m_size(0)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates an empty buffer with no stream, that keeps every byte in memory
+ * 
+ * @param[in] capacity Number of bytes to allocate up front
+ * --------------------------------------------------------------------------------------
+*/
+MazeOutputBuffer::MazeOutputBuffer(std::size_t capacity)
+    : m_outfile(nullptr), m_buffer(std::max<std::size_t>(capacity, 64)), m_size(0)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * Destructor
+ * 
+ * Flushes whatever is left in the buffer
+ * --------------------------------------------------------------------------------------
+*/
+MazeOutputBuffer::~MazeOutputBuffer()
+{
+    flush();
+}
+
+/**--------------------------------------------------------------------------------------
+ * appendUnsigned()
+ * 
+ * Adds the decimal digits of an integer to the buffer
+ * 
+ * @param[in] value Integer to add
+ * --------------------------------------------------------------------------------------
+*/
+void MazeOutputBuffer::appendUnsigned(std::uint64_t value)
+{
+    // 20 digits are enough for any 64-bit integer
+    char* digits = reserve(20);
+    m_size += static_cast<std::size_t>(std::to_chars(digits, digits + 20, value).ptr - digits);
+}
+
+/**--------------------------------------------------------------------------------------
+ * flush()
+ * 
+ * Writes everything in the buffer to the stream, and flushes the stream
+ *     A buffer with no stream keeps its bytes
+ * 
+ * @return true if the stream is still good, or if there is no stream
+ * --------------------------------------------------------------------------------------
+*/
+bool MazeOutputBuffer::flush()
+{
+    if(m_outfile == nullptr)
+    {
+        return true;
+    }
+
+    if(m_size > 0)
+    {
+        m_outfile->write(m_buffer.data(), static_cast<std::streamsize>(m_size));
+        m_size = 0;
+    }
+    m_outfile->flush();
+    return m_outfile->good();
+}
+
+/**--------------------------------------------------------------------------------------
+ * makeRoom()
+ * 
+ * Flushes the buffer, and grows it if numBytes still do not fit
+ *     A buffer with no stream at least doubles instead, keeping the buffered bytes
+ * 
+ * @param[in] numBytes Number of bytes that must fit after the buffered ones
+ * --------------------------------------------------------------------------------------
+*/
+void MazeOutputBuffer::makeRoom(std::size_t numBytes)
+{
+    if(m_outfile == nullptr)
+    {
+        m_buffer.resize(std::max(2 * m_buffer.size(), m_size + numBytes));
+        return;
+    }
+
+    if(m_size > 0)
+    {
+        m_outfile->write(m_buffer.data(), static_cast<std::streamsize>(m_size));
+        m_size = 0;
+    }
+
+    if(numBytes > m_buffer.size())
+    {
+        m_buffer.resize(numBytes);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * copyToken()
+ * 
+ * Copies a string literal to a row being formatted, without its null terminator
+ * 
+ * @param[in,out]   rowEnd  End of the formatted row, moved past the copied characters
+ * @param[in]       token   String literal to copy
+ * --------------------------------------------------------------------------------------
+*/
+template<std::size_t N>
+void copyToken(char*& rowEnd, const char (&token)[N])
+{
+    std::memcpy(rowEnd, token, N - 1);
+    rowEnd += N - 1;
+}
+
+/**--------------------------------------------------------------------------------------
+ * writeMazeDataCSV()
+ * 
+ * Write the completed and solved maze data to a csv file
+ *     Each row is formatted straight into the output buffer from the maze's wall bitplanes
+ * 
+ * @param[in,out]   outfile     Csv file (or other stream, or the buffer in front of one) to be
+ *                              modified, filled with solved maze information
+ * @param[in]       solvedMaze  Maze object with path from entrance to exit
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazeDataCSV(std::ostream& outfile, const Maze& solvedMaze)
+{
+    MazeOutputBuffer outputBuffer(outfile);
+    writeMazeDataCSV(outputBuffer, solvedMaze);
+}
+
+void writeMazeDataCSV(MazeOutputBuffer& outfile, const Maze& solvedMaze)
+{
+    METRIC_TIMER(METRIC_WRITE_TIMER)
+    const int numRows = solvedMaze.getROWCELLS();
+    const int numCols = solvedMaze.getCOLCELLS();
+
+    outfile.appendUnsigned(static_cast<std::uint64_t>(numRows));
+    outfile.append(',');
+    outfile.appendUnsigned(static_cast<std::uint64_t>(numCols));
+    outfile.append(",\n");
+
+    std::tuple<int, int> entranceCoords = solvedMaze.getEntrance();
+    int entranceRow = std::get<0>(entranceCoords);
+    int entranceCol = std::get<1>(entranceCoords);
+
+    std::tuple<int, int> exitCoords = solvedMaze.getExit();
+    int exitRow = std::get<0>(exitCoords);
+    int exitCol = std::get<1>(exitCoords);
+
+    // Longest cell is "CellEntranceSE,", plus the ",\n" ending the row
+    const std::size_t maxRowBytes = static_cast<std::size_t>(numCols) * 15 + 2;
+
+    for(int row = 0; row < numRows; row++)
+    {
+        const std::uint64_t* southWalls = solvedMaze.getSouthWallRow(row);
+        const std::uint64_t* eastWalls = solvedMaze.getEastWallRow(row);
+        const bool hasSouthWalls = row < numRows - 1;
+
+        char* rowStart = outfile.reserve(maxRowBytes);
+        char* rowEnd = rowStart;
+
+        for(int col = 0; col < numCols; col++)
+        {
+            // Cells
+            if(row == entranceRow && col == entranceCol)
+            {
+                copyToken(rowEnd, "CellEntrance");
+            }
+            else if(row == exitRow && col == exitCol)
+            {
+                copyToken(rowEnd, "CellExit");
+            }
+            else if(solvedMaze.isCellOnPath(row, col))
+            {
+                copyToken(rowEnd, "CellPath");
+            }
+            else
+            {
+                copyToken(rowEnd, "CellRegular");
+            }
+
+            const std::uint64_t wallBit = std::uint64_t(1) << (col & 63);
+
+            // Walls are random, so branching on them mispredicts half the time. Instead the 
+            // letter is always stored, and only kept if the wall is closed
+            // Horizontal walls
+            *rowEnd = 'S';
+            rowEnd += hasSouthWalls && !(southWalls[col >> 6] & wallBit);
+
+            // Vertical walls
+            if(col < numCols - 1)
+            {
+                *rowEnd = 'E';
+                rowEnd += !(eastWalls[col >> 6] & wallBit);
+                *rowEnd++ = ',';
+            }
+        }
+
+        *rowEnd++ = ',';
+
+        if(row < numRows - 1)
+        {
+            *rowEnd++ = '\n';
+        }
+
+        outfile.commit(static_cast<std::size_t>(rowEnd - rowStart));
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * writeMazeAscii()
+ * 
+ * Write the completed and solved maze as text, in the same layout as Maze::printMaze()
+ *     I is the entrance, O the exit, W a path cell and C any other cell, | and - are closed 
+ *     walls. The entrance and exit coordinates follow the maze
+ *     Each row is formatted straight into the output buffer from the maze's wall bitplanes
+ * 
+ * @param[in,out]   outfile     Text file (or other stream, or the buffer in front of one) to 
+ *                              be modified, filled with the drawing of the maze
+ * @param[in]       solvedMaze  Maze object with path from entrance to exit
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazeAscii(std::ostream& outfile, const Maze& solvedMaze)
+{
+    MazeOutputBuffer outputBuffer(outfile);
+    writeMazeAscii(outputBuffer, solvedMaze);
+}
+
+void writeMazeAscii(MazeOutputBuffer& outfile, const Maze& solvedMaze)
+{
+    METRIC_TIMER(METRIC_WRITE_TIMER)
+    const int numRows = solvedMaze.getROWCELLS();
+    const int numCols = solvedMaze.getCOLCELLS();
+
+    std::tuple<int, int> entranceCoords = solvedMaze.getEntrance();
+    int entranceRow = std::get<0>(entranceCoords);
+    int entranceCol = std::get<1>(entranceCoords);
+
+    std::tuple<int, int> exitCoords = solvedMaze.getExit();
+    int exitRow = std::get<0>(exitCoords);
+    int exitCol = std::get<1>(exitCoords);
+
+    // Each cell takes 4 characters on both lines of a row, plus the newlines
+    const std::size_t maxRowBytes = static_cast<std::size_t>(numCols) * 8 + 2;
+
+    for(int row = 0; row < numRows; row++)
+    {
+        const std::uint64_t* southWalls = solvedMaze.getSouthWallRow(row);
+        const std::uint64_t* eastWalls = solvedMaze.getEastWallRow(row);
+
+        char* rowStart = outfile.reserve(maxRowBytes);
+        char* rowEnd = rowStart;
+
+        // Cells and vertical walls
+        for(int col = 0; col < numCols; col++)
+        {
+            char cell = solvedMaze.isCellOnPath(row, col) ? 'W' : 'C';
+            if(row == entranceRow && col == entranceCol)
+            {
+                cell = 'I';
+            }
+            else if(row == exitRow && col == exitCol)
+            {
+                cell = 'O';
+            }
+            *rowEnd++ = cell;
+            *rowEnd++ = ' ';
+
+            if(col < numCols - 1)
+            {
+                *rowEnd++ = (eastWalls[col >> 6] & (std::uint64_t(1) << (col & 63))) ? ' ' : '|';
+                *rowEnd++ = ' ';
+            }
+        }
+        *rowEnd++ = '\n';
+
+        // Horizontal walls, the last row has none
+        if(row < numRows - 1)
+        {
+            for(int col = 0; col < numCols; col++)
+            {
+                *rowEnd++ = (southWalls[col >> 6] & (std::uint64_t(1) << (col & 63))) ? ' ' : '-';
+                copyToken(rowEnd, "   ");
+            }
+            *rowEnd++ = '\n';
+        }
+
+        outfile.commit(static_cast<std::size_t>(rowEnd - rowStart));
+    }
+
+    if(entranceRow != Maze::INVALID_ROW_COL && entranceCol != Maze::INVALID_ROW_COL)
+    {
+        outfile.append("Entrance I: (");
+        outfile.appendUnsigned(static_cast<std::uint64_t>(entranceRow));
+        outfile.append(", ");
+        outfile.appendUnsigned(static_cast<std::uint64_t>(entranceCol));
+        outfile.append(")\n");
+    }
+    if(exitRow != Maze::INVALID_ROW_COL && exitCol != Maze::INVALID_ROW_COL)
+    {
+        outfile.append("Exit O: (");
+        outfile.appendUnsigned(static_cast<std::uint64_t>(exitRow));
+        outfile.append(", ");
+        outfile.appendUnsigned(static_cast<std::uint64_t>(exitCol));
+        outfile.append(")\n");
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * storeRowWords()
+ * 
+ * Stores a row of a bitplane as little-endian words
+ * 
+ * @param[out]  bytes       Destination, 8 * numWords bytes
+ * @param[in]   words       First word of the row
+ * @param[in]   numWords    Number of words in the row
+ * @return the end of the stored bytes
+ * --------------------------------------------------------------------------------------
+*/
+char* storeRowWords(char* bytes, const std::uint64_t* words, std::size_t numWords)
+{
+    for(std::size_t word = 0; word < numWords; word++)
+    {
+        for(int byte = 0; byte < 8; byte++)
+        {
+            *bytes++ = static_cast<char>(words[word] >> (8 * byte));
+        }
+    }
+    return bytes;
+}
+
+/**--------------------------------------------------------------------------------------
+ * writeMazeDataBinary()
+ * 
+ * Write the completed and solved maze data to a binary file, see mazeBinary.h for the format
+ *     The wall bitplanes are written row by row straight from the maze, and the path 
+ *     section from the cells labeled as path cells
+ * 
+ * @param[in,out]   outfile     Binary file (or other stream, or the buffer in front of one) 
+ *                              to be modified, opened in binary mode
+ * @param[in]       solvedMaze  Maze object with path from entrance to exit
+ * @param[in]       hasSeed     Whether seed is stored in the header
+ * @param[in]       seed        Seed the maze was generated from
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazeDataBinary(std::ostream& outfile, const Maze& solvedMaze, bool hasSeed, std::uint64_t seed)
+{
+    MazeOutputBuffer outputBuffer(outfile);
+    writeMazeDataBinary(outputBuffer, solvedMaze, hasSeed, seed);
+}
+
+void writeMazeDataBinary(MazeOutputBuffer& outfile, const Maze& solvedMaze, bool hasSeed, std::uint64_t seed)
+{
+    METRIC_TIMER(METRIC_WRITE_TIMER)
+    std::tuple<int, int> entranceCoords = solvedMaze.getEntrance();
+    std::tuple<int, int> exitCoords = solvedMaze.getExit();
+
+    MazeBinaryHeader header;
+    header.numRows = static_cast<std::uint64_t>(solvedMaze.getROWCELLS());
+    header.numCols = static_cast<std::uint64_t>(solvedMaze.getCOLCELLS());
+    header.entranceRow = std::get<0>(entranceCoords);
+    header.entranceCol = std::get<1>(entranceCoords);
+    header.exitRow = std::get<0>(exitCoords);
+    header.exitCol = std::get<1>(exitCoords);
+    header.seed = hasSeed ? seed : 0;
+    header.flags = MAZE_BINARY_HAS_PATH | (hasSeed ? MAZE_BINARY_HAS_SEED : 0);
+    makeMazeBinaryHeader(header);
+
+    encodeMazeBinaryHeader(header, reinterpret_cast<std::uint8_t*>(outfile.reserve(MAZE_BINARY_HEADER_BYTES)));
+    outfile.commit(MAZE_BINARY_HEADER_BYTES);
+
+    std::size_t wordsPerRow = solvedMaze.getWallWordsPerRow();
+
+    // Wall section, south then east words of every row
+    for(int row = 0; row < solvedMaze.getROWCELLS(); row++)
+    {
+        char* rowBytes = outfile.reserve(16 * wordsPerRow);
+        rowBytes = storeRowWords(rowBytes, solvedMaze.getSouthWallRow(row), wordsPerRow);
+        storeRowWords(rowBytes, solvedMaze.getEastWallRow(row), wordsPerRow);
+        outfile.commit(16 * wordsPerRow);
+    }
+
+    // Path section, packed from the path labels of the cells
+    std::vector<std::uint64_t> pathWords(wordsPerRow);
+    for(int row = 0; row < solvedMaze.getROWCELLS(); row++)
+    {
+        std::fill(pathWords.begin(), pathWords.end(), 0);
+        for(int col = 0; col < solvedMaze.getCOLCELLS(); col++)
+        {
+            if(solvedMaze.isCellOnPath(row, col))
+            {
+                pathWords[col >> 6] |= std::uint64_t(1) << (col & 63);
+            }
+        }
+
+        storeRowWords(outfile.reserve(8 * wordsPerRow), pathWords.data(), wordsPerRow);
+        outfile.commit(8 * wordsPerRow);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * writeMazePathBinary()
+ * 
+ * Write the ordered path of a solved maze on its own as a binary path record, see 
+ * mazeBinary.h for the format
+ *     Only the path is written, so path-only readers never touch the maze grid
+ * 
+ * @param[in,out]   outfile Binary file (or other stream, or the buffer in front of one) to 
+ *                          be modified, opened in binary mode
+ * @param[in]       path    Path to write, see MazeSolver::getCompactPath()
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazePathBinary(std::ostream& outfile, const MazePath& path)
+{
+    MazeOutputBuffer outputBuffer(outfile);
+    writeMazePathBinary(outputBuffer, path);
+}
+
+void writeMazePathBinary(MazeOutputBuffer& outfile, const MazePath& path)
+{
+    METRIC_TIMER(METRIC_WRITE_TIMER)
+    std::size_t numBytes = mazePathBinaryBytes(path);
+    encodeMazePathBinary(path, reinterpret_cast<std::uint8_t*>(outfile.reserve(numBytes)));
+    outfile.commit(numBytes);
+}
+
+/**--------------------------------------------------------------------------------------
+ * mazeFormatExtension()
+ * 
+ * Returns the file extension of an output format
+ * 
+ * @param[in] format Output format, MAZE_FORMAT_CSV or MAZE_FORMAT_BINARY
+ * @return ".csv" or ".mzb"
+ * --------------------------------------------------------------------------------------
+*/
+std::string mazeFormatExtension(int format)
+{
+    return (format == MAZE_FORMAT_BINARY) ? ".mzb" : ".csv";
+}
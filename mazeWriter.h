@@ -0,0 +1,303 @@
+/*mazeWriter.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Maze writer
+ * 
+ * Writes completed and solved maze data to a .csv file, or to a binary .mzb file, through a
+ * large reusable output buffer
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "maze.h"
+#include "mazePath.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Integers representing the output formats selectable from main()
+ *     MAZE_FORMAT_CSV: text format read by maze_img_displayer.py, see writeMazeDataCSV()
+ *     MAZE_FORMAT_BINARY: binary format, see writeMazeDataBinary() and mazeBinary.h
+*/
+const int MAZE_FORMAT_CSV = 0;
+const int MAZE_FORMAT_BINARY = 1;
+
+/**--------------------------------------------------------------------------------------
+ * MazeOutputBuffer class
+ * 
+ * Byte buffer in front of an output stream (a file, std::cout or a pipe), so a writer
+ * can format straight into memory and the stream only sees large writes
+ *     Writers either append() small pieces, or reserve() room for a whole row, format 
+ *     into it and commit() the bytes they used
+ *     The buffer is flushed to the stream whenever it fills up, and when it is destroyed
+ *     A buffer without a stream keeps everything in memory instead, growing as needed, so a 
+ *     maze can be formatted on one thread and written out on another, see getData()
+ *     One buffer can be reused for any number of mazes, see runBatch()
+ * --------------------------------------------------------------------------------------
+*/
+class MazeOutputBuffer
+{
+public:
+    // Default buffer size, large enough that flushes are rare even for huge mazes
+    static const std::size_t DEFAULT_CAPACITY = std::size_t(1) << 20;
+
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates an empty buffer in front of a stream
+     * 
+     * @param[in,out]   outfile     Stream the buffer is flushed to, must outlive the buffer
+     * @param[in]       capacity    Number of bytes buffered before flushing
+     * --------------------------------------------------------------------------------------
+    */
+    explicit MazeOutputBuffer(std::ostream& outfile, std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates an empty buffer with no stream, that keeps every byte in memory
+     * 
+     * @param[in] capacity Number of bytes to allocate up front
+     * --------------------------------------------------------------------------------------
+    */
+    explicit MazeOutputBuffer(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**--------------------------------------------------------------------------------------
+     * Destructor
+     * 
+     * Flushes whatever is left in the buffer
+     * --------------------------------------------------------------------------------------
+    */
+    ~MazeOutputBuffer();
+
+    MazeOutputBuffer(const MazeOutputBuffer&) = delete;
+    MazeOutputBuffer& operator=(const MazeOutputBuffer&) = delete;
+
+    /**--------------------------------------------------------------------------------------
+     * reserve()
+     * 
+     * Makes room for numBytes more bytes, flushing or growing the buffer if needed
+     * 
+     * @param[in] numBytes Most bytes the caller will write before calling commit()
+     * @return a pointer to the first free byte of the buffer
+     * --------------------------------------------------------------------------------------
+    */
+    char* reserve(std::size_t numBytes)
+    {
+        if(m_size + numBytes > m_buffer.size())
+        {
+            makeRoom(numBytes);
+        }
+        return m_buffer.data() + m_size;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * commit()
+     * 
+     * Adds the bytes written after the last reserve() to the buffer
+     * 
+     * @param[in] numBytes Number of bytes written, at most the number reserved
+     * --------------------------------------------------------------------------------------
+    */
+    void commit(std::size_t numBytes)
+    {
+        m_size += numBytes;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * append()
+     * 
+     * Adds bytes, a null-terminated string or one character to the buffer
+     * --------------------------------------------------------------------------------------
+    */
+    void append(const char* bytes, std::size_t numBytes)
+    {
+        std::memcpy(reserve(numBytes), bytes, numBytes);
+        m_size += numBytes;
+    }
+
+    void append(const char* text)
+    {
+        append(text, std::strlen(text));
+    }
+
+    void append(char character)
+    {
+        *reserve(1) = character;
+        m_size++;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * appendUnsigned()
+     * 
+     * Adds the decimal digits of an integer to the buffer
+     * 
+     * @param[in] value Integer to add
+     * --------------------------------------------------------------------------------------
+    */
+    void appendUnsigned(std::uint64_t value);
+
+    /**--------------------------------------------------------------------------------------
+     * flush()
+     * 
+     * Writes everything in the buffer to the stream, and flushes the stream
+     *     A buffer with no stream keeps its bytes
+     * 
+     * @return true if the stream is still good, or if there is no stream
+     * --------------------------------------------------------------------------------------
+    */
+    bool flush();
+
+    /**--------------------------------------------------------------------------------------
+     * getData() / getSize()
+     * 
+     * Returns the bytes in the buffer that were not flushed yet, every byte written for a 
+     * buffer with no stream
+     * --------------------------------------------------------------------------------------
+    */
+    const char* getData() const
+    {
+        return m_buffer.data();
+    }
+
+    std::size_t getSize() const
+    {
+        return m_size;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * clear()
+     * 
+     * Drops the bytes in the buffer without writing them, keeping its storage
+     * --------------------------------------------------------------------------------------
+    */
+    void clear()
+    {
+        m_size = 0;
+    }
+
+private:
+    // Flushes the buffer, and grows it if numBytes still do not fit
+    void makeRoom(std::size_t numBytes);
+
+    // Stream the buffer is flushed to, nullptr to keep everything in memory
+    std::ostream* m_outfile;
+    std::vector<char> m_buffer;
+    std::size_t m_size;
+};
+
+/**--------------------------------------------------------------------------------------
+ * writeMazeDataCSV()
+ * 
+ * Write the completed and solved maze data to a csv file
+ *     Each row is formatted straight into the output buffer from the maze's wall bitplanes
+ * 
+ * @param[in,out]   outfile     Csv file (or other stream, or the buffer in front of one) to be
+ *                              modified, filled with solved maze information
+ * @param[in]       solvedMaze  Maze object with path from entrance to exit
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazeDataCSV(std::ostream& outfile, const Maze& solvedMaze);
+void writeMazeDataCSV(MazeOutputBuffer& outfile, const Maze& solvedMaze);
+
+/**--------------------------------------------------------------------------------------
+ * writeMazeDataBinary()
+ * 
+ * Write the completed and solved maze data to a binary file, see mazeBinary.h for the format
+ *     The wall bitplanes are written row by row straight from the maze, and the path 
+ *     section from the cells labeled as path cells
+ * 
+ * @param[in,out]   outfile     Binary file (or other stream, or the buffer in front of one) 
+ *                              to be modified, opened in binary mode
+ * @param[in]       solvedMaze  Maze object with path from entrance to exit
+ * @param[in]       hasSeed     Whether seed is stored in the header
+ * @param[in]       seed        Seed the maze was generated from
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazeDataBinary(std::ostream& outfile, const Maze& solvedMaze, bool hasSeed, std::uint64_t seed);
+void writeMazeDataBinary(MazeOutputBuffer& outfile, const Maze& solvedMaze, bool hasSeed, std::uint64_t seed);
+
+/**--------------------------------------------------------------------------------------
+ * writeMazePathBinary()
+ * 
+ * Write the ordered path of a solved maze on its own as a binary path record, see 
+ * mazeBinary.h for the format
+ *     Only the path is written, so path-only readers never touch the maze grid
+ * 
+ * @param[in,out]   outfile Binary file (or other stream, or the buffer in front of one) to 
+ *                          be modified, opened in binary mode
+ * @param[in]       path    Path to write, see MazeSolver::getCompactPath()
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazePathBinary(std::ostream& outfile, const MazePath& path);
+void writeMazePathBinary(MazeOutputBuffer& outfile, const MazePath& path);
+
+/**--------------------------------------------------------------------------------------
+ * writeMazeAscii()
+ * 
+ * Write the completed and solved maze as text, in the same layout as Maze::printMaze()
+ *     I is the entrance, O the exit, W a path cell and C any other cell, | and - are closed 
+ *     walls. The entrance and exit coordinates follow the maze
+ *     Each row is formatted straight into the output buffer from the maze's wall bitplanes
+ * 
+ * @param[in,out]   outfile     Text file (or other stream, or the buffer in front of one) to 
+ *                              be modified, filled with the drawing of the maze
+ * @param[in]       solvedMaze  Maze object with path from entrance to exit
+ * --------------------------------------------------------------------------------------
+*/
+void writeMazeAscii(std::ostream& outfile, const Maze& solvedMaze);
+void writeMazeAscii(MazeOutputBuffer& outfile, const Maze& solvedMaze);
+
+/**--------------------------------------------------------------------------------------
+ * storeRowWords()
+ * 
+ * Stores a row of a bitplane as little-endian words
+ * 
+ * @param[out]  bytes       Destination, 8 * numWords bytes
+ * @param[in]   words       First word of the row
+ * @param[in]   numWords    Number of words in the row
+ * @return the end of the stored bytes
+ * --------------------------------------------------------------------------------------
+*/
+char* storeRowWords(char* bytes, const std::uint64_t* words, std::size_t numWords);
+
+/**--------------------------------------------------------------------------------------
+ * mazeFormatExtension()
+ * 
+ * Returns the file extension of an output format
+ * 
+ * @param[in] format Output format, MAZE_FORMAT_CSV or MAZE_FORMAT_BINARY
+ * @return ".csv" or ".mzb"
+ * --------------------------------------------------------------------------------------
+*/
+std::string mazeFormatExtension(int format);
@@ -0,0 +1,180 @@
+"""maze_binary.py"""
+
+"""
+Author: Eric Fei
+Version 0.0.1
+
+Reads the binary maze files (.mzb) written by main.cpp with --format binary, mapping
+them into memory instead of parsing them, see mazeBinary.h for the format
+"""
+
+"""
+MIT License
+Copyright (c) 2023 Eric Fei
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+"""
+
+import mmap
+import struct
+
+MAZE_BINARY_MAGIC = b"MAZEGRID"
+MAZE_BINARY_VERSION = 1
+MAZE_BINARY_HEADER_BYTES = 96
+MAZE_BINARY_HAS_SEED = 1
+MAZE_BINARY_HAS_PATH = 2
+
+# Header layout after the magic, see mazeBinary.h
+HEADER_STRUCT = struct.Struct("<8sIIQQqqqqQIIQQ")
+
+MAZE_PATH_BINARY_MAGIC = b"MAZEPATH"
+MAZE_PATH_BINARY_VERSION = 1
+MAZE_PATH_BINARY_HEADER_BYTES = 40
+
+# Path record header layout, see mazeBinary.h
+PATH_HEADER_STRUCT = struct.Struct("<8sIIqqQ")
+
+NORTH_DIRECTION = 0
+SOUTH_DIRECTION = 1
+EAST_DIRECTION = 2
+WEST_DIRECTION = 3
+
+class MappedMaze:
+    """
+    Read-only view of the first maze record of a binary maze file, mapped into memory.
+
+    Arguments:
+    file_name -- name of the .mzb file to map
+    """
+    def __init__(self, file_name):
+        with open(file_name, 'rb') as f:
+            self.data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        if len(self.data) < MAZE_BINARY_HEADER_BYTES:
+            raise ValueError("{} is too short to be a binary maze file".format(file_name))
+
+        (magic, version, header_bytes, self.num_rows, self.num_cols,
+         self.entrance_row, self.entrance_col, self.exit_row, self.exit_col,
+         self.seed, self.flags, _, self.path_offset, self.total_bytes) = HEADER_STRUCT.unpack_from(self.data, 0)
+
+        if magic != MAZE_BINARY_MAGIC or version != MAZE_BINARY_VERSION or header_bytes != MAZE_BINARY_HEADER_BYTES:
+            raise ValueError("{} is not a version {} binary maze file".format(file_name, MAZE_BINARY_VERSION))
+        if self.total_bytes > len(self.data):
+            raise ValueError("{} is truncated".format(file_name))
+
+        self.words_per_row = (self.num_cols + 63) // 64
+
+    def close(self):
+        """Unmaps the file"""
+        self.data.close()
+
+    def has_seed(self):
+        return (self.flags & MAZE_BINARY_HAS_SEED) != 0
+
+    def has_path(self):
+        return (self.flags & MAZE_BINARY_HAS_PATH) != 0
+
+    def _is_bit_set(self, plane_offset, col):
+        return (self.data[plane_offset + (col >> 3)] >> (col & 7)) & 1 == 1
+
+    def _south_row_offset(self, row):
+        return MAZE_BINARY_HEADER_BYTES + row * 16 * self.words_per_row
+
+    def _east_row_offset(self, row):
+        return self._south_row_offset(row) + 8 * self.words_per_row
+
+    def is_wall_open(self, row, col, direction):
+        """
+        Checks if the wall on the given side of a cell is open, walls facing the maze border are always closed.
+
+        Arguments:
+        row -- row index of the cell
+        col -- column index of the cell
+        direction -- one of NORTH_DIRECTION, SOUTH_DIRECTION, EAST_DIRECTION or WEST_DIRECTION
+        """
+        if direction == NORTH_DIRECTION:
+            return row > 0 and self._is_bit_set(self._south_row_offset(row - 1), col)
+        elif direction == SOUTH_DIRECTION:
+            return row + 1 < self.num_rows and self._is_bit_set(self._south_row_offset(row), col)
+        elif direction == EAST_DIRECTION:
+            return col + 1 < self.num_cols and self._is_bit_set(self._east_row_offset(row), col)
+        elif direction == WEST_DIRECTION:
+            return col > 0 and self._is_bit_set(self._east_row_offset(row), col - 1)
+        return False
+
+    def is_cell_on_path(self, row, col):
+        """Checks if a cell is on the path stored in the file"""
+        if not self.has_path():
+            return False
+        return self._is_bit_set(self.path_offset + row * 8 * self.words_per_row, col)
+
+    def to_cell_strings(self):
+        """
+        Returns the maze as a 2D array of the same cell strings read from mazeData.csv
+        (e.g. "CellRegularSE"), so it can be drawn the same way.
+        """
+        arr = [["" for i in range(self.num_cols)] for j in range(self.num_rows)]
+        for row in range(self.num_rows):
+            for col in range(self.num_cols):
+                if row == self.entrance_row and col == self.entrance_col:
+                    cell_str = "CellEntrance"
+                elif row == self.exit_row and col == self.exit_col:
+                    cell_str = "CellExit"
+                elif self.is_cell_on_path(row, col):
+                    cell_str = "CellPath"
+                else:
+                    cell_str = "CellRegular"
+
+                if row < self.num_rows - 1 and not self.is_wall_open(row, col, SOUTH_DIRECTION):
+                    cell_str += "S"
+                if col < self.num_cols - 1 and not self.is_wall_open(row, col, EAST_DIRECTION):
+                    cell_str += "E"
+                arr[row][col] = cell_str
+        return arr
+
+def read_maze_path(file_name):
+    """
+    Returns the cells of the path in a binary path file (.mzp) as a list of (row, col),
+    ordered from the entrance to the exit, without reading the maze grid.
+
+    Arguments:
+    file_name -- name of the .mzp file to read
+    """
+    with open(file_name, 'rb') as f:
+        data = f.read()
+
+    if len(data) < MAZE_PATH_BINARY_HEADER_BYTES:
+        raise ValueError("{} is too short to be a binary path file".format(file_name))
+
+    (magic, version, header_bytes, row, col, num_moves) = PATH_HEADER_STRUCT.unpack_from(data, 0)
+    if magic != MAZE_PATH_BINARY_MAGIC or version != MAZE_PATH_BINARY_VERSION or header_bytes != MAZE_PATH_BINARY_HEADER_BYTES:
+        raise ValueError("{} is not a version {} binary path file".format(file_name, MAZE_PATH_BINARY_VERSION))
+    if len(data) < MAZE_PATH_BINARY_HEADER_BYTES + 8 * ((num_moves + 31) // 32):
+        raise ValueError("{} is truncated".format(file_name))
+    if row < 0:
+        return []
+
+    # Moves are 2 bits each, 4 to a byte since the words are little-endian
+    steps = {NORTH_DIRECTION: (-1, 0), SOUTH_DIRECTION: (1, 0), EAST_DIRECTION: (0, 1), WEST_DIRECTION: (0, -1)}
+    cells = [(row, col)]
+    for position in range(num_moves):
+        move = (data[MAZE_PATH_BINARY_HEADER_BYTES + (position >> 2)] >> (2 * (position & 3))) & 3
+        row += steps[move][0]
+        col += steps[move][1]
+        cells.append((row, col))
+    return cells
@@ -11,6 +11,10 @@ Christian Hill, April 2017.
 
 Given the solved maze data from main.cpp, displays the unsolved and solved 
 versions of the maze as separate png image files
+
+Reads mazeData.csv by default, or the file named by the first argument, which may be
+a binary maze file (.mzb) written with --format binary, or "-" to read csv data piped
+from main.exe --stdout
 """
 
 """
@@ -36,23 +40,37 @@ SOFTWARE.
 """
 
 import csv
+import sys
 import time
 
+import maze_binary
+
 arr = []
 total_rows = 0
 total_cols = 0
 
-with open('mazeData.csv', mode='r') as csv_file:
-    """Opens the csv file containing the solved maze data, and reads it into a 2D array"""
-    csv_reader = csv.reader(csv_file)
-    for row_num, row in enumerate(csv_reader):
-        if row_num == 0:
-            total_rows = int(row[1])
-            total_cols = int(row[0])
-            arr = [["" for i in range(total_cols)] for j in range(total_rows)]
-        else:
-            for col_num, col_entry in enumerate(row[:-1]):
-                arr[row_num - 1][col_num] = col_entry
+maze_data_fname = sys.argv[1] if len(sys.argv) > 1 else 'mazeData.csv'
+
+if maze_data_fname.endswith('.mzb'):
+    # Binary maze file, mapped and converted to the same cell strings as the csv file
+    mapped_maze = maze_binary.MappedMaze(maze_data_fname)
+    total_rows = mapped_maze.num_rows
+    total_cols = mapped_maze.num_cols
+    arr = mapped_maze.to_cell_strings()
+    mapped_maze.close()
+else:
+    csv_file = sys.stdin if maze_data_fname == '-' else open(maze_data_fname, mode='r')
+    with csv_file:
+        """Opens the csv file containing the solved maze data, and reads it into a 2D array"""
+        csv_reader = csv.reader(csv_file)
+        for row_num, row in enumerate(csv_reader):
+            if row_num == 0:
+                total_rows = int(row[0])
+                total_cols = int(row[1])
+                arr = [["" for i in range(total_cols)] for j in range(total_rows)]
+            else:
+                for col_num, col_entry in enumerate(row[:-1]):
+                    arr[row_num - 1][col_num] = col_entry
 
 def make_svg(file_name, maze_rows, maze_cols, maze_arr, bool_draw_path):
     """
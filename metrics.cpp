@@ -0,0 +1,183 @@
+/*metrics.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Metrics
+ * 
+ * Compile-time switchable counters, high-water marks and scoped timers for the generators, 
+ * solvers and writers, summarized at exit
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "metrics.h"
+
+#ifdef DO_METRICS
+
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+
+thread_local ThreadMetrics t_threadMetrics = {};
+
+// Totals of every thread that has exited
+static ThreadMetrics s_totalMetrics = {};
+static std::mutex s_totalMetricsMutex;
+
+// Whether the calling thread's metrics are already in the totals
+static thread_local bool t_isMetricsMerged = false;
+
+static const char* const METRIC_COUNTER_NAMES[NUM_METRIC_COUNTERS] = {
+    "walks", "walk steps", "erased walk steps", "parallel loop erasures", "walk collisions", \
+    "tremaux steps", "junction visits", "backtracks", "backtrack steps", "aldous-broder steps"
+};
+static const char* const METRIC_MAXIMUM_NAMES[NUM_METRIC_MAXIMUMS] = {
+    "tremaux stack high-water mark"
+};
+static const char* const METRIC_TIMER_NAMES[NUM_METRIC_TIMERS] = {
+    "wilson", "parallel wilson", "eller", "sidewinder", "kruskal", "backtracker", "solve", "write", "render"
+};
+
+/**--------------------------------------------------------------------------------------
+ * addMetrics()
+ * 
+ * Adds one set of metrics to another, keeping the higher of each high-water mark
+ * 
+ * @param[in,out]   total   Metrics to add to
+ * @param[in]       metrics Metrics to add
+ * --------------------------------------------------------------------------------------
+*/
+void addMetrics(ThreadMetrics& total, const ThreadMetrics& metrics)
+{
+    for(int counter = 0; counter < NUM_METRIC_COUNTERS; counter++)
+    {
+        total.counters[counter] += metrics.counters[counter];
+    }
+    for(int maximum = 0; maximum < NUM_METRIC_MAXIMUMS; maximum++)
+    {
+        if(metrics.maximums[maximum] > total.maximums[maximum])
+        {
+            total.maximums[maximum] = metrics.maximums[maximum];
+        }
+    }
+    for(int timer = 0; timer < NUM_METRIC_TIMERS; timer++)
+    {
+        total.timerNanoseconds[timer] += metrics.timerNanoseconds[timer];
+        total.timerCalls[timer] += metrics.timerCalls[timer];
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * MetricsThreadMerger struct
+ * 
+ * Adds its thread's metrics to the totals when the thread exits
+ * --------------------------------------------------------------------------------------
+*/
+struct MetricsThreadMerger
+{
+    ~MetricsThreadMerger()
+    {
+        std::lock_guard<std::mutex> lock(s_totalMetricsMutex);
+        addMetrics(s_totalMetrics, t_threadMetrics);
+        t_isMetricsMerged = true;
+    }
+};
+
+/**--------------------------------------------------------------------------------------
+ * registerMetricsThread()
+ * 
+ * Makes sure the calling thread's metrics are added to the totals when it exits
+ *     Called by every ScopedMetricTimer, so a thread that counts inside a timed stage is 
+ *     always registered. Worker threads that count outside of one call it through 
+ *     METRIC_REGISTER_THREAD()
+ * --------------------------------------------------------------------------------------
+*/
+void registerMetricsThread()
+{
+    static thread_local MetricsThreadMerger merger;
+    (void)merger;
+}
+
+/**--------------------------------------------------------------------------------------
+ * printMetricsSummary()
+ * 
+ * Prints the totals of every thread that has exited, and of the calling thread so far
+ * 
+ * @param[in,out] outfile Stream to print to
+ * --------------------------------------------------------------------------------------
+*/
+void printMetricsSummary(std::ostream& outfile)
+{
+    ThreadMetrics total;
+    {
+        std::lock_guard<std::mutex> lock(s_totalMetricsMutex);
+        total = s_totalMetrics;
+    }
+    if(!t_isMetricsMerged)
+    {
+        addMetrics(total, t_threadMetrics);
+    }
+
+    outfile << "Metrics summary:\n";
+    for(int counter = 0; counter < NUM_METRIC_COUNTERS; counter++)
+    {
+        outfile << "    " << METRIC_COUNTER_NAMES[counter] << ": " << total.counters[counter] << "\n";
+    }
+    for(int maximum = 0; maximum < NUM_METRIC_MAXIMUMS; maximum++)
+    {
+        outfile << "    " << METRIC_MAXIMUM_NAMES[maximum] << ": " << total.maximums[maximum] << "\n";
+    }
+
+    char milliseconds[32];
+    for(int timer = 0; timer < NUM_METRIC_TIMERS; timer++)
+    {
+        if(total.timerCalls[timer] > 0)
+        {
+            std::snprintf(milliseconds, sizeof(milliseconds), "%.3f", total.timerNanoseconds[timer] / 1e6);
+            outfile << "    " << METRIC_TIMER_NAMES[timer] << " time: " << milliseconds << " ms over " << total.timerCalls[timer] << " calls\n";
+        }
+    }
+    outfile << std::flush;
+}
+
+/**--------------------------------------------------------------------------------------
+ * MetricsSummaryAtExit struct
+ * 
+ * Prints the summary to stderr when the program exits
+ *     Static objects are destroyed after the main thread's thread_local objects, so the 
+ *     main thread's metrics are already in the totals by then
+ * --------------------------------------------------------------------------------------
+*/
+struct MetricsSummaryAtExit
+{
+    ~MetricsSummaryAtExit()
+    {
+        printMetricsSummary(std::cerr);
+    }
+};
+
+static MetricsSummaryAtExit s_metricsSummaryAtExit;
+
+#endif
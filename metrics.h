@@ -0,0 +1,155 @@
+/*metrics.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Metrics
+ * 
+ * Compile-time switchable counters, high-water marks and scoped timers for the generators, 
+ * solvers and writers, summarized at exit
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+/**
+ * Metrics are compiled in with -DDO_METRICS, like LOG_DEBUG with -DDO_DEBUG
+ *     Without it every METRIC_ macro is empty, so instrumented code costs nothing
+ *     With it each thread counts into its own thread_local ThreadMetrics, which is added 
+ *     to the process totals when the thread exits, and the totals are printed to stderr 
+ *     when the program exits
+*/
+#ifdef DO_METRICS
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Counters
+const int METRIC_WALKS = 0;             // Random walks started by Wilson's Algorithm
+const int METRIC_WALK_STEPS = 1;        // Random walk steps
+const int METRIC_ERASED_STEPS = 2;      // Random walk steps erased by loops
+const int METRIC_PARALLEL_LOOP_ERASURES = 3; // Loops erased by the parallel walks, the sequential walks overwrite theirs unseen
+const int METRIC_WALK_COLLISIONS = 4;   // Parallel walks given up after running into another walk
+const int METRIC_TREMAUX_STEPS = 5;     // Cells entered by Tremaux's Algorithm
+const int METRIC_JUNCTION_VISITS = 6;   // Junctions entered by Tremaux's Algorithm
+const int METRIC_BACKTRACKS = 7;        // Calls to backTrack()
+const int METRIC_BACKTRACK_STEPS = 8;   // Cells popped off the Tremaux stack while backtracking
+const int METRIC_ALDOUS_BRODER_STEPS = 9; // Aldous-Broder steps taken before Wilson's Algorithm
+const int NUM_METRIC_COUNTERS = 10;
+
+// High-water marks
+const int METRIC_TREMAUX_STACK_MAX = 0; // Deepest the Tremaux stack got
+const int NUM_METRIC_MAXIMUMS = 1;
+
+// Timers
+const int METRIC_WILSON_TIMER = 0;
+const int METRIC_PARALLEL_WILSON_TIMER = 1;
+const int METRIC_ELLER_TIMER = 2;
+const int METRIC_SIDEWINDER_TIMER = 3;
+const int METRIC_KRUSKAL_TIMER = 4;
+const int METRIC_BACKTRACKER_TIMER = 5;
+const int METRIC_SOLVE_TIMER = 6;
+const int METRIC_WRITE_TIMER = 7;
+const int METRIC_RENDER_TIMER = 8;
+const int NUM_METRIC_TIMERS = 9;
+
+/**--------------------------------------------------------------------------------------
+ * ThreadMetrics struct
+ * 
+ * Every counter, high-water mark and timer of one thread
+ *     Plain data, so thread_local instances are zeroed without any guard on each access
+ * --------------------------------------------------------------------------------------
+*/
+struct ThreadMetrics
+{
+    std::uint64_t counters[NUM_METRIC_COUNTERS];
+    std::uint64_t maximums[NUM_METRIC_MAXIMUMS];
+    std::uint64_t timerNanoseconds[NUM_METRIC_TIMERS];
+    std::uint64_t timerCalls[NUM_METRIC_TIMERS];
+};
+
+extern thread_local ThreadMetrics t_threadMetrics;
+
+/**--------------------------------------------------------------------------------------
+ * registerMetricsThread()
+ * 
+ * Makes sure the calling thread's metrics are added to the totals when it exits
+ *     Called by every ScopedMetricTimer, so a thread that counts inside a timed stage is 
+ *     always registered. Worker threads that count outside of one call it through 
+ *     METRIC_REGISTER_THREAD()
+ * --------------------------------------------------------------------------------------
+*/
+void registerMetricsThread();
+
+/**--------------------------------------------------------------------------------------
+ * printMetricsSummary()
+ * 
+ * Prints the totals of every thread that has exited, and of the calling thread so far
+ * 
+ * @param[in,out] outfile Stream to print to
+ * --------------------------------------------------------------------------------------
+*/
+void printMetricsSummary(std::ostream& outfile);
+
+/**--------------------------------------------------------------------------------------
+ * ScopedMetricTimer class
+ * 
+ * Adds the time from its construction to its destruction to a timer of the calling thread
+ * --------------------------------------------------------------------------------------
+*/
+class ScopedMetricTimer
+{
+public:
+    explicit ScopedMetricTimer(int timer) : m_timer(timer), m_startTime(std::chrono::steady_clock::now())
+    {
+        registerMetricsThread();
+    }
+
+    ~ScopedMetricTimer()
+    {
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - m_startTime;
+        t_threadMetrics.timerNanoseconds[m_timer] += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        t_threadMetrics.timerCalls[m_timer]++;
+    }
+
+    ScopedMetricTimer(const ScopedMetricTimer&) = delete;
+    ScopedMetricTimer& operator=(const ScopedMetricTimer&) = delete;
+
+private:
+    int m_timer;
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+#define METRIC_ADD(counter, amount) t_threadMetrics.counters[counter] += (amount);
+#define METRIC_MAX(maximum, value) do { if(static_cast<std::uint64_t>(value) > t_threadMetrics.maximums[maximum]) { t_threadMetrics.maximums[maximum] = static_cast<std::uint64_t>(value); } } while(0);
+#define METRIC_TIMER(timer) ScopedMetricTimer scopedMetricTimer(timer);
+#define METRIC_REGISTER_THREAD() registerMetricsThread();
+#else
+#define METRIC_ADD(counter, amount)
+#define METRIC_MAX(maximum, value)
+#define METRIC_TIMER(timer)
+#define METRIC_REGISTER_THREAD()
+#endif
@@ -0,0 +1,514 @@
+/*parallelWilson.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Parallel Wilson's Algorithm
+ * 
+ * Given an empty (blank) maze, uses loop-erased random walks on several threads at once
+ * to fill out the maze in an unbiased manner
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "parallelWilson.h"
+#include "wilson.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "metrics.h"
+#include "rng.h"
+
+// Claim values of a cell, any other value is the stamp of the walker that owns the cell
+const std::uint32_t FREE_CLAIM = 0;
+const std::uint32_t TREE_CLAIM = 0xFFFFFFFFu;
+
+// How long a walker waits on a cell owned by another walker before giving up its walk
+const int MAX_COLLISION_SPINS = 64;
+
+/**--------------------------------------------------------------------------------------
+ * CyclePoppingGrid struct
+ * 
+ * State shared by every thread of runParallelWilson()
+ *     claims: per cell, FREE_CLAIM, TREE_CLAIM, or the stamp of the walker owning it
+ *     popCounts: per cell, how many directions have been popped off its stack, only 
+ *     read or written by the walker owning the cell
+ * --------------------------------------------------------------------------------------
+*/
+struct CyclePoppingGrid
+{
+	int numRows;
+	int numCols;
+	std::uint64_t seed;
+	std::size_t rootIndex;
+	std::vector<std::atomic<std::uint32_t>> claims;
+	std::vector<std::uint32_t> popCounts;
+
+	CyclePoppingGrid(int uRows, int uCols, std::uint64_t uSeed, std::size_t uRootIndex)
+		: numRows(uRows), numCols(uCols), seed(uSeed), rootIndex(uRootIndex),
+		  claims(static_cast<std::size_t>(uRows) * static_cast<std::size_t>(uCols)),
+		  popCounts(static_cast<std::size_t>(uRows) * static_cast<std::size_t>(uCols), 0)
+	{}
+};
+
+
+
+/**--------------------------------------------------------------------------------------
+ * stackDirection()
+ * 
+ * Returns the direction on top of a cell's direction stack, after popCount pops
+ *     The direction is a hash of the seed, the cell index and popCount, the same as 
+ *     drawing from SplitMix64 at that position, so no stack is ever stored
+ *     Directions are uniform over the neighbors of the cell
+ * 
+ * @param[in] grid		Shared cycle popping state
+ * @param[in] row		Row index of the cell
+ * @param[in] col		Column index of the cell
+ * @param[in] cellIndex	Row-major index of the cell
+ * @param[in] popCount	Number of directions popped off the cell's stack
+ * @return an int representing the cardinal direction on top of the stack
+ * --------------------------------------------------------------------------------------
+*/
+int stackDirection(const CyclePoppingGrid& grid, int row, int col, std::size_t cellIndex, std::uint32_t popCount)
+{
+	std::uint64_t hash = grid.seed + ((static_cast<std::uint64_t>(cellIndex) << 32) | popCount) * 0x9E3779B97F4A7C15ULL;
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+	hash ^= hash >> 31;
+
+	if(row > 0 && row < grid.numRows - 1 && col > 0 && col < grid.numCols - 1)
+	{
+		// Interior cell, every direction leads to a valid cell
+		return static_cast<int>(hash >> 62);
+	}
+
+	// Border cell, draw from the directions that lead to a valid cell
+	int validDirs[4];
+	int numValidDirs = 0;
+	if(row != 0)
+	{
+		validDirs[numValidDirs++] = Maze::NORTH_DIRECTION;
+	}
+	if(row != grid.numRows - 1)
+	{
+		validDirs[numValidDirs++] = Maze::SOUTH_DIRECTION;
+	}
+	if(col != grid.numCols - 1)
+	{
+		validDirs[numValidDirs++] = Maze::EAST_DIRECTION;
+	}
+	if(col != 0)
+	{
+		validDirs[numValidDirs++] = Maze::WEST_DIRECTION;
+	}
+
+	return validDirs[((hash >> 32) * static_cast<std::uint64_t>(numValidDirs)) >> 32];
+}
+
+
+
+/**--------------------------------------------------------------------------------------
+ * claimCell()
+ * 
+ * Tries to claim a cell for a walker
+ *     If another walker owns the cell, waits a while for it to either join the tree or 
+ *     let the cell go
+ * 
+ * @param[in,out]	grid		Shared cycle popping state
+ * @param[in]		cellIndex	Row-major index of the cell
+ * @param[in]		stamp		Stamp of the walker
+ * @return stamp if the walker now owns the cell, TREE_CLAIM if the cell is in the tree, 
+ * or the stamp of the walker still owning it
+ * --------------------------------------------------------------------------------------
+*/
+std::uint32_t claimCell(CyclePoppingGrid& grid, std::size_t cellIndex, std::uint32_t stamp)
+{
+	std::uint32_t claim = grid.claims[cellIndex].load(std::memory_order_acquire);
+	for(int spin = 0; spin < MAX_COLLISION_SPINS; spin++)
+	{
+		if(claim == TREE_CLAIM)
+		{
+			return TREE_CLAIM;
+		}
+
+		if(claim == FREE_CLAIM)
+		{
+			if(grid.claims[cellIndex].compare_exchange_weak(claim, stamp, std::memory_order_acquire, std::memory_order_acquire))
+			{
+				return stamp;
+			}
+		}
+		else
+		{
+			std::this_thread::yield();
+			claim = grid.claims[cellIndex].load(std::memory_order_acquire);
+		}
+	}
+
+	return claim;
+}
+
+
+
+/**--------------------------------------------------------------------------------------
+ * walkToTree()
+ * 
+ * Performs a loop-erased random walk from a cell until it reaches the tree, then adds the 
+ * loop-erased path to the tree
+ *     The walk follows the top direction of each cell's stack, and pops the stacks of 
+ *     every cell on a loop when erasing it
+ *     If the walk runs into a cell owned by another walker, it lets go of its whole path 
+ *     and gives up. Every pop it made stays popped, so retrying the walk later retraces 
+ *     the same path without any new random directions
+ * 
+ * @param[in,out]	grid		Shared cycle popping state
+ * @param[in]		startIndex	Row-major index of cell from which to start the walk
+ * @param[in]		stamp		Stamp of the walker, unique to the thread
+ * @param[in,out]	path		Scratch space for the loop-erased path, reused across walks
+ * @param[in,out]	numSteps	Number of random walk steps taken, incremented by this walk
+ * @return true if the starting cell is in the tree, false if the walk gave up
+ * --------------------------------------------------------------------------------------
+*/
+bool walkToTree(CyclePoppingGrid& grid, std::size_t startIndex, std::uint32_t stamp, std::vector<std::size_t>& path, std::uint64_t& numSteps)
+{
+	std::uint32_t claim = claimCell(grid, startIndex, stamp);
+	if(claim != stamp)
+	{
+		return claim == TREE_CLAIM;
+	}
+
+	path.clear();
+	path.push_back(startIndex);
+	METRIC_ADD(METRIC_WALKS, 1)
+
+	std::size_t curIndex = startIndex;
+	int curRow = static_cast<int>(startIndex / static_cast<std::size_t>(grid.numCols));
+	int curCol = static_cast<int>(startIndex % static_cast<std::size_t>(grid.numCols));
+
+	while(true)
+	{
+		int nextRow = curRow;
+		int nextCol = curCol;
+		std::size_t nextIndex = curIndex;
+		switch(stackDirection(grid, curRow, curCol, curIndex, grid.popCounts[curIndex]))
+		{
+			case Maze::NORTH_DIRECTION:	// Move North
+				nextRow -= 1;
+				nextIndex -= static_cast<std::size_t>(grid.numCols);
+				break;
+			case Maze::SOUTH_DIRECTION:	// Move South
+				nextRow += 1;
+				nextIndex += static_cast<std::size_t>(grid.numCols);
+				break;
+			case Maze::EAST_DIRECTION:	// Move East
+				nextCol += 1;
+				nextIndex += 1;
+				break;
+			default:					// Move West
+				nextCol -= 1;
+				nextIndex -= 1;
+				break;
+		}
+		numSteps++;
+
+		// Only this walker ever writes its own stamp, so a relaxed load is enough to spot a loop
+		if(grid.claims[nextIndex].load(std::memory_order_relaxed) == stamp)
+		{
+			// Erasing the loop, every cell on it gets the next direction on its stack
+			METRIC_ADD(METRIC_PARALLEL_LOOP_ERASURES, 1)
+			while(path.back() != nextIndex)
+			{
+				grid.popCounts[path.back()]++;
+				grid.claims[path.back()].store(FREE_CLAIM, std::memory_order_release);
+				path.pop_back();
+			}
+			grid.popCounts[nextIndex]++;
+		}
+		else
+		{
+			claim = claimCell(grid, nextIndex, stamp);
+			if(claim == TREE_CLAIM)
+			{
+				// Reached the tree, the directions on the path are final
+				for(std::size_t i = path.size(); i-- > 0;)
+				{
+					grid.claims[path[i]].store(TREE_CLAIM, std::memory_order_release);
+				}
+				return true;
+			}
+			else if(claim != stamp)
+			{
+				// Ran into another walker, giving up the path
+				METRIC_ADD(METRIC_WALK_COLLISIONS, 1)
+				for(std::size_t pathIndex : path)
+				{
+					grid.claims[pathIndex].store(FREE_CLAIM, std::memory_order_release);
+				}
+				return false;
+			}
+			path.push_back(nextIndex);
+		}
+
+		curIndex = nextIndex;
+		curRow = nextRow;
+		curCol = nextCol;
+	}
+}
+
+
+
+/**--------------------------------------------------------------------------------------
+ * runCyclePoppingWorker()
+ * 
+ * Body of one thread in runParallelWilson(), starts a walk from every cell in its band of 
+ * rows that is not in the tree yet
+ *     Walks that give up are retried after the band is done, for as long as retrying 
+ *     still gets walks through. Walks that never get through are left to the caller
+ * 
+ * @param[in,out]	grid		Shared cycle popping state
+ * @param[in]		rowBegin	First row of the band
+ * @param[in]		rowEnd		One past the last row of the band
+ * @param[in]		stamp		Stamp of the walker, unique to the thread
+ * @param[out]		leftovers	Starting cells of the walks that never got through
+ * @param[out]		numSteps	Number of random walk steps taken by the thread
+ * --------------------------------------------------------------------------------------
+*/
+void runCyclePoppingWorker(CyclePoppingGrid& grid, int rowBegin, int rowEnd, std::uint32_t stamp, std::vector<std::size_t>& leftovers, std::uint64_t& numSteps)
+{
+	METRIC_REGISTER_THREAD()
+	std::vector<std::size_t> path;
+	std::vector<std::size_t> retries;
+	std::uint64_t workerSteps = 0;
+
+	std::size_t bandEnd = static_cast<std::size_t>(rowEnd) * static_cast<std::size_t>(grid.numCols);
+	for(std::size_t startIndex = static_cast<std::size_t>(rowBegin) * static_cast<std::size_t>(grid.numCols); startIndex < bandEnd; startIndex++)
+	{
+		if(!walkToTree(grid, startIndex, stamp, path, workerSteps))
+		{
+			retries.push_back(startIndex);
+		}
+	}
+
+	bool madeProgress = true;
+	while(!retries.empty() && madeProgress)
+	{
+		madeProgress = false;
+		leftovers.clear();
+		for(std::size_t startIndex : retries)
+		{
+			if(walkToTree(grid, startIndex, stamp, path, workerSteps))
+			{
+				madeProgress = true;
+			}
+			else
+			{
+				leftovers.push_back(startIndex);
+			}
+		}
+		retries.swap(leftovers);
+	}
+
+	leftovers.swap(retries);
+	numSteps = workerSteps;
+}
+
+
+
+/**--------------------------------------------------------------------------------------
+ * openTreeWallsInRows()
+ * 
+ * Opens every wall of the finished tree that lies in a band of rows, and updates the exits 
+ * of the cells in the band
+ *     Only writes to the band's own cells and walls, so bands can be done side by side
+ * 
+ * @param[in,out]	blankMaze	Maze to open the walls of
+ * @param[in]		grid		Cycle popping state where every cell is in the tree
+ * @param[in]		rowBegin	First row of the band
+ * @param[in]		rowEnd		One past the last row of the band
+ * --------------------------------------------------------------------------------------
+*/
+void openTreeWallsInRows(Maze& blankMaze, const CyclePoppingGrid& grid, int rowBegin, int rowEnd)
+{
+	// Final direction of a cell, the root has none
+	auto treeDirection = [&grid](int row, int col) -> int
+	{
+		std::size_t cellIndex = static_cast<std::size_t>(row) * static_cast<std::size_t>(grid.numCols) + static_cast<std::size_t>(col);
+		if(cellIndex == grid.rootIndex)
+		{
+			return Maze::INVALID_CARDINAL_DIRECTION;
+		}
+		return stackDirection(grid, row, col, cellIndex, grid.popCounts[cellIndex]);
+	};
+
+	for(int row = rowBegin; row < rowEnd; row++)
+	{
+		for(int col = 0; col < grid.numCols; col++)
+		{
+			int myDir = treeDirection(row, col);
+			bool northOpen = (myDir == Maze::NORTH_DIRECTION) || (row > 0 && treeDirection(row - 1, col) == Maze::SOUTH_DIRECTION);
+			bool southOpen = (myDir == Maze::SOUTH_DIRECTION) || (row < grid.numRows - 1 && treeDirection(row + 1, col) == Maze::NORTH_DIRECTION);
+			bool eastOpen = (myDir == Maze::EAST_DIRECTION) || (col < grid.numCols - 1 && treeDirection(row, col + 1) == Maze::WEST_DIRECTION);
+			bool westOpen = (myDir == Maze::WEST_DIRECTION) || (col > 0 && treeDirection(row, col - 1) == Maze::EAST_DIRECTION);
+
+			if(northOpen)
+			{
+				blankMaze.updateCellExits(row, col, Maze::NORTH_DIRECTION);
+			}
+			if(southOpen)
+			{
+				blankMaze.updateCellExits(row, col, Maze::SOUTH_DIRECTION);
+				blankMaze.openWall(row, col, Maze::SOUTH_DIRECTION);
+			}
+			if(eastOpen)
+			{
+				blankMaze.updateCellExits(row, col, Maze::EAST_DIRECTION);
+				blankMaze.openWall(row, col, Maze::EAST_DIRECTION);
+			}
+			if(westOpen)
+			{
+				blankMaze.updateCellExits(row, col, Maze::WEST_DIRECTION);
+			}
+		}
+	}
+}
+
+
+
+/**--------------------------------------------------------------------------------------
+ * runParallelWilson()
+ * 
+ * Given an "empty" maze with no passageways, entrances, or exits fills it out with a 
+ * uniform spanning tree, using numThreads threads
+ *     Works by cycle popping (Propp and Wilson, 1998), the view of Wilson's Algorithm in 
+ *     which every cell has its own endless stack of random directions and a loop-erased 
+ *     walk pops the top direction of every cell on each loop it erases
+ *     The k-th direction on a cell's stack is a hash of the seed, the cell and k, so the 
+ *     stacks exist without being stored. Whatever order cycles are popped in, the cells 
+ *     end up pointing along the same tree, which is the first spanning tree on the stacks
+ *     Threads run loop-erased walks side by side, each claiming the cells on its current 
+ *     path. A walk only pops cycles made entirely of cells it owns, so every pop is one a 
+ *     single-threaded run could also have made
+ * 
+ * Distribution guarantees:
+ *     Every spanning tree of the grid is equally likely, exactly as with runWilson(), up 
+ *     to the quality of the hash standing in for the direction stacks
+ *     The maze depends only on the engine state, never on numThreads or on how the 
+ *     threads are scheduled
+ *     It is not the same maze runWilson() makes from the same engine state, since the 
+ *     random directions are drawn differently
+ * 
+ * @param[in,out] blankMaze "empty" Maze object containing no passageways, entrances or 
+ * exits, updates the Maze object so that every cell in the grid is connected to each 
+ * other, and an entrance and exit cell both exist
+ * @param[in,out] rng Random number engine used for the root, the hash seed, and the 
+ * entrance and exit
+ * @param[in] numThreads Number of threads to walk with, at least 1
+ * @return the total number of random walk steps taken to fill out the maze
+ * 
+ * Instantiated in parallelWilson.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runParallelWilson(Maze& blankMaze, RngEngine& rng, int numThreads)
+{
+	METRIC_TIMER(METRIC_PARALLEL_WILSON_TIMER)
+	int numRows = blankMaze.getROWCELLS();
+	int numCols = blankMaze.getCOLCELLS();
+	if(numThreads < 1)
+	{
+		numThreads = 1;
+	}
+
+	// Setting random cell as the root of the tree
+	int rootRow = static_cast<int>(randomBelow(rng, numRows));
+	int rootCol = static_cast<int>(randomBelow(rng, numCols));
+	std::uint64_t seed = (static_cast<std::uint64_t>(randomBits32(rng)) << 32) | randomBits32(rng);
+
+	CyclePoppingGrid grid(numRows, numCols, seed, static_cast<std::size_t>(rootRow) * static_cast<std::size_t>(numCols) + static_cast<std::size_t>(rootCol));
+	grid.claims[grid.rootIndex].store(TREE_CLAIM, std::memory_order_relaxed);
+
+	// Every thread starts walks from its own band of rows, the calling thread takes band 0
+	std::vector<std::vector<std::size_t>> leftovers(numThreads);
+	std::vector<std::uint64_t> threadSteps(numThreads, 0);
+	std::vector<std::thread> workers;
+	for(int worker = 1; worker < numThreads; worker++)
+	{
+		workers.emplace_back(runCyclePoppingWorker, std::ref(grid), worker * numRows / numThreads, (worker + 1) * numRows / numThreads, \
+							 static_cast<std::uint32_t>(worker + 1), std::ref(leftovers[worker]), std::ref(threadSteps[worker]));
+	}
+	runCyclePoppingWorker(grid, 0, numRows / numThreads, 1, leftovers[0], threadSteps[0]);
+	for(std::thread& workerThread : workers)
+	{
+		workerThread.join();
+	}
+
+	// Walks that kept running into each other, finished on one thread where nothing can get in the way
+	std::vector<std::size_t> path;
+	std::uint64_t numWalkSteps = 0;
+	for(const std::vector<std::size_t>& workerLeftovers : leftovers)
+	{
+		for(std::size_t startIndex : workerLeftovers)
+		{
+			if(!walkToTree(grid, startIndex, 1, path, numWalkSteps))
+			{
+				std::cerr << "ERROR: Parallel Wilson's Algorithm could not add cell " << startIndex << " to the maze" << std::endl;
+			}
+		}
+	}
+	for(std::uint64_t steps : threadSteps)
+	{
+		numWalkSteps += steps;
+	}
+
+	// Every step that did not add a cell to the tree was erased by a loop or given up
+	METRIC_ADD(METRIC_WALK_STEPS, numWalkSteps)
+	METRIC_ADD(METRIC_ERASED_STEPS, numWalkSteps - (blankMaze.getNumCells() - 1))
+
+	// Opening the walls of the tree, a band of rows per thread
+	workers.clear();
+	for(int worker = 1; worker < numThreads; worker++)
+	{
+		workers.emplace_back(openTreeWallsInRows, std::ref(blankMaze), std::cref(grid), worker * numRows / numThreads, (worker + 1) * numRows / numThreads);
+	}
+	openTreeWallsInRows(blankMaze, grid, 0, numRows / numThreads);
+	for(std::thread& workerThread : workers)
+	{
+		workerThread.join();
+	}
+
+	createEntranceAndExit(blankMaze, rng);
+
+	return numWalkSteps;
+}
+
+// Explicit instantiations for the engines in rng.h
+template std::uint64_t runParallelWilson<SplitMix64>(Maze& blankMaze, SplitMix64& rng, int numThreads);
+template std::uint64_t runParallelWilson<Xoshiro256StarStar>(Maze& blankMaze, Xoshiro256StarStar& rng, int numThreads);
+template std::uint64_t runParallelWilson<Pcg32>(Maze& blankMaze, Pcg32& rng, int numThreads);
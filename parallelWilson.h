@@ -0,0 +1,77 @@
+/*parallelWilson.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Parallel Wilson's Algorithm
+ * 
+ * Given an empty (blank) maze, uses loop-erased random walks on several threads at once
+ * to fill out the maze in an unbiased manner
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "maze.h"
+#include "rng.h"
+
+#include <cstdint>
+
+/**--------------------------------------------------------------------------------------
+ * runParallelWilson()
+ * 
+ * Given an "empty" maze with no passageways, entrances, or exits fills it out with a 
+ * uniform spanning tree, using numThreads threads
+ *     Works by cycle popping (Propp and Wilson, 1998), the view of Wilson's Algorithm in 
+ *     which every cell has its own endless stack of random directions and a loop-erased 
+ *     walk pops the top direction of every cell on each loop it erases
+ *     The k-th direction on a cell's stack is a hash of the seed, the cell and k, so the 
+ *     stacks exist without being stored. Whatever order cycles are popped in, the cells 
+ *     end up pointing along the same tree, which is the first spanning tree on the stacks
+ *     Threads run loop-erased walks side by side, each claiming the cells on its current 
+ *     path. A walk only pops cycles made entirely of cells it owns, so every pop is one a 
+ *     single-threaded run could also have made
+ * 
+ * Distribution guarantees:
+ *     Every spanning tree of the grid is equally likely, exactly as with runWilson(), up 
+ *     to the quality of the hash standing in for the direction stacks
+ *     The maze depends only on the engine state, never on numThreads or on how the 
+ *     threads are scheduled
+ *     It is not the same maze runWilson() makes from the same engine state, since the 
+ *     random directions are drawn differently
+ * 
+ * @param[in,out] blankMaze "empty" Maze object containing no passageways, entrances or 
+ * exits, updates the Maze object so that every cell in the grid is connected to each 
+ * other, and an entrance and exit cell both exist
+ * @param[in,out] rng Random number engine used for the root, the hash seed, and the 
+ * entrance and exit
+ * @param[in] numThreads Number of threads to walk with, at least 1
+ * @return the total number of random walk steps taken to fill out the maze
+ * 
+ * Instantiated in parallelWilson.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runParallelWilson(Maze& blankMaze, RngEngine& rng, int numThreads);
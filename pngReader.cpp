@@ -0,0 +1,722 @@
+/*pngReader.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * PNG reader
+ * 
+ * Dependency-free PNG decoding for loading scanned and rendered maze images: a deflate
+ * decompressor and a decoder of every non-interlaced png color type
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pngReader.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+/**
+ * Base values and numbers of extra bits of the deflate length codes 257 to 285 and 
+ * distance codes 0 to 29
+*/
+const int NUM_INFLATE_LENGTH_CODES = 29;
+const int INFLATE_LENGTH_BASES[NUM_INFLATE_LENGTH_CODES] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, \
+                                                             35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const int INFLATE_LENGTH_EXTRA_BITS[NUM_INFLATE_LENGTH_CODES] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, \
+                                                                  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const int NUM_INFLATE_DISTANCE_CODES = 30;
+const int INFLATE_DISTANCE_BASES[NUM_INFLATE_DISTANCE_CODES] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, \
+                                                                 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const int INFLATE_DISTANCE_EXTRA_BITS[NUM_INFLATE_DISTANCE_CODES] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, \
+                                                                      7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+// Order the lengths of the code length code are stored in
+const int CODE_LENGTH_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+// Largest image decoded, so the RGB pixels stay under 1 GiB
+const std::uint64_t MAX_PNG_DECODER_PIXELS = std::uint64_t(1) << 28;
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates an inflater with the tables of the fixed Huffman codes built
+ * --------------------------------------------------------------------------------------
+*/
+PngInflater::PngInflater()
+    : m_input(nullptr), m_inputEnd(nullptr), m_bitBuffer(0), m_numBits(0), m_numPaddingBytes(0), m_output(nullptr), m_outputPos(0), m_outputSize(0)
+{
+    std::uint8_t codeLengths[NUM_LITERAL_LENGTH_SYMBOLS];
+    std::fill(codeLengths, codeLengths + 144, 8);
+    std::fill(codeLengths + 144, codeLengths + 256, 9);
+    std::fill(codeLengths + 256, codeLengths + 280, 7);
+    std::fill(codeLengths + 280, codeLengths + NUM_LITERAL_LENGTH_SYMBOLS, 8);
+    buildTable(codeLengths, NUM_LITERAL_LENGTH_SYMBOLS, m_fixedLiteralLengths);
+
+    std::fill(codeLengths, codeLengths + NUM_DISTANCE_SYMBOLS, 5);
+    buildTable(codeLengths, NUM_DISTANCE_SYMBOLS, m_fixedDistances);
+}
+
+/**--------------------------------------------------------------------------------------
+ * buildTable()
+ * 
+ * Builds the lookup table of a canonical Huffman code from its code lengths
+ *     Codes are stored most significant bit first but read least significant bit first, 
+ *     so each code is reversed, and repeated for every value of the bits after it
+ *     Incomplete codes are allowed, the bits they leave out start no code
+ * 
+ * @param[in]   codeLengths Code length of each symbol, 0 for symbols not in the code
+ * @param[in]   numSymbols  Number of symbols
+ * @param[out]  table       Lookup table of the code
+ * @return false if the code lengths are over-subscribed
+ * --------------------------------------------------------------------------------------
+*/
+bool PngInflater::buildTable(const std::uint8_t* codeLengths, int numSymbols, HuffmanTable& table)
+{
+    int lengthCounts[MAX_CODE_LENGTH + 1] = { 0 };
+    for(int symbol = 0; symbol < numSymbols; symbol++)
+    {
+        lengthCounts[codeLengths[symbol]]++;
+    }
+    lengthCounts[0] = 0;
+
+    int numLeft = 1;
+    int longestLength = 0;
+    for(int length = 1; length <= MAX_CODE_LENGTH; length++)
+    {
+        numLeft = (numLeft << 1) - lengthCounts[length];
+        if(numLeft < 0)
+        {
+            return false;
+        }
+        longestLength = lengthCounts[length] ? length : longestLength;
+    }
+
+    // A code with no symbols, only allowed for distances in blocks of literals alone
+    table.numBits = std::max(longestLength, 1);
+    table.entries.assign(std::size_t(1) << table.numBits, 0);
+
+    int nextCodes[MAX_CODE_LENGTH + 1] = { 0 };
+    for(int length = 1, code = 0; length <= MAX_CODE_LENGTH; length++)
+    {
+        code = (code + lengthCounts[length - 1]) << 1;
+        nextCodes[length] = code;
+    }
+
+    for(int symbol = 0; symbol < numSymbols; symbol++)
+    {
+        const int length = codeLengths[symbol];
+        if(length == 0)
+        {
+            continue;
+        }
+
+        int code = nextCodes[length]++;
+        std::size_t reversed = 0;
+        for(int bit = 0; bit < length; bit++)
+        {
+            reversed = (reversed << 1) | ((code >> bit) & 1);
+        }
+        for(std::size_t index = reversed; index < table.entries.size(); index += std::size_t(1) << length)
+        {
+            table.entries[index] = static_cast<std::uint16_t>((symbol << 4) | length);
+        }
+    }
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * decodeSymbol()
+ * 
+ * Decodes the next symbol of the stream with one table lookup
+ * 
+ * @param[in] table Table of the code the symbol is coded with
+ * @return the symbol, or -1 if the bits start no code or the stream ended
+ * --------------------------------------------------------------------------------------
+*/
+int PngInflater::decodeSymbol(const HuffmanTable& table)
+{
+    if(!refill(table.numBits))
+    {
+        return -1;
+    }
+
+    std::uint16_t entry = table.entries[m_bitBuffer & ((std::uint64_t(1) << table.numBits) - 1)];
+    int length = entry & 15;
+    if(length == 0)
+    {
+        return -1;
+    }
+    takeBits(length);
+    return entry >> 4;
+}
+
+/**--------------------------------------------------------------------------------------
+ * inflateStoredBlock()
+ * 
+ * Copies a block stored without compression to the output
+ * 
+ * @return true if the block is valid and fits in the output
+ * --------------------------------------------------------------------------------------
+*/
+bool PngInflater::inflateStoredBlock()
+{
+    // Stored blocks start on a byte boundary
+    takeBits(m_numBits & 7);
+    if(!refill(32))
+    {
+        return false;
+    }
+    std::size_t length = takeBits(16);
+    std::size_t lengthComplement = takeBits(16);
+    if(hasReadPastEnd() || length != (~lengthComplement & 0xFFFF) || length > m_outputSize - m_outputPos)
+    {
+        return false;
+    }
+
+    // The bytes already in the bit buffer come first, then the rest straight from the input
+    while(length > 0 && m_numBits - 8 * m_numPaddingBytes >= 8)
+    {
+        m_output[m_outputPos++] = static_cast<std::uint8_t>(takeBits(8));
+        length--;
+    }
+    if(length > static_cast<std::size_t>(m_inputEnd - m_input))
+    {
+        return false;
+    }
+    std::memcpy(m_output + m_outputPos, m_input, length);
+    m_input += length;
+    m_outputPos += length;
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * readDynamicTables()
+ * 
+ * Reads the code lengths of a block with dynamic Huffman codes, and builds its tables
+ * 
+ * @return true if the code lengths are valid
+ * --------------------------------------------------------------------------------------
+*/
+bool PngInflater::readDynamicTables()
+{
+    if(!refill(14))
+    {
+        return false;
+    }
+    const int numLiteralLengths = static_cast<int>(takeBits(5)) + 257;
+    const int numDistances = static_cast<int>(takeBits(5)) + 1;
+    const int numCodeLengths = static_cast<int>(takeBits(4)) + 4;
+    if(numLiteralLengths > 286 || numDistances > NUM_INFLATE_DISTANCE_CODES)
+    {
+        return false;
+    }
+
+    std::uint8_t codeLengthLengths[NUM_CODE_LENGTH_SYMBOLS] = { 0 };
+    for(int i = 0; i < numCodeLengths; i++)
+    {
+        if(!refill(3))
+        {
+            return false;
+        }
+        codeLengthLengths[CODE_LENGTH_ORDER[i]] = static_cast<std::uint8_t>(takeBits(3));
+    }
+    if(!buildTable(codeLengthLengths, NUM_CODE_LENGTH_SYMBOLS, m_codeLengths))
+    {
+        return false;
+    }
+
+    // Literal/length and distance code lengths are one run-length coded sequence
+    std::uint8_t codeLengths[NUM_LITERAL_LENGTH_SYMBOLS + NUM_DISTANCE_SYMBOLS] = { 0 };
+    const int numSymbols = numLiteralLengths + numDistances;
+    for(int i = 0; i < numSymbols;)
+    {
+        int symbol = decodeSymbol(m_codeLengths);
+        if(symbol < 0)
+        {
+            return false;
+        }
+        if(symbol < 16)
+        {
+            codeLengths[i++] = static_cast<std::uint8_t>(symbol);
+            continue;
+        }
+
+        std::uint8_t repeatedLength = 0;
+        int numRepeats = 0;
+        if(!refill(7))
+        {
+            return false;
+        }
+        if(symbol == 16)
+        {
+            if(i == 0)
+            {
+                return false;
+            }
+            repeatedLength = codeLengths[i - 1];
+            numRepeats = 3 + static_cast<int>(takeBits(2));
+        }
+        else if(symbol == 17)
+        {
+            numRepeats = 3 + static_cast<int>(takeBits(3));
+        }
+        else
+        {
+            numRepeats = 11 + static_cast<int>(takeBits(7));
+        }
+        if(i + numRepeats > numSymbols)
+        {
+            return false;
+        }
+        std::fill(codeLengths + i, codeLengths + i + numRepeats, repeatedLength);
+        i += numRepeats;
+    }
+
+    // A block must be able to end
+    if(codeLengths[END_OF_BLOCK] == 0)
+    {
+        return false;
+    }
+    return buildTable(codeLengths, numLiteralLengths, m_literalLengths) && \
+           buildTable(codeLengths + numLiteralLengths, numDistances, m_distances);
+}
+
+/**--------------------------------------------------------------------------------------
+ * inflateCodes()
+ * 
+ * Decodes the literals and matches of a compressed block up to its end
+ * 
+ * @param[in] literalLengths    Table of the literal/length code of the block
+ * @param[in] distances         Table of the distance code of the block
+ * @return true if the block is valid and fits in the output
+ * --------------------------------------------------------------------------------------
+*/
+bool PngInflater::inflateCodes(const HuffmanTable& literalLengths, const HuffmanTable& distances)
+{
+    while(true)
+    {
+        int symbol = decodeSymbol(literalLengths);
+        if(symbol < 0)
+        {
+            return false;
+        }
+
+        if(symbol < END_OF_BLOCK)
+        {
+            if(m_outputPos == m_outputSize)
+            {
+                return false;
+            }
+            m_output[m_outputPos++] = static_cast<std::uint8_t>(symbol);
+            continue;
+        }
+        if(symbol == END_OF_BLOCK)
+        {
+            return true;
+        }
+
+        symbol -= END_OF_BLOCK + 1;
+        if(symbol >= NUM_INFLATE_LENGTH_CODES || !refill(INFLATE_LENGTH_EXTRA_BITS[symbol]))
+        {
+            return false;
+        }
+        std::size_t length = INFLATE_LENGTH_BASES[symbol] + takeBits(INFLATE_LENGTH_EXTRA_BITS[symbol]);
+
+        int distanceSymbol = decodeSymbol(distances);
+        if(distanceSymbol < 0 || distanceSymbol >= NUM_INFLATE_DISTANCE_CODES || !refill(INFLATE_DISTANCE_EXTRA_BITS[distanceSymbol]))
+        {
+            return false;
+        }
+        std::size_t distance = INFLATE_DISTANCE_BASES[distanceSymbol] + takeBits(INFLATE_DISTANCE_EXTRA_BITS[distanceSymbol]);
+        if(distance > m_outputPos || length > m_outputSize - m_outputPos)
+        {
+            return false;
+        }
+
+        // Matches may overlap the bytes they copy, like long runs at distance 1
+        const std::uint8_t* source = m_output + m_outputPos - distance;
+        std::uint8_t* destination = m_output + m_outputPos;
+        for(std::size_t i = 0; i < length; i++)
+        {
+            destination[i] = source[i];
+        }
+        m_outputPos += length;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * inflate()
+ * 
+ * Decompresses a whole zlib stream, which must give exactly numOutput bytes
+ * 
+ * @param[in]   compressed      zlib stream
+ * @param[in]   numCompressed   Number of bytes of the stream
+ * @param[out]  output          Buffer of numOutput bytes
+ * @param[in]   numOutput       Number of bytes the stream decompresses to
+ * @return true if the stream is valid, fills the buffer and has the right checksum
+ * --------------------------------------------------------------------------------------
+*/
+bool PngInflater::inflate(const std::uint8_t* compressed, std::size_t numCompressed, std::uint8_t* output, std::size_t numOutput)
+{
+    // zlib header: deflate with at most a 32K window and no preset dictionary
+    if(numCompressed < 2 || (compressed[0] & 0x0F) != 8 || (compressed[0] >> 4) > 7 || (compressed[1] & 0x20) != 0 || \
+       ((compressed[0] << 8) | compressed[1]) % 31 != 0)
+    {
+        return false;
+    }
+
+    m_input = compressed + 2;
+    m_inputEnd = compressed + numCompressed;
+    m_bitBuffer = 0;
+    m_numBits = 0;
+    m_numPaddingBytes = 0;
+    m_output = output;
+    m_outputPos = 0;
+    m_outputSize = numOutput;
+
+    bool isFinalBlock = false;
+    while(!isFinalBlock)
+    {
+        if(!refill(3))
+        {
+            return false;
+        }
+        isFinalBlock = takeBits(1) != 0;
+
+        bool isValid = false;
+        switch(takeBits(2))
+        {
+            case 0:
+                isValid = inflateStoredBlock();
+                break;
+            case 1:
+                isValid = inflateCodes(m_fixedLiteralLengths, m_fixedDistances);
+                break;
+            case 2:
+                isValid = readDynamicTables() && inflateCodes(m_literalLengths, m_distances);
+                break;
+            default:
+                break;
+        }
+        if(!isValid || hasReadPastEnd())
+        {
+            return false;
+        }
+    }
+
+    if(m_outputPos != m_outputSize)
+    {
+        return false;
+    }
+
+    // Adler-32 of the output, most significant byte first, on the next byte boundary
+    takeBits(m_numBits & 7);
+    if(!refill(32))
+    {
+        return false;
+    }
+    std::uint32_t storedAdler = 0;
+    for(int i = 0; i < 4; i++)
+    {
+        storedAdler = (storedAdler << 8) | takeBits(8);
+    }
+    if(hasReadPastEnd())
+    {
+        return false;
+    }
+
+    // Reduced often enough that neither sum can overflow 32 bits
+    const std::uint32_t ADLER_MODULUS = 65521;
+    const std::size_t ADLER_BLOCK_BYTES = 5552;
+    std::uint32_t adlerLow = 1;
+    std::uint32_t adlerHigh = 0;
+    for(std::size_t blockStart = 0; blockStart < numOutput; blockStart += ADLER_BLOCK_BYTES)
+    {
+        std::size_t blockEnd = std::min(blockStart + ADLER_BLOCK_BYTES, numOutput);
+        for(std::size_t i = blockStart; i < blockEnd; i++)
+        {
+            adlerLow += output[i];
+            adlerHigh += adlerLow;
+        }
+        adlerLow %= ADLER_MODULUS;
+        adlerHigh %= ADLER_MODULUS;
+    }
+    return storedAdler == ((adlerHigh << 16) | adlerLow);
+}
+
+/**--------------------------------------------------------------------------------------
+ * loadBigEndian32()
+ * 
+ * Decodes the 32-bit big-endian integers of png chunks
+ * --------------------------------------------------------------------------------------
+*/
+std::uint32_t loadBigEndian32(const std::uint8_t* bytes)
+{
+    return (static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16) | \
+           (static_cast<std::uint32_t>(bytes[2]) << 8) | static_cast<std::uint32_t>(bytes[3]);
+}
+
+/**--------------------------------------------------------------------------------------
+ * unfilterScanlines()
+ * 
+ * Undoes the filter of every scanline in place, top to bottom, so the row above a 
+ * scanline is always unfiltered by the time it is needed
+ * 
+ * @param[in] rowBytes      Bytes of one scanline, without its filter byte
+ * @param[in] bytesPerPixel Bytes of one pixel, 1 for pixels smaller than a byte
+ * @return false if a scanline has an unknown filter
+ * --------------------------------------------------------------------------------------
+*/
+bool PngDecoder::unfilterScanlines(std::size_t rowBytes, std::size_t bytesPerPixel)
+{
+    const std::uint8_t* previous = nullptr;
+    for(std::uint32_t y = 0; y < m_height; y++)
+    {
+        std::uint8_t* scanline = m_scanlines.data() + y * (rowBytes + 1);
+        std::uint8_t* current = scanline + 1;
+        switch(scanline[0])
+        {
+            case 0:
+                break;
+            case 1:
+                for(std::size_t i = bytesPerPixel; i < rowBytes; i++)
+                {
+                    current[i] = static_cast<std::uint8_t>(current[i] + current[i - bytesPerPixel]);
+                }
+                break;
+            case 2:
+                for(std::size_t i = 0; previous != nullptr && i < rowBytes; i++)
+                {
+                    current[i] = static_cast<std::uint8_t>(current[i] + previous[i]);
+                }
+                break;
+            case 3:
+                for(std::size_t i = 0; i < rowBytes; i++)
+                {
+                    int left = (i >= bytesPerPixel) ? current[i - bytesPerPixel] : 0;
+                    int up = previous ? previous[i] : 0;
+                    current[i] = static_cast<std::uint8_t>(current[i] + ((left + up) >> 1));
+                }
+                break;
+            case 4:
+                for(std::size_t i = 0; i < rowBytes; i++)
+                {
+                    int left = (i >= bytesPerPixel) ? current[i - bytesPerPixel] : 0;
+                    int up = previous ? previous[i] : 0;
+                    int upLeft = (previous && i >= bytesPerPixel) ? previous[i - bytesPerPixel] : 0;
+
+                    // Paeth predictor: whichever neighbor is closest to left + up - upLeft
+                    int leftDistance = std::abs(up - upLeft);
+                    int upDistance = std::abs(left - upLeft);
+                    int upLeftDistance = std::abs(left + up - 2 * upLeft);
+                    int predictor = (leftDistance <= upDistance && leftDistance <= upLeftDistance) ? left : (upDistance <= upLeftDistance) ? up : upLeft;
+                    current[i] = static_cast<std::uint8_t>(current[i] + predictor);
+                }
+                break;
+            default:
+                return false;
+        }
+        previous = current;
+    }
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * decode()
+ * 
+ * Decodes a whole png file
+ *     The IDAT chunks are joined and inflated in one go into the filtered scanlines, which 
+ *     are unfiltered in place and then expanded to RGB
+ * 
+ * @param[in] data      Bytes of the file
+ * @param[in] size      Number of bytes of the file
+ * @param[in] fileName  Name of the file, for error messages
+ * @return true if the file is a png image this decoder reads, see getPixelRow()
+ * --------------------------------------------------------------------------------------
+*/
+bool PngDecoder::decode(const std::uint8_t* data, std::size_t size, const std::string& fileName)
+{
+    static const std::uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if(size < sizeof(PNG_SIGNATURE) || std::memcmp(data, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0)
+    {
+        std::cerr << "ERROR: " << fileName << " is not a png image" << std::endl;
+        return false;
+    }
+
+    m_width = 0;
+    m_height = 0;
+    int bitDepth = 0;
+    int colorType = -1;
+    std::uint8_t palette[3 * 256] = { 0 };
+    std::uint8_t paletteAlpha[256];
+    std::fill(paletteAlpha, paletteAlpha + 256, 255);
+    std::size_t numPaletteColors = 0;
+    m_compressed.clear();
+
+    // Chunks: length, type, data and CRC, up to IEND
+    std::size_t offset = sizeof(PNG_SIGNATURE);
+    bool hasEnd = false;
+    while(!hasEnd)
+    {
+        if(size - offset < 12 || loadBigEndian32(data + offset) > size - offset - 12)
+        {
+            std::cerr << "ERROR: " << fileName << " is cut short" << std::endl;
+            return false;
+        }
+        const std::size_t chunkBytes = loadBigEndian32(data + offset);
+        const char* chunkType = reinterpret_cast<const char*>(data + offset + 4);
+        const std::uint8_t* chunk = data + offset + 8;
+
+        if(std::memcmp(chunkType, "IHDR", 4) == 0 && chunkBytes == 13)
+        {
+            m_width = loadBigEndian32(chunk);
+            m_height = loadBigEndian32(chunk + 4);
+            bitDepth = chunk[8];
+            colorType = chunk[9];
+            if(chunk[10] != 0 || chunk[11] != 0)
+            {
+                std::cerr << "ERROR: " << fileName << " uses an unknown png compression or filter method" << std::endl;
+                return false;
+            }
+            if(chunk[12] != 0)
+            {
+                std::cerr << "ERROR: " << fileName << " is interlaced, save it without interlacing to load it" << std::endl;
+                return false;
+            }
+        }
+        else if(std::memcmp(chunkType, "PLTE", 4) == 0)
+        {
+            numPaletteColors = std::min<std::size_t>(chunkBytes / 3, 256);
+            std::copy(chunk, chunk + 3 * numPaletteColors, palette);
+        }
+        else if(std::memcmp(chunkType, "tRNS", 4) == 0 && colorType == 3)
+        {
+            std::copy(chunk, chunk + std::min<std::size_t>(chunkBytes, 256), paletteAlpha);
+        }
+        else if(std::memcmp(chunkType, "IDAT", 4) == 0)
+        {
+            m_compressed.insert(m_compressed.end(), chunk, chunk + chunkBytes);
+        }
+        else if(std::memcmp(chunkType, "IEND", 4) == 0)
+        {
+            hasEnd = true;
+        }
+        offset += 12 + chunkBytes;
+    }
+
+    // Samples per pixel of each color type, 0 for the ones that do not exist
+    static const int SAMPLES_PER_PIXEL[7] = { 1, 0, 3, 1, 2, 0, 4 };
+    int numSamples = (colorType >= 0 && colorType < 7) ? SAMPLES_PER_PIXEL[colorType] : 0;
+    bool isValidDepth = (bitDepth == 8) || (bitDepth == 16 && colorType != 3) || \
+                        ((bitDepth == 1 || bitDepth == 2 || bitDepth == 4) && (colorType == 0 || colorType == 3));
+    if(m_width == 0 || m_height == 0 || numSamples == 0 || !isValidDepth || (colorType == 3 && numPaletteColors == 0) || m_compressed.empty())
+    {
+        std::cerr << "ERROR: " << fileName << " is not a png image this program reads" << std::endl;
+        return false;
+    }
+    if(static_cast<std::uint64_t>(m_width) * m_height > MAX_PNG_DECODER_PIXELS)
+    {
+        std::cerr << "ERROR: " << fileName << " is " << m_width << " x " << m_height << " pixels, too big to load" << std::endl;
+        return false;
+    }
+
+    const std::size_t rowBytes = (static_cast<std::size_t>(m_width) * numSamples * bitDepth + 7) / 8;
+    const std::size_t bytesPerPixel = std::max<std::size_t>(1, static_cast<std::size_t>(numSamples * bitDepth) / 8);
+    m_scanlines.resize(m_height * (rowBytes + 1));
+    if(!m_inflater.inflate(m_compressed.data(), m_compressed.size(), m_scanlines.data(), m_scanlines.size()) || !unfilterScanlines(rowBytes, bytesPerPixel))
+    {
+        std::cerr << "ERROR: The image data of " << fileName << " is corrupt" << std::endl;
+        return false;
+    }
+
+    // Expanding every pixel to 8-bit RGB, 16-bit samples keep their high byte
+    const int bytesPerSample = (bitDepth == 16) ? 2 : 1;
+    const int maxPackedValue = (1 << bitDepth) - 1;
+    m_pixels.resize(3 * static_cast<std::size_t>(m_width) * m_height);
+    for(std::uint32_t y = 0; y < m_height; y++)
+    {
+        const std::uint8_t* scanline = m_scanlines.data() + y * (rowBytes + 1) + 1;
+        std::uint8_t* pixel = m_pixels.data() + 3 * static_cast<std::size_t>(y) * m_width;
+        for(std::uint32_t x = 0; x < m_width; x++, pixel += 3)
+        {
+            // Samples smaller than a byte are packed most significant bits first
+            int packedValue = 0;
+            if(bitDepth < 8)
+            {
+                std::size_t bitOffset = static_cast<std::size_t>(x) * bitDepth;
+                packedValue = (scanline[bitOffset >> 3] >> (8 - bitDepth - (bitOffset & 7))) & maxPackedValue;
+            }
+            const std::uint8_t* samples = scanline + static_cast<std::size_t>(x) * numSamples * bytesPerSample;
+
+            int alpha = 255;
+            switch(colorType)
+            {
+                case 0:
+                    pixel[0] = pixel[1] = pixel[2] = (bitDepth < 8) ? static_cast<std::uint8_t>(packedValue * 255 / maxPackedValue) : samples[0];
+                    break;
+                case 2:
+                    pixel[0] = samples[0];
+                    pixel[1] = samples[bytesPerSample];
+                    pixel[2] = samples[2 * bytesPerSample];
+                    break;
+                case 3:
+                {
+                    std::size_t index = (bitDepth < 8) ? static_cast<std::size_t>(packedValue) : samples[0];
+                    if(index >= numPaletteColors)
+                    {
+                        std::cerr << "ERROR: " << fileName << " uses a color missing from its palette" << std::endl;
+                        return false;
+                    }
+                    std::copy(palette + 3 * index, palette + 3 * index + 3, pixel);
+                    alpha = paletteAlpha[index];
+                    break;
+                }
+                case 4:
+                    pixel[0] = pixel[1] = pixel[2] = samples[0];
+                    alpha = samples[bytesPerSample];
+                    break;
+                default:
+                    pixel[0] = samples[0];
+                    pixel[1] = samples[bytesPerSample];
+                    pixel[2] = samples[2 * bytesPerSample];
+                    alpha = samples[3 * bytesPerSample];
+                    break;
+            }
+
+            // Transparent pixels are blended onto a white background
+            if(alpha < 255)
+            {
+                for(int channel = 0; channel < 3; channel++)
+                {
+                    pixel[channel] = static_cast<std::uint8_t>((pixel[channel] * alpha + 255 * (255 - alpha) + 127) / 255);
+                }
+            }
+        }
+    }
+
+    return true;
+}
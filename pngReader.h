@@ -0,0 +1,221 @@
+/*pngReader.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * PNG reader
+ * 
+ * Dependency-free PNG decoding for loading scanned and rendered maze images: a deflate
+ * decompressor and a decoder of every non-interlaced png color type
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * PngInflater class
+ * 
+ * Decompresses the zlib stream of a png image, without any external library
+ *     Handles stored blocks and blocks with the fixed or dynamic Huffman codes, so it reads 
+ *     the images of any png encoder, not only the ones of PngDeflater
+ *     Each Huffman code is looked up with one table read, in a table as wide as its longest 
+ *     code. The tables are kept from one stream to the next
+ * --------------------------------------------------------------------------------------
+*/
+class PngInflater
+{
+public:
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates an inflater with the tables of the fixed Huffman codes built
+     * --------------------------------------------------------------------------------------
+    */
+    PngInflater();
+
+    /**--------------------------------------------------------------------------------------
+     * inflate()
+     * 
+     * Decompresses a whole zlib stream, which must give exactly numOutput bytes
+     * 
+     * @param[in]   compressed      zlib stream
+     * @param[in]   numCompressed   Number of bytes of the stream
+     * @param[out]  output          Buffer of numOutput bytes
+     * @param[in]   numOutput       Number of bytes the stream decompresses to
+     * @return true if the stream is valid, fills the buffer and has the right checksum
+     * --------------------------------------------------------------------------------------
+    */
+    bool inflate(const std::uint8_t* compressed, std::size_t numCompressed, std::uint8_t* output, std::size_t numOutput);
+
+private:
+    /**
+     * Canonical Huffman code, indexed by the next numBits bits of the stream
+     *     Each entry is (symbol << 4) | code length, 0 for bits starting no code
+    */
+    struct HuffmanTable
+    {
+        std::vector<std::uint16_t> entries;
+        int numBits = 0;
+    };
+
+    static const int END_OF_BLOCK = 256;
+    static const int NUM_LITERAL_LENGTH_SYMBOLS = 288;
+    static const int NUM_DISTANCE_SYMBOLS = 32;
+    static const int NUM_CODE_LENGTH_SYMBOLS = 19;
+    static const int MAX_CODE_LENGTH = 15;
+
+    // Builds the table of the code with the given code lengths, false if they are over-subscribed
+    static bool buildTable(const std::uint8_t* codeLengths, int numSymbols, HuffmanTable& table);
+
+    // Makes sure there are at least numBits bits in the bit buffer, at most 57
+    //     Past the end of the stream it adds a few zero bytes, so the last (short) code can 
+    //     still be looked up in a table wider than it, see hasReadPastEnd()
+    bool refill(int numBits)
+    {
+        while(m_numBits < numBits)
+        {
+            if(m_input < m_inputEnd)
+            {
+                m_bitBuffer |= static_cast<std::uint64_t>(*m_input++) << m_numBits;
+            }
+            else if(++m_numPaddingBytes > 8)
+            {
+                return false;
+            }
+            m_numBits += 8;
+        }
+        return true;
+    }
+
+    // Takes numBits bits from the bit buffer, least significant bit first, after refill()
+    std::uint32_t takeBits(int numBits)
+    {
+        std::uint32_t value = static_cast<std::uint32_t>(m_bitBuffer & ((std::uint64_t(1) << numBits) - 1));
+        m_bitBuffer >>= numBits;
+        m_numBits -= numBits;
+        return value;
+    }
+
+    // true if bits of the zero bytes added past the end of the stream were taken
+    bool hasReadPastEnd() const
+    {
+        return 8 * m_numPaddingBytes > m_numBits;
+    }
+
+    // Decodes one symbol, or returns -1 if the bits start no code of the table
+    int decodeSymbol(const HuffmanTable& table);
+
+    bool inflateStoredBlock();
+    bool readDynamicTables();
+    bool inflateCodes(const HuffmanTable& literalLengths, const HuffmanTable& distances);
+
+    const std::uint8_t* m_input;
+    const std::uint8_t* m_inputEnd;
+    std::uint64_t m_bitBuffer;
+    int m_numBits;
+    int m_numPaddingBytes;
+    std::uint8_t* m_output;
+    std::size_t m_outputPos;
+    std::size_t m_outputSize;
+
+    HuffmanTable m_fixedLiteralLengths;
+    HuffmanTable m_fixedDistances;
+    HuffmanTable m_literalLengths;
+    HuffmanTable m_distances;
+    HuffmanTable m_codeLengths;
+};
+
+/**--------------------------------------------------------------------------------------
+ * PngDecoder class
+ * 
+ * Decodes png images into 8-bit RGB pixels
+ *     Reads every bit depth of the gray, RGB, palette, gray and alpha, and RGBA color 
+ *     types, with transparent pixels blended onto white. Interlaced images are not read
+ *     The buffers are kept from one image to the next, so decoding images of the same size 
+ *     one after another does not allocate
+ * --------------------------------------------------------------------------------------
+*/
+class PngDecoder
+{
+public:
+    /**--------------------------------------------------------------------------------------
+     * decode()
+     * 
+     * Decodes a whole png file
+     * 
+     * @param[in] data      Bytes of the file
+     * @param[in] size      Number of bytes of the file
+     * @param[in] fileName  Name of the file, for error messages
+     * @return true if the file is a png image this decoder reads, see getPixelRow()
+     * --------------------------------------------------------------------------------------
+    */
+    bool decode(const std::uint8_t* data, std::size_t size, const std::string& fileName);
+
+    /**--------------------------------------------------------------------------------------
+     * getWidth() / getHeight()
+     * 
+     * Returns the size of the last decoded image in pixels
+     * --------------------------------------------------------------------------------------
+    */
+    std::uint32_t getWidth() const
+    {
+        return m_width;
+    }
+
+    std::uint32_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getPixelRow()
+     * 
+     * Returns one row of the last decoded image, 3 bytes (red, green, blue) per pixel
+     * 
+     * @param[in] y Row index, from the top
+     * @return a pointer to the first pixel of the row
+     * --------------------------------------------------------------------------------------
+    */
+    const std::uint8_t* getPixelRow(std::uint32_t y) const
+    {
+        return m_pixels.data() + 3 * static_cast<std::size_t>(y) * m_width;
+    }
+
+private:
+    // Undoes the filter of every scanline, in place
+    bool unfilterScanlines(std::size_t rowBytes, std::size_t bytesPerPixel);
+
+    PngInflater m_inflater;
+    std::vector<std::uint8_t> m_compressed;
+    std::vector<std::uint8_t> m_scanlines;
+    std::vector<std::uint8_t> m_pixels;
+    std::uint32_t m_width = 0;
+    std::uint32_t m_height = 0;
+};
@@ -0,0 +1,292 @@
+/*pngWriter.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * PNG writer
+ * 
+ * Dependency-free PNG encoding for the maze renderers: a small deflate compressor made for
+ * images of long single-color runs, and the PNG file structure around it
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pngWriter.h"
+
+#include <algorithm>
+
+/**
+ * Base lengths and numbers of extra bits of the deflate length codes 257 to 285
+*/
+const int NUM_LENGTH_CODES = 29;
+const int LENGTH_BASES[NUM_LENGTH_CODES] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, \
+                                             35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const int LENGTH_EXTRA_BITS[NUM_LENGTH_CODES] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, \
+                                                  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Starts a zlib stream at the end of a byte vector
+ * 
+ * @param[in,out] compressed Vector the compressed bytes are appended to
+ * --------------------------------------------------------------------------------------
+*/
+PngDeflater::PngDeflater(std::vector<std::uint8_t>& compressed)
+    : m_compressed(compressed), m_bitBuffer(0), m_numBits(0), m_lastByte(-1), m_runLength(0), m_adlerLow(1), m_adlerHigh(0)
+{
+    // zlib header: deflate with a 32K window, no dictionary, fastest compression
+    m_compressed.push_back(0x78);
+    m_compressed.push_back(0x01);
+
+    // Final block, fixed Huffman codes
+    putBits(1, 1);
+    putBits(1, 2);
+}
+
+/**--------------------------------------------------------------------------------------
+ * putRepeated()
+ * 
+ * Adds count copies of one byte to the stream, without going through them one by one
+ * 
+ * @param[in] byte  Byte to add
+ * @param[in] count Number of copies
+ * --------------------------------------------------------------------------------------
+*/
+void PngDeflater::putRepeated(std::uint8_t byte, std::size_t count)
+{
+    if(count == 0)
+    {
+        return;
+    }
+    putByte(byte);
+    count--;
+
+    // The checksum of n copies of a byte has a closed form
+    std::uint64_t adlerLow = m_adlerLow % ADLER_MODULUS;
+    std::uint64_t adlerHigh = m_adlerHigh % ADLER_MODULUS;
+    std::uint64_t numBytes = count;
+    adlerHigh = (adlerHigh + (numBytes % ADLER_MODULUS) * adlerLow + byte * ((numBytes * (numBytes + 1) / 2) % ADLER_MODULUS)) % ADLER_MODULUS;
+    adlerLow = (adlerLow + byte * (numBytes % ADLER_MODULUS)) % ADLER_MODULUS;
+    m_adlerLow = static_cast<std::uint32_t>(adlerLow);
+    m_adlerHigh = static_cast<std::uint32_t>(adlerHigh);
+
+    // Every copy after the first one is part of the run of the last byte
+    std::size_t runLength = static_cast<std::size_t>(m_runLength) + count;
+    while(runLength >= static_cast<std::size_t>(MAX_MATCH))
+    {
+        m_runLength = MAX_MATCH;
+        flushRun();
+        runLength -= MAX_MATCH;
+    }
+    m_runLength = static_cast<int>(runLength);
+}
+
+/**--------------------------------------------------------------------------------------
+ * finish()
+ * 
+ * Ends the deflate block and adds the zlib checksum, nothing can be added after it
+ * --------------------------------------------------------------------------------------
+*/
+void PngDeflater::finish()
+{
+    flushRun();
+    putSymbol(END_OF_BLOCK);
+    if(m_numBits > 0)
+    {
+        putBits(0, 8 - m_numBits);
+    }
+
+    std::uint32_t adler = (m_adlerHigh % ADLER_MODULUS) << 16 | (m_adlerLow % ADLER_MODULUS);
+    for(int shift = 24; shift >= 0; shift -= 8)
+    {
+        m_compressed.push_back(static_cast<std::uint8_t>(adler >> shift));
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * flushRun()
+ * 
+ * Writes the repeats of the last byte as a match at distance 1, or as literals if too short
+ * --------------------------------------------------------------------------------------
+*/
+void PngDeflater::flushRun()
+{
+    if(m_runLength >= MIN_MATCH)
+    {
+        int lengthCode = 0;
+        while(lengthCode + 1 < NUM_LENGTH_CODES && LENGTH_BASES[lengthCode + 1] <= m_runLength)
+        {
+            lengthCode++;
+        }
+        putSymbol(257 + lengthCode);
+        putBits(static_cast<std::uint32_t>(m_runLength - LENGTH_BASES[lengthCode]), LENGTH_EXTRA_BITS[lengthCode]);
+
+        // Distance code 0, distance 1
+        putBits(0, 5);
+    }
+    else
+    {
+        for(int i = 0; i < m_runLength; i++)
+        {
+            putSymbol(m_lastByte);
+        }
+    }
+    m_runLength = 0;
+}
+
+/**--------------------------------------------------------------------------------------
+ * putSymbol()
+ * 
+ * Writes a literal/length symbol with the fixed Huffman codes, most significant bit first
+ * 
+ * @param[in] symbol Literal byte, END_OF_BLOCK or length code
+ * --------------------------------------------------------------------------------------
+*/
+void PngDeflater::putSymbol(int symbol)
+{
+    std::uint32_t code = 0;
+    int codeLength = 0;
+    if(symbol < 144)
+    {
+        code = 0x30 + symbol;
+        codeLength = 8;
+    }
+    else if(symbol < 256)
+    {
+        code = 0x190 + (symbol - 144);
+        codeLength = 9;
+    }
+    else if(symbol < 280)
+    {
+        code = symbol - 256;
+        codeLength = 7;
+    }
+    else
+    {
+        code = 0xC0 + (symbol - 280);
+        codeLength = 8;
+    }
+
+    std::uint32_t reversed = 0;
+    for(int i = 0; i < codeLength; i++)
+    {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    putBits(reversed, codeLength);
+}
+
+/**--------------------------------------------------------------------------------------
+ * updateCrc32()
+ * 
+ * Updates the CRC-32 that ends every PNG chunk
+ * 
+ * @param[in] crc       CRC of the bytes before, 0xFFFFFFFF to start
+ * @param[in] bytes     Bytes to add
+ * @param[in] numBytes  Number of bytes to add
+ * @return the updated CRC, to be inverted once every byte is added
+ * --------------------------------------------------------------------------------------
+*/
+std::uint32_t updateCrc32(std::uint32_t crc, const std::uint8_t* bytes, std::size_t numBytes)
+{
+    static const std::vector<std::uint32_t> crcTable = []()
+    {
+        std::vector<std::uint32_t> table(256);
+        for(std::uint32_t entry = 0; entry < 256; entry++)
+        {
+            std::uint32_t value = entry;
+            for(int bit = 0; bit < 8; bit++)
+            {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            table[entry] = value;
+        }
+        return table;
+    }();
+
+    for(std::size_t i = 0; i < numBytes; i++)
+    {
+        crc = crcTable[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+/**--------------------------------------------------------------------------------------
+ * writePngChunk()
+ * 
+ * Writes one PNG chunk: length, type, data and CRC
+ * 
+ * @param[in,out]   outfile     Stream of the png file
+ * @param[in]       type        Four letter chunk type
+ * @param[in]       data        Chunk data
+ * @param[in]       numBytes    Number of bytes of chunk data
+ * --------------------------------------------------------------------------------------
+*/
+void writePngChunk(std::ostream& outfile, const char* type, const std::uint8_t* data, std::size_t numBytes)
+{
+    std::uint8_t length[4] = { static_cast<std::uint8_t>(numBytes >> 24), static_cast<std::uint8_t>(numBytes >> 16), \
+                               static_cast<std::uint8_t>(numBytes >> 8), static_cast<std::uint8_t>(numBytes) };
+    outfile.write(reinterpret_cast<const char*>(length), 4);
+    outfile.write(type, 4);
+    outfile.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(numBytes));
+
+    std::uint32_t crc = updateCrc32(0xFFFFFFFFu, reinterpret_cast<const std::uint8_t*>(type), 4);
+    crc = updateCrc32(crc, data, numBytes) ^ 0xFFFFFFFFu;
+    std::uint8_t crcBytes[4] = { static_cast<std::uint8_t>(crc >> 24), static_cast<std::uint8_t>(crc >> 16), \
+                                 static_cast<std::uint8_t>(crc >> 8), static_cast<std::uint8_t>(crc) };
+    outfile.write(reinterpret_cast<const char*>(crcBytes), 4);
+}
+
+/**--------------------------------------------------------------------------------------
+ * writePngFile()
+ * 
+ * Writes a complete 8-bit palette png file from compressed image data
+ * 
+ * @param[in,out]   outfile         Stream of the png file, opened in binary mode
+ * @param[in]       width           Image width in pixels
+ * @param[in]       height          Image height in pixels
+ * @param[in]       palette         numColors RGB colors
+ * @param[in]       numColors       Number of palette colors, at most 256
+ * @param[in]       compressed      zlib stream of the filtered scanlines, see PngDeflater
+ * --------------------------------------------------------------------------------------
+*/
+void writePngFile(std::ostream& outfile, std::uint32_t width, std::uint32_t height, const std::uint8_t* palette, int numColors, const std::vector<std::uint8_t>& compressed)
+{
+    static const std::uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    outfile.write(reinterpret_cast<const char*>(PNG_SIGNATURE), sizeof(PNG_SIGNATURE));
+
+    // 8-bit palette color, no interlacing
+    std::uint8_t header[13] = { static_cast<std::uint8_t>(width >> 24), static_cast<std::uint8_t>(width >> 16), static_cast<std::uint8_t>(width >> 8), static_cast<std::uint8_t>(width), \
+                                static_cast<std::uint8_t>(height >> 24), static_cast<std::uint8_t>(height >> 16), static_cast<std::uint8_t>(height >> 8), static_cast<std::uint8_t>(height), \
+                                8, 3, 0, 0, 0 };
+    writePngChunk(outfile, "IHDR", header, sizeof(header));
+    writePngChunk(outfile, "PLTE", palette, 3 * static_cast<std::size_t>(numColors));
+
+    const std::size_t MAX_IDAT_BYTES = std::size_t(1) << 20;
+    for(std::size_t offset = 0; offset < compressed.size(); offset += MAX_IDAT_BYTES)
+    {
+        writePngChunk(outfile, "IDAT", compressed.data() + offset, std::min(MAX_IDAT_BYTES, compressed.size() - offset));
+    }
+    writePngChunk(outfile, "IEND", nullptr, 0);
+}
@@ -0,0 +1,163 @@
+/*pngWriter.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * PNG writer
+ * 
+ * Dependency-free PNG encoding for the maze renderers: a small deflate compressor made for
+ * images of long single-color runs, and the PNG file structure around it
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * PngDeflater class
+ * 
+ * Compresses PNG image data into a zlib stream, without any external library
+ *     Uses a single deflate block with the fixed Huffman codes, and only ever matches the 
+ *     byte before, so runs of one color (and rows equal to the row above, which the Up 
+ *     filter turns into runs of zeros) are what get compressed
+ *     Maze images are almost entirely made of such runs
+ * --------------------------------------------------------------------------------------
+*/
+class PngDeflater
+{
+public:
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Starts a zlib stream at the end of a byte vector
+     * 
+     * @param[in,out] compressed Vector the compressed bytes are appended to
+     * --------------------------------------------------------------------------------------
+    */
+    explicit PngDeflater(std::vector<std::uint8_t>& compressed);
+
+    /**--------------------------------------------------------------------------------------
+     * put() / putRepeated()
+     * 
+     * Adds bytes to the stream, or count copies of one byte without going through them 
+     * one by one
+     * --------------------------------------------------------------------------------------
+    */
+    void put(const std::uint8_t* bytes, std::size_t numBytes)
+    {
+        for(std::size_t i = 0; i < numBytes; i++)
+        {
+            putByte(bytes[i]);
+        }
+    }
+
+    void putRepeated(std::uint8_t byte, std::size_t count);
+
+    /**--------------------------------------------------------------------------------------
+     * finish()
+     * 
+     * Ends the deflate block and adds the zlib checksum, nothing can be added after it
+     * --------------------------------------------------------------------------------------
+    */
+    void finish();
+
+private:
+    static const int END_OF_BLOCK = 256;
+    static const int MIN_MATCH = 3;
+    static const int MAX_MATCH = 258;
+    static const std::uint32_t ADLER_MODULUS = 65521;
+
+    void putByte(std::uint8_t byte)
+    {
+        // Reduced often enough that neither sum can overflow 32 bits
+        m_adlerLow += byte;
+        m_adlerHigh += m_adlerLow;
+        if(m_adlerHigh >= 0xF0000000u)
+        {
+            m_adlerLow %= ADLER_MODULUS;
+            m_adlerHigh %= ADLER_MODULUS;
+        }
+
+        if(byte == m_lastByte)
+        {
+            m_runLength++;
+            if(m_runLength == MAX_MATCH)
+            {
+                flushRun();
+            }
+            return;
+        }
+
+        flushRun();
+        putSymbol(byte);
+        m_lastByte = byte;
+    }
+
+    // Writes the repeats of the last byte as a match at distance 1, or as literals if too short
+    void flushRun();
+
+    // Writes a literal/length symbol with the fixed Huffman codes, most significant bit first
+    void putSymbol(int symbol);
+
+    // Writes bits least significant bit first
+    void putBits(std::uint32_t value, int numBits)
+    {
+        m_bitBuffer |= static_cast<std::uint64_t>(value) << m_numBits;
+        m_numBits += numBits;
+        while(m_numBits >= 8)
+        {
+            m_compressed.push_back(static_cast<std::uint8_t>(m_bitBuffer));
+            m_bitBuffer >>= 8;
+            m_numBits -= 8;
+        }
+    }
+
+    std::vector<std::uint8_t>& m_compressed;
+    std::uint64_t m_bitBuffer;
+    int m_numBits;
+    int m_lastByte;
+    int m_runLength;
+    std::uint32_t m_adlerLow;
+    std::uint32_t m_adlerHigh;
+};
+
+/**--------------------------------------------------------------------------------------
+ * writePngFile()
+ * 
+ * Writes a complete 8-bit palette png file from compressed image data
+ * 
+ * @param[in,out]   outfile         Stream of the png file, opened in binary mode
+ * @param[in]       width           Image width in pixels
+ * @param[in]       height          Image height in pixels
+ * @param[in]       palette         numColors RGB colors
+ * @param[in]       numColors       Number of palette colors, at most 256
+ * @param[in]       compressed      zlib stream of the filtered scanlines, see PngDeflater
+ * --------------------------------------------------------------------------------------
+*/
+void writePngFile(std::ostream& outfile, std::uint32_t width, std::uint32_t height, const std::uint8_t* palette, int numColors, const std::vector<std::uint8_t>& compressed);
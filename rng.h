@@ -0,0 +1,431 @@
+/*rng.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Random number engines
+ * 
+ * Small, fast pseudo-random number engines used to generate mazes, and helpers for drawing
+ * unbiased values from them
+ * 
+ * Every engine satisfies the UniformRandomBitGenerator requirements, so the maze generators
+ * accept any of them (or a standard library engine) as a template parameter
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+/**--------------------------------------------------------------------------------------
+ * SplitMix64 class
+ * 
+ * 64-bit engine with a single word of state, every seed gives a full-period stream
+ *     Mostly used to expand one user-supplied seed into the state of the other engines
+ * --------------------------------------------------------------------------------------
+*/
+class SplitMix64
+{
+public:
+    typedef std::uint64_t result_type;
+
+    explicit SplitMix64(std::uint64_t seed)
+        : m_state(seed)
+    {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+/**--------------------------------------------------------------------------------------
+ * Xoshiro256StarStar class
+ * 
+ * xoshiro256** engine by Blackman and Vigna, 256 bits of state and a period of 2^256 - 1
+ *     The default engine for maze generation
+ * --------------------------------------------------------------------------------------
+*/
+class Xoshiro256StarStar
+{
+public:
+    typedef std::uint64_t result_type;
+
+    explicit Xoshiro256StarStar(std::uint64_t seed)
+    {
+        SplitMix64 seeder(seed);
+        for(std::uint64_t& word : m_state)
+        {
+            word = seeder();
+        }
+    }
+
+    // Starts from the given state words, which must not all be 0, see makeStreamEngine()
+    Xoshiro256StarStar(std::uint64_t state0, std::uint64_t state1, std::uint64_t state2, std::uint64_t state3)
+        : m_state{ state0, state1, state2, state3 }
+    {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const std::uint64_t result = rotateLeft(m_state[1] * 5, 7) * 9;
+        const std::uint64_t t = m_state[1] << 17;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotateLeft(m_state[3], 45);
+
+        return result;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * jump()
+     * 
+     * Advances the engine by 2^128 draws, as if operator() had been called that many times
+     *     Jumping copies of one engine 0, 1, 2, ... times gives non-overlapping streams, one 
+     *     per thread
+     * --------------------------------------------------------------------------------------
+    */
+    void jump()
+    {
+        static const std::uint64_t JUMP[4] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+
+        std::uint64_t jumped[4] = { 0, 0, 0, 0 };
+        for(std::uint64_t jumpWord : JUMP)
+        {
+            for(int bit = 0; bit < 64; bit++)
+            {
+                if(jumpWord & (std::uint64_t(1) << bit))
+                {
+                    for(int i = 0; i < 4; i++)
+                    {
+                        jumped[i] ^= m_state[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+
+        for(int i = 0; i < 4; i++)
+        {
+            m_state[i] = jumped[i];
+        }
+    }
+
+private:
+    static std::uint64_t rotateLeft(std::uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t m_state[4];
+};
+
+/**--------------------------------------------------------------------------------------
+ * Pcg32 class
+ * 
+ * PCG-XSH-RR engine by O'Neill, 64 bits of state and 32-bit output
+ * --------------------------------------------------------------------------------------
+*/
+class Pcg32
+{
+public:
+    typedef std::uint32_t result_type;
+
+    explicit Pcg32(std::uint64_t seed, std::uint64_t stream = 0x14057B7EF767814FULL)
+        : m_state(0), m_increment((stream << 1) | 1)
+    {
+        (*this)();
+        m_state += seed;
+        (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        std::uint64_t oldState = m_state;
+        m_state = oldState * 6364136223846793005ULL + m_increment;
+        std::uint32_t xorShifted = static_cast<std::uint32_t>(((oldState >> 18) ^ oldState) >> 27);
+        int rotation = static_cast<int>(oldState >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+    }
+
+private:
+    std::uint64_t m_state;
+    std::uint64_t m_increment;
+};
+
+/**--------------------------------------------------------------------------------------
+ * Philox4x32 class
+ * 
+ * Philox4x32-10 counter-based engine by Salmon, Moraes, Dror and Shaw (Random123)
+ *     Each output block is a keyed bijection of a 128-bit counter, so any block of any 
+ *     stream can be computed on its own, with no state carried over from the blocks before
+ *     The key is the seed; the counter holds the stream index (64 bits), the substream 
+ *     index (32 bits) and the block index (32 bits), so every (seed, stream, substream) 
+ *     triple names its own stream of 2^33 64-bit draws, and no two threads ever need to 
+ *     share one
+ *     Every block takes 10 rounds of two 32-bit multiplies, which makes it slower per draw 
+ *     than the engines above: it is best used to key them, see makeStreamEngine()
+ * --------------------------------------------------------------------------------------
+*/
+class Philox4x32
+{
+public:
+    typedef std::uint64_t result_type;
+
+    explicit Philox4x32(std::uint64_t seed, std::uint64_t streamIndex = 0, std::uint32_t substreamIndex = 0)
+        : m_seed(seed), m_streamIndex(streamIndex), m_substreamIndex(substreamIndex), m_blockIndex(0), m_numUnused(0)
+    {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        if(m_numUnused == 0)
+        {
+            computeBlock(m_seed, m_streamIndex, m_substreamIndex, m_blockIndex++, m_block);
+            m_numUnused = 2;
+        }
+
+        int first = 4 - 2 * m_numUnused--;
+        return (static_cast<std::uint64_t>(m_block[first + 1]) << 32) | m_block[first];
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * computeBlock()
+     * 
+     * Computes one block of a stream without an engine, as four 32-bit words
+     * 
+     * @param[in]   seed            Key of the stream
+     * @param[in]   streamIndex     Stream index, counter words 2 and 3
+     * @param[in]   substreamIndex  Substream index, counter word 1
+     * @param[in]   blockIndex      Block index, counter word 0
+     * @param[out]  block           The four words of the block
+     * --------------------------------------------------------------------------------------
+    */
+    static void computeBlock(std::uint64_t seed, std::uint64_t streamIndex, std::uint32_t substreamIndex, std::uint32_t blockIndex, std::uint32_t block[4])
+    {
+        std::uint32_t counter[4] = { blockIndex, substreamIndex, static_cast<std::uint32_t>(streamIndex), static_cast<std::uint32_t>(streamIndex >> 32) };
+        std::uint32_t key[2] = { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+
+        for(int round = 0; round < 10; round++)
+        {
+            const std::uint64_t product0 = static_cast<std::uint64_t>(0xD2511F53u) * counter[0];
+            const std::uint64_t product1 = static_cast<std::uint64_t>(0xCD9E8D57u) * counter[2];
+            const std::uint32_t next[4] = { static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(product1),
+                                            static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(product0) };
+            for(int i = 0; i < 4; i++)
+            {
+                counter[i] = next[i];
+            }
+
+            // Weyl sequence bumps of the key between rounds
+            key[0] += 0x9E3779B9u;
+            key[1] += 0xBB67AE85u;
+        }
+
+        for(int i = 0; i < 4; i++)
+        {
+            block[i] = counter[i];
+        }
+    }
+
+private:
+    std::uint64_t m_seed;
+    std::uint64_t m_streamIndex;
+    std::uint32_t m_substreamIndex;
+    std::uint32_t m_blockIndex;
+    std::uint32_t m_block[4];
+    int m_numUnused;
+};
+
+// Engine used by the maze generators unless the caller picks another one
+typedef Xoshiro256StarStar DefaultRng;
+
+/**--------------------------------------------------------------------------------------
+ * makeStreamEngine()
+ * 
+ * Returns the default engine for one stream of a seed, keyed by counter-based Philox4x32 
+ * draws rather than by jumping one engine ahead once per stream
+ *     The engine only depends on the seed and the indices, never on how many other streams 
+ *     were made or in which order, so the mazes of a batch come out the same whatever the 
+ *     number of threads and however the jobs are scheduled
+ * 
+ * @param[in] seed              Seed of the run
+ * @param[in] streamIndex       Index of the stream, the maze index in batch mode
+ * @param[in] substreamIndex    Index of a stream within the stream, e.g. a walk index
+ * @return an engine starting at the first draw of the stream
+ * --------------------------------------------------------------------------------------
+*/
+inline DefaultRng makeStreamEngine(std::uint64_t seed, std::uint64_t streamIndex, std::uint32_t substreamIndex = 0)
+{
+    Philox4x32 keyedStream(seed, streamIndex, substreamIndex);
+    std::uint64_t state[4] = { keyedStream(), keyedStream(), keyedStream(), keyedStream() };
+
+    // xoshiro256** must not start from the all-zero state, which Philox can only hit with probability 2^-256
+    if((state[0] | state[1] | state[2] | state[3]) == 0)
+    {
+        state[0] = 1;
+    }
+    return DefaultRng(state[0], state[1], state[2], state[3]);
+}
+
+/**--------------------------------------------------------------------------------------
+ * randomBits32()
+ * 
+ * Draws 32 random bits from an engine producing 32 or 64 bits per call, keeping the high 
+ * bits which are the strongest bits for every engine in this file
+ * 
+ * @param[in,out] rng Engine to draw from
+ * @return 32 uniformly distributed random bits
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+inline std::uint32_t randomBits32(RngEngine& rng)
+{
+    static_assert(RngEngine::min() == 0, "randomBits32() needs an engine whose outputs start at 0");
+    static_assert(std::numeric_limits<typename RngEngine::result_type>::digits == 32 ||
+                  std::numeric_limits<typename RngEngine::result_type>::digits == 64,
+                  "randomBits32() needs an engine producing 32 or 64 bits per call");
+    static_assert(RngEngine::max() == std::numeric_limits<typename RngEngine::result_type>::max(),
+                  "randomBits32() needs an engine whose outputs cover every bit pattern");
+
+    return static_cast<std::uint32_t>(rng() >> (std::numeric_limits<typename RngEngine::result_type>::digits - 32));
+}
+
+/**--------------------------------------------------------------------------------------
+ * randomBelow()
+ * 
+ * Draws a uniformly distributed integer in [0, bound) without modulo bias, using Lemire's 
+ * multiply-and-shift method. Only retries on the rare draws that would introduce bias
+ * 
+ * @param[in,out] rng   Engine to draw from
+ * @param[in]     bound Exclusive upper bound, must be at least 1
+ * @return a random integer in [0, bound)
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+inline std::uint32_t randomBelow(RngEngine& rng, std::uint32_t bound)
+{
+    std::uint64_t product = static_cast<std::uint64_t>(randomBits32(rng)) * bound;
+    std::uint32_t low = static_cast<std::uint32_t>(product);
+
+    if(low < bound)
+    {
+        const std::uint32_t threshold = (0u - bound) % bound;
+        while(low < threshold)
+        {
+            product = static_cast<std::uint64_t>(randomBits32(rng)) * bound;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+/**--------------------------------------------------------------------------------------
+ * randomBelow64()
+ * 
+ * Draws a uniformly distributed integer in [0, bound) for bounds past 32 bits, rejecting 
+ * the draws that would introduce modulo bias
+ *     Bounds that fit in 32 bits are drawn by randomBelow(), with the same engine calls
+ * 
+ * @param[in,out] rng   Engine to draw from
+ * @param[in]     bound Exclusive upper bound, must be at least 1
+ * @return a random integer in [0, bound)
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+inline std::uint64_t randomBelow64(RngEngine& rng, std::uint64_t bound)
+{
+    if(bound <= 0xFFFFFFFFu)
+    {
+        return randomBelow(rng, static_cast<std::uint32_t>(bound));
+    }
+
+    const std::uint64_t threshold = (0 - bound) % bound;
+    std::uint64_t draw = 0;
+    do
+    {
+        draw = (static_cast<std::uint64_t>(randomBits32(rng)) << 32) | randomBits32(rng);
+    } while(draw < threshold);
+
+    return draw % bound;
+}
+
+/**--------------------------------------------------------------------------------------
+ * randomDirection()
+ * 
+ * Draws one of the four cardinal directions uniformly with a single engine call
+ * 
+ * @param[in,out] rng Engine to draw from
+ * @return an int from 0 to 3 representing a cardinal direction
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+inline int randomDirection(RngEngine& rng)
+{
+    return static_cast<int>(randomBits32(rng) >> 30);
+}
+
+/**--------------------------------------------------------------------------------------
+ * makeRandomSeed()
+ * 
+ * Creates a seed for when the user did not supply one, mixing the system's random device 
+ * with the clock so that two runs in the same second still differ
+ * 
+ * @return a 64-bit seed
+ * --------------------------------------------------------------------------------------
+*/
+inline std::uint64_t makeRandomSeed()
+{
+    std::random_device device;
+    std::uint64_t deviceBits = (static_cast<std::uint64_t>(device()) << 32) ^ device();
+    std::uint64_t clockBits = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+
+    SplitMix64 mixer(deviceBits ^ clockBits);
+    return mixer();
+}
@@ -4,11 +4,13 @@ import sys
 str_side_length = ""
 
 # Checking if correct number of arguments passed
-if len(sys.argv) != 2:
+# Any arguments after the side length (e.g. a number of columns, or --seed <seed>) are passed on to main.exe
+if len(sys.argv) < 2:
     print("ERROR: Incorrect number of arguments passed to run_all.py, please one side length")
     sys.exit(2)
 else:
     str_side_length = sys.argv[1]
+    main_options = sys.argv[2:]
 
 # Making sure inputted side length is valid
 converted_length = float(str_side_length)
@@ -22,8 +24,9 @@ if int_length < 1:
 if not converted_length.is_integer():
     print("User-inputted side length of", converted_length, "is not valid, rounding down to", int_length)
 
-# Generating and solving the maze with C++
-subprocess.run(["main.exe", str_side_length])
+# Generating, solving and drawing the svg files of the solved and unsolved maze with C++
+# maze_img_displayer.py can still draw them from mazeData.csv (or mazeData.mzb) afterwards
+if "--render" not in main_options:
+    main_options = main_options + ["--render", "svg"]
 
-# Creating svg files of the solved and unsolved maze
-subprocess.call(["python3", "maze_img_displayer.py"])
\ No newline at end of file
+subprocess.run(["main.exe", str_side_length] + main_options)
\ No newline at end of file
@@ -0,0 +1,125 @@
+/*scratchArena.cpp*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Scratch arena
+ * 
+ * Monotonic arena the maze generators take their scratch arrays from, reset between
+ * mazes so a batch worker stops calling the heap once its arena is big enough
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "scratchArena.h"
+
+#include <iostream>
+
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates an arena with a block of the given size
+ * 
+ * @param[in] numBytes Size of the block, 0 to allocate it later with reserve()
+ * --------------------------------------------------------------------------------------
+*/
+ScratchArena::ScratchArena(std::size_t numBytes)
+    : m_capacity(0),
+      m_numBytesUsed(0),
+      m_numOverflowBytes(0)
+{
+    reserve(numBytes);
+}
+
+/**--------------------------------------------------------------------------------------
+ * reserve()
+ * 
+ * Grows the block to at least the given size
+ *     Only grows an arena with nothing allocated from it, right after it was created or 
+ *     reset
+ * 
+ * @param[in] numBytes Size the block should have
+ * --------------------------------------------------------------------------------------
+*/
+void ScratchArena::reserve(std::size_t numBytes)
+{
+    numBytes = roundUpToAlignment(numBytes);
+    if(numBytes <= m_capacity)
+    {
+        return;
+    }
+    if(m_numBytesUsed > 0 || m_numOverflowBytes > 0)
+    {
+        std::cerr << "ERROR: ScratchArena::reserve() was called while memory was allocated from the arena" << std::endl;
+        return;
+    }
+
+    m_block.reset(new unsigned char[numBytes]);
+    m_capacity = numBytes;
+}
+
+/**--------------------------------------------------------------------------------------
+ * reset()
+ * 
+ * Takes back everything allocated from the arena, so the next maze can reuse the block
+ *     If allocations did not fit in the block since the last reset, frees their blocks 
+ *     and grows the block to fit all of them
+ * --------------------------------------------------------------------------------------
+*/
+void ScratchArena::reset()
+{
+    std::size_t numBytesWanted = m_numBytesUsed + m_numOverflowBytes;
+    m_numBytesUsed = 0;
+
+    if(m_numOverflowBytes > 0)
+    {
+        m_overflowBlocks.clear();
+        m_numOverflowBytes = 0;
+        reserve(numBytesWanted);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * allocateBytes()
+ * 
+ * Hands out memory from the block, or from a block of its own if it does not fit
+ * 
+ * @param[in] numBytes Number of bytes wanted
+ * @return a pointer aligned to ALIGNMENT
+ * --------------------------------------------------------------------------------------
+*/
+void* ScratchArena::allocateBytes(std::size_t numBytes)
+{
+    numBytes = roundUpToAlignment(numBytes);
+    if(numBytes <= m_capacity - m_numBytesUsed)
+    {
+        void* allocation = m_block.get() + m_numBytesUsed;
+        m_numBytesUsed += numBytes;
+        return allocation;
+    }
+
+    m_overflowBlocks.emplace_back(new unsigned char[numBytes > 0 ? numBytes : 1]);
+    m_numOverflowBytes += numBytes;
+    return m_overflowBlocks.back().get();
+}
@@ -0,0 +1,180 @@
+/*scratchArena.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Scratch arena
+ * 
+ * Monotonic arena the maze generators take their scratch arrays from, reset between
+ * mazes so a batch worker stops calling the heap once its arena is big enough
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * ScratchArena class
+ * 
+ * Monotonic arena for the scratch arrays of a maze generator, one per thread
+ *     Allocations only move a cursor through one block, nothing is freed until reset()
+ *     An allocation that does not fit gets a block of its own, and the next reset() grows 
+ *     the main block to fit everything handed out since the last one, so an arena reset 
+ *     between mazes of the same size stops calling the heap after the first maze
+ *     Only holds trivial types, nothing allocated from it is ever destroyed
+ *     Not thread-safe, every thread needs its own
+ * --------------------------------------------------------------------------------------
+*/
+class ScratchArena
+{
+public:
+    // Every allocation starts on a multiple of this many bytes
+    static const std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates an arena with a block of the given size
+     * 
+     * @param[in] numBytes Size of the block, 0 to allocate it later with reserve()
+     * --------------------------------------------------------------------------------------
+    */
+    explicit ScratchArena(std::size_t numBytes = 0);
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /**--------------------------------------------------------------------------------------
+     * reserve()
+     * 
+     * Grows the block to at least the given size
+     *     Only grows an arena with nothing allocated from it, right after it was created or 
+     *     reset
+     * 
+     * @param[in] numBytes Size the block should have
+     * --------------------------------------------------------------------------------------
+    */
+    void reserve(std::size_t numBytes);
+
+    /**--------------------------------------------------------------------------------------
+     * reset()
+     * 
+     * Takes back everything allocated from the arena, so the next maze can reuse the block
+     *     If allocations did not fit in the block since the last reset, frees their blocks 
+     *     and grows the block to fit all of them
+     * --------------------------------------------------------------------------------------
+    */
+    void reset();
+
+    /**--------------------------------------------------------------------------------------
+     * allocate()
+     * 
+     * Hands out an uninitialized array, valid until the next reset()
+     * 
+     * @param[in] count Number of elements in the array
+     * @return a pointer to the first element
+     * --------------------------------------------------------------------------------------
+    */
+    template <typename T>
+    T* allocate(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value && std::is_trivially_default_constructible<T>::value, "ScratchArena only holds trivial types");
+        static_assert(alignof(T) <= ALIGNMENT, "ScratchArena cannot align past ALIGNMENT");
+        return static_cast<T*>(allocateBytes(count * sizeof(T)));
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * bytesFor()
+     * 
+     * Returns the room allocate() takes for an array, to size an arena up front
+     * 
+     * @param[in] count Number of elements in the array
+     * @return the size of the array, rounded up to a multiple of ALIGNMENT
+     * --------------------------------------------------------------------------------------
+    */
+    template <typename T>
+    static std::size_t bytesFor(std::size_t count)
+    {
+        return roundUpToAlignment(count * sizeof(T));
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getCapacity()
+     * 
+     * Returns the size of the block
+     * 
+     * @return the number of bytes that can be allocated without calling the heap
+     * --------------------------------------------------------------------------------------
+    */
+    std::size_t getCapacity() const
+    {
+        return m_capacity;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getNumBytesUsed()
+     * 
+     * Returns the room taken by every allocation since the last reset, blocks of their own 
+     * included
+     * 
+     * @return the number of bytes allocated
+     * --------------------------------------------------------------------------------------
+    */
+    std::size_t getNumBytesUsed() const
+    {
+        return m_numBytesUsed + m_numOverflowBytes;
+    }
+
+private:
+    // Hands out numBytes from the block, or from a block of their own if they do not fit
+    void* allocateBytes(std::size_t numBytes);
+
+    static std::size_t roundUpToAlignment(std::size_t numBytes)
+    {
+        return (numBytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    /**
+     * Main block and its cursor
+     *     m_block: the memory handed out, aligned to ALIGNMENT by operator new[]
+     *     m_numBytesUsed: bytes of m_block handed out since the last reset
+    */
+    std::unique_ptr<unsigned char[]> m_block;
+    std::size_t m_capacity;
+    std::size_t m_numBytesUsed;
+
+    /**
+     * Allocations that did not fit in m_block since the last reset
+     *     m_overflowBlocks: one block per allocation, freed by reset()
+     *     m_numOverflowBytes: their total size, which reset() grows m_block by
+    */
+    std::vector<std::unique_ptr<unsigned char[]>> m_overflowBlocks;
+    std::size_t m_numOverflowBytes;
+};
@@ -0,0 +1,646 @@
+/*staticMaze.h*/
+
+/**
+ * Author: Eric Fei
+ * Version 0.0.1
+ * 
+ * Static maze
+ * 
+ * Maze with dimensions fixed at compile time, with the Wilson generator and Tremaux
+ * solver specialized for it, for small mazes generated millions of times
+ */
+
+/**
+ * MIT License
+ * Copyright (c) 2023 Eric Fei
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "bitOps.h"
+#include "maze.h"
+#include "rng.h"
+#include "wilson.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <tuple>
+
+/**--------------------------------------------------------------------------------------
+ * StaticMaze class
+ * 
+ * Maze whose dimensions are fixed at compile time, for the small sizes, like 16x16 or 
+ * 32x32 game levels, that get generated millions of times
+ *     Keeps the same wall layout as Maze, an open-wall bit for the south and for the east 
+ *     side of every cell, but as row-major bitsets in std::arrays with no row padding, and 
+ *     with no per-cell state besides the path bit: a cell's exits are its open walls
+ *     Never allocates, so a StaticMaze can live on the stack, and copying one copies 
+ *     the maze
+ *     The neighbor of a cell in every direction is a fixed offset of its row-major index, 
+ *     and which of them exist is a constexpr table, so generating and solving never work 
+ *     out rows and columns, see runWilson() and runTremaux() below
+ *     Cell indices are 16 bits, so a StaticMaze has at most 65535 cells. Bigger mazes 
+ *     belong in a Maze
+ *     copyToMaze() hands a finished maze to the writers and renderers, which take a Maze
+ * 
+ * @tparam NUM_ROWS Number of rows in the maze
+ * @tparam NUM_COLS Number of columns in the maze
+ * --------------------------------------------------------------------------------------
+*/
+template <int NUM_ROWS, int NUM_COLS>
+class StaticMaze
+{
+public:
+    static_assert(NUM_ROWS >= 1 && NUM_COLS >= 1, "StaticMaze needs at least one row and one column");
+    static_assert(NUM_ROWS <= 65535 / NUM_COLS, "StaticMaze cell indices are 16 bits, use Maze for bigger mazes");
+
+    typedef std::uint16_t CellIndex;
+
+    static constexpr std::size_t NUM_CELLS = static_cast<std::size_t>(NUM_ROWS) * NUM_COLS;
+    static constexpr std::size_t NUM_WORDS = (NUM_CELLS + 63) / 64;
+    static constexpr CellIndex INVALID_CELL = 0xFFFF;
+
+    typedef std::array<std::uint64_t, NUM_WORDS> CellBits;
+
+    /**
+     * Row-major index offset to the neighbor in each cardinal direction, see Maze::NORTH_DIRECTION
+    */
+    static constexpr int NEIGHBOR_OFFSETS[4] = { -NUM_COLS, NUM_COLS, 1, -1 };
+
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates an empty maze: no entrance, exit or path cells, and every wall closed
+     * --------------------------------------------------------------------------------------
+    */
+    StaticMaze()
+    {
+        reset();
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * reset()
+     * 
+     * Returns the maze to the state it was constructed in, see Maze::reset()
+     * --------------------------------------------------------------------------------------
+    */
+    void reset()
+    {
+        m_southWalls.fill(0);
+        m_eastWalls.fill(0);
+        m_pathBits.fill(0);
+        m_entranceIndex = INVALID_CELL;
+        m_exitIndex = INVALID_CELL;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getROWCELLS() / getCOLCELLS() / getNumCells()
+     * 
+     * Returns the number of rows, columns and cells in the maze, as Maze does
+     * --------------------------------------------------------------------------------------
+    */
+    static constexpr int getROWCELLS()
+    {
+        return NUM_ROWS;
+    }
+
+    static constexpr int getCOLCELLS()
+    {
+        return NUM_COLS;
+    }
+
+    static constexpr std::size_t getNumCells()
+    {
+        return NUM_CELLS;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * cellIndex()
+     * 
+     * Returns the row-major index of a cell
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @return row * NUM_COLS + col
+     * --------------------------------------------------------------------------------------
+    */
+    static constexpr CellIndex cellIndex(int row, int col)
+    {
+        return static_cast<CellIndex>(row * NUM_COLS + col);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getNeighborDirs()
+     * 
+     * Returns the directions leading from a cell to a cell of the maze, in the order North, 
+     * South, East, West
+     *     Read from a constexpr table built with the class, see buildNeighborDirs()
+     * 
+     * @param[in] index Row-major index of the cell
+     * @return the number of directions in bits 0 to 2, and direction k in bits 3 + 2k and 
+     * 4 + 2k
+     * --------------------------------------------------------------------------------------
+    */
+    static std::uint16_t getNeighborDirs(CellIndex index)
+    {
+        return NEIGHBOR_DIRS[index];
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getBorderMask()
+     * 
+     * Returns the cells that have a neighbor in a direction, so the cells not in it are the 
+     * ones facing the maze border on that side
+     * 
+     * @param[in] dir Cardinal direction
+     * @return one bit per cell, row-major
+     * --------------------------------------------------------------------------------------
+    */
+    static const CellBits& getBorderMask(int dir)
+    {
+        return BORDER_MASKS[dir];
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * openPassage()
+     * 
+     * Opens the wall on the given side of a cell, see Maze::openPassage()
+     * 
+     * @param[in] index Row-major index of cell
+     * @param[in] dir   Cardinal direction of the passage to open, must not face the maze border
+     * --------------------------------------------------------------------------------------
+    */
+    void openPassage(CellIndex index, int dir)
+    {
+        switch(dir)
+        {
+            case Maze::NORTH_DIRECTION:
+                setBit(m_southWalls, index - NUM_COLS);
+                break;
+            case Maze::SOUTH_DIRECTION:
+                setBit(m_southWalls, index);
+                break;
+            case Maze::EAST_DIRECTION:
+                setBit(m_eastWalls, index);
+                break;
+            case Maze::WEST_DIRECTION:
+                setBit(m_eastWalls, index - 1);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void openPassage(int row, int col, int dir)
+    {
+        openPassage(cellIndex(row, col), dir);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * isWallOpen()
+     * 
+     * Checks if the wall on the given side of a cell is open, see Maze::isWallOpen()
+     *     Walls facing the maze border are always closed
+     * 
+     * @param[in] index Row-major index of cell
+     * @param[in] dir   Cardinal direction of the wall to check
+     * @return true if there is a passageway in the given direction, false otherwise
+     * --------------------------------------------------------------------------------------
+    */
+    bool isWallOpen(CellIndex index, int dir) const
+    {
+        switch(dir)
+        {
+            case Maze::NORTH_DIRECTION:
+                return index >= NUM_COLS && isBitSet(m_southWalls, index - NUM_COLS);
+            case Maze::SOUTH_DIRECTION:
+                return isBitSet(m_southWalls, index);
+            case Maze::EAST_DIRECTION:
+                return isBitSet(m_eastWalls, index);
+            case Maze::WEST_DIRECTION:
+                return index % NUM_COLS != 0 && isBitSet(m_eastWalls, index - 1);
+            default:
+                return false;
+        }
+    }
+
+    bool isWallOpen(int row, int col, int dir) const
+    {
+        return isWallOpen(cellIndex(row, col), dir);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * labelMazeEntrance() / labelMazeExit()
+     * 
+     * Labels a cell as the entrance or the exit of the maze
+     * 
+     * @param[in] row Row index of cell to be labeled
+     * @param[in] col Column index of cell to be labeled
+     * --------------------------------------------------------------------------------------
+    */
+    void labelMazeEntrance(int row, int col)
+    {
+        m_entranceIndex = cellIndex(row, col);
+    }
+
+    void labelMazeExit(int row, int col)
+    {
+        m_exitIndex = cellIndex(row, col);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getEntrance() / getExit()
+     * 
+     * Returns the location (row, col) of the maze entrance or exit, as Maze does
+     * 
+     * @return a tuple<int, int>, (Maze::INVALID_ROW_COL, Maze::INVALID_ROW_COL) if there is none
+     * --------------------------------------------------------------------------------------
+    */
+    std::tuple<int, int> getEntrance() const
+    {
+        return cellRowCol(m_entranceIndex);
+    }
+
+    std::tuple<int, int> getExit() const
+    {
+        return cellRowCol(m_exitIndex);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getEntranceIndex() / getExitIndex()
+     * 
+     * Returns the row-major index of the maze entrance or exit
+     * 
+     * @return the index of the cell, INVALID_CELL if there is none
+     * --------------------------------------------------------------------------------------
+    */
+    CellIndex getEntranceIndex() const
+    {
+        return m_entranceIndex;
+    }
+
+    CellIndex getExitIndex() const
+    {
+        return m_exitIndex;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * labelCellAsPath() / isCellOnPath() / clearPath()
+     * 
+     * Labels a cell as part of the path from the maze entrance to the maze exit, checks the 
+     * label, or removes it from every cell
+     * 
+     * @param[in] index Row-major index of cell
+     * --------------------------------------------------------------------------------------
+    */
+    void labelCellAsPath(CellIndex index)
+    {
+        setBit(m_pathBits, index);
+    }
+
+    bool isCellOnPath(CellIndex index) const
+    {
+        return isBitSet(m_pathBits, index);
+    }
+
+    bool isCellOnPath(int row, int col) const
+    {
+        return isCellOnPath(cellIndex(row, col));
+    }
+
+    void clearPath()
+    {
+        m_pathBits.fill(0);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getSouthWalls() / getEastWalls() / getPathBits()
+     * 
+     * Returns the open south walls, the open east walls or the path cells as one bit per 
+     * cell, row-major
+     * --------------------------------------------------------------------------------------
+    */
+    const CellBits& getSouthWalls() const
+    {
+        return m_southWalls;
+    }
+
+    const CellBits& getEastWalls() const
+    {
+        return m_eastWalls;
+    }
+
+    const CellBits& getPathBits() const
+    {
+        return m_pathBits;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * copyToMaze()
+     * 
+     * Copies the walls, entrance, exit and path into a Maze, so the maze can be written or 
+     * drawn by everything that takes a Maze
+     * 
+     * @param[in,out] maze Maze of the same dimensions, reset and updated to match this one
+     * @return false if the dimensions differ
+     * --------------------------------------------------------------------------------------
+    */
+    bool copyToMaze(Maze& maze) const
+    {
+        if(maze.getROWCELLS() != NUM_ROWS || maze.getCOLCELLS() != NUM_COLS)
+        {
+            std::cerr << "ERROR: StaticMaze::copyToMaze() was given a " << maze.getROWCELLS() << "x" << maze.getCOLCELLS() \
+                      << " maze for a " << NUM_ROWS << "x" << NUM_COLS << " one" << std::endl;
+            return false;
+        }
+
+        maze.reset();
+        for(int row = 0; row < NUM_ROWS; row++)
+        {
+            for(int col = 0; col < NUM_COLS; col++)
+            {
+                const CellIndex index = cellIndex(row, col);
+                if(isBitSet(m_southWalls, index))
+                {
+                    maze.openPassage(row, col, Maze::SOUTH_DIRECTION);
+                }
+                if(isBitSet(m_eastWalls, index))
+                {
+                    maze.openPassage(row, col, Maze::EAST_DIRECTION);
+                }
+                if(isBitSet(m_pathBits, index))
+                {
+                    maze.labelCellAsPath(row, col);
+                }
+            }
+        }
+
+        if(m_entranceIndex != INVALID_CELL)
+        {
+            maze.labelMazeEntrance(m_entranceIndex / NUM_COLS, m_entranceIndex % NUM_COLS);
+        }
+        if(m_exitIndex != INVALID_CELL)
+        {
+            maze.labelMazeExit(m_exitIndex / NUM_COLS, m_exitIndex % NUM_COLS);
+        }
+        return true;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * setBit() / isBitSet()
+     * 
+     * Sets or reads the bit of one cell in a row-major cell bitset
+     * --------------------------------------------------------------------------------------
+    */
+    static void setBit(CellBits& bits, std::size_t index)
+    {
+        bits[index >> 6] |= std::uint64_t(1) << (index & 63);
+    }
+
+    static bool isBitSet(const CellBits& bits, std::size_t index)
+    {
+        return (bits[index >> 6] >> (index & 63)) & 1;
+    }
+
+private:
+    /**--------------------------------------------------------------------------------------
+     * buildNeighborDirs() / buildBorderMasks()
+     * 
+     * Build the constexpr tables of getNeighborDirs() and getBorderMask()
+     * --------------------------------------------------------------------------------------
+    */
+    static constexpr std::array<std::uint16_t, NUM_CELLS> buildNeighborDirs()
+    {
+        std::array<std::uint16_t, NUM_CELLS> neighborDirs{};
+        for(int row = 0; row < NUM_ROWS; row++)
+        {
+            for(int col = 0; col < NUM_COLS; col++)
+            {
+                const bool hasNeighbor[4] = { row > 0, row < NUM_ROWS - 1, col < NUM_COLS - 1, col > 0 };
+                int numDirs = 0;
+                int packedDirs = 0;
+                for(int dir = 0; dir < 4; dir++)
+                {
+                    if(hasNeighbor[dir])
+                    {
+                        packedDirs |= dir << (3 + 2 * numDirs);
+                        numDirs++;
+                    }
+                }
+                neighborDirs[static_cast<std::size_t>(row) * NUM_COLS + col] = static_cast<std::uint16_t>(packedDirs | numDirs);
+            }
+        }
+        return neighborDirs;
+    }
+
+    static constexpr std::array<CellBits, 4> buildBorderMasks()
+    {
+        std::array<CellBits, 4> borderMasks{};
+        for(std::size_t index = 0; index < NUM_CELLS; index++)
+        {
+            const int row = static_cast<int>(index / NUM_COLS);
+            const int col = static_cast<int>(index % NUM_COLS);
+            const bool hasNeighbor[4] = { row > 0, row < NUM_ROWS - 1, col < NUM_COLS - 1, col > 0 };
+            for(int dir = 0; dir < 4; dir++)
+            {
+                if(hasNeighbor[dir])
+                {
+                    borderMasks[dir][index >> 6] |= std::uint64_t(1) << (index & 63);
+                }
+            }
+        }
+        return borderMasks;
+    }
+
+    static std::tuple<int, int> cellRowCol(CellIndex index)
+    {
+        if(index == INVALID_CELL)
+        {
+            return std::make_tuple(Maze::INVALID_ROW_COL, Maze::INVALID_ROW_COL);
+        }
+        return std::make_tuple(index / NUM_COLS, index % NUM_COLS);
+    }
+
+    static constexpr std::array<std::uint16_t, NUM_CELLS> NEIGHBOR_DIRS = buildNeighborDirs();
+    static constexpr std::array<CellBits, 4> BORDER_MASKS = buildBorderMasks();
+
+    /**
+     * Maze state, one bit per cell, row-major
+     *     m_southWalls, m_eastWalls: set if the wall on that side of the cell is open
+     *     m_pathBits: set if the cell is labeled as part of the path
+    */
+    CellBits m_southWalls;
+    CellBits m_eastWalls;
+    CellBits m_pathBits;
+    CellIndex m_entranceIndex;
+    CellIndex m_exitIndex;
+};
+
+/**--------------------------------------------------------------------------------------
+ * runWilson()
+ * 
+ * Given an "empty" StaticMaze, uses Wilson's Algorithm to create an unbiased maze, same as 
+ * runWilson() on a Maze, with the scratch state in std::arrays on the stack
+ *     Draws from the engine in the same order as runWilson() on a Maze without the 
+ *     Aldous-Broder start, so the same engine state gives the same maze as a Maze of the 
+ *     same size would get, see StaticMaze::copyToMaze()
+ *     Walks step by the constexpr neighbor offsets, and the next walk starts from the 
+ *     lowest cell outside the maze, found a 64-bit word at a time
+ * 
+ * @param[in,out] blankMaze "empty" StaticMaze, updates it so that every cell in the grid is 
+ * connected to each other, and an entrance and exit cell both exist
+ * @param[in,out] rng Random number engine driving the random walks
+ * @return the total number of random walk steps taken to fill out the maze
+ * --------------------------------------------------------------------------------------
+*/
+template <int NUM_ROWS, int NUM_COLS, typename RngEngine>
+std::uint64_t runWilson(StaticMaze<NUM_ROWS, NUM_COLS>& blankMaze, RngEngine& rng)
+{
+    typedef StaticMaze<NUM_ROWS, NUM_COLS> MazeType;
+    typedef typename MazeType::CellIndex CellIndex;
+
+    // One bit per cell "in" the maze, and the last direction of exit from each cell, reused by every random walk
+    typename MazeType::CellBits inMaze{};
+    std::array<std::uint8_t, MazeType::NUM_CELLS> walkDirs;
+    std::uint64_t numWalkSteps = 0;
+
+    const int randR = static_cast<int>(randomBelow(rng, NUM_ROWS));
+    const int randC = static_cast<int>(randomBelow(rng, NUM_COLS));
+    MazeType::setBit(inMaze, MazeType::cellIndex(randR, randC));
+
+    for(std::size_t word = 0; word < MazeType::NUM_WORDS; word++)
+    {
+        // Bits past the last cell count as "in" the maze, so they are never picked
+        const std::size_t numCellsInWord = (word + 1 < MazeType::NUM_WORDS) ? 64 : MazeType::NUM_CELLS - 64 * word;
+        const std::uint64_t cellsInWord = (numCellsInWord == 64) ? ~std::uint64_t(0) : (std::uint64_t(1) << numCellsInWord) - 1;
+
+        while((inMaze[word] & cellsInWord) != cellsInWord)
+        {
+            const CellIndex startIndex = static_cast<CellIndex>(64 * word + countTrailingZeros(~inMaze[word] & cellsInWord));
+
+            // Loop-erased random walk until reaching a cell "in" the maze
+            CellIndex curIndex = startIndex;
+            while(!MazeType::isBitSet(inMaze, curIndex))
+            {
+                const std::uint16_t neighborDirs = MazeType::getNeighborDirs(curIndex);
+                const int numDirs = neighborDirs & 7;
+                const int dir = (numDirs == 4) ? randomDirection(rng) : \
+                                (neighborDirs >> (3 + 2 * randomBelow(rng, static_cast<std::uint32_t>(numDirs)))) & 3;
+
+                walkDirs[curIndex] = static_cast<std::uint8_t>(dir);
+                curIndex = static_cast<CellIndex>(curIndex + MazeType::NEIGHBOR_OFFSETS[dir]);
+                numWalkSteps++;
+            }
+
+            // Travel along the loop-erased path, adding each cell to the maze
+            curIndex = startIndex;
+            while(!MazeType::isBitSet(inMaze, curIndex))
+            {
+                const int dir = walkDirs[curIndex];
+                MazeType::setBit(inMaze, curIndex);
+                blankMaze.openPassage(curIndex, dir);
+                curIndex = static_cast<CellIndex>(curIndex + MazeType::NEIGHBOR_OFFSETS[dir]);
+            }
+        }
+    }
+
+    int entranceRow = Maze::INVALID_ROW_COL;
+    int entranceCol = Maze::INVALID_ROW_COL;
+    int exitRow = Maze::INVALID_ROW_COL;
+    int exitCol = Maze::INVALID_ROW_COL;
+    chooseEntranceAndExit(NUM_ROWS, NUM_COLS, rng, entranceRow, entranceCol, exitRow, exitCol);
+    blankMaze.labelMazeEntrance(entranceRow, entranceCol);
+    blankMaze.labelMazeExit(exitRow, exitCol);
+
+    return numWalkSteps;
+}
+
+/**--------------------------------------------------------------------------------------
+ * runTremaux()
+ * 
+ * Finds the path from the entrance to the exit of a StaticMaze with Tremaux's Algorithm, 
+ * same as runTremaux() on a Maze, with the marks and the stack in std::arrays on the stack
+ *     Every cell entered is marked, and a passage into a marked cell is never taken, so the 
+ *     walk ends at dead ends and backtracks. The cells left on the stack when it reaches 
+ *     the exit are the path
+ * 
+ * @param[in,out] unsolvedMaze StaticMaze with passageways, an entrance and an exit, updated 
+ * so that the cells on the path from the entrance to the exit are labeled as path cells
+ * @return true if a path was found
+ * --------------------------------------------------------------------------------------
+*/
+template <int NUM_ROWS, int NUM_COLS>
+bool runTremaux(StaticMaze<NUM_ROWS, NUM_COLS>& unsolvedMaze)
+{
+    typedef StaticMaze<NUM_ROWS, NUM_COLS> MazeType;
+    typedef typename MazeType::CellIndex CellIndex;
+
+    const CellIndex entranceIndex = unsolvedMaze.getEntranceIndex();
+    const CellIndex exitIndex = unsolvedMaze.getExitIndex();
+    if(entranceIndex == MazeType::INVALID_CELL || exitIndex == MazeType::INVALID_CELL)
+    {
+        std::cerr << "ERROR: runTremaux() was given a StaticMaze without an entrance or an exit" << std::endl;
+        return false;
+    }
+
+    // Traversal stack, each cell with the next direction to try from it
+    typename MazeType::CellBits marked{};
+    std::array<CellIndex, MazeType::NUM_CELLS> stackCells;
+    std::array<std::uint8_t, MazeType::NUM_CELLS> stackDirs;
+    std::size_t stackSize = 0;
+
+    stackCells[stackSize] = entranceIndex;
+    stackDirs[stackSize++] = 0;
+    MazeType::setBit(marked, entranceIndex);
+
+    while(stackSize > 0 && stackCells[stackSize - 1] != exitIndex)
+    {
+        const CellIndex curIndex = stackCells[stackSize - 1];
+        std::uint8_t& nextDir = stackDirs[stackSize - 1];
+
+        while(nextDir < 4)
+        {
+            const int dir = nextDir++;
+            const CellIndex nextIndex = static_cast<CellIndex>(curIndex + MazeType::NEIGHBOR_OFFSETS[dir]);
+            if(unsolvedMaze.isWallOpen(curIndex, dir) && !MazeType::isBitSet(marked, nextIndex))
+            {
+                MazeType::setBit(marked, nextIndex);
+                stackCells[stackSize] = nextIndex;
+                stackDirs[stackSize++] = 0;
+                break;
+            }
+        }
+
+        // Dead end, backtrack
+        if(nextDir == 4 && stackCells[stackSize - 1] == curIndex)
+        {
+            stackSize--;
+        }
+    }
+
+    for(std::size_t i = 0; i < stackSize; i++)
+    {
+        unsolvedMaze.labelCellAsPath(stackCells[i]);
+    }
+
+    return stackSize > 0;
+}
@@ -34,9 +34,96 @@
 
 #include "tremaux.h"
 #include "logger.h"
+#include "metrics.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 
+/**--------------------------------------------------------------------------------------
+ * Constructor
+ * 
+ * Creates a context with storage for mazes of up to uRows x uCols cells
+ * 
+ * @param[in] uRows Number of rows to preallocate for
+ * @param[in] uCols Number of columns to preallocate for
+ * --------------------------------------------------------------------------------------
+*/
+TremauxContext::TremauxContext(int uRows, int uCols)
+    : m_numCols(uCols),
+      m_marks(static_cast<std::size_t>(uRows) * static_cast<std::size_t>(uCols), 0),
+      m_pathBits((static_cast<std::size_t>(uRows) * static_cast<std::size_t>(uCols) + 63) / 64, 0)
+{
+}
+
+/**--------------------------------------------------------------------------------------
+ * beginSolve()
+ * 
+ * Clears the marks, traversal stack and path of the previous solve, and sizes the 
+ * context for the given maze
+ *     Only grows the storage if the maze has more cells than any maze solved before
+ * 
+ * @param[in] maze Maze about to be solved
+ * --------------------------------------------------------------------------------------
+*/
+void TremauxContext::beginSolve(const Maze& maze)
+{
+    std::size_t numCells = maze.getNumCells();
+
+    // Only the bits of the previous path are set, clearing just those
+    for(std::size_t pathIndex : m_path)
+    {
+        m_pathBits[pathIndex >> 6] &= ~(std::uint64_t(1) << (pathIndex & 63));
+    }
+    m_path.clear();
+    m_compactPath.clear();
+    m_traversedPath.clear();
+
+    if(m_marks.size() < numCells)
+    {
+        m_marks.resize(numCells);
+        m_pathBits.resize((numCells + 63) / 64, 0);
+    }
+    std::fill(m_marks.begin(), m_marks.begin() + static_cast<std::ptrdiff_t>(numCells), 0);
+    m_numCols = maze.getCOLCELLS();
+}
+
+/**--------------------------------------------------------------------------------------
+ * finishPath()
+ * 
+ * Records the cells left on the traversal stack as the path found by the solve, both as a 
+ * list of cells and as a compact path
+ * --------------------------------------------------------------------------------------
+*/
+void TremauxContext::finishPath()
+{
+    // The bottom of the stack is the start cell, the top is the end cell
+    for(const std::tuple<int, int, int>& instruction : m_traversedPath)
+    {
+        std::size_t pathIndex = static_cast<std::size_t>(std::get<0>(instruction)) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(std::get<1>(instruction));
+        m_path.push_back(pathIndex);
+        m_pathBits[pathIndex >> 6] |= std::uint64_t(1) << (pathIndex & 63);
+        m_compactPath.appendCell(std::get<0>(instruction), std::get<1>(instruction));
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * labelPath()
+ * 
+ * Labels every cell on the path found by the last solve as a path cell of the maze
+ * 
+ * @param[in,out] maze Maze that was solved, updated so the cells on the path are labeled
+ * as path cells
+ * --------------------------------------------------------------------------------------
+*/
+void TremauxContext::labelPath(Maze& maze) const
+{
+    for(std::size_t pathIndex : m_path)
+    {
+        maze.labelCellAsPath(static_cast<int>(pathIndex / static_cast<std::size_t>(m_numCols)), static_cast<int>(pathIndex % static_cast<std::size_t>(m_numCols)));
+    }
+}
+
 /**--------------------------------------------------------------------------------------
  * takeStep()
  * 
@@ -95,11 +182,10 @@ int oppositeDirection(int dir)
  *     Takes the given traversed path, continuously removes the latest cell visited until 
  *     reaching a junction or the beginning of the maze
  * 
- * @param[in,out]   traversedPath       Stack of tuple<int, int, int> representing the 
- * current path travelled. Tuples are formatted as <row, col, direction of exit>. Updates 
- * the stack until reaching the previous junction
- * @param[in,out]   unolvedMaze         Maze object with passageways, an entrance and an 
- * exit, is updated with new marks on the previous junction cell
+ * @param[in]       unsolvedMaze        Maze object with passageways, not modified
+ * @param[in,out]   context             Context of the solve, its stack of traversed cells 
+ * (tuple<int, int, int> formatted as <row, col, direction of exit>) is updated until 
+ * reaching the previous junction, and the previous junction cell gets new marks
  * @param[in,out]   curRow              Current row index before backtracking, is updated 
  * to current row index after backtracking is finished
  * @param[in,out]   curCol              Current column index before backtracking, is 
@@ -113,16 +199,27 @@ int oppositeDirection(int dir)
  * direction used to enter latest junction cell after backtracking is finished
  * @param[in]       startRow            Row index of the maze entrance
  * @param[in]       startCol            Column index of the maze entrance
+ * @return false if the stack ran out before reaching a junction, meaning there is no path
  * --------------------------------------------------------------------------------------
 */
-void backTrack(std::stack<std::tuple<int, int, int>>& traversedPath, Maze& unsolvedMaze, \
+bool backTrack(const Maze& unsolvedMaze, TremauxContext& context, \
                int& curRow, int& curCol, int& exitedPrevThrough, int& enteredCurThrough, int startRow, int startCol)
 {
+    std::vector<std::tuple<int, int, int>>& traversedPath = context.getTraversedPath();
+    if(traversedPath.empty())
+    {
+        return false;
+    }
+
+    // The stack only shrinks while backtracking, so it is at its deepest right before
+    METRIC_ADD(METRIC_BACKTRACKS, 1)
+    METRIC_MAX(METRIC_TREMAUX_STACK_MAX, traversedPath.size())
+
     // Start backtracking to return to the last junction (or to the maze entrance if it was the last junction)
-    std::tuple<int, int, int> curBacktrackInstructions = traversedPath.top();
+    std::tuple<int, int, int> curBacktrackInstructions = traversedPath.back();
     while(true)
     {
-        Cell& curBacktrackCell = unsolvedMaze.findCell(std::get<0>(curBacktrackInstructions), std::get<1>(curBacktrackInstructions));
+        Cell curBacktrackCell = context.findCell(unsolvedMaze, std::get<0>(curBacktrackInstructions), std::get<1>(curBacktrackInstructions));
 
         // When encountering a junction, exit the while loop
         if(curBacktrackCell.isCellJunction() || (curBacktrackCell.isItThisCell(startRow, startCol) && curBacktrackCell.isCellEntranceAndJunction()))
@@ -130,15 +227,19 @@ void backTrack(std::stack<std::tuple<int, int, int>>& traversedPath, Maze& unsol
             break;
         }
 
-        traversedPath.pop();
+        traversedPath.pop_back();
+        METRIC_ADD(METRIC_BACKTRACK_STEPS, 1)
         LOG_DEBUG("Backtrack: removed instruction (" << std::get<0>(curBacktrackInstructions) << ", " << std::get<1>(curBacktrackInstructions) \
                   << "), exitDir " << std::get<2>(curBacktrackInstructions) << " from the traversedPath stack")
 
-        curBacktrackInstructions = traversedPath.top();
-        curBacktrackCell = unsolvedMaze.findCell(std::get<0>(curBacktrackInstructions), std::get<1>(curBacktrackInstructions));
+        if(traversedPath.empty())
+        {
+            return false;
+        }
+        curBacktrackInstructions = traversedPath.back();
     }
 
-    Cell& finalBacktrackCell = unsolvedMaze.findCell(std::get<0>(curBacktrackInstructions), std::get<1>(curBacktrackInstructions));
+    Cell finalBacktrackCell = context.findCell(unsolvedMaze, std::get<0>(curBacktrackInstructions), std::get<1>(curBacktrackInstructions));
 
     // Mark the exit we last took from this junction
     exitedPrevThrough = std::get<2>(curBacktrackInstructions);
@@ -155,41 +256,47 @@ void backTrack(std::stack<std::tuple<int, int, int>>& traversedPath, Maze& unsol
               << "), exitDir " << std::get<2>(curBacktrackInstructions) << " from the traversedPath stack\n" \
               << "-------------------" << finalBacktrackCell.getStringMarks())
     // Pop the junction (or beginning of the maze) from the stack so we can traverse it again
-    traversedPath.pop();
+    traversedPath.pop_back();
+    METRIC_ADD(METRIC_BACKTRACK_STEPS, 1)
 
     if(traversedPath.empty())
     {
         LOG_DEBUG("-------------------Back to beginning")
     }
+    return true;
 }
 
 /**--------------------------------------------------------------------------------------
  * runTremaux()
  * 
- * Iteratively traverses maze, stopping at junctions and travelling down each path until 
- * either encountering the exit or reaching a dead end, upon which the algorithm will 
- * backtrack and try a different path
- *     Functions as a human-friendly DFS approach to maze navigation
+ * Finds a path from a start cell to an end cell with Tremaux's Algorithm, keeping every 
+ * mark and the path in the given context
+ *     The maze is only read, so several threads can solve the same maze at once, each with
+ *     its own context
  * 
- * @param[in,out] unsolvedMaze Maze object where the path from the entrance to the exit 
- * is unknown, updates the Maze object so that the cells on the path from the entrance to
- * the exit are labeled as path cells
+ * @param[in]       maze        Maze object with passageways, not modified
+ * @param[in,out]   context     Context to solve in, updated to hold the path from the start 
+ * cell to the end cell
+ * @param[in]       startRow    Row index of the cell to start from
+ * @param[in]       startCol    Column index of the cell to start from
+ * @param[in]       endRow      Row index of the cell to find a path to
+ * @param[in]       endCol      Column index of the cell to find a path to
+ * @return true if a path was found, false once the walk is left with no exit that was not 
+ * walked both ways already, so the end cell cannot be reached from the start cell
  * --------------------------------------------------------------------------------------
 */
-void runTremaux(Maze& unsolvedMaze)
+bool runTremaux(const Maze& maze, TremauxContext& context, int startRow, int startCol, int endRow, int endCol)
 {
-    std::tuple<int, int> startCoords = unsolvedMaze.getEntrance();
-    std::tuple<int, int> endCoords = unsolvedMaze.getExit();
+    context.beginSolve(maze);
+    if(startRow < 0 || startRow >= maze.getROWCELLS() || startCol < 0 || startCol >= maze.getCOLCELLS() || \
+       endRow < 0 || endRow >= maze.getROWCELLS() || endCol < 0 || endCol >= maze.getCOLCELLS())
+    {
+        std::cerr << "ERROR: runTremaux() was given a start or end cell outside of the maze grid" << std::endl;
+        return false;
+    }
 
     // Stack of traversed cells
-    std::stack<std::tuple<int, int, int>> traversedPath;
-
-    int startRow = std::get<0>(startCoords);
-    int startCol = std::get<1>(startCoords);
-
-    int endRow = std::get<0>(endCoords);
-    int endCol = std::get<1>(endCoords);
-    
+    std::vector<std::tuple<int, int, int>>& traversedPath = context.getTraversedPath();
     int curRow = startRow;
     int curCol = startCol;
 
@@ -199,29 +306,34 @@ void runTremaux(Maze& unsolvedMaze)
     // Indicates which direction was used to exit the previous cell
     int exitedPrevThrough = Maze::INVALID_CARDINAL_DIRECTION;
 
-    int numLoops = 0;
     while(true)
     {   
-        Cell& curCell = unsolvedMaze.findCell(curRow, curCol);
+        Cell curCell = context.findCell(maze, curRow, curCol);
+        METRIC_ADD(METRIC_TREMAUX_STEPS, 1)
         LOG_DEBUG("    Current cell: (" << curRow << ", " << curCol << "), entered from : " << enteredCurThrough << "\n" \
                   << "    --------Current cell " << curCell.getStringMarks())
 
         if(curRow == endRow && curCol == endCol)
         {
-            traversedPath.push(std::make_tuple(curRow, curCol, 100));
+            traversedPath.push_back(std::make_tuple(curRow, curCol, 100));
             LOG_DEBUG("      Tremaux reached maze exit")
             break;
         }
         else if(curCell.isCellJunction() || (curCell.isItThisCell(startRow, startCol) && curCell.isCellEntranceAndJunction()))
         {
+            METRIC_ADD(METRIC_JUNCTION_VISITS, 1)
             if(enteredCurThrough == Maze::INVALID_CARDINAL_DIRECTION) // Just started traversing the maze, pick any valid direction
             {
                 exitedPrevThrough = curCell.getDirFewestMarks();
+                if(exitedPrevThrough == Maze::INVALID_CARDINAL_DIRECTION)
+                {
+                    return false;
+                }
                 enteredCurThrough = oppositeDirection(exitedPrevThrough);
 
                 curCell.markCellExit(exitedPrevThrough);
 
-                traversedPath.push(std::make_tuple(curRow, curCol, exitedPrevThrough));
+                traversedPath.push_back(std::make_tuple(curRow, curCol, exitedPrevThrough));
                 LOG_DEBUG("    Added a instruction: (" << curRow << ", " << curCol << "), exitDir: " << exitedPrevThrough << " to the traversedPath stack")
                 takeStep(curRow, curCol, exitedPrevThrough);
             }
@@ -230,56 +342,85 @@ void runTremaux(Maze& unsolvedMaze)
                 curCell.markCellExit(enteredCurThrough);
 
                 exitedPrevThrough = curCell.getDirFewestMarks();
+                if(exitedPrevThrough == Maze::INVALID_CARDINAL_DIRECTION)
+                {
+                    return false;
+                }
                 enteredCurThrough = oppositeDirection(exitedPrevThrough);
 
                 curCell.markCellExit(exitedPrevThrough);
 
-                traversedPath.push(std::make_tuple(curRow, curCol, exitedPrevThrough));
+                traversedPath.push_back(std::make_tuple(curRow, curCol, exitedPrevThrough));
                 LOG_DEBUG("    Added a instruction: (" << curRow << ", " << curCol << "), exitDir: " << exitedPrevThrough << " to the traversedPath stack")
                 takeStep(curRow, curCol, exitedPrevThrough);
             }
             else if(curCell.isThisDirMarkedTwice(enteredCurThrough)) // The entrance to this cell we came through is marked twice, pick exit direction with fewest marks
             {
-                if(curCell.isCellJunctionAllDirFilled()) // Every exit to the junction except one is filled, remove the junction from the traversedPath and begin backtracking to previous junction
+                // Every exit to the junction except one is filled, remove the junction from the traversedPath and begin backtracking to previous junction
+                //     The entrance has no previous junction to return to, so its last unfilled exit is explored instead
+                if(!curCell.isItThisCell(startRow, startCol) && curCell.isCellJunctionAllDirFilled())
                 {
                     exitedPrevThrough = curCell.getDirFewestMarks();
+                    if(exitedPrevThrough == Maze::INVALID_CARDINAL_DIRECTION)
+                    {
+                        return false;
+                    }
                     enteredCurThrough = oppositeDirection(exitedPrevThrough);
 
                     curCell.markCellExit(exitedPrevThrough);
 
                     // Dont push the current junction to traversedPath, instead start backtracking
                     LOG_DEBUG("From closed junction: started backtracking")
-                    backTrack(traversedPath, unsolvedMaze, curRow, curCol, exitedPrevThrough, enteredCurThrough, startRow, startCol);
+                    if(!backTrack(maze, context, curRow, curCol, exitedPrevThrough, enteredCurThrough, startRow, startCol))
+                    {
+                        return false;
+                    }
                 }
                 else
                 {
                     exitedPrevThrough = curCell.getDirFewestMarks();
+                    if(exitedPrevThrough == Maze::INVALID_CARDINAL_DIRECTION)
+                    {
+                        return false;
+                    }
                     enteredCurThrough = oppositeDirection(exitedPrevThrough);
 
                     curCell.markCellExit(exitedPrevThrough);
 
-                    traversedPath.push(std::make_tuple(curRow, curCol, exitedPrevThrough));
+                    traversedPath.push_back(std::make_tuple(curRow, curCol, exitedPrevThrough));
                     LOG_DEBUG("    Added a instruction: (" << curRow << ", " << curCol << "), exitDir: " << exitedPrevThrough << " to the traversedPath stack")
                     takeStep(curRow, curCol, exitedPrevThrough);
                 }
             }
             else // The entrance to this cell we came through is marked once, and other exits have marks
             {
+                // Only a maze with loops gets back to a junction through a new passage. The passage is 
+                // marked twice so the junction never takes it, then the walk turns back down it
+                curCell.markCellExit(enteredCurThrough);
+                curCell.markCellExit(enteredCurThrough);
+
                 // Backtrack to the last junction
                 int temp = exitedPrevThrough;
                 exitedPrevThrough = enteredCurThrough;
                 enteredCurThrough = temp;
 
                 LOG_DEBUG("Started backtracking")
-                backTrack(traversedPath, unsolvedMaze, curRow, curCol, exitedPrevThrough, enteredCurThrough, startRow, startCol);
+                if(!backTrack(maze, context, curRow, curCol, exitedPrevThrough, enteredCurThrough, startRow, startCol))
+                {
+                    return false;
+                }
             }
         }
         else if(curCell.isItThisCell(startRow, startCol)) // Edge case where there is only one exit from the entrance cell
         {
             exitedPrevThrough = curCell.getDirFewestMarks();
+            if(exitedPrevThrough == Maze::INVALID_CARDINAL_DIRECTION)
+            {
+                return false;
+            }
             enteredCurThrough = oppositeDirection(exitedPrevThrough);
 
-            traversedPath.push(std::make_tuple(curRow, curCol, exitedPrevThrough));
+            traversedPath.push_back(std::make_tuple(curRow, curCol, exitedPrevThrough));
             LOG_DEBUG("    Added a instruction: (" << curRow << ", " << curCol << "), exitDir: " << exitedPrevThrough << " to the traversedPath stack")
             takeStep(curRow, curCol, exitedPrevThrough);
         }
@@ -291,33 +432,136 @@ void runTremaux(Maze& unsolvedMaze)
             enteredCurThrough = temp;
 
             LOG_DEBUG("Started backtracking")
-            backTrack(traversedPath, unsolvedMaze, curRow, curCol, exitedPrevThrough, enteredCurThrough, startRow, startCol);
+            if(!backTrack(maze, context, curRow, curCol, exitedPrevThrough, enteredCurThrough, startRow, startCol))
+            {
+                return false;
+            }
         }
         else // Current cell is part of a passageway, continue down said passageway
         {
             exitedPrevThrough = curCell.findDirOnlyOtherExit(enteredCurThrough);
             enteredCurThrough = oppositeDirection(exitedPrevThrough);
 
-            traversedPath.push(std::make_tuple(curRow, curCol, exitedPrevThrough));
+            traversedPath.push_back(std::make_tuple(curRow, curCol, exitedPrevThrough));
             LOG_DEBUG("    Added a instruction: (" << curRow << ", " << curCol << "), exitDir: " << exitedPrevThrough << " to the traversedPath stack")
             takeStep(curRow, curCol, exitedPrevThrough);
         }
     }
 
-    LOG_DEBUG("        BEFORE FINAL INSTRUCTIONS\n" \
-              << "            Final instructions num remaining: " << traversedPath.size())
+    LOG_DEBUG("        Final instructions num remaining: " << traversedPath.size())
+    METRIC_MAX(METRIC_TREMAUX_STACK_MAX, traversedPath.size())
     // Return the set of final instructions
-    while(!traversedPath.empty())
+    context.finishPath();
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * runTremaux()
+ * 
+ * Finds a path from the maze entrance to the maze exit with Tremaux's Algorithm, keeping 
+ * every mark and the path in the given context
+ * 
+ * @param[in]       maze    Maze object with passageways, an entrance and an exit, not modified
+ * @param[in,out]   context Context to solve in, updated to hold the path from the entrance 
+ * to the exit
+ * @return true if a path was found
+ * --------------------------------------------------------------------------------------
+*/
+bool runTremaux(const Maze& maze, TremauxContext& context)
+{
+    return runTremaux(maze, context, std::get<0>(maze.getEntrance()), std::get<1>(maze.getEntrance()), \
+                      std::get<0>(maze.getExit()), std::get<1>(maze.getExit()));
+}
+
+/**--------------------------------------------------------------------------------------
+ * runTremaux()
+ * 
+ * Iteratively traverses maze, stopping at junctions and travelling down each path until 
+ * either encountering the exit or reaching a dead end, upon which the algorithm will 
+ * backtrack and try a different path
+ *     Functions as a human-friendly DFS approach to maze navigation
+ * 
+ * @param[in,out] unsolvedMaze Maze object where the path from the entrance to the exit 
+ * is unknown, updates the Maze object so that the cells on the path from the entrance to
+ * the exit are labeled as path cells
+ *     Solves with a temporary TremauxContext, see the overloads taking a TremauxContext to reuse one
+ * --------------------------------------------------------------------------------------
+*/
+void runTremaux(Maze& unsolvedMaze)
+{
+    TremauxContext context(unsolvedMaze.getROWCELLS(), unsolvedMaze.getCOLCELLS());
+    if(runTremaux(unsolvedMaze, context))
+    {
+        context.labelPath(unsolvedMaze);
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * runTremaux()
+ * 
+ * Finds the path from the entrance to the exit of a GridGraph with Tremaux's Algorithm, 
+ * whatever its topology
+ *     Every cell entered is marked, and a passage into a marked cell is never taken, so the 
+ *     walk ends at dead ends and backtracks. The cells left on the stack when it reaches 
+ *     the exit are the path
+ *     Passages are read from the graph's adjacency arrays, one neighbor slot at a time
+ * 
+ * @param[in,out] unsolvedGraph GridGraph with passageways, an entrance and an exit, updated 
+ * so that the cells on the path from the entrance to the exit are labeled as path cells
+ * @return true if a path was found
+ * --------------------------------------------------------------------------------------
+*/
+bool runTremaux(GridGraph& unsolvedGraph)
+{
+    METRIC_TIMER(METRIC_SOLVE_TIMER)
+    const std::uint32_t entrance = unsolvedGraph.getEntrance();
+    const std::uint32_t exit = unsolvedGraph.getExit();
+    if(entrance == GridGraph::INVALID_CELL || exit == GridGraph::INVALID_CELL)
     {
-        std::tuple<int, int, int> curInstruction = traversedPath.top();
-        int pathRow = std::get<0>(curInstruction);
-        int pathCol = std::get<1>(curInstruction);
-        int pathDir = std::get<2>(curInstruction);
-        
-        Cell& pathCell = unsolvedMaze.findCell(pathRow, pathCol);
-        pathCell.labelCellAsPath();
-        
-        traversedPath.pop();
-        LOG_DEBUG("        Final instructions: traversedPath.pop(), num remaining: " << traversedPath.size())
+        std::cerr << "ERROR: runTremaux() was given a GridGraph without an entrance or an exit" << std::endl;
+        return false;
     }
+
+    // Traversal stack, each cell with the next neighbor slot to try from it
+    std::vector<bool> marked(unsolvedGraph.getNumCells(), false);
+    std::vector<std::uint32_t> stackCells(1, entrance);
+    std::vector<int> stackSlots(1, 0);
+    marked[entrance] = true;
+
+    while(!stackCells.empty() && stackCells.back() != exit)
+    {
+        const std::uint32_t curCell = stackCells.back();
+        int& nextSlot = stackSlots.back();
+
+        bool isDeadEnd = true;
+        while(nextSlot < unsolvedGraph.getDegree(curCell))
+        {
+            const int slot = nextSlot++;
+            const std::uint32_t nextCell = unsolvedGraph.getNeighbor(curCell, slot);
+            if(unsolvedGraph.isPassageOpen(curCell, slot) && !marked[nextCell])
+            {
+                METRIC_ADD(METRIC_TREMAUX_STEPS, 1)
+                marked[nextCell] = true;
+                stackCells.push_back(nextCell);
+                stackSlots.push_back(0);
+                METRIC_MAX(METRIC_TREMAUX_STACK_MAX, stackCells.size())
+                isDeadEnd = false;
+                break;
+            }
+        }
+
+        // Dead end, backtrack
+        if(isDeadEnd)
+        {
+            stackCells.pop_back();
+            stackSlots.pop_back();
+        }
+    }
+
+    for(std::uint32_t cell : stackCells)
+    {
+        unsolvedGraph.labelCellAsPath(cell);
+    }
+
+    return !stackCells.empty();
 }
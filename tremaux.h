@@ -34,9 +34,162 @@
 
 #pragma once
 
+#include "cell.h"
+#include "gridGraph.h"
 #include "maze.h"
+#include "mazePath.h"
 
-#include <stack>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+/**--------------------------------------------------------------------------------------
+ * TremauxContext class
+ * 
+ * Scratch state of one run of Tremaux's Algorithm, kept out of the Maze so the maze is only 
+ * read while solving
+ *     Holds the Tremaux marks of every cell, the stack of traversed cells, and the path 
+ *     found, both as an ordered list of cells and as a bitmap
+ *     A context can be reused for any number of solves; each thread solving the same maze 
+ *     needs its own context
+ * --------------------------------------------------------------------------------------
+*/
+class TremauxContext
+{
+public:
+    /**--------------------------------------------------------------------------------------
+     * Constructor
+     * 
+     * Creates a context with storage for mazes of up to uRows x uCols cells
+     * 
+     * @param[in] uRows Number of rows to preallocate for
+     * @param[in] uCols Number of columns to preallocate for
+     * --------------------------------------------------------------------------------------
+    */
+    TremauxContext(int uRows = 0, int uCols = 0);
+
+    /**--------------------------------------------------------------------------------------
+     * beginSolve()
+     * 
+     * Clears the marks, traversal stack and path of the previous solve, and sizes the 
+     * context for the given maze
+     *     Only grows the storage if the maze has more cells than any maze solved before
+     * 
+     * @param[in] maze Maze about to be solved
+     * --------------------------------------------------------------------------------------
+    */
+    void beginSolve(const Maze& maze);
+
+    /**--------------------------------------------------------------------------------------
+     * findCell()
+     * 
+     * Returns a view of a cell of the maze being solved, with the marks of this context
+     * 
+     * @param[in] maze  Maze being solved
+     * @param[in] row   Row index of cell
+     * @param[in] col   Column index of cell
+     * @return a Cell object viewing the cell's state in the maze and its marks in the context
+     * --------------------------------------------------------------------------------------
+    */
+    Cell findCell(const Maze& maze, int row, int col)
+    {
+        return maze.findCell(row, col, m_marks[static_cast<std::size_t>(row) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(col)]);
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getTraversedPath()
+     * 
+     * Returns the stack of traversed cells, formatted as <row, col, direction of exit>
+     * 
+     * @return a reference to the traversal stack, the top of the stack is at the back
+     * --------------------------------------------------------------------------------------
+    */
+    std::vector<std::tuple<int, int, int>>& getTraversedPath()
+    {
+        return m_traversedPath;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * finishPath()
+     * 
+     * Records the cells left on the traversal stack as the path found by the solve, both as a 
+     * list of cells and as a compact path
+     * --------------------------------------------------------------------------------------
+    */
+    void finishPath();
+
+    /**--------------------------------------------------------------------------------------
+     * getPath()
+     * 
+     * Returns the path found by the last solve, ordered from entrance to exit
+     * 
+     * @return a constant reference to the row-major indices of the cells on the path
+     * --------------------------------------------------------------------------------------
+    */
+    const std::vector<std::size_t>& getPath() const
+    {
+        return m_path;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * getCompactPath()
+     * 
+     * Returns the path found by the last solve as a start cell and 2 bits per move
+     * 
+     * @return a constant reference to the path, ordered from entrance to exit, empty if no 
+     * path was found
+     * --------------------------------------------------------------------------------------
+    */
+    const MazePath& getCompactPath() const
+    {
+        return m_compactPath;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * isCellOnPath()
+     * 
+     * Checks if a cell is on the path found by the last solve
+     * 
+     * @param[in] row Row index of cell
+     * @param[in] col Column index of cell
+     * @return true if the cell is on the path, false otherwise
+     * --------------------------------------------------------------------------------------
+    */
+    bool isCellOnPath(int row, int col) const
+    {
+        std::size_t index = static_cast<std::size_t>(row) * static_cast<std::size_t>(m_numCols) + static_cast<std::size_t>(col);
+        return (m_pathBits[index >> 6] >> (index & 63)) & 1;
+    }
+
+    /**--------------------------------------------------------------------------------------
+     * labelPath()
+     * 
+     * Labels every cell on the path found by the last solve as a path cell of the maze
+     * 
+     * @param[in,out] maze Maze that was solved, updated so the cells on the path are labeled
+     * as path cells
+     * --------------------------------------------------------------------------------------
+    */
+    void labelPath(Maze& maze) const;
+
+private:
+    int m_numCols;
+
+    /**
+     * Scratch state, stored row-major
+     *     m_marks: Tremaux marks of each cell, 2 bits per cardinal direction, see Cell
+     *     m_traversedPath: stack of traversed cells, <row, col, direction of exit>
+     *     m_path: row-major indices of the cells on the path, from entrance to exit
+     *     m_pathBits: one bit per cell, set if the cell is in m_path
+     *     m_compactPath: m_path as a start cell and the direction of every move
+    */
+    std::vector<std::uint8_t> m_marks;
+    std::vector<std::tuple<int, int, int>> m_traversedPath;
+    std::vector<std::size_t> m_path;
+    std::vector<std::uint64_t> m_pathBits;
+    MazePath m_compactPath;
+};
 
 /**--------------------------------------------------------------------------------------
  * runTremaux()
@@ -49,6 +202,59 @@
  * @param[in,out] unsolvedMaze Maze object where the path from the entrance to the exit 
  * is unknown, updates the Maze object so that the cells on the path from the entrance to
  * the exit are labeled as path cells
+ *     Solves with a temporary TremauxContext, see the overloads taking a TremauxContext to reuse one
+ * --------------------------------------------------------------------------------------
+*/
+void runTremaux(Maze& unsolvedMaze);
+
+/**--------------------------------------------------------------------------------------
+ * runTremaux()
+ * 
+ * Finds a path from a start cell to an end cell with Tremaux's Algorithm, keeping every 
+ * mark and the path in the given context
+ *     The maze is only read, so several threads can solve the same maze at once, each with
+ *     its own context
+ * 
+ * @param[in]       maze        Maze object with passageways, not modified
+ * @param[in,out]   context     Context to solve in, updated to hold the path from the start 
+ * cell to the end cell
+ * @param[in]       startRow    Row index of the cell to start from
+ * @param[in]       startCol    Column index of the cell to start from
+ * @param[in]       endRow      Row index of the cell to find a path to
+ * @param[in]       endCol      Column index of the cell to find a path to
+ * @return true if a path was found, false once the walk is left with no exit that was not 
+ * walked both ways already, so the end cell cannot be reached from the start cell
+ * --------------------------------------------------------------------------------------
+*/
+bool runTremaux(const Maze& maze, TremauxContext& context, int startRow, int startCol, int endRow, int endCol);
+
+/**--------------------------------------------------------------------------------------
+ * runTremaux()
+ * 
+ * Finds a path from the maze entrance to the maze exit with Tremaux's Algorithm, keeping 
+ * every mark and the path in the given context
+ * 
+ * @param[in]       maze    Maze object with passageways, an entrance and an exit, not modified
+ * @param[in,out]   context Context to solve in, updated to hold the path from the entrance 
+ * to the exit
+ * @return true if a path was found
+ * --------------------------------------------------------------------------------------
+*/
+bool runTremaux(const Maze& maze, TremauxContext& context);
+
+/**--------------------------------------------------------------------------------------
+ * runTremaux()
+ * 
+ * Finds the path from the entrance to the exit of a GridGraph with Tremaux's Algorithm, 
+ * whatever its topology
+ *     Every cell entered is marked, and a passage into a marked cell is never taken, so the 
+ *     walk ends at dead ends and backtracks. The cells left on the stack when it reaches 
+ *     the exit are the path
+ *     Passages are read from the graph's adjacency arrays, one neighbor slot at a time
+ * 
+ * @param[in,out] unsolvedGraph GridGraph with passageways, an entrance and an exit, updated 
+ * so that the cells on the path from the entrance to the exit are labeled as path cells
+ * @return true if a path was found
  * --------------------------------------------------------------------------------------
 */
-void runTremaux(Maze& unsolvedMaze);
\ No newline at end of file
+bool runTremaux(GridGraph& unsolvedGraph);
@@ -34,8 +34,13 @@
 
 #include "wilson.h"
 
-#include <cstdlib>
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <vector>
+
+#include "metrics.h"
+#include "rng.h"
 
 /**--------------------------------------------------------------------------------------
  * clearInMaze()
@@ -61,25 +66,193 @@ void clearInMaze(bool** inMaze, int rowLength, int colLength){
 
 
 /**--------------------------------------------------------------------------------------
- * clearOutsideMaze()
+ * advanceToCellOutsideMaze()
  * 
- * Is given a map of tuple<int, int> (representing cell indices) to themselves, where
- * the map represents the cells which are not "in" the maze
- *     In the map, the value will always be the same as the key. Therefore it is mapping 
- *     a set of cell indices unto themselves
- * "Clear" the record of cells outside the maze by filling the map with every cell from
- * the grid
+ * Moves a row-major scan cursor forward until it reaches a cell that is not "in" the maze
+ *     Cells only ever join the maze, so every cell behind the cursor stays "in" the maze and 
+ *     the cursor never has to move backwards. Over a whole run of Wilson's Algorithm the 
+ *     cursor visits each cell once
+ *     The cursor lands on the first cell outside the maze in row-major order, which is the 
+ *     same cell that picking the smallest (row, col) would give
  * 
- * @param[in,out] outOfMaze Map of tuple<int, int> (representing cell indices) to themselves
- * is updated to contain the indices of every cell in the grid
+ * @param[in]       inMaze      ROWCELLS x COLCELLS grid representing which cells are "in" 
+ * the maze and which are not
+ * @param[in,out]   cursorRow   Row index of the cursor, updated to the row index of the 
+ * next cell outside the maze
+ * @param[in,out]   cursorCol   Column index of the cursor, updated to the column index of 
+ * the next cell outside the maze
+ * @return true if a cell outside the maze was found, false if every cell is "in" the maze
  * --------------------------------------------------------------------------------------
 */
-void clearOutsideMaze(std::map<std::tuple<int, int>, std::tuple<int, int>>& outOfMaze, int numRows, int numCols){
-	for(int row = 0; row < numRows; row++){
-		for(int col = 0; col < numCols; col++){
-			outOfMaze.emplace(std::make_tuple(row, col), std::make_tuple(row, col));
+bool advanceToCellOutsideMaze(bool const* const* inMaze, int numRows, int numCols, int& cursorRow, int& cursorCol)
+{
+	for(; cursorRow < numRows; cursorRow++, cursorCol = 0){
+		for(; cursorCol < numCols; cursorCol++){
+			if(!inMaze[cursorRow][cursorCol]){
+				return true;
+			}
 		}
 	}
+
+	return false;
+}
+
+
+
+/**--------------------------------------------------------------------------------------
+ * recordWalkDir()
+ * 
+ * Records the direction of exit taken from a cell during a random walk
+ *     Directions are packed 2 bits per cell, 4 cells per byte, indexed by the row-major 
+ *     index of the cell. Recording a new direction overwrites the old one, which is how 
+ *     the loops of the random walk get erased
+ * 
+ * @param[in,out]   walkDirs    Packed directions of exit, updated with the given direction
+ * @param[in]       cellIndex   Row-major index of the cell
+ * @param[in]       dir         Cardinal direction of exit from the cell
+ * --------------------------------------------------------------------------------------
+*/
+void recordWalkDir(std::uint8_t* walkDirs, std::size_t cellIndex, int dir)
+{
+	std::uint8_t& packedDirs = walkDirs[cellIndex >> 2];
+	int shift = static_cast<int>(cellIndex & 3) * 2;
+	packedDirs = static_cast<std::uint8_t>((packedDirs & ~(3 << shift)) | (dir << shift));
+}
+
+
+
+/**--------------------------------------------------------------------------------------
+ * readWalkDir()
+ * 
+ * Returns the last direction of exit recorded for a cell by recordWalkDir()
+ * 
+ * @param[in] walkDirs  Packed directions of exit
+ * @param[in] cellIndex Row-major index of the cell
+ * @return an int representing the cardinal direction of exit from the cell
+ * --------------------------------------------------------------------------------------
+*/
+int readWalkDir(const std::uint8_t* walkDirs, std::size_t cellIndex)
+{
+	return (walkDirs[cellIndex >> 2] >> (static_cast<int>(cellIndex & 3) * 2)) & 3;
+}
+
+
+
+/**--------------------------------------------------------------------------------------
+ * randomNeighborDirection()
+ * 
+ * Picks one of the directions leading from a cell to a valid neighbor, every valid 
+ * direction equally likely, which is one step of a simple random walk on the grid
+ * 
+ * @param[in]       numRows Number of rows in the maze
+ * @param[in]       numCols Number of columns in the maze
+ * @param[in]       row     Row index of the cell
+ * @param[in]       col     Column index of the cell
+ * @param[in,out]   rng     Random number engine driving the walk
+ * @return an int representing the chosen cardinal direction, or 
+ * Maze::INVALID_CARDINAL_DIRECTION if the maze is a single cell
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+inline int randomNeighborDirection(int numRows, int numCols, int row, int col, RngEngine& rng)
+{
+	if(row > 0 && row < numRows - 1 && col > 0 && col < numCols - 1)
+	{
+		// Interior cell, every direction leads to a valid cell
+		return randomDirection(rng);
+	}
+
+	// Border cell, draw directly from the directions that lead to a valid cell
+	int validDirs[4];
+	int numValidDirs = 0;
+	if(row != 0)				// Moving North is valid
+	{
+		validDirs[numValidDirs++] = Maze::NORTH_DIRECTION;
+	}
+	if(row != numRows - 1)		// Moving South is valid
+	{
+		validDirs[numValidDirs++] = Maze::SOUTH_DIRECTION;
+	}
+	if(col != numCols - 1)		// Moving East is valid
+	{
+		validDirs[numValidDirs++] = Maze::EAST_DIRECTION;
+	}
+	if(col != 0)				// Moving West is valid
+	{
+		validDirs[numValidDirs++] = Maze::WEST_DIRECTION;
+	}
+
+	if(numValidDirs == 0)
+	{
+		return Maze::INVALID_CARDINAL_DIRECTION;
+	}
+	return validDirs[randomBelow(rng, static_cast<std::uint32_t>(numValidDirs))];
+}
+
+
+
+/**--------------------------------------------------------------------------------------
+ * aldousBroderWalk()
+ * 
+ * Performs the Aldous-Broder Algorithm from a cell "in" the maze until numCellsWanted 
+ * cells are "in" the maze
+ *     Walks the grid at random without erasing anything. The first time the walk enters a 
+ *     cell outside the maze, the cell joins the maze through the wall the walk came in by
+ *     Cheap while most cells are still outside the maze, which is exactly when the random 
+ *     walks of Wilson's Algorithm are at their longest, but slows down as the maze fills up
+ *     Run until every cell is "in" the maze it gives an unbiased maze on its own. Handing 
+ *     the cells it leaves "in" the maze over to Wilson's Algorithm part way through biases 
+ *     the maze, since the rest of the maze should depend on where the walk stopped and 
+ *     Wilson's Algorithm never looks at it, so some mazes come up more often than others 
+ *     and the bias grows with the fraction handed over. Stopping at 30% of a 200x200 maze 
+ *     gives about 0.7% more dead ends than an unbiased maze
+ * 
+ * @param[in,out]   inMaze          ROWCELLS x COLCELLS grid representing which cells are 
+ * "in" the maze, updated with every cell the walk adds
+ * @param[in,out]   blankMaze       Maze object being filled out, has a wall opened for 
+ * every cell the walk adds
+ * @param[in]       startRow        Row index of the cell "in" the maze to start walking from
+ * @param[in]       startCol        Column index of the cell "in" the maze to start walking from
+ * @param[in,out]   cellsInMaze     Number of cells "in" the maze, updated as cells are added
+ * @param[in]       numCellsWanted  Number of cells "in" the maze to stop at
+ * @param[in,out]   rng             Random number engine driving the walk
+ * @return the number of steps taken by the walk
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t aldousBroderWalk(bool* const* inMaze, Maze& blankMaze, int startRow, int startCol, std::uint64_t& cellsInMaze, std::uint64_t numCellsWanted, RngEngine& rng)
+{
+	const int numRows = blankMaze.getROWCELLS();
+	const int numCols = blankMaze.getCOLCELLS();
+	std::uint64_t numSteps = 0;
+
+	int curRow = startRow;
+	int curCol = startCol;
+	while(cellsInMaze < numCellsWanted)
+	{
+		int randDir = randomNeighborDirection(numRows, numCols, curRow, curCol, rng);
+		if(randDir == Maze::INVALID_CARDINAL_DIRECTION)
+		{
+			break;
+		}
+
+		int nextRow = curRow + (randDir == Maze::SOUTH_DIRECTION) - (randDir == Maze::NORTH_DIRECTION);
+		int nextCol = curCol + (randDir == Maze::EAST_DIRECTION) - (randDir == Maze::WEST_DIRECTION);
+		numSteps++;
+
+		if(!inMaze[nextRow][nextCol])
+		{
+			// First visit, the cell joins the maze through the wall the walk crossed
+			inMaze[nextRow][nextCol] = true;
+			blankMaze.openPassage(curRow, curCol, randDir);
+			cellsInMaze++;
+		}
+
+		curRow = nextRow;
+		curCol = nextCol;
+	}
+
+	return numSteps;
 }
 
 
@@ -91,20 +264,27 @@ void clearOutsideMaze(std::map<std::tuple<int, int>, std::tuple<int, int>>& outO
  * "in" the maze, recording the direction of travel for each cell traversed. Updates the 
  * existing direction of travel for a cell if it has already been traversed once and is 
  * being traversed again
- *     Modifies a given grid of ints, where the int represents the last direction traveled 
- *     at the cell with the associated grid indices
+ *     Modifies a given packed grid of directions (see recordWalkDir()), where each entry 
+ *     represents the last direction traveled at the cell with the associated grid indices
+ *     Only the cells on the final loop-erased path are read back afterwards, so the grid 
+ *     is reused across walks without being cleared
  * 
  * @param[in] inMaze		ROWCELLS x COLCELLS grid representing which cells are "in" 
  * the maze and which are not
  * @param[in] 		startRow		Row index of cell from which to start the random walk
  * @param[in] 		startCol		Column index of cell from which to start the random walk
- * @param[in,out] 	dirOfExit		Map of tuple<int, int> (representing cell indices) to 
- * ints (representing cardinal directions) indicating the last direction of exit from the 
- * cell, is updated to contain final travel path of the random walk
+ * @param[in,out] 	dirOfExit		Packed ROWCELLS x COLCELLS grid of cardinal directions 
+ * indicating the last direction of exit from each cell, is updated to contain final 
+ * travel path of the random walk
+ * @param[in,out]	rng				Random number engine driving the walk
+ * @return the number of steps taken by the random walk
  * --------------------------------------------------------------------------------------
 */
-void randomWalk(bool const* const* inMaze, int numRows, int numCols, int startRow, int startCol, std::map<std::tuple<int, int>, int>& dirOfExit)
+template <typename RngEngine>
+std::uint64_t randomWalk(bool const* const* inMaze, int numRows, int numCols, int startRow, int startCol, std::uint8_t* dirOfExit, RngEngine& rng)
 {
+	std::uint64_t numSteps = 0;
+
 	// Initiating the random walk from the given starting cell indices
 	int curRow = startRow;
 	int curCol = startCol;
@@ -118,32 +298,16 @@ void randomWalk(bool const* const* inMaze, int numRows, int numCols, int startRo
 		// Repeat until reaching a cell "in" the maze
 		while(inMaze[curRow][curCol] != true)
 		{
-			int randDir = Maze::INVALID_CARDINAL_DIRECTION;
-			// Go in a random direction until reaching a valid cell
-			while(true)
+			int randDir = randomNeighborDirection(numRows, numCols, curRow, curCol, rng);
+			if(randDir == Maze::INVALID_CARDINAL_DIRECTION)
 			{
-				randDir  = std::rand() % 4;
-
-				if(Maze::NORTH_DIRECTION == randDir && curRow != 0) 				// Moving North is valid
-				{
-					break;
-				} 
-				else if(Maze::SOUTH_DIRECTION == randDir && curRow != numRows - 1) // Moving South is valid
-				{
-					break;
-				}
-				else if(Maze::EAST_DIRECTION == randDir && curCol != numCols - 1) 	// Moving East is valid
-				{
-					break;
-				}
-				else if(Maze::WEST_DIRECTION == randDir && curCol != 0) 			// Moving West is valid
-				{
-					break;
-				}
+				std::cerr << "ERROR: randomWalk started in a maze with a single cell" << std::endl;
+				break;
 			}
 
 			// Recording chosen direction as exit direction from current cell
-			dirOfExit[std::make_tuple(curRow, curCol)] = randDir;
+			recordWalkDir(dirOfExit, static_cast<std::size_t>(curRow) * static_cast<std::size_t>(numCols) + static_cast<std::size_t>(curCol), randDir);
+			numSteps++;
 
 			switch(randDir)
 			{
@@ -170,46 +334,58 @@ void randomWalk(bool const* const* inMaze, int numRows, int numCols, int startRo
 			}
 		}
 	}
+
+	return numSteps;
 }
 
 
 
 /**--------------------------------------------------------------------------------------
- * createEntranceAndExit()
+ * chooseEntranceAndExit()
  * 
- * Given a "closed off" maze (no entrance or exit), marks its entrance and exit so that they are not too close to each other
+ * Picks an entrance and an exit on the border of a numRows x numCols maze so that they are not too close to each other
+ *     Needs no Maze, so generators that stream the maze out can place them before writing anything
  * 
- * @param[in] closedOffMaze A maze that has no entrance or exit cells
+ * @param[in] numRows       Number of rows in the maze
+ * @param[in] numCols       Number of columns in the maze
+ * @param[in,out] rng       Random number engine used to place the entrance and exit
+ * @param[out] entranceRow  Row index of the entrance
+ * @param[out] entranceCol  Column index of the entrance
+ * @param[out] exitRow      Row index of the exit
+ * @param[out] exitCol      Column index of the exit
+ * 
+ * Instantiated in wilson.cpp for every engine in rng.h
  * --------------------------------------------------------------------------------------
 */
-void createEntranceAndExit(Maze& closedOffMaze)
+template <typename RngEngine>
+void chooseEntranceAndExit(int numRows, int numCols, RngEngine& rng, int& entranceRow, int& entranceCol, int& exitRow, int& exitCol)
 {
 	/**
 	 * Marking two unique random cells on the edges to be the Entrance and Exit
 	 *     IMPORTANT CAVEAT: the maze has at least 2 rows and at least 2 columns, otherwise the entrance and exit may be at the same cell
 	*/
-	if(closedOffMaze.getROWCELLS() >= 2 && closedOffMaze.getCOLCELLS() >= 2)
+	if(numRows >= 2 && numCols >= 2)
 	{
 		// Choosing entrance indices
-		int entranceSide = std::rand() % 4;
-		int entranceRow = Maze::INVALID_ROW_COL;
-		int entranceCol = Maze::INVALID_ROW_COL;
+		int entranceSide = randomDirection(rng);
+		entranceRow = Maze::INVALID_ROW_COL;
+		entranceCol = Maze::INVALID_ROW_COL;
 		switch(entranceSide)
 		{
 			case Maze::NORTH_DIRECTION:	// Entrance is on North side
 				entranceRow = 0;
-				entranceCol = std::rand() % closedOffMaze.getCOLCELLS();
+				entranceCol = static_cast<int>(randomBelow(rng, numCols));
 				break;
 			case Maze::SOUTH_DIRECTION:	// Entrance is on South side
-				entranceRow = closedOffMaze.getROWCELLS() - 1;
-				entranceCol = std::rand() % closedOffMaze.getCOLCELLS();
+				entranceRow = numRows - 1;
+				entranceCol = static_cast<int>(randomBelow(rng, numCols));
 				break;
 			case Maze::EAST_DIRECTION:	// Entrance is on East side
-				entranceRow = std::rand() % closedOffMaze.getROWCELLS();
-				entranceCol = closedOffMaze.getCOLCELLS() - 1;
+				entranceRow = static_cast<int>(randomBelow(rng, numRows));
+				entranceCol = numCols - 1;
 				break;
 			case Maze::WEST_DIRECTION:	// Entrance is on West side
-				entranceRow = std::rand() % closedOffMaze.getROWCELLS();
+				entranceRow = static_cast<int>(randomBelow(rng, numRows));
 				entranceCol = 0;
 				break;
 			default:
@@ -217,121 +393,181 @@ void createEntranceAndExit(Maze& closedOffMaze)
 		}
 
 		// Choosing exit side
-		int exitSide = std::rand() % 4;
-		int exitRow = Maze::INVALID_ROW_COL;
-		int exitCol = Maze::INVALID_ROW_COL;
+		int exitSide = Maze::INVALID_CARDINAL_DIRECTION;
+		exitRow = Maze::INVALID_ROW_COL;
+		exitCol = Maze::INVALID_ROW_COL;
 
 		// First four checks are edge cases where the entrance is in a corner
 		if(entranceRow == 0 && entranceCol == 0)
 		{
-			exitRow = closedOffMaze.getROWCELLS() - 1;
-			exitCol = closedOffMaze.getCOLCELLS() - 1;
+			exitRow = numRows - 1;
+			exitCol = numCols - 1;
 		}
-		else if(entranceRow == 0 && entranceCol == closedOffMaze.getCOLCELLS() - 1)
+		else if(entranceRow == 0 && entranceCol == numCols - 1)
 		{
-			exitRow = closedOffMaze.getROWCELLS() - 1;
+			exitRow = numRows - 1;
 			exitCol = 0;
 		}
-		else if(entranceRow == closedOffMaze.getROWCELLS() - 1 && entranceCol == 0)
+		else if(entranceRow == numRows - 1 && entranceCol == 0)
 		{
 			exitRow = 0;
-			exitCol = closedOffMaze.getCOLCELLS() - 1;
+			exitCol = numCols - 1;
 		}
-		else if(entranceRow == closedOffMaze.getROWCELLS() - 1 && entranceCol == closedOffMaze.getCOLCELLS() - 1)
+		else if(entranceRow == numRows - 1 && entranceCol == numCols - 1)
 		{
 			exitRow = 0;
 			exitCol = 0;
 		}
 		else
 		{
-			while(exitSide == entranceSide) // Ensures Entrance and Exit will not land on the same side pt. 1
+			// Ensures Entrance and Exit will not land on the same side pt. 1, draws from the other three sides
+			exitSide = static_cast<int>(randomBelow(rng, 3));
+			if(exitSide >= entranceSide)
 			{
-				exitSide = std::rand() % 4;
+				exitSide++;
 			}
 
 			if(Maze::NORTH_DIRECTION == exitSide)		// Exit is on North side
 			{
 				exitRow = 0;
-				exitCol = std::rand() % closedOffMaze.getCOLCELLS();
-				while(exitCol == entranceCol) // Ensures Entrance and Exit will not land on the same side pt. 2
+				// Ensures Entrance and Exit will not land on the same side pt. 2, draws from the other indices
+				exitCol = static_cast<int>(randomBelow(rng, numCols - 1));
+				if(exitCol >= entranceCol)
 				{
-					exitCol = std::rand() % closedOffMaze.getCOLCELLS();
+					exitCol++;
 				}
 			}
 			else if(Maze::SOUTH_DIRECTION == exitSide)	// Exit is on South side
 			{
-				exitRow = closedOffMaze.getROWCELLS() - 1;
-				exitCol = std::rand() % closedOffMaze.getCOLCELLS();
-				while(exitCol == entranceCol) // Ensures Entrance and Exit will not land on the same side pt. 2
+				exitRow = numRows - 1;
+				// Ensures Entrance and Exit will not land on the same side pt. 2, draws from the other indices
+				exitCol = static_cast<int>(randomBelow(rng, numCols - 1));
+				if(exitCol >= entranceCol)
 				{
-					exitCol = std::rand() % closedOffMaze.getCOLCELLS();
+					exitCol++;
 				}
 			}
 			else if(Maze::EAST_DIRECTION == exitSide)	// Exit is on East side
 			{
-				exitRow = std::rand() % closedOffMaze.getROWCELLS();
-				exitCol = closedOffMaze.getCOLCELLS() - 1;
-				while(exitRow == entranceRow) // Ensures Entrance and Exit will not land on the same side pt. 2
+				exitCol = numCols - 1;
+				// Ensures Entrance and Exit will not land on the same side pt. 2, draws from the other indices
+				exitRow = static_cast<int>(randomBelow(rng, numRows - 1));
+				if(exitRow >= entranceRow)
 				{
-					exitRow = std::rand() % closedOffMaze.getROWCELLS();
+					exitRow++;
 				}
 			}
 			else										// Exit is on West side
 			{
-				exitRow = std::rand() % closedOffMaze.getROWCELLS();
 				exitCol = 0;
-				while(exitRow == entranceRow) // Ensures Entrance and Exit will not land on the same side pt. 2
+				// Ensures Entrance and Exit will not land on the same side pt. 2, draws from the other indices
+				exitRow = static_cast<int>(randomBelow(rng, numRows - 1));
+				if(exitRow >= entranceRow)
 				{
-					exitRow = std::rand() % closedOffMaze.getROWCELLS();
+					exitRow++;
 				}
 			}
 		}
-		
-		// Marking entrance and exit
-		closedOffMaze.labelMazeEntrance(entranceRow, entranceCol);
-		closedOffMaze.labelMazeExit(exitRow, exitCol);
 	}
 	else
 	{
-		std::cout << "WARNING: Maze is too small to generate proper entrance and exit\n    Be aware that the generated entrance and exit may be at the same location" << std::endl;
-		closedOffMaze.labelMazeEntrance(std::rand() % closedOffMaze.getROWCELLS(), std::rand() % closedOffMaze.getCOLCELLS());
-		closedOffMaze.labelMazeExit(std::rand() % closedOffMaze.getROWCELLS(), std::rand() % closedOffMaze.getCOLCELLS());
+		std::cerr << "WARNING: Maze is too small to generate proper entrance and exit\n    Be aware that the generated entrance and exit may be at the same location" << std::endl;
+		entranceRow = static_cast<int>(randomBelow(rng, numRows));
+		entranceCol = static_cast<int>(randomBelow(rng, numCols));
+
+		exitRow = static_cast<int>(randomBelow(rng, numRows));
+		exitCol = static_cast<int>(randomBelow(rng, numCols));
 	}
 }
 
+/**--------------------------------------------------------------------------------------
+ * createEntranceAndExit()
+ * 
+ * Given a "closed off" maze (no entrance or exit), marks its entrance and exit so that they are not too close to each other
+ *     Shared by every generator that fills out a blank maze, see chooseEntranceAndExit()
+ * 
+ * @param[in] closedOffMaze A maze that has no entrance or exit cells
+ * @param[in,out] rng       Random number engine used to place the entrance and exit
+ * 
+ * Instantiated in wilson.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+void createEntranceAndExit(Maze& closedOffMaze, RngEngine& rng)
+{
+	int entranceRow = Maze::INVALID_ROW_COL;
+	int entranceCol = Maze::INVALID_ROW_COL;
+	int exitRow = Maze::INVALID_ROW_COL;
+	int exitCol = Maze::INVALID_ROW_COL;
+	chooseEntranceAndExit(closedOffMaze.getROWCELLS(), closedOffMaze.getCOLCELLS(), rng, entranceRow, entranceCol, exitRow, exitCol);
+
+	// Marking entrance and exit
+	closedOffMaze.labelMazeEntrance(entranceRow, entranceCol);
+	closedOffMaze.labelMazeExit(exitRow, exitCol);
+}
+
 /**--------------------------------------------------------------------------------------
  * runWilson()
  * 
  * Given an "empty" maze with no passageways, entrances, or exits uses Wilson's Algorithm
- * to create an unbiased maze
+ * to create an unbiased maze, or a biased one when started off with aldousBroderWalk()
  *     Repeatedly uses loop-erased random walks to "fill out" the maze, until every cell
  *     in the grid is connected to the maze
  * 
  * @param[in,out] blankMaze "empty" Maze object containing no passageways, entrances or 
  * exits, updates the Maze object so that every cell in the grid is connected to each 
  * other, and an entrance and exit cell both exist
+ * @param[in,out] rng Random number engine driving the random walks, the same engine state
+ * always produces the same maze
+ * @param[in] aldousBroderFraction Fraction of the cells to add with aldousBroderWalk() 
+ * before switching to loop-erased random walks, 0 for Wilson's Algorithm alone and the 
+ * only value that keeps the maze unbiased, see DEFAULT_ALDOUS_BRODER_FRACTION
+ * @param[in,out] scratch Arena to take the inMaze grid and walk directions from, see 
+ * wilsonScratchBytes(), or nullptr to allocate them for this maze alone
+ * @return the total number of random walk steps taken to fill out the maze, Aldous-Broder 
+ * steps included
  * --------------------------------------------------------------------------------------
 */
-void runWilson(Maze& blankMaze)
+template <typename RngEngine>
+std::uint64_t runWilson(Maze& blankMaze, RngEngine& rng, double aldousBroderFraction, ScratchArena* scratch)
 {
-	std::srand(time(NULL));
+	METRIC_TIMER(METRIC_WILSON_TIMER)
+	std::uint64_t unvisitedCells = blankMaze.getNumCells();
+
+	// Without an arena from the caller, one sized for this maze alone
+	ScratchArena localScratch;
+	if(scratch == nullptr)
+	{
+		localScratch.reserve(wilsonScratchBytes(blankMaze.getROWCELLS(), blankMaze.getCOLCELLS()));
+		scratch = &localScratch;
+	}
 
-	int unvisitedCells = blankMaze.getROWCELLS() * blankMaze.getCOLCELLS();
 	// false: cell is not in the maze, true: cell is in the maze
-	bool** inMaze = new bool*[blankMaze.getROWCELLS()];
+	// Rows point into one row-major array
+	bool** inMaze = scratch->allocate<bool*>(static_cast<std::size_t>(blankMaze.getROWCELLS()));
+	bool* inMazeCells = scratch->allocate<bool>(blankMaze.getNumCells());
 	for(int i = 0; i < blankMaze.getROWCELLS(); i++)
 	{
-		inMaze[i] = new bool[blankMaze.getCOLCELLS()];
+		inMaze[i] = inMazeCells + static_cast<std::size_t>(i) * static_cast<std::size_t>(blankMaze.getCOLCELLS());
 	}
 
-	std::map<std::tuple<int, int>, std::tuple<int, int>> notInMaze;
-
 	clearInMaze(inMaze, blankMaze.getROWCELLS(), blankMaze.getCOLCELLS());
-	clearOutsideMaze(notInMaze, blankMaze.getROWCELLS(), blankMaze.getCOLCELLS());
+
+	// Last direction of exit from each cell, reused by every random walk
+	const std::size_t numWalkPathBytes = (blankMaze.getNumCells() + 3) / 4;
+	std::uint8_t* walkPath = scratch->allocate<std::uint8_t>(numWalkPathBytes);
+	std::fill(walkPath, walkPath + numWalkPathBytes, std::uint8_t(0));
+	std::uint64_t numWalkSteps = 0;
+	std::uint64_t numAldousBroderSteps = 0;
+	std::uint64_t numAldousBroderCells = 0;
+
+	// Row-major scan cursor over inMaze, walks start from the first cell outside the maze
+	int cursorRow = 0;
+	int cursorCol = 0;
 
 	// Setting random cell as "in" maze
-	int randR = std::rand() % blankMaze.getROWCELLS();
-	int randC = std::rand() % blankMaze.getCOLCELLS();
+	int randR = static_cast<int>(randomBelow(rng, blankMaze.getROWCELLS()));
+	int randC = static_cast<int>(randomBelow(rng, blankMaze.getCOLCELLS()));
 
 	if(randR < 0 || randR >= blankMaze.getROWCELLS() || randC < 0 || randC >= blankMaze.getCOLCELLS())
 	{
@@ -340,29 +576,43 @@ void runWilson(Maze& blankMaze)
 	else
 	{
 		inMaze[randR][randC] = true;
-	    notInMaze.erase(std::make_tuple(randR, randC));
 	    unvisitedCells -= 1;
+
+		/**
+		 * The first loop-erased walks are the slowest, with one cell in the maze they wander for a 
+		 * long time before hitting it. Growing the start of the tree with Aldous-Broder instead is 
+		 * much cheaper, and Wilson's Algorithm takes over once the maze is big enough to hit quickly, 
+		 * at the cost of the bias described in aldousBroderWalk()
+		*/
+		if(aldousBroderFraction > 0.0)
+		{
+			std::uint64_t numCellsWanted = static_cast<std::uint64_t>(std::min(aldousBroderFraction, 1.0) * static_cast<double>(blankMaze.getNumCells()));
+			std::uint64_t cellsInMaze = blankMaze.getNumCells() - unvisitedCells;
+			numAldousBroderSteps = aldousBroderWalk(inMaze, blankMaze, randR, randC, cellsInMaze, numCellsWanted, rng);
+			numAldousBroderCells = cellsInMaze - (blankMaze.getNumCells() - unvisitedCells);
+			unvisitedCells -= numAldousBroderCells;
+		}
 	}
 
 	/**
 	 * Performing random walks until the entire maze is filled
 	 *
 	 * Start from a cell not "in" the maze, randomly walk until reaching a cell "in" the maze.
+	 * Wilson's Algorithm produces an unbiased maze no matter which cell outside the maze each walk starts from.
 	 * Record the direction of travel for each cell traversed. 
 	 * Updates the existing direction of travel for a cell if it has already been traversed once and is being traversed again.
 	 * 
 	 * Once done walking, start from the starting cell and travel along the recorded directions, adding each traversed
 	 * cell to the maze and removing walls along the way. For each cell, decrement the number of unvisited cells by 1.
 	*/
-	while(unvisitedCells > 0 && notInMaze.empty() == false)
+	while(unvisitedCells > 0 && advanceToCellOutsideMaze(inMaze, blankMaze.getROWCELLS(), blankMaze.getCOLCELLS(), cursorRow, cursorCol))
 	{
 		// Selecting a cell to initiate the random walk from
-		std::tuple<int, int> startingCell = notInMaze.begin()->second;
-		int curRow = std::get<0>(startingCell);
-		int curCol = std::get<1>(startingCell);
+		int curRow = cursorRow;
+		int curCol = cursorCol;
 	
-		std::map<std::tuple<int, int>, int> walkPath;
-		randomWalk(inMaze, blankMaze.getROWCELLS(), blankMaze.getCOLCELLS(), curRow, curCol, walkPath);
+		numWalkSteps += randomWalk(inMaze, blankMaze.getROWCELLS(), blankMaze.getCOLCELLS(), curRow, curCol, walkPath, rng);
+		METRIC_ADD(METRIC_WALKS, 1)
 
 		if(curRow < 0 || curRow >= blankMaze.getROWCELLS() || curCol < 0 || curCol >= blankMaze.getCOLCELLS())
 		{
@@ -378,21 +628,11 @@ void runWilson(Maze& blankMaze)
 			*/
 			while(inMaze[curRow][curCol] != true)
 			{
-				auto iter = walkPath.find(std::make_tuple(curRow, curCol));
-				int curDir;
-				if(iter != walkPath.end())
-				{
-					curDir = iter->second;
-				}
-				else
-				{
-					std::cerr << "ERROR: walkPath in Wilson's Algorithm was unable to find the cell with indices: (Row: " << curRow << ", Col: " << curCol << ")" << std::endl;
-				}
+				int curDir = readWalkDir(walkPath, static_cast<std::size_t>(curRow) * static_cast<std::size_t>(blankMaze.getCOLCELLS()) + static_cast<std::size_t>(curCol));
 				int nextCRow = curRow;
 				int nextCCol = curCol;
 
 				inMaze[curRow][curCol] = true; // Adding current cell to "in" maze
-				notInMaze.erase(std::make_tuple(curRow, curCol)); // Removing current cell from "outside" maze
 
 				// Finding indices of next cell in the traveled path
 				int oppositeDir = Maze::INVALID_CARDINAL_DIRECTION;
@@ -421,29 +661,7 @@ void runWilson(Maze& blankMaze)
 
 				blankMaze.updateCellExits(curRow, curCol, curDir);
 				blankMaze.updateCellExits(nextCRow, nextCCol, oppositeDir);
-				std::tuple<int, int, int, int> neighborsInOrder;
-
-				// Formatting neighborsInOrder so that it matches to a key in the map of walls
-				if(curRow < nextCRow)	// Current cell comes first in key
-				{
-					neighborsInOrder = std::make_tuple(curRow, curCol, nextCRow, nextCCol);
-				}
-				else if(curRow == nextCRow)
-				{
-					if(curCol < nextCCol)	// Current cell comes first in key
-					{
-						neighborsInOrder = std::make_tuple(curRow, curCol, nextCRow, nextCCol);
-					}
-					else					// Next cell comes first in key
-					{
-						neighborsInOrder = std::make_tuple(nextCRow, nextCCol, curRow, curCol);
-					}
-				}
-				else					// Next cell comes first in key
-				{
-					neighborsInOrder = std::make_tuple(nextCRow, nextCCol, curRow, curCol);
-				}
-				blankMaze.connectNeighbors(neighborsInOrder);
+				blankMaze.openWall(curRow, curCol, curDir);
 
 				// Moving to next cell
 				curRow = nextCRow;
@@ -459,27 +677,188 @@ void runWilson(Maze& blankMaze)
 			}
 		}
 	}
-	std::cout << std::endl;
 
 	// Maze not properly filled out error catcher
-	if(notInMaze.empty() == false)
+	if(advanceToCellOutsideMaze(inMaze, blankMaze.getROWCELLS(), blankMaze.getCOLCELLS(), cursorRow, cursorCol))
 	{
-		std::tuple<int, int> remainingCell = notInMaze.begin()->second;
-		int row = std::get<0>(remainingCell);
-		int col = std::get<1>(remainingCell);
-
 		std::cerr << "ERROR: Wilson's Algorithm did not fill the maze out" \
-				  << "\n      notInMaze remaining: " << notInMaze.size() \
-				  << "\n      remaining cell indices: (" << row << ", " << col << ")" \
-				  << "\n      inMaze status at remaining cell: " << inMaze[row][col] << "\n" << std::endl;
+				  << "\n      unvisited cells remaining: " << unvisitedCells \
+				  << "\n      remaining cell indices: (" << cursorRow << ", " << cursorCol << ")" \
+				  << "\n      inMaze status at remaining cell: " << inMaze[cursorRow][cursorCol] << "\n" << std::endl;
 	}
 	
-	createEntranceAndExit(blankMaze);
+	// Every loop-erased walk step that did not add a cell to the maze was erased by a loop
+	METRIC_ADD(METRIC_WALK_STEPS, numWalkSteps)
+	METRIC_ADD(METRIC_ERASED_STEPS, numWalkSteps - (blankMaze.getNumCells() - 1 - unvisitedCells - numAldousBroderCells))
+	METRIC_ADD(METRIC_ALDOUS_BRODER_STEPS, numAldousBroderSteps)
 
-	for(int i = 0; i < blankMaze.getROWCELLS(); i++)
+	createEntranceAndExit(blankMaze, rng);
+
+	return numWalkSteps + numAldousBroderSteps;
+}
+
+/**--------------------------------------------------------------------------------------
+ * createGraphEntranceAndExit()
+ * 
+ * Given a "closed off" GridGraph, marks an entrance on a random border cell and an exit on 
+ * a random border cell at least half as far from it as the farthest border cell
+ * 
+ * @param[in,out] closedOffGraph A graph that has no entrance or exit cells
+ * @param[in,out] rng            Random number engine used to place the entrance and exit
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+void createGraphEntranceAndExit(GridGraph& closedOffGraph, RngEngine& rng)
+{
+	const std::vector<std::uint32_t>& borderCells = closedOffGraph.getBorderCells();
+	const std::uint32_t entrance = borderCells[randomBelow(rng, static_cast<std::uint32_t>(borderCells.size()))];
+	closedOffGraph.labelEntrance(entrance);
+
+	auto squaredDistance = [&](std::uint32_t cell)
 	{
-		delete inMaze[i];
+		const double dx = closedOffGraph.getCenterX(cell) - closedOffGraph.getCenterX(entrance);
+		const double dy = closedOffGraph.getCenterY(cell) - closedOffGraph.getCenterY(entrance);
+		return dx * dx + dy * dy;
+	};
+
+	double maxSquaredDistance = 0.0;
+	for(std::uint32_t cell : borderCells)
+	{
+		maxSquaredDistance = std::max(maxSquaredDistance, squaredDistance(cell));
+	}
+
+	// Half as far is a quarter of the squared distance, counted first so the exit takes a single draw
+	std::uint32_t numFarCells = 0;
+	for(std::uint32_t cell : borderCells)
+	{
+		numFarCells += (squaredDistance(cell) >= 0.25 * maxSquaredDistance && cell != entrance);
 	}
+	if(numFarCells == 0)
+	{
+		std::cerr << "WARNING: Maze is too small to generate proper entrance and exit\n    Be aware that the generated entrance and exit may be at the same location" << std::endl;
+		closedOffGraph.labelExit(entrance);
+		return;
+	}
+
+	std::uint32_t farCell = randomBelow(rng, numFarCells);
+	for(std::uint32_t cell : borderCells)
+	{
+		if(squaredDistance(cell) >= 0.25 * maxSquaredDistance && cell != entrance && farCell-- == 0)
+		{
+			closedOffGraph.labelExit(cell);
+			break;
+		}
+	}
+}
+
+/**--------------------------------------------------------------------------------------
+ * runWilson()
+ * 
+ * Given an "empty" GridGraph with no passageways, entrances, or exits uses Wilson's 
+ * Algorithm to create an unbiased maze on its grid, whatever the topology
+ *     Same loop-erased random walks as on a Maze: each step moves to one of the cell's 
+ *     neighbors, every neighbor equally likely, read from the graph's adjacency arrays, 
+ *     and walks start from the lowest cell outside the maze
+ *     The entrance goes on a random border cell, and the exit on a random border cell at 
+ *     least half as far from it as the farthest one
+ * 
+ * @param[in,out] blankGraph "empty" GridGraph, updated so that every cell is connected to 
+ * each other, and an entrance and exit cell both exist
+ * @param[in,out] rng Random number engine driving the random walks, the same engine state
+ * always produces the same maze
+ * @return the total number of random walk steps taken to fill out the maze, the graph is 
+ * left without an entrance if a cell has no neighbors to walk to
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runWilson(GridGraph& blankGraph, RngEngine& rng)
+{
+	METRIC_TIMER(METRIC_WILSON_TIMER)
+	const std::uint32_t numCells = static_cast<std::uint32_t>(blankGraph.getNumCells());
+
+	// false: cell is not in the maze, true: cell is in the maze
+	// Neighbor slot of the last exit from each cell, reused by every random walk
+	std::vector<bool> inMaze(numCells, false);
+	std::vector<std::uint8_t> walkSlots(numCells, 0);
+	std::uint64_t numWalkSteps = 0;
+
+	inMaze[randomBelow(rng, numCells)] = true;
+
+	// Walks start from the first cell outside the maze, the cursor never has to move backwards
+	for(std::uint32_t cursor = 0; cursor < numCells; cursor++)
+	{
+		if(inMaze[cursor])
+		{
+			continue;
+		}
+
+		// Random walk until reaching a cell "in" the maze, recording the slot of each exit
+		std::uint32_t curCell = cursor;
+		if(blankGraph.getDegree(curCell) == 0)
+		{
+			// No walk ever reaches or leaves a cell without neighbors, so the maze can never be finished
+			std::cerr << "ERROR: runWilson() cannot reach cell " << curCell << ", it has no neighbors" << std::endl;
+			return numWalkSteps;
+		}
+		while(!inMaze[curCell])
+		{
+			const int slot = static_cast<int>(randomBelow(rng, static_cast<std::uint32_t>(blankGraph.getDegree(curCell))));
+			walkSlots[curCell] = static_cast<std::uint8_t>(slot);
+			curCell = blankGraph.getNeighbor(curCell, slot);
+			numWalkSteps++;
+		}
+		METRIC_ADD(METRIC_WALKS, 1)
+
+		// Travel along the loop-erased path, adding each cell to the maze and opening the walls along the way
+		curCell = cursor;
+		while(!inMaze[curCell])
+		{
+			const int slot = walkSlots[curCell];
+			inMaze[curCell] = true;
+			blankGraph.openEdge(blankGraph.getEdge(curCell, slot));
+			curCell = blankGraph.getNeighbor(curCell, slot);
+		}
+	}
+
+	METRIC_ADD(METRIC_WALK_STEPS, numWalkSteps)
+	METRIC_ADD(METRIC_ERASED_STEPS, numWalkSteps - (numCells - 1))
+
+	createGraphEntranceAndExit(blankGraph, rng);
+
+	return numWalkSteps;
+}
+
+/**--------------------------------------------------------------------------------------
+ * wilsonScratchBytes()
+ * 
+ * Returns the room runWilson() takes from its scratch arena
+ * 
+ * @param[in] numRows Number of rows in the maze
+ * @param[in] numCols Number of columns in the maze
+ * @return one row pointer per row, one inMaze bool per cell and 2 bits of walk direction 
+ * per cell, in bytes
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t wilsonScratchBytes(int numRows, int numCols)
+{
+	const std::size_t numCells = static_cast<std::size_t>(numRows) * static_cast<std::size_t>(numCols);
+	return ScratchArena::bytesFor<bool*>(static_cast<std::size_t>(numRows)) + ScratchArena::bytesFor<bool>(numCells) + \
+		   ScratchArena::bytesFor<std::uint8_t>((numCells + 3) / 4);
+}
+
+// Explicit instantiations for the engines in rng.h
+template std::uint64_t runWilson<SplitMix64>(Maze& blankMaze, SplitMix64& rng, double aldousBroderFraction, ScratchArena* scratch);
+template std::uint64_t runWilson<Xoshiro256StarStar>(Maze& blankMaze, Xoshiro256StarStar& rng, double aldousBroderFraction, ScratchArena* scratch);
+template std::uint64_t runWilson<Pcg32>(Maze& blankMaze, Pcg32& rng, double aldousBroderFraction, ScratchArena* scratch);
+
+template void chooseEntranceAndExit<SplitMix64>(int numRows, int numCols, SplitMix64& rng, int& entranceRow, int& entranceCol, int& exitRow, int& exitCol);
+template void chooseEntranceAndExit<Xoshiro256StarStar>(int numRows, int numCols, Xoshiro256StarStar& rng, int& entranceRow, int& entranceCol, int& exitRow, int& exitCol);
+template void chooseEntranceAndExit<Pcg32>(int numRows, int numCols, Pcg32& rng, int& entranceRow, int& entranceCol, int& exitRow, int& exitCol);
+
+template void createEntranceAndExit<SplitMix64>(Maze& closedOffMaze, SplitMix64& rng);
+template void createEntranceAndExit<Xoshiro256StarStar>(Maze& closedOffMaze, Xoshiro256StarStar& rng);
+template void createEntranceAndExit<Pcg32>(Maze& closedOffMaze, Pcg32& rng);
 
-	delete[] inMaze;
-}
\ No newline at end of file
+template std::uint64_t runWilson<SplitMix64>(GridGraph& blankGraph, SplitMix64& rng);
+template std::uint64_t runWilson<Xoshiro256StarStar>(GridGraph& blankGraph, Xoshiro256StarStar& rng);
+template std::uint64_t runWilson<Pcg32>(GridGraph& blankGraph, Pcg32& rng);
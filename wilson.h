@@ -34,19 +34,116 @@
 
 #pragma once
 
+#include "gridGraph.h"
 #include "maze.h"
+#include "rng.h"
+#include "scratchArena.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Fraction of the cells the hybrid generator adds with the Aldous-Broder Algorithm before 
+ * switching to Wilson's Algorithm, see runWilson()
+ *     The fastest on 1000x1000 mazes, about 2.5 times faster than Wilson's Algorithm alone
+*/
+const double DEFAULT_ALDOUS_BRODER_FRACTION = 0.3;
 
 /**--------------------------------------------------------------------------------------
  * runWilson()
  * 
  * Given an "empty" maze with no passageways, entrances, or exits uses Wilson's Algorithm
- * to create an unbiased maze
+ * to create an unbiased maze, or a biased one when started off with aldousBroderWalk()
  *     Repeatedly uses loop-erased random walks to "fill out" the maze, until every cell
  *     in the grid is connected to the maze
  * 
  * @param[in,out] blankMaze "empty" Maze object containing no passageways, entrances or 
  * exits, updates the Maze object so that every cell in the grid is connected to each 
  * other, and an entrance and exit cell both exist
+ * @param[in,out] rng Random number engine driving the random walks, the same engine state
+ * always produces the same maze
+ * @param[in] aldousBroderFraction Fraction of the cells to add with aldousBroderWalk() 
+ * before switching to loop-erased random walks, 0 for Wilson's Algorithm alone and the 
+ * only value that keeps the maze unbiased, see DEFAULT_ALDOUS_BRODER_FRACTION
+ * @param[in,out] scratch Arena to take the inMaze grid and walk directions from, see 
+ * wilsonScratchBytes(), or nullptr to allocate them for this maze alone
+ * @return the total number of random walk steps taken to fill out the maze, Aldous-Broder 
+ * steps included
+ * 
+ * Instantiated in wilson.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runWilson(Maze& blankMaze, RngEngine& rng, double aldousBroderFraction = 0.0, ScratchArena* scratch = nullptr);
+
+/**--------------------------------------------------------------------------------------
+ * runWilson()
+ * 
+ * Given an "empty" GridGraph with no passageways, entrances, or exits uses Wilson's 
+ * Algorithm to create an unbiased maze on its grid, whatever the topology
+ *     Same loop-erased random walks as on a Maze: each step moves to one of the cell's 
+ *     neighbors, every neighbor equally likely, read from the graph's adjacency arrays, 
+ *     and walks start from the lowest cell outside the maze
+ *     The entrance goes on a random border cell, and the exit on a random border cell at 
+ *     least half as far from it as the farthest one
+ * 
+ * @param[in,out] blankGraph "empty" GridGraph, updated so that every cell is connected to 
+ * each other, and an entrance and exit cell both exist
+ * @param[in,out] rng Random number engine driving the random walks, the same engine state
+ * always produces the same maze
+ * @return the total number of random walk steps taken to fill out the maze, the graph is 
+ * left without an entrance if a cell has no neighbors to walk to
+ * 
+ * Instantiated in wilson.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+std::uint64_t runWilson(GridGraph& blankGraph, RngEngine& rng);
+
+/**--------------------------------------------------------------------------------------
+ * wilsonScratchBytes()
+ * 
+ * Returns the room runWilson() takes from its scratch arena
+ * 
+ * @param[in] numRows Number of rows in the maze
+ * @param[in] numCols Number of columns in the maze
+ * @return one row pointer per row, one inMaze bool per cell and 2 bits of walk direction 
+ * per cell, in bytes
+ * --------------------------------------------------------------------------------------
+*/
+std::size_t wilsonScratchBytes(int numRows, int numCols);
+
+/**--------------------------------------------------------------------------------------
+ * chooseEntranceAndExit()
+ * 
+ * Picks an entrance and an exit on the border of a numRows x numCols maze so that they are not too close to each other
+ *     Needs no Maze, so generators that stream the maze out can place them before writing anything
+ * 
+ * @param[in] numRows       Number of rows in the maze
+ * @param[in] numCols       Number of columns in the maze
+ * @param[in,out] rng       Random number engine used to place the entrance and exit
+ * @param[out] entranceRow  Row index of the entrance
+ * @param[out] entranceCol  Column index of the entrance
+ * @param[out] exitRow      Row index of the exit
+ * @param[out] exitCol      Column index of the exit
+ * 
+ * Instantiated in wilson.cpp for every engine in rng.h
+ * --------------------------------------------------------------------------------------
+*/
+template <typename RngEngine>
+void chooseEntranceAndExit(int numRows, int numCols, RngEngine& rng, int& entranceRow, int& entranceCol, int& exitRow, int& exitCol);
+
+/**--------------------------------------------------------------------------------------
+ * createEntranceAndExit()
+ * 
+ * Given a "closed off" maze (no entrance or exit), marks its entrance and exit so that they are not too close to each other
+ *     Shared by every generator that fills out a blank maze, see chooseEntranceAndExit()
+ * 
+ * @param[in] closedOffMaze A maze that has no entrance or exit cells
+ * @param[in,out] rng       Random number engine used to place the entrance and exit
+ * 
+ * Instantiated in wilson.cpp for every engine in rng.h
  * --------------------------------------------------------------------------------------
 */
-void runWilson(Maze& blankMaze);
\ No newline at end of file
+template <typename RngEngine>
+void createEntranceAndExit(Maze& closedOffMaze, RngEngine& rng);